@@ -0,0 +1,170 @@
+//================================================================================================
+/// @file main.cpp
+///
+/// @brief Benchmarks how well per-port processing isolates the latency of quiet CAN ports from a busy one.
+/// @details Three virtual CAN channels are connected to the stack. Channel 0 is flooded with bursts
+/// of frames that are expensive to process, while channels 1 and 2 carry a probe frame every 10 ms.
+/// The probes carry the time they were sent, so the time until the stack delivers them to the application is measured.
+/// Run it without arguments to process all ports together, or with `--per-port` to process each port on its own thread.
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/hardware_integration/can_hardware_interface.hpp"
+#include "isobus/hardware_integration/virtual_can_plugin.hpp"
+#include "isobus/isobus/can_general_parameter_group_numbers.hpp"
+#include "isobus/isobus/can_network_manager.hpp"
+#include "isobus/utility/system_timing.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+static constexpr std::uint8_t NUMBER_OF_CHANNELS = 3;
+static constexpr std::uint32_t FLOOD_PGN = 0xFF00; ///< Proprietary B PGN of the frames flooding channel 0
+static constexpr std::uint32_t PROBE_PGN = 0xFF01; ///< Proprietary B PGN of the probe frames on channels 1 and 2
+static constexpr std::uint32_t FLOOD_FRAMES_PER_BURST = 500;
+static constexpr std::uint32_t FLOOD_BURST_INTERVAL_MS = 25;
+static constexpr std::uint32_t FLOOD_PROCESSING_TIME_US = 20; ///< How long the application takes to handle each flood frame
+static constexpr std::uint32_t PROBE_INTERVAL_MS = 10;
+static constexpr std::uint32_t BENCHMARK_DURATION_MS = 5000;
+
+static std::atomic_bool running = { true };
+static std::mutex latencyMutex;
+static std::array<std::vector<std::uint64_t>, NUMBER_OF_CHANNELS> probeLatencies_us;
+
+static isobus::CANMessageFrame create_frame(std::uint32_t parameterGroupNumber, std::uint8_t sourceAddress)
+{
+	isobus::CANMessageFrame frame = {};
+	frame.identifier = (static_cast<std::uint32_t>(6) << 26) | (parameterGroupNumber << 8) | sourceAddress;
+	frame.isExtendedFrame = true;
+	frame.dataLength = 8;
+	return frame;
+}
+
+static void claim_address(isobus::VirtualCANPlugin &device, std::uint8_t address)
+{
+	// The stack only passes on broadcasts from control functions that it knows about
+	isobus::NAME name(0);
+	name.set_arbitrary_address_capable(true);
+	name.set_industry_group(2);
+	name.set_identity_number(address);
+
+	isobus::CANMessageFrame frame = create_frame(static_cast<std::uint32_t>(isobus::CANLibParameterGroupNumber::AddressClaim) | isobus::CANIdentifier::GLOBAL_ADDRESS, address);
+	const std::uint64_t fullName = name.get_full_name();
+	for (std::uint8_t i = 0; i < 8; i++)
+	{
+		frame.data[i] = static_cast<std::uint8_t>(fullName >> (8 * i));
+	}
+	device.write_frame(frame);
+}
+
+static void on_flood_frame(const isobus::CANMessage &, void *)
+{
+	// Simulates an application that does real work for each frame of the busy bus
+	const std::uint64_t start_us = isobus::SystemTiming::get_timestamp_us();
+	while (!isobus::SystemTiming::time_expired_us(start_us, FLOOD_PROCESSING_TIME_US))
+	{
+	}
+}
+
+static void on_probe_frame(const isobus::CANMessage &message, void *)
+{
+	const std::uint64_t received_us = isobus::SystemTiming::get_timestamp_us();
+	std::uint64_t sent_us = 0;
+	std::memcpy(&sent_us, message.get_data().data(), sizeof(sent_us));
+
+	const std::lock_guard<std::mutex> lock(latencyMutex);
+	probeLatencies_us[message.get_can_port_index()].push_back(received_us - sent_us);
+}
+
+static void flood_channel(const std::string &channelName)
+{
+	isobus::VirtualCANPlugin device(channelName);
+	isobus::CANMessageFrame frame = create_frame(FLOOD_PGN, 0x90);
+	device.open();
+	claim_address(device, 0x90);
+
+	while (running)
+	{
+		for (std::uint32_t i = 0; i < FLOOD_FRAMES_PER_BURST; i++)
+		{
+			device.write_frame(frame);
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(FLOOD_BURST_INTERVAL_MS));
+	}
+}
+
+static void probe_channel(const std::string &channelName)
+{
+	isobus::VirtualCANPlugin device(channelName);
+	isobus::CANMessageFrame frame = create_frame(PROBE_PGN, 0x91);
+	device.open();
+	claim_address(device, 0x91);
+
+	while (running)
+	{
+		const std::uint64_t sent_us = isobus::SystemTiming::get_timestamp_us();
+		std::memcpy(frame.data, &sent_us, sizeof(sent_us));
+		device.write_frame(frame);
+		std::this_thread::sleep_for(std::chrono::milliseconds(PROBE_INTERVAL_MS));
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const bool perPortProcessing = (argc > 1) && (std::string("--per-port") == argv[1]);
+
+	isobus::CANNetworkManager::CANNetwork.get_configuration().set_per_port_processing(perPortProcessing);
+	isobus::CANHardwareInterface::set_per_channel_processing(perPortProcessing);
+	isobus::CANHardwareInterface::set_number_of_can_channels(NUMBER_OF_CHANNELS);
+	for (std::uint8_t i = 0; i < NUMBER_OF_CHANNELS; i++)
+	{
+		isobus::CANHardwareInterface::assign_can_channel_frame_handler(i, std::make_shared<isobus::VirtualCANPlugin>("bus" + std::to_string(i)));
+	}
+
+	isobus::CANNetworkManager::CANNetwork.add_global_parameter_group_number_callback(FLOOD_PGN, on_flood_frame, nullptr);
+	isobus::CANNetworkManager::CANNetwork.add_global_parameter_group_number_callback(PROBE_PGN, on_probe_frame, nullptr);
+
+	if (!isobus::CANHardwareInterface::start())
+	{
+		std::cout << "Failed to start the hardware interface." << std::endl;
+		return -1;
+	}
+
+	std::vector<std::thread> trafficThreads;
+	trafficThreads.emplace_back(flood_channel, "bus0");
+	for (std::uint8_t i = 1; i < NUMBER_OF_CHANNELS; i++)
+	{
+		trafficThreads.emplace_back(probe_channel, "bus" + std::to_string(i));
+	}
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(BENCHMARK_DURATION_MS));
+	running = false;
+	for (auto &thread : trafficThreads)
+	{
+		thread.join();
+	}
+	isobus::CANHardwareInterface::stop();
+
+	std::cout << (perPortProcessing ? "Per-port processing" : "Shared processing") << ", probe latency while channel 0 is flooded:" << std::endl;
+	for (std::uint8_t i = 1; i < NUMBER_OF_CHANNELS; i++)
+	{
+		auto &latencies = probeLatencies_us[i];
+
+		if (latencies.empty())
+		{
+			std::cout << "  Channel " << static_cast<int>(i) << ": no probes received" << std::endl;
+			continue;
+		}
+		std::sort(latencies.begin(), latencies.end());
+		std::cout << "  Channel " << static_cast<int>(i) << ": " << latencies.size() << " probes, median " << latencies[latencies.size() / 2]
+		          << " us, 99th percentile " << latencies[(latencies.size() * 99) / 100] << " us, max " << latencies.back() << " us" << std::endl;
+	}
+	return 0;
+}
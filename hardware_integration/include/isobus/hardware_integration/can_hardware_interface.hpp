@@ -11,18 +11,23 @@
 #define CAN_HARDWARE_INTERFACE_HPP
 
 #include "isobus/hardware_integration/can_hardware_plugin.hpp"
+#include "isobus/isobus/can_channel_metrics.hpp"
 #include "isobus/isobus/can_hardware_abstraction.hpp"
 #include "isobus/isobus/can_message_frame.hpp"
 #include "isobus/utility/event_dispatcher.hpp"
+#include "isobus/utility/lock_free_event_dispatcher.hpp"
 
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <deque>
+#include <string>
 #include <vector>
 
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 #include <condition_variable>
+#include <mutex>
 #include <thread>
 #endif
 
@@ -36,6 +41,44 @@ namespace isobus
 	class CANHardwareInterface
 	{
 	public:
+		/// @brief The scheduling policies that can be requested for the threads of the interface
+		enum class ThreadSchedulingPolicy : std::uint8_t
+		{
+			Default, ///< Keep the policy the thread was created with, normally time-sharing
+			Fifo, ///< Real-time first-in-first-out scheduling (SCHED_FIFO)
+			RoundRobin ///< Real-time round-robin scheduling (SCHED_RR)
+		};
+
+		/// @brief The scheduling settings for a group of threads of the interface
+		struct ThreadScheduling
+		{
+			ThreadSchedulingPolicy policy = ThreadSchedulingPolicy::Default; ///< The scheduling policy of the threads
+			int priority = 0; ///< The real-time priority of the threads, only used for the real-time policies
+			std::uint64_t cpuAffinityMask = 0; ///< The CPUs the threads may run on, where bit N is CPU N, or 0 to allow all CPUs
+		};
+
+		/// @brief A snapshot of how punctually the periodic updates of the stack ran
+		/// @details The lateness of an update is the time between when it was due and when it started.
+		/// The buckets of the histogram have the same limits as `CANChannelMetrics::receiveLatencyHistogram`.
+		/// The latency between receiving a frame and processing it is available from `CANChannelMetrics`.
+		struct UpdateTimingStatistics
+		{
+			std::uint64_t numberOfUpdates; ///< The number of periodic updates since startup
+			std::uint64_t maximumLateness_us; ///< The highest lateness of a periodic update since startup
+			std::array<std::uint32_t, CANChannelMetrics::NUMBER_OF_LATENCY_BUCKETS> latenessHistogram; ///< The number of periodic updates by lateness
+		};
+
+		/// @brief A snapshot of the usage of the frame queues of a CAN channel
+		struct QueueStatistics
+		{
+			std::size_t receiveQueueCapacity; ///< The configured capacity of the receive queue
+			std::size_t transmitQueueCapacity; ///< The configured capacity of the transmit queue
+			std::size_t receiveQueueHighWaterMark; ///< The highest number of frames in the receive queue since startup
+			std::size_t transmitQueueHighWaterMark; ///< The highest number of frames in the transmit queue since startup
+			std::size_t receiveQueueFullCount; ///< The number of times frames were left in the driver because the receive queue was full, where the driver may drop them
+			std::size_t transmitQueueDroppedFrames; ///< The number of frames that were not transmitted because the transmit queue was full
+		};
+
 		/// @brief Returns the number of configured CAN channels that the class is managing
 		/// @returns The number of configured CAN channels that the class is managing
 		static std::uint8_t get_number_of_can_channels();
@@ -63,6 +106,12 @@ namespace isobus
 		/// @returns `true` if the driver was removed from the channel, otherwise `false`
 		static bool unassign_can_channel_frame_handler(std::uint8_t channelIndex);
 
+		/// @brief Gets a snapshot of the usage of the frame queues of a channel, to diagnose overloaded buses
+		/// @param[in] channelIndex The channel to get the statistics of
+		/// @param[out] statistics The statistics of the channel's queues
+		/// @returns `true` if the statistics were retrieved, `false` if the channel doesn't exist
+		static bool get_queue_statistics(std::uint8_t channelIndex, QueueStatistics &statistics);
+
 		/// @brief Gets the CAN driver assigned to a channel
 		/// @param[in] channelIndex The channel to get the driver from
 		/// @returns The driver assigned to the channel, or `nullptr` if the channel is not assigned
@@ -87,11 +136,11 @@ namespace isobus
 
 		/// @brief Get the event dispatcher for when a CAN message frame is received from hardware event
 		/// @returns The event dispatcher which can be used to register callbacks/listeners to
-		static EventDispatcher<const CANMessageFrame &> &get_can_frame_received_event_dispatcher();
+		static LockFreeEventDispatcher<const CANMessageFrame &> &get_can_frame_received_event_dispatcher();
 
 		/// @brief Get the event dispatcher for when a CAN message frame will be send to hardware event
 		/// @returns The event dispatcher which can be used to register callbacks/listeners to
-		static EventDispatcher<const CANMessageFrame &> &get_can_frame_transmitted_event_dispatcher();
+		static LockFreeEventDispatcher<const CANMessageFrame &> &get_can_frame_transmitted_event_dispatcher();
 
 		/// @brief Get the event dispatcher for when a periodic update is called
 		/// @returns The event dispatcher which can be used to register callbacks/listeners to
@@ -109,14 +158,53 @@ namespace isobus
 		/// @returns The interval between update calls in milliseconds
 		static std::uint32_t get_periodic_update_interval();
 
+		/// @brief Enables or disables processing each CAN channel on its own thread
+		/// @details When enabled, each channel gets a thread that receives its frames, passes them
+		/// to the stack and updates the stack for that channel at the periodic update interval, so
+		/// a busy bus does not delay the processing of the other buses. Transmitting and the update
+		/// of the state shared between channels stay on the main thread.
+		/// Enable `CANNetworkConfiguration::set_per_port_processing` as well to get this isolation
+		/// in the network manager, otherwise the network manager still processes all channels at once.
+		/// @note The function will fail if the interface is already started, or if threads are disabled
+		/// @param[in] enabled `true` to process each channel on its own thread, otherwise `false`
+		/// @returns `true` if the setting was changed, otherwise `false`
+		static bool set_per_channel_processing(bool enabled);
+
+		/// @brief Returns if each CAN channel is processed on its own thread
+		/// @returns `true` if each channel is processed on its own thread, otherwise `false`
+		static bool get_per_channel_processing();
+
+		/// @brief Sets the scheduling of the thread that updates the stack and transmits frames
+		/// @details Real-time scheduling keeps the timing of the transport protocols and cyclic
+		/// messages steady when the rest of the application keeps the CPUs busy. It usually requires
+		/// elevated privileges (like CAP_SYS_NICE), and if it can't be applied the thread runs with its
+		/// default scheduling and a warning is logged. Only supported on Linux.
+		/// @note The function will fail if the interface is already started, or if threads are disabled
+		/// @param[in] scheduling The scheduling settings for the thread
+		/// @returns `true` if the settings were stored, otherwise `false`
+		static bool set_update_thread_scheduling(const ThreadScheduling &scheduling);
+
+		/// @brief Sets the scheduling of the threads that receive frames from the drivers
+		/// @details This also applies to the per-channel threads when per-channel processing is enabled.
+		/// See `set_update_thread_scheduling` for the requirements.
+		/// @note The function will fail if the interface is already started, or if threads are disabled
+		/// @param[in] scheduling The scheduling settings for the threads
+		/// @returns `true` if the settings were stored, otherwise `false`
+		static bool set_receive_thread_scheduling(const ThreadScheduling &scheduling);
+
+		/// @brief Gets a snapshot of how punctually the periodic updates of the stack ran, to diagnose timing jitter
+		/// @param[out] statistics The timing statistics of the periodic updates
+		static void get_update_timing_statistics(UpdateTimingStatistics &statistics);
+
 	private:
 		/// @brief Stores the data for a single CAN channel
 		class CANHardware
 		{
 		public:
 			/// @brief Constructor for the CANHardware
+			/// @param[in] channelIndex The index of this CAN channel
 			/// @param[in] queueCapacity The capacity of the transmit and receive queues
-			explicit CANHardware(std::size_t queueCapacity);
+			CANHardware(std::uint8_t channelIndex, std::size_t queueCapacity);
 
 			/// @brief Destructor for the CANHardware
 			virtual ~CANHardware();
@@ -129,17 +217,33 @@ namespace isobus
 			/// @returns `true` if the channel was stopped, otherwise `false`
 			bool stop();
 
-			/// @brief Try to transmit the frame to the hardware
-			/// @param[in] frame The frame to transmit
-			/// @returns `true` if the frame was transmitted, otherwise `false`
-			bool transmit_can_frame(const CANMessageFrame &frame) const;
+			/// @brief Try to transmit the frames to the hardware, in order
+			/// @param[in] frames The frames to transmit
+			/// @returns The number of frames that were transmitted, counted from the start of `frames`
+			std::size_t transmit_can_frames(DataSpan<const CANMessageFrame> frames) const;
 
-			/// @brief Receives a frame from the hardware and adds it to the receive queue
-			/// @returns `true` if a frame was received, otherwise `false`
+			/// @brief Receives as many frames as the hardware has available (and the receive queue can hold)
+			/// and adds them to the receive queue
+			/// @returns `true` if at least one frame was received, otherwise `false`
 			bool receive_can_frame();
 
+			/// @brief Passes all frames in the receive queue on to the stack
+			void process_received_frames();
+
+			/// @brief Raises a high-water mark to a new value, if the value is higher
+			/// @param[in] highWaterMark The high-water mark to update
+			/// @param[in] value The value to raise the high-water mark to
+			static void update_high_water_mark(std::atomic<std::size_t> &highWaterMark, std::size_t value);
+
+			/// @brief The maximum number of frames requested from the driver in one `read_frames` call
+			static constexpr std::size_t MAX_FRAMES_PER_RECEIVE = 32;
+
+			/// @brief The maximum number of frames handed to the driver in one `write_frames` call
+			static constexpr std::size_t MAX_FRAMES_PER_TRANSMIT = 32;
+
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
-			/// @brief Starts the receiving thread for this CAN channel
+			/// @brief Starts receiving for this CAN channel, either through the shared receive reactor
+			/// or, if the driver can't be serviced by it, on a dedicated thread
 			void start_threads();
 
 			/// @brief Stops the receiving thread for this CAN channel
@@ -148,14 +252,42 @@ namespace isobus
 			/// @brief The receiving thread loop for this CAN channel
 			void receive_thread_function();
 
+			/// @brief The thread loop for this CAN channel when per-channel processing is enabled,
+			/// which receives frames, passes them to the stack and updates the stack for this channel
+			void processing_thread_function();
+
+			/// @brief Stops receiving for this channel while its receive queue is full, so that the receiving
+			/// thread doesn't keep waking up for frames it has no room for
+			/// @details With the receive reactor this stops polling the driver's file descriptor and returns straight away.
+			/// Otherwise it blocks the calling receive thread until the queue has been processed, or a timeout.
+			void pause_receiving();
+
+			/// @brief Resumes receiving for this channel if it was paused because its receive queue was full
+			void resume_receiving();
+
+			/// @brief The time a receive thread waits for a frame before re-checking its state, in milliseconds
+			static constexpr std::uint32_t RECEIVE_WAIT_TIMEOUT_MS = 100;
+
 			std::unique_ptr<std::thread> receiveMessageThread; ///< Thread to manage getting messages from a CAN channel
 			std::atomic_bool receiveThreadRunning = { false }; ///< Flag to indicate if the receive thread is running
+			std::uint64_t periodicUpdateDeadline_us = 0; ///< When the stack is due to be updated for this channel, when per-channel processing is enabled
+			std::mutex receivePauseMutex; ///< Protects pausing and resuming receiving for this channel
+			std::condition_variable receiveResumeCondition; ///< Signals a paused receive thread that the receive queue has been processed
+			bool receivePaused = false; ///< If receiving is paused until the receive queue has been processed
+			bool inReceiveReactor = false; ///< If this channel is received by the shared receive reactor instead of its own thread
 #endif
 
+			const std::uint8_t channelIndex; ///< The index of this CAN channel
 			std::shared_ptr<CANHardwarePlugin> frameHandler; ///< The CAN driver to use for a CAN channel
 
 			LockFreeQueue<CANMessageFrame> messagesToBeTransmittedQueue; ///< Transmit message queue for a CAN channel
 			LockFreeQueue<CANMessageFrame> receivedMessagesQueue; ///< Receive message queue for a CAN channel
+			const std::size_t queueCapacity; ///< The capacity of the transmit and receive queues
+
+			std::atomic<std::size_t> receiveQueueHighWaterMark = { 0 }; ///< The highest number of frames in the receive queue
+			std::atomic<std::size_t> transmitQueueHighWaterMark = { 0 }; ///< The highest number of frames in the transmit queue
+			std::atomic<std::size_t> receiveQueueFullCount = { 0 }; ///< The number of times receiving was skipped because the receive queue was full
+			std::atomic<std::size_t> transmitQueueDroppedFrames = { 0 }; ///< The number of frames dropped because the transmit queue was full
 		};
 
 		/// @brief Singleton instance of the CANHardwareInterface class
@@ -172,25 +304,64 @@ namespace isobus
 		/// @brief The main thread loop for updating the stack
 		static void update_thread_function();
 
+		/// @brief Wakes up the update thread to handle received frames or frames to transmit
+		/// @details The request is remembered if the update thread is busy, so it updates again straight away afterwards.
+		static void wake_update_thread();
+
 		/// @brief Starts all threads related to the hardware interface
 		static void start_threads();
 
 		/// @brief Stops all threads related to the hardware interface
 		static void stop_threads();
 
+		/// @brief Registers a channel with the shared receive reactor, starting the reactor if needed
+		/// @param[in] channel The channel to service from the reactor
+		/// @returns `true` if the channel is now serviced by the reactor, `false` if it needs its own receive thread
+		static bool add_to_receive_reactor(CANHardware *channel);
+
+		/// @brief The receive loop that services all channels registered with the reactor
+		static void receive_reactor_thread_function();
+
+		/// @brief Applies scheduling settings to the calling thread
+		/// @param[in] scheduling The scheduling settings to apply
+		/// @param[in] threadName The name of the thread to use in log messages
+		static void apply_thread_scheduling(const ThreadScheduling &scheduling, const std::string &threadName);
+
 		static std::unique_ptr<std::thread> updateThread; ///< The main thread
+		static std::unique_ptr<std::thread> receiveReactorThread; ///< A single thread receiving frames for all channels with a pollable driver
+		static int receiveReactorFileDescriptor; ///< The epoll instance used by the receive reactor, or -1 if unavailable
 		static std::condition_variable updateThreadWakeupCondition; ///< A condition variable to allow for signaling the `updateThread` to wakeup
+		static std::atomic_bool updateThreadWakeupPending; ///< If the update thread was asked to wake up since its last update
+		static ThreadScheduling updateThreadScheduling; ///< The scheduling settings of the update thread
+		static ThreadScheduling receiveThreadScheduling; ///< The scheduling settings of the receive threads
 #endif
-		static std::uint32_t lastUpdateTimestamp; ///< The last time the network manager was updated
+		/// @brief Records the lateness of a periodic update that is starting, and schedules the next one
+		/// @param[in,out] deadline_us When the update was due, which is advanced to when the next one is due
+		static void record_periodic_update(std::uint64_t &deadline_us);
+
+		/// @brief Returns the time until a deadline, for waiting on it
+		/// @param[in] deadline_us The deadline to wait for
+		/// @returns The time until the deadline in microseconds, or 0 if it has passed
+		static std::uint64_t get_time_until_us(std::uint64_t deadline_us);
+
+		/// @brief Returns when the stack next needs an update from the update thread for its protocol and heartbeat timers
+		/// @returns The deadline as a timestamp from SystemTiming::get_timestamp_us, or the largest `std::uint64_t` if there is none
+		static std::uint64_t get_next_stack_update_deadline_us();
+
+		static std::uint64_t periodicUpdateDeadline_us; ///< When the network manager is due to be updated
+		static std::atomic<std::uint64_t> numberOfPeriodicUpdates; ///< The number of periodic updates since startup
+		static std::atomic<std::uint64_t> maximumPeriodicUpdateLateness_us; ///< The highest lateness of a periodic update since startup
+		static std::array<std::atomic<std::uint32_t>, CANChannelMetrics::NUMBER_OF_LATENCY_BUCKETS> periodicUpdateLatenessHistogram; ///< The number of periodic updates by lateness
 		static std::uint32_t periodicUpdateInterval; ///< The period between calls to the network manager update function in milliseconds
-		static EventDispatcher<const CANMessageFrame &> frameReceivedEventDispatcher; ///< The event dispatcher for when a CAN message frame is received from hardware event
-		static EventDispatcher<const CANMessageFrame &> frameTransmittedEventDispatcher; ///< The event dispatcher for when a CAN message has been transmitted via hardware
+		static LockFreeEventDispatcher<const CANMessageFrame &> frameReceivedEventDispatcher; ///< The event dispatcher for when a CAN message frame is received from hardware event
+		static LockFreeEventDispatcher<const CANMessageFrame &> frameTransmittedEventDispatcher; ///< The event dispatcher for when a CAN message has been transmitted via hardware
 		static EventDispatcher<> periodicUpdateEventDispatcher; ///< The event dispatcher for when a periodic update is called
 
 		static std::vector<std::unique_ptr<CANHardware>> hardwareChannels; ///< A list of all CAN channel's metadata
 		static Mutex hardwareChannelsMutex; ///< Mutex to protect `hardwareChannels`
 		static Mutex updateMutex; ///< A mutex for the main thread
 		static std::atomic_bool started; ///< Stores if the threads have been started
+		static bool perChannelProcessing; ///< Stores if each channel is processed on its own thread
 	};
 }
 #endif // CAN_HARDWARE_INTERFACE_HPP
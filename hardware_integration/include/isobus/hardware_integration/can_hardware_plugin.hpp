@@ -10,6 +10,10 @@
 #define CAN_HARDEWARE_PLUGIN_HPP
 
 #include "isobus/isobus/can_message_frame.hpp"
+#include "isobus/utility/data_span.hpp"
+
+#include <cstddef>
+#include <cstdint>
 
 namespace isobus
 {
@@ -41,10 +45,66 @@ namespace isobus
 		/// @returns `true` if a CAN frame was read, otherwise `false`
 		virtual bool read_frame(isobus::CANMessageFrame &canFrame) = 0;
 
+		/// @brief Reads up to `canFrames.size()` frames from the bus synchronously
+		/// @details The default implementation reads a single frame with `read_frame`. Drivers that
+		/// can fetch several frames with one call to the OS or hardware should override this to
+		/// reduce the per-frame overhead on busy buses.
+		/// @param[in, out] canFrames The buffer to store the CAN frames that were read into
+		/// @returns The number of CAN frames that were read
+		virtual std::size_t read_frames(DataSpan<isobus::CANMessageFrame> canFrames)
+		{
+			std::size_t retVal = 0;
+
+			if ((canFrames.size() > 0) && read_frame(canFrames[0]))
+			{
+				retVal = 1;
+			}
+			return retVal;
+		}
+
+		/// @brief Blocks until a frame is available to be read, or the timeout expires
+		/// @details The receive thread calls this whenever no frame could be read, so drivers whose
+		/// `read_frame` returns immediately should override this to avoid busy-waiting.
+		/// The default implementation returns immediately, which is only suitable for drivers
+		/// that already block inside `read_frame`.
+		/// @param[in] timeout The maximum time to wait in milliseconds
+		/// @returns `true` if a frame might be available to read, `false` if the timeout expired
+		virtual bool wait_for_frame(std::uint32_t timeout)
+		{
+			(void)timeout;
+			return true;
+		}
+
+		/// @brief Returns an OS file descriptor that becomes readable when a frame is available
+		/// @details If a driver returns a valid descriptor here, the hardware interface will service
+		/// it from a single shared receive thread (where supported) instead of a thread per channel.
+		/// @returns The file descriptor, or -1 if the driver does not have one
+		virtual int get_receive_file_descriptor() const
+		{
+			return -1;
+		}
+
 		/// @brief Writes a frame to the bus (synchronous)
 		/// @param[in] canFrame The frame to write to the bus
 		/// @returns `true` if the frame was written, otherwise `false`
 		virtual bool write_frame(const isobus::CANMessageFrame &canFrame) = 0;
+
+		/// @brief Writes several frames to the bus (synchronous), in order
+		/// @details The default implementation writes the frames one by one with `write_frame` and
+		/// stops at the first frame that could not be written. Drivers that can hand several frames
+		/// to the OS or hardware in one call should override this.
+		/// @param[in] canFrames The frames to write to the bus
+		/// @returns The number of frames that were written, counted from the start of `canFrames`
+		virtual std::size_t write_frames(DataSpan<const isobus::CANMessageFrame> canFrames)
+		{
+			std::size_t retVal = 0;
+
+			while ((retVal < canFrames.size()) && write_frame(canFrames[retVal]))
+			{
+				retVal++;
+			}
+			return retVal;
+		}
 	};
 }
 #endif // CAN_HARDEWARE_PLUGIN_HPP
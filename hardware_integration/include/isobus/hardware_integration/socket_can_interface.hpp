@@ -54,17 +54,43 @@ namespace isobus
 		/// @returns `true` if a CAN frame was read, otherwise `false`
 		bool read_frame(isobus::CANMessageFrame &canFrame) override;
 
+		/// @brief Reads all frames that are pending on the socket with a single `recvmmsg` call.
+		/// @details Waits up to 100ms for the first frame, after which as many frames as are available
+		/// (limited by the size of `canFrames` and `MAX_FRAMES_PER_READ`) are read without blocking.
+		/// @param[in, out] canFrames The buffer to store the CAN frames that were read into
+		/// @returns The number of CAN frames that were read
+		std::size_t read_frames(DataSpan<isobus::CANMessageFrame> canFrames) override;
+
+		/// @brief Waits for the socket to become readable
+		/// @param[in] timeout The maximum time to wait in milliseconds
+		/// @returns `true` if a frame is available to read, `false` if the timeout expired
+		bool wait_for_frame(std::uint32_t timeout) override;
+
+		/// @brief Returns the file descriptor of the socket
+		/// @returns The file descriptor of the socket, or -1 if the socket is not open
+		int get_receive_file_descriptor() const override;
+
 		/// @brief Writes a frame to the bus (synchronous)
 		/// @param[in] canFrame The frame to write to the bus
 		/// @returns `true` if the frame was written, otherwise `false`
 		bool write_frame(const isobus::CANMessageFrame &canFrame) override;
 
+		/// @brief Writes several frames to the bus with a single `sendmmsg` call
+		/// @details If the socket's transmit queue is full (`ENOBUFS`) only the frames that were
+		/// accepted are reported, so the caller can retry the remainder later without reordering.
+		/// @param[in] canFrames The frames to write to the bus
+		/// @returns The number of frames that were written, counted from the start of `canFrames`
+		std::size_t write_frames(DataSpan<const isobus::CANMessageFrame> canFrames) override;
+
 		/// @brief Changes the name of the device to use, which only works if the device is not open
 		/// @param[in] newName The new name for the device (such as "can0" or "vcan0")
 		/// @returns `true` if the name was changed, otherwise `false` (if the device is open this will return false)
 		bool set_name(const std::string &newName);
 
 	private:
+		static constexpr std::size_t MAX_FRAMES_PER_READ = 32; ///< The maximum number of frames fetched from the socket per `recvmmsg` call
+		static constexpr std::size_t MAX_FRAMES_PER_WRITE = 32; ///< The maximum number of frames handed to the socket per `sendmmsg` call
+
 		struct sockaddr_can *pCANDevice; ///< The structure for CAN sockets
 		std::string name; ///< The device name
 		int fileDescriptor; ///< File descriptor for the socket
@@ -68,6 +68,11 @@ namespace isobus
 		/// @returns `true` if a CAN frame was read, otherwise `false`
 		bool read_frame(isobus::CANMessageFrame &canFrame, std::uint32_t timeout) const;
 
+		/// @brief Blocks until a frame is queued for this device, or the timeout expires
+		/// @param[in] timeout The maximum time to wait in milliseconds
+		/// @returns `true` if a frame is available to read, `false` if the timeout expired
+		bool wait_for_frame(std::uint32_t timeout) override;
+
 		/// @brief Writes a frame to the bus (synchronous)
 		/// @param[in] canFrame The frame to write to the bus
 		/// @returns `true` if the frame was written, otherwise `false`
@@ -13,30 +13,47 @@
 #include "isobus/utility/to_string.hpp"
 
 #include <algorithm>
+#include <array>
 #include <limits>
 
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO && defined __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
 namespace isobus
 {
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 	std::unique_ptr<std::thread> CANHardwareInterface::updateThread;
+	std::unique_ptr<std::thread> CANHardwareInterface::receiveReactorThread;
+	int CANHardwareInterface::receiveReactorFileDescriptor = -1;
 	std::condition_variable CANHardwareInterface::updateThreadWakeupCondition;
+	std::atomic_bool CANHardwareInterface::updateThreadWakeupPending = { false };
+	CANHardwareInterface::ThreadScheduling CANHardwareInterface::updateThreadScheduling;
+	CANHardwareInterface::ThreadScheduling CANHardwareInterface::receiveThreadScheduling;
 #endif
 	std::uint32_t CANHardwareInterface::periodicUpdateInterval = PERIODIC_UPDATE_INTERVAL;
-	std::uint32_t CANHardwareInterface::lastUpdateTimestamp;
+	std::uint64_t CANHardwareInterface::periodicUpdateDeadline_us = 0;
+	std::atomic<std::uint64_t> CANHardwareInterface::numberOfPeriodicUpdates = { 0 };
+	std::atomic<std::uint64_t> CANHardwareInterface::maximumPeriodicUpdateLateness_us = { 0 };
+	std::array<std::atomic<std::uint32_t>, CANChannelMetrics::NUMBER_OF_LATENCY_BUCKETS> CANHardwareInterface::periodicUpdateLatenessHistogram;
 
-	EventDispatcher<const CANMessageFrame &> CANHardwareInterface::frameReceivedEventDispatcher;
-	EventDispatcher<const CANMessageFrame &> CANHardwareInterface::frameTransmittedEventDispatcher;
+	LockFreeEventDispatcher<const CANMessageFrame &> CANHardwareInterface::frameReceivedEventDispatcher;
+	LockFreeEventDispatcher<const CANMessageFrame &> CANHardwareInterface::frameTransmittedEventDispatcher;
 	EventDispatcher<> CANHardwareInterface::periodicUpdateEventDispatcher;
 
 	std::vector<std::unique_ptr<CANHardwareInterface::CANHardware>> CANHardwareInterface::hardwareChannels;
 	Mutex CANHardwareInterface::hardwareChannelsMutex;
 	Mutex CANHardwareInterface::updateMutex;
 	std::atomic_bool CANHardwareInterface::started = { false };
+	bool CANHardwareInterface::perChannelProcessing = false;
 
 	CANHardwareInterface CANHardwareInterface::SINGLETON;
 
-	CANHardwareInterface::CANHardware::CANHardware(std::size_t queueCapacity) :
-	  messagesToBeTransmittedQueue(queueCapacity), receivedMessagesQueue(queueCapacity)
+	CANHardwareInterface::CANHardware::CANHardware(std::uint8_t channelIndex, std::size_t queueCapacity) :
+	  channelIndex(channelIndex), messagesToBeTransmittedQueue(queueCapacity), receivedMessagesQueue(queueCapacity), queueCapacity(queueCapacity)
 	{
 	}
 
@@ -78,29 +95,64 @@ namespace isobus
 		return false;
 	}
 
-	bool CANHardwareInterface::CANHardware::transmit_can_frame(const CANMessageFrame &frame) const
+	std::size_t CANHardwareInterface::CANHardware::transmit_can_frames(DataSpan<const CANMessageFrame> frames) const
 	{
-		if ((nullptr != frameHandler) && frameHandler->get_is_valid() && frameHandler->write_frame(frame))
+		if ((nullptr != frameHandler) && frameHandler->get_is_valid())
 		{
-			return true;
+			return frameHandler->write_frames(frames);
 		}
-		return false;
+		return 0;
 	}
 
 	bool CANHardwareInterface::CANHardware::receive_can_frame()
 	{
-		if ((nullptr != frameHandler) && frameHandler->get_is_valid() && (!receivedMessagesQueue.is_full()))
+		if ((nullptr != frameHandler) && frameHandler->get_is_valid())
 		{
-			CANMessageFrame frame;
-			if (frameHandler->read_frame(frame))
+			if (receivedMessagesQueue.is_full())
+			{
+				receiveQueueFullCount++;
+				return false;
+			}
+
+			std::array<CANMessageFrame, MAX_FRAMES_PER_RECEIVE> frames;
+			const std::size_t numberOfFramesToRead = std::min(frames.size(), receivedMessagesQueue.space_available());
+			const std::size_t numberOfFramesRead = frameHandler->read_frames(DataSpan<CANMessageFrame>(frames.data(), numberOfFramesToRead));
+
+			for (std::size_t i = 0; i < numberOfFramesRead; i++)
 			{
-				receivedMessagesQueue.push(frame);
-				return true; // Indicate that a frame was read
+				receivedMessagesQueue.push(frames[i]);
 			}
+			update_high_water_mark(receiveQueueHighWaterMark, receivedMessagesQueue.size());
+			return (numberOfFramesRead > 0); // Indicate that at least one frame was read
 		}
 		return false;
 	}
 
+	void CANHardwareInterface::CANHardware::update_high_water_mark(std::atomic<std::size_t> &highWaterMark, std::size_t value)
+	{
+		std::size_t currentHighWaterMark = highWaterMark.load();
+		while ((value > currentHighWaterMark) && (!highWaterMark.compare_exchange_weak(currentHighWaterMark, value)))
+		{
+			// currentHighWaterMark was updated by the failed exchange, so try again with it
+		}
+	}
+
+	void CANHardwareInterface::CANHardware::process_received_frames()
+	{
+		isobus::CANMessageFrame frame;
+		while (receivedMessagesQueue.peek(frame))
+		{
+			frame.channel = channelIndex;
+			frameReceivedEventDispatcher.invoke(frame);
+			receive_can_message_frame_from_hardware(frame);
+			receivedMessagesQueue.pop();
+		}
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		resume_receiving();
+#endif
+	}
+
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 	CANHardwareInterface::~CANHardwareInterface()
 	{
@@ -109,16 +161,30 @@ namespace isobus
 
 	void CANHardwareInterface::CANHardware::start_threads()
 	{
+		inReceiveReactor = ((!perChannelProcessing) && CANHardwareInterface::add_to_receive_reactor(this));
+		if (inReceiveReactor)
+		{
+			return;
+		}
+
 		receiveThreadRunning = true;
 		if (nullptr == receiveMessageThread)
 		{
-			receiveMessageThread.reset(new std::thread([this]() { receive_thread_function(); }));
+			if (perChannelProcessing)
+			{
+				receiveMessageThread.reset(new std::thread([this]() { processing_thread_function(); }));
+			}
+			else
+			{
+				receiveMessageThread.reset(new std::thread([this]() { receive_thread_function(); }));
+			}
 		}
 	}
 
 	void CANHardwareInterface::CANHardware::stop_threads()
 	{
 		receiveThreadRunning = false;
+		receiveResumeCondition.notify_all();
 		if (nullptr != receiveMessageThread)
 		{
 			if (receiveMessageThread->joinable())
@@ -131,18 +197,109 @@ namespace isobus
 
 	void CANHardwareInterface::CANHardware::receive_thread_function()
 	{
+		apply_thread_scheduling(receiveThreadScheduling, "receive");
+
 		while (receiveThreadRunning)
 		{
 			if ((nullptr != frameHandler) && frameHandler->get_is_valid())
 			{
-				if (!receive_can_frame())
+				if (receive_can_frame())
+				{
+					CANHardwareInterface::wake_update_thread();
+				}
+				else if (receivedMessagesQueue.is_full())
 				{
-					// There was no frame to receive, so if any other thread wants to do something, let it.
-					std::this_thread::yield();
+					// Frames might be pending that we have no room for, so wait for the update thread to process the queue
+					pause_receiving();
 				}
 				else
 				{
-					CANHardwareInterface::updateThreadWakeupCondition.notify_all();
+					frameHandler->wait_for_frame(RECEIVE_WAIT_TIMEOUT_MS);
+				}
+			}
+			else
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1000)); // Arbitrary, but don't want to infinite loop on the validity check.
+			}
+		}
+	}
+
+	void CANHardwareInterface::CANHardware::pause_receiving()
+	{
+		std::unique_lock<std::mutex> lock(receivePauseMutex);
+
+		// The queue might have been processed since the caller found it full, and then nobody would resume us
+		if (receivedMessagesQueue.is_full())
+		{
+			receivePaused = true;
+
+			if (inReceiveReactor)
+			{
+#ifdef __linux__
+				// Keep the file descriptor registered, but without any events until the queue has been processed
+				struct epoll_event event;
+				event.events = 0;
+				event.data.ptr = this;
+				epoll_ctl(receiveReactorFileDescriptor, EPOLL_CTL_MOD, frameHandler->get_receive_file_descriptor(), &event);
+#endif
+			}
+			else
+			{
+				receiveResumeCondition.wait_for(lock, std::chrono::milliseconds(RECEIVE_WAIT_TIMEOUT_MS), [this]() { return (!receivePaused) || (!receiveThreadRunning); });
+				receivePaused = false;
+			}
+		}
+	}
+
+	void CANHardwareInterface::CANHardware::resume_receiving()
+	{
+		std::lock_guard<std::mutex> lock(receivePauseMutex);
+
+		if (receivePaused)
+		{
+			receivePaused = false;
+
+			if (inReceiveReactor && (nullptr != frameHandler))
+			{
+#ifdef __linux__
+				struct epoll_event event;
+				event.events = EPOLLIN;
+				event.data.ptr = this;
+				epoll_ctl(receiveReactorFileDescriptor, EPOLL_CTL_MOD, frameHandler->get_receive_file_descriptor(), &event);
+#endif
+			}
+			else
+			{
+				receiveResumeCondition.notify_all();
+			}
+		}
+	}
+
+	void CANHardwareInterface::CANHardware::processing_thread_function()
+	{
+		apply_thread_scheduling(receiveThreadScheduling, "channel " + to_string(channelIndex));
+
+		while (receiveThreadRunning)
+		{
+			if ((nullptr != frameHandler) && frameHandler->get_is_valid())
+			{
+				// Wait for frames only until the next update of this channel is due, either the periodic one
+				// or an earlier one the stack needs for something like a protocol timeout
+				const std::uint64_t timeUntilUpdate_us = std::min(get_time_until_us(periodicUpdateDeadline_us), get_time_until_us(get_next_update_deadline_from_hardware(channelIndex)));
+				if (frameHandler->wait_for_frame(static_cast<std::uint32_t>((timeUntilUpdate_us + 999) / 1000)))
+				{
+					receive_can_frame();
+				}
+				process_received_frames();
+
+				const bool periodicUpdateDue = (0 == get_time_until_us(periodicUpdateDeadline_us));
+				if (periodicUpdateDue || (0 == get_time_until_us(get_next_update_deadline_from_hardware(channelIndex))))
+				{
+					if (periodicUpdateDue)
+					{
+						record_periodic_update(periodicUpdateDeadline_us);
+					}
+					periodic_update_from_hardware(channelIndex);
 				}
 			}
 			else
@@ -170,7 +327,7 @@ namespace isobus
 
 		while (value > static_cast<std::uint8_t>(hardwareChannels.size()))
 		{
-			hardwareChannels.emplace_back(new CANHardware(queueCapacity));
+			hardwareChannels.emplace_back(new CANHardware(static_cast<std::uint8_t>(hardwareChannels.size()), queueCapacity));
 		}
 		while (value < static_cast<std::uint8_t>(hardwareChannels.size()))
 		{
@@ -239,6 +396,24 @@ namespace isobus
 		return true;
 	}
 
+	bool CANHardwareInterface::get_queue_statistics(std::uint8_t channelIndex, QueueStatistics &statistics)
+	{
+		bool retVal = false;
+
+		if (channelIndex < static_cast<std::uint8_t>(hardwareChannels.size()))
+		{
+			const std::unique_ptr<CANHardware> &channel = hardwareChannels[channelIndex];
+			statistics.receiveQueueCapacity = channel->queueCapacity;
+			statistics.transmitQueueCapacity = channel->queueCapacity;
+			statistics.receiveQueueHighWaterMark = channel->receiveQueueHighWaterMark;
+			statistics.transmitQueueHighWaterMark = channel->transmitQueueHighWaterMark;
+			statistics.receiveQueueFullCount = channel->receiveQueueFullCount;
+			statistics.transmitQueueDroppedFrames = channel->transmitQueueDroppedFrames;
+			retVal = true;
+		}
+		return retVal;
+	}
+
 	std::shared_ptr<CANHardwarePlugin> CANHardwareInterface::get_assigned_can_channel_frame_handler(std::uint8_t channelIndex)
 	{
 		std::shared_ptr<CANHardwarePlugin> retVal;
@@ -314,23 +489,27 @@ namespace isobus
 			return false;
 		}
 
-		if ((channel->frameHandler->get_is_valid()) &&
-		    (channel->messagesToBeTransmittedQueue.push(frame)))
+		if (channel->frameHandler->get_is_valid())
 		{
+			if (channel->messagesToBeTransmittedQueue.push(frame))
+			{
+				CANHardware::update_high_water_mark(channel->transmitQueueHighWaterMark, channel->messagesToBeTransmittedQueue.size());
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
-			updateThreadWakeupCondition.notify_all();
+				wake_update_thread();
 #endif
-			return true;
+				return true;
+			}
+			channel->transmitQueueDroppedFrames++;
 		}
 		return false;
 	}
 
-	EventDispatcher<const CANMessageFrame &> &CANHardwareInterface::get_can_frame_received_event_dispatcher()
+	LockFreeEventDispatcher<const CANMessageFrame &> &CANHardwareInterface::get_can_frame_received_event_dispatcher()
 	{
 		return frameReceivedEventDispatcher;
 	}
 
-	EventDispatcher<const CANMessageFrame &> &CANHardwareInterface::get_can_frame_transmitted_event_dispatcher()
+	LockFreeEventDispatcher<const CANMessageFrame &> &CANHardwareInterface::get_can_frame_transmitted_event_dispatcher()
 	{
 		return frameTransmittedEventDispatcher;
 	}
@@ -350,12 +529,139 @@ namespace isobus
 		return periodicUpdateInterval;
 	}
 
+	bool CANHardwareInterface::set_per_channel_processing(bool enabled)
+	{
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		LOCK_GUARD(Mutex, hardwareChannelsMutex);
+
+		if (started)
+		{
+			LOG_ERROR("[HardwareInterface] Cannot change per-channel processing after interface is started.");
+			return false;
+		}
+
+		perChannelProcessing = enabled;
+		return true;
+#else
+		(void)enabled;
+		LOG_ERROR("[HardwareInterface] Per-channel processing requires threads.");
+		return false;
+#endif
+	}
+
+	bool CANHardwareInterface::get_per_channel_processing()
+	{
+		return perChannelProcessing;
+	}
+
+	bool CANHardwareInterface::set_update_thread_scheduling(const ThreadScheduling &scheduling)
+	{
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		LOCK_GUARD(Mutex, hardwareChannelsMutex);
+
+		if (started)
+		{
+			LOG_ERROR("[HardwareInterface] Cannot change the update thread scheduling after interface is started.");
+			return false;
+		}
+
+		updateThreadScheduling = scheduling;
+		return true;
+#else
+		(void)scheduling;
+		LOG_ERROR("[HardwareInterface] Thread scheduling requires threads.");
+		return false;
+#endif
+	}
+
+	bool CANHardwareInterface::set_receive_thread_scheduling(const ThreadScheduling &scheduling)
+	{
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+		LOCK_GUARD(Mutex, hardwareChannelsMutex);
+
+		if (started)
+		{
+			LOG_ERROR("[HardwareInterface] Cannot change the receive thread scheduling after interface is started.");
+			return false;
+		}
+
+		receiveThreadScheduling = scheduling;
+		return true;
+#else
+		(void)scheduling;
+		LOG_ERROR("[HardwareInterface] Thread scheduling requires threads.");
+		return false;
+#endif
+	}
+
+	void CANHardwareInterface::get_update_timing_statistics(UpdateTimingStatistics &statistics)
+	{
+		statistics.numberOfUpdates = numberOfPeriodicUpdates;
+		statistics.maximumLateness_us = maximumPeriodicUpdateLateness_us;
+		for (std::size_t i = 0; i < statistics.latenessHistogram.size(); i++)
+		{
+			statistics.latenessHistogram[i] = periodicUpdateLatenessHistogram[i];
+		}
+	}
+
+	std::uint64_t CANHardwareInterface::get_time_until_us(std::uint64_t deadline_us)
+	{
+		const std::uint64_t currentTimestamp_us = SystemTiming::get_timestamp_us();
+		return (deadline_us > currentTimestamp_us) ? (deadline_us - currentTimestamp_us) : 0;
+	}
+
+	void CANHardwareInterface::record_periodic_update(std::uint64_t &deadline_us)
+	{
+		const std::uint64_t currentTimestamp_us = SystemTiming::get_timestamp_us();
+		const std::uint64_t lateness_us = (currentTimestamp_us > deadline_us) ? (currentTimestamp_us - deadline_us) : 0;
+		const std::uint64_t interval_us = static_cast<std::uint64_t>(periodicUpdateInterval) * 1000;
+
+		std::size_t bucketIndex = 0;
+		while ((bucketIndex < (periodicUpdateLatenessHistogram.size() - 1)) &&
+		       (lateness_us >= CANChannelMetrics::get_latency_bucket_limit_us(bucketIndex)))
+		{
+			bucketIndex++;
+		}
+		periodicUpdateLatenessHistogram[bucketIndex]++;
+		numberOfPeriodicUpdates++;
+
+		std::uint64_t currentMaximum_us = maximumPeriodicUpdateLateness_us.load();
+		while ((lateness_us > currentMaximum_us) && (!maximumPeriodicUpdateLateness_us.compare_exchange_weak(currentMaximum_us, lateness_us)))
+		{
+			// currentMaximum_us was updated by the failed exchange, so try again with it
+		}
+
+		// Schedule against the deadline rather than the current time so that late updates don't
+		// shift all following ones, unless we fell behind by more than an interval
+		deadline_us += interval_us;
+		if (deadline_us <= currentTimestamp_us)
+		{
+			deadline_us = currentTimestamp_us + interval_us;
+		}
+	}
+
+	std::uint64_t CANHardwareInterface::get_next_stack_update_deadline_us()
+	{
+		std::uint64_t retVal = get_next_update_deadline_from_hardware();
+
+		if (!perChannelProcessing)
+		{
+			// The channels are updated from here too, so their own deadlines count if the stack processes them separately
+			for (std::uint8_t i = 0; i < hardwareChannels.size(); i++)
+			{
+				retVal = std::min(retVal, get_next_update_deadline_from_hardware(i));
+			}
+		}
+		return retVal;
+	}
+
 	void CANHardwareInterface::update()
 	{
 		if (started)
 		{
+			if (!perChannelProcessing)
 			{
-				// Stage 1 - Receiving messages from hardware
+				// Stage 1 - Receiving messages from hardware, unless each channel's own thread does that
 				LOCK_GUARD(Mutex, hardwareChannelsMutex);
 				for (std::uint8_t i = 0; i < hardwareChannels.size(); i++)
 				{
@@ -363,42 +669,51 @@ namespace isobus
 					// If we don't have threads, we need to poll the hardware for messages here
 					hardwareChannels[i]->receive_can_frame();
 #endif
-
-					isobus::CANMessageFrame frame;
-					while (hardwareChannels[i]->receivedMessagesQueue.peek(frame))
-					{
-						frame.channel = i;
-						frameReceivedEventDispatcher.invoke(frame);
-						receive_can_message_frame_from_hardware(frame);
-						hardwareChannels[i]->receivedMessagesQueue.pop();
-					}
+					hardwareChannels[i]->process_received_frames();
 				}
 			}
 
-			// Stage 2 - Update stack. That will fill up the transmit queues if needed
-			if (SystemTiming::time_expired_ms(lastUpdateTimestamp, periodicUpdateInterval))
+			// Stage 2 - Update stack. That will fill up the transmit queues if needed.
+			// Besides the periodic updates, the stack asks for updates when its protocol or heartbeat timers expire.
+			const bool periodicUpdateDue = (0 == get_time_until_us(periodicUpdateDeadline_us));
+			if (periodicUpdateDue || (0 == get_time_until_us(get_next_stack_update_deadline_us())))
 			{
-				periodicUpdateEventDispatcher.invoke();
+				if (periodicUpdateDue)
+				{
+					record_periodic_update(periodicUpdateDeadline_us);
+					periodicUpdateEventDispatcher.invoke();
+				}
 				periodic_update_from_hardware();
-				lastUpdateTimestamp = SystemTiming::get_timestamp_ms();
+
+				if (!perChannelProcessing)
+				{
+					for (std::uint8_t i = 0; i < hardwareChannels.size(); i++)
+					{
+						periodic_update_from_hardware(i);
+					}
+				}
 			}
 
 			// Stage 3 - Transmitting messages to hardware
 			{
 				LOCK_GUARD(Mutex, hardwareChannelsMutex);
 				std::for_each(hardwareChannels.begin(), hardwareChannels.end(), [](const std::unique_ptr<CANHardware> &channel) {
-					isobus::CANMessageFrame frame;
-					while (channel->messagesToBeTransmittedQueue.peek(frame))
+					std::array<CANMessageFrame, CANHardware::MAX_FRAMES_PER_TRANSMIT> frames;
+					std::size_t numberOfFramesQueued;
+					while ((numberOfFramesQueued = channel->messagesToBeTransmittedQueue.peek(frames.data(), frames.size())) > 0)
 					{
-						if (channel->transmit_can_frame(frame))
+						const std::size_t numberOfFramesTransmitted = channel->transmit_can_frames(DataSpan<const CANMessageFrame>(frames.data(), numberOfFramesQueued));
+
+						for (std::size_t i = 0; i < numberOfFramesTransmitted; i++)
 						{
-							frameTransmittedEventDispatcher.invoke(frame);
-							on_transmit_can_message_frame_from_hardware(frame);
-							channel->messagesToBeTransmittedQueue.pop();
+							frameTransmittedEventDispatcher.invoke(frames[i]);
+							on_transmit_can_message_frame_from_hardware(frames[i]);
 						}
-						else
+						channel->messagesToBeTransmittedQueue.pop(numberOfFramesTransmitted);
+
+						if (numberOfFramesTransmitted < numberOfFramesQueued)
 						{
-							break;
+							break; // The driver is busy, the remaining frames stay queued in order for the next update
 						}
 					}
 				});
@@ -413,14 +728,150 @@ namespace isobus
 		// Wait until everything is running
 		hardwareLock.unlock();
 
+		apply_thread_scheduling(updateThreadScheduling, "update");
+
 		while (started)
 		{
+			// Sleep until the next periodic update or stack timer is due, unless frames need handling before that
+			const std::uint64_t timeUntilUpdate_us = std::min(get_time_until_us(periodicUpdateDeadline_us), get_time_until_us(get_next_stack_update_deadline_us()));
 			std::unique_lock<std::mutex> threadLock(updateMutex);
-			updateThreadWakeupCondition.wait_for(threadLock, std::chrono::milliseconds(periodicUpdateInterval)); // Update with at least the periodic interval
+			updateThreadWakeupCondition.wait_for(threadLock, std::chrono::microseconds(timeUntilUpdate_us), []() { return updateThreadWakeupPending.load() || (!started); });
+			updateThreadWakeupPending = false;
 			update();
 		}
 	}
 
+	void CANHardwareInterface::wake_update_thread()
+	{
+		updateThreadWakeupPending = true;
+		updateThreadWakeupCondition.notify_all();
+	}
+
+	bool CANHardwareInterface::add_to_receive_reactor(CANHardware *channel)
+	{
+#ifdef __linux__
+		const int driverFileDescriptor = channel->frameHandler->get_receive_file_descriptor();
+
+		if (driverFileDescriptor < 0)
+		{
+			return false;
+		}
+
+		if (-1 == receiveReactorFileDescriptor)
+		{
+			receiveReactorFileDescriptor = epoll_create1(EPOLL_CLOEXEC);
+
+			if (-1 == receiveReactorFileDescriptor)
+			{
+				LOG_WARNING("[HardwareInterface] Unable to create the receive reactor, falling back to a receive thread per channel.");
+				return false;
+			}
+		}
+
+		struct epoll_event event;
+		event.events = EPOLLIN;
+		event.data.ptr = channel;
+
+		if (0 != epoll_ctl(receiveReactorFileDescriptor, EPOLL_CTL_ADD, driverFileDescriptor, &event))
+		{
+			return false;
+		}
+
+		if (nullptr == receiveReactorThread)
+		{
+			receiveReactorThread.reset(new std::thread(receive_reactor_thread_function));
+		}
+		return true;
+#else
+		(void)channel;
+		return false;
+#endif
+	}
+
+	void CANHardwareInterface::receive_reactor_thread_function()
+	{
+#ifdef __linux__
+		constexpr std::size_t MAX_EVENTS_PER_WAIT = 8;
+		std::array<struct epoll_event, MAX_EVENTS_PER_WAIT> events;
+
+		apply_thread_scheduling(receiveThreadScheduling, "receive reactor");
+
+		while (started)
+		{
+			const int numberOfEvents = epoll_wait(receiveReactorFileDescriptor, events.data(), static_cast<int>(events.size()), CANHardware::RECEIVE_WAIT_TIMEOUT_MS);
+			bool anyFrameReceived = false;
+
+			for (int i = 0; i < numberOfEvents; i++)
+			{
+				CANHardware *channel = static_cast<CANHardware *>(events[i].data.ptr);
+
+				if ((nullptr != channel->frameHandler) && channel->frameHandler->get_is_valid())
+				{
+					if (channel->receive_can_frame())
+					{
+						anyFrameReceived = true;
+					}
+
+					if (channel->receivedMessagesQueue.is_full())
+					{
+						// Stop polling the channel until the update thread has processed its queue,
+						// otherwise the pending frames would wake us up again straight away
+						channel->pause_receiving();
+						anyFrameReceived = true;
+					}
+				}
+			}
+
+			if (anyFrameReceived)
+			{
+				wake_update_thread();
+			}
+		}
+#endif
+	}
+
+	void CANHardwareInterface::apply_thread_scheduling(const ThreadScheduling &scheduling, const std::string &threadName)
+	{
+#ifdef __linux__
+		if (ThreadSchedulingPolicy::Default != scheduling.policy)
+		{
+			struct sched_param parameters = {};
+			parameters.sched_priority = scheduling.priority;
+			const int policy = (ThreadSchedulingPolicy::Fifo == scheduling.policy) ? SCHED_FIFO : SCHED_RR;
+			const int error = pthread_setschedparam(pthread_self(), policy, &parameters);
+
+			if (0 != error)
+			{
+				LOG_WARNING("[HardwareInterface] Unable to set the real-time scheduling of the " + threadName + " thread (error " + to_string(error) + "), it usually requires CAP_SYS_NICE.");
+			}
+		}
+
+		if (0 != scheduling.cpuAffinityMask)
+		{
+			cpu_set_t cpus;
+			CPU_ZERO(&cpus);
+			for (std::size_t i = 0; i < 64; i++)
+			{
+				if (0 != ((scheduling.cpuAffinityMask >> i) & 1))
+				{
+					CPU_SET(i, &cpus);
+				}
+			}
+			const int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+
+			if (0 != error)
+			{
+				LOG_WARNING("[HardwareInterface] Unable to set the CPU affinity of the " + threadName + " thread (error " + to_string(error) + ").");
+			}
+		}
+#else
+		if ((ThreadSchedulingPolicy::Default != scheduling.policy) || (0 != scheduling.cpuAffinityMask))
+		{
+			LOG_WARNING("[HardwareInterface] Thread scheduling is not supported on this platform, the " + threadName + " thread keeps its default scheduling.");
+		}
+#endif
+	}
+
 	void CANHardwareInterface::start_threads()
 	{
 		started = true;
@@ -442,6 +893,21 @@ namespace isobus
 			}
 			updateThread = nullptr;
 		}
+		if (nullptr != receiveReactorThread)
+		{
+			if (receiveReactorThread->joinable())
+			{
+				receiveReactorThread->join();
+			}
+			receiveReactorThread = nullptr;
+		}
+#ifdef __linux__
+		if (-1 != receiveReactorFileDescriptor)
+		{
+			::close(receiveReactorFileDescriptor);
+			receiveReactorFileDescriptor = -1;
+		}
+#endif
 	}
 #endif
 }
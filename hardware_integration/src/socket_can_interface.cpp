@@ -106,76 +106,107 @@ namespace isobus
 		}
 	}
 
+	/// @brief Converts a received socket CAN frame and its control messages into a stack frame
+	/// @param[in] rxFrame The frame that was received from the socket
+	/// @param[in] message The message header of the frame, containing the timestamp control messages
+	/// @param[out] canFrame The converted frame
+	/// @returns `true` if the frame was converted, `false` if it was an error frame
+	static bool convert_received_frame(const struct can_frame &rxFrame, struct msghdr &message, isobus::CANMessageFrame &canFrame)
+	{
+		if (0 != (rxFrame.can_id & CAN_ERR_FLAG))
+		{
+			return false;
+		}
+
+		canFrame.timestamp_us = std::numeric_limits<std::uint64_t>::max();
+		if (0 != (rxFrame.can_id & CAN_EFF_FLAG))
+		{
+			canFrame.identifier = (rxFrame.can_id & CAN_EFF_MASK);
+			canFrame.isExtendedFrame = true;
+		}
+		else
+		{
+			canFrame.identifier = (rxFrame.can_id & CAN_SFF_MASK);
+			canFrame.isExtendedFrame = false;
+		}
+		canFrame.dataLength = rxFrame.can_dlc;
+		memset(canFrame.data, 0, sizeof(canFrame.data));
+		memcpy(canFrame.data, rxFrame.data, canFrame.dataLength);
+
+		for (struct cmsghdr *pControlMessage = CMSG_FIRSTHDR(&message); (nullptr != pControlMessage) && (SOL_SOCKET == pControlMessage->cmsg_level); pControlMessage = CMSG_NXTHDR(&message, pControlMessage))
+		{
+			switch (pControlMessage->cmsg_type)
+			{
+				case SO_TIMESTAMP:
+				{
+					struct timeval *time = (struct timeval *)CMSG_DATA(pControlMessage);
+
+					if (std::numeric_limits<std::uint64_t>::max() == canFrame.timestamp_us)
+					{
+						canFrame.timestamp_us = static_cast<std::uint64_t>(time->tv_usec) + (static_cast<std::uint64_t>(time->tv_sec) * 1000000);
+					}
+				}
+				break;
+
+				case SO_TIMESTAMPING:
+				{
+					struct timespec *time = (struct timespec *)(CMSG_DATA(pControlMessage));
+					canFrame.timestamp_us = (static_cast<std::uint64_t>(time[2].tv_nsec) / 1000) + (static_cast<std::uint64_t>(time[2].tv_sec) * 1000000);
+				}
+				break;
+			}
+		}
+		return true;
+	}
+
 	bool SocketCANInterface::read_frame(isobus::CANMessageFrame &canFrame)
+	{
+		return (0 != read_frames(DataSpan<isobus::CANMessageFrame>(&canFrame, 1)));
+	}
+
+	std::size_t SocketCANInterface::read_frames(DataSpan<isobus::CANMessageFrame> canFrames)
 	{
 		struct pollfd pollingFileDescriptor;
-		bool retVal = false;
+		std::size_t retVal = 0;
 
 		pollingFileDescriptor.fd = fileDescriptor;
 		pollingFileDescriptor.events = POLLIN;
 		pollingFileDescriptor.revents = 0;
 
+		if (canFrames.size() == 0)
+		{
+			return retVal;
+		}
+
 		if (1 == poll(&pollingFileDescriptor, 1, 100))
 		{
-			canFrame.timestamp_us = std::numeric_limits<std::uint64_t>::max();
-			struct can_frame txFrame;
-			struct msghdr message;
-			struct iovec segment;
+			struct can_frame rxFrames[MAX_FRAMES_PER_READ];
+			struct mmsghdr messages[MAX_FRAMES_PER_READ];
+			struct iovec segments[MAX_FRAMES_PER_READ];
+			char controlMessages[MAX_FRAMES_PER_READ][CMSG_SPACE(sizeof(struct timeval) + (3 * sizeof(struct timespec)) + sizeof(std::uint32_t))];
+			const std::size_t numberOfFramesToRead = (canFrames.size() < MAX_FRAMES_PER_READ) ? canFrames.size() : MAX_FRAMES_PER_READ;
 
-			char lControlMessage[CMSG_SPACE(sizeof(struct timeval) + (3 * sizeof(struct timespec)) + sizeof(std::uint32_t))];
+			memset(messages, 0, sizeof(messages));
+			for (std::size_t i = 0; i < numberOfFramesToRead; i++)
+			{
+				segments[i].iov_base = &rxFrames[i];
+				segments[i].iov_len = sizeof(struct can_frame);
+				messages[i].msg_hdr.msg_iov = &segments[i];
+				messages[i].msg_hdr.msg_iovlen = 1;
+				messages[i].msg_hdr.msg_control = controlMessages[i];
+				messages[i].msg_hdr.msg_controllen = sizeof(controlMessages[i]);
+			}
 
-			segment.iov_base = &txFrame;
-			segment.iov_len = sizeof(struct can_frame);
-			message.msg_iov = &segment;
-			message.msg_iovlen = 1;
-			message.msg_control = &lControlMessage;
-			message.msg_controllen = sizeof(lControlMessage);
-			message.msg_name = pCANDevice;
-			message.msg_namelen = sizeof(struct sockaddr_can);
-			message.msg_flags = 0;
+			const int numberOfFramesRead = recvmmsg(fileDescriptor, messages, static_cast<unsigned int>(numberOfFramesToRead), MSG_DONTWAIT, nullptr);
 
-			if (recvmsg(fileDescriptor, &message, 0) > 0)
+			if (numberOfFramesRead > 0)
 			{
-				if (0 == (txFrame.can_id & CAN_ERR_FLAG))
+				for (int i = 0; i < numberOfFramesRead; i++)
 				{
-					if (0 != (txFrame.can_id & CAN_EFF_FLAG))
-					{
-						canFrame.identifier = (txFrame.can_id & CAN_EFF_MASK);
-						canFrame.isExtendedFrame = true;
-					}
-					else
+					if (convert_received_frame(rxFrames[i], messages[i].msg_hdr, canFrames[retVal]))
 					{
-						canFrame.identifier = (txFrame.can_id & CAN_SFF_MASK);
-						canFrame.isExtendedFrame = false;
+						retVal++;
 					}
-					canFrame.dataLength = txFrame.can_dlc;
-					memset(canFrame.data, 0, sizeof(canFrame.data));
-					memcpy(canFrame.data, txFrame.data, canFrame.dataLength);
-
-					for (struct cmsghdr *pControlMessage = CMSG_FIRSTHDR(&message); (nullptr != pControlMessage) && (SOL_SOCKET == pControlMessage->cmsg_level); pControlMessage = CMSG_NXTHDR(&message, pControlMessage))
-					{
-						switch (pControlMessage->cmsg_type)
-						{
-							case SO_TIMESTAMP:
-							{
-								struct timeval *time = (struct timeval *)CMSG_DATA(pControlMessage);
-
-								if (std::numeric_limits<std::uint64_t>::max() == canFrame.timestamp_us)
-								{
-									canFrame.timestamp_us = static_cast<std::uint64_t>(time->tv_usec) + (static_cast<std::uint64_t>(time->tv_sec) * 1000000);
-								}
-							}
-							break;
-
-							case SO_TIMESTAMPING:
-							{
-								struct timespec *time = (struct timespec *)(CMSG_DATA(pControlMessage));
-								canFrame.timestamp_us = (static_cast<std::uint64_t>(time[2].tv_nsec) / 1000) + (static_cast<std::uint64_t>(time[2].tv_sec) * 1000000);
-							}
-							break;
-						}
-					}
-					retVal = true;
 				}
 			}
 			else if (errno == ENETDOWN)
@@ -191,6 +222,23 @@ namespace isobus
 		return retVal;
 	}
 
+	bool SocketCANInterface::wait_for_frame(std::uint32_t timeout)
+	{
+		struct pollfd pollingFileDescriptor;
+
+		pollingFileDescriptor.fd = fileDescriptor;
+		pollingFileDescriptor.events = POLLIN;
+		pollingFileDescriptor.revents = 0;
+
+		const int timeoutMs = static_cast<int>(std::min(timeout, static_cast<std::uint32_t>(std::numeric_limits<int>::max())));
+		return (1 == poll(&pollingFileDescriptor, 1, timeoutMs));
+	}
+
+	int SocketCANInterface::get_receive_file_descriptor() const
+	{
+		return fileDescriptor;
+	}
+
 	bool SocketCANInterface::write_frame(const isobus::CANMessageFrame &canFrame)
 	{
 		struct can_frame txFrame;
@@ -217,6 +265,62 @@ namespace isobus
 		return retVal;
 	}
 
+	std::size_t SocketCANInterface::write_frames(DataSpan<const isobus::CANMessageFrame> canFrames)
+	{
+		struct can_frame txFrames[MAX_FRAMES_PER_WRITE];
+		struct mmsghdr messages[MAX_FRAMES_PER_WRITE];
+		struct iovec segments[MAX_FRAMES_PER_WRITE];
+		std::size_t retVal = 0;
+
+		while (retVal < canFrames.size())
+		{
+			const std::size_t remainingFrames = canFrames.size() - retVal;
+			const std::size_t numberOfFramesToWrite = (remainingFrames < MAX_FRAMES_PER_WRITE) ? remainingFrames : MAX_FRAMES_PER_WRITE;
+
+			memset(messages, 0, sizeof(messages));
+			for (std::size_t i = 0; i < numberOfFramesToWrite; i++)
+			{
+				const isobus::CANMessageFrame &canFrame = canFrames[retVal + i];
+
+				memset(&txFrames[i], 0, sizeof(struct can_frame));
+				txFrames[i].can_id = canFrame.identifier;
+				txFrames[i].can_dlc = canFrame.dataLength;
+				memcpy(txFrames[i].data, canFrame.data, canFrame.dataLength);
+
+				if (canFrame.isExtendedFrame)
+				{
+					txFrames[i].can_id |= CAN_EFF_FLAG;
+				}
+				segments[i].iov_base = &txFrames[i];
+				segments[i].iov_len = sizeof(struct can_frame);
+				messages[i].msg_hdr.msg_iov = &segments[i];
+				messages[i].msg_hdr.msg_iovlen = 1;
+			}
+
+			const int numberOfFramesWritten = sendmmsg(fileDescriptor, messages, static_cast<unsigned int>(numberOfFramesToWrite), 0);
+
+			if (numberOfFramesWritten > 0)
+			{
+				retVal += static_cast<std::size_t>(numberOfFramesWritten);
+
+				if (static_cast<std::size_t>(numberOfFramesWritten) < numberOfFramesToWrite)
+				{
+					break; // The socket's queue is full, let the caller retry the rest later
+				}
+			}
+			else
+			{
+				if (errno == ENETDOWN)
+				{
+					LOG_CRITICAL("[SocketCAN] " + get_device_name() + " interface is down.");
+					close();
+				}
+				break;
+			}
+		}
+		return retVal;
+	}
+
 	bool SocketCANInterface::set_name(const std::string &newName)
 	{
 		bool retVal = false;
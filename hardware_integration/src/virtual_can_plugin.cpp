@@ -94,6 +94,12 @@ namespace isobus
 		return false;
 	}
 
+	bool VirtualCANPlugin::wait_for_frame(std::uint32_t timeout)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		return ourDevice->condition.wait_for(lock, std::chrono::milliseconds(timeout), [this] { return !ourDevice->queue.empty() || !running; }) && running;
+	}
+
 	bool VirtualCANPlugin::get_queue_empty() const
 	{
 		const std::lock_guard<std::mutex> lock(mutex);
@@ -11,6 +11,8 @@
 #define CAN_CALLBACKS_HPP
 
 #include <functional>
+#include <unordered_map>
+#include <vector>
 #include "isobus/isobus/can_message.hpp"
 
 namespace isobus
@@ -111,6 +113,50 @@ namespace isobus
 		void *parent; ///< A generic variable that can provide context to which object the callback was meant for
 		std::shared_ptr<InternalControlFunction> internalControlFunctionFilter; ///< An optional way to filter callbacks based on the destination of messages from the partner
 	};
+
+	/// @brief A collection of PGN callbacks that is indexed by PGN
+	/// @details Callbacks are kept in the order they were added, both in the table as a whole
+	/// and within the set of callbacks for each PGN, so looking up the callbacks for a received
+	/// message does not require comparing against every registered callback.
+	/// The set of callbacks for a PGN is kept even once it becomes empty, which means a callback
+	/// may safely add or remove callbacks while the table is being iterated by index.
+	class ParameterGroupNumberCallbackTable
+	{
+	public:
+		/// @brief Adds a callback to the end of the table
+		/// @param[in] callbackData The callback to add
+		void add(const ParameterGroupNumberCallbackData &callbackData);
+
+		/// @brief Removes the first callback that matches *exactly* the one passed in
+		/// @param[in] callbackData The callback to remove
+		/// @returns true if a callback was removed, otherwise false
+		bool remove(const ParameterGroupNumberCallbackData &callbackData);
+
+		/// @brief Checks if a callback that matches *exactly* the one passed in is in the table
+		/// @param[in] callbackData The callback to look for
+		/// @returns true if the callback is in the table, otherwise false
+		bool contains(const ParameterGroupNumberCallbackData &callbackData) const;
+
+		/// @brief Returns the number of callbacks in the table
+		/// @returns The number of callbacks in the table
+		std::size_t size() const;
+
+		/// @brief Returns a callback by the index it has in the order of registration
+		/// @param[in] index The index of the callback to get, must be less than `size()`
+		/// @returns The callback at the index specified
+		const ParameterGroupNumberCallbackData &get(std::size_t index) const;
+
+		/// @brief Returns all callbacks that were registered for a PGN, in the order of registration
+		/// @param[in] parameterGroupNumber The PGN to get the callbacks for
+		/// @returns The callbacks registered for the PGN, which may be empty
+		const std::vector<ParameterGroupNumberCallbackData> &get_callbacks(std::uint32_t parameterGroupNumber) const;
+
+	private:
+		static const std::vector<ParameterGroupNumberCallbackData> EMPTY_CALLBACK_LIST; ///< Returned when no callbacks were ever registered for a PGN
+
+		std::vector<ParameterGroupNumberCallbackData> callbacks; ///< All callbacks in the order of registration
+		std::unordered_map<std::uint32_t, std::vector<ParameterGroupNumberCallbackData>> callbacksByParameterGroupNumber; ///< The callbacks grouped by their PGN
+	};
 } // namespace isobus
 
 #endif // CAN_CALLBACKS_HPP
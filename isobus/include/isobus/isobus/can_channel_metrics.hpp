@@ -0,0 +1,74 @@
+//================================================================================================
+/// @file can_channel_metrics.hpp
+///
+/// @brief A snapshot of the traffic metrics of a single CAN channel, as measured by the
+/// network manager.
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#ifndef CAN_CHANNEL_METRICS_HPP
+#define CAN_CHANNEL_METRICS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace isobus
+{
+	//================================================================================================
+	/// @class CANChannelMetrics
+	///
+	/// @brief A snapshot of the traffic metrics of a single CAN channel.
+	/// @details Rates are measured over the last second. Polling the metrics into the same
+	/// object repeatedly reuses its memory, so it is cheap enough to do periodically.
+	/// The usage of the hardware queues of a channel is available from the `CANHardwareInterface`.
+	//================================================================================================
+	class CANChannelMetrics
+	{
+	public:
+		/// @brief The message rate of a single PGN
+		struct ParameterGroupNumberRate
+		{
+			std::uint32_t parameterGroupNumber; ///< The PGN
+			std::uint32_t framesPerSecond; ///< The number of frames with this PGN received and transmitted during the last second
+		};
+
+		/// @brief The number of buckets in the receive latency histogram
+		static constexpr std::size_t NUMBER_OF_LATENCY_BUCKETS = 12;
+
+		/// @brief Returns the upper limit of a bucket in the receive latency histogram
+		/// @details Bucket 0 holds latencies below 128 us, and each following bucket doubles the limit.
+		/// The last bucket also holds all latencies above its limit.
+		/// @param[in] bucketIndex The index of the bucket
+		/// @returns The exclusive upper limit of the bucket in microseconds
+		static std::uint64_t get_latency_bucket_limit_us(std::size_t bucketIndex)
+		{
+			return static_cast<std::uint64_t>(128) << bucketIndex;
+		}
+
+		float busload = 0.0f; ///< The estimated busload between 0.0f and 100.0f
+		std::uint32_t receivedFramesPerSecond = 0; ///< The number of frames received during the last second
+		std::uint32_t transmittedFramesPerSecond = 0; ///< The number of frames transmitted during the last second
+		std::uint32_t receivedBytesPerSecond = 0; ///< The number of data bytes received during the last second
+		std::uint32_t transmittedBytesPerSecond = 0; ///< The number of data bytes transmitted during the last second
+		std::uint64_t totalReceivedFrames = 0; ///< The number of frames received since startup
+		std::uint64_t totalTransmittedFrames = 0; ///< The number of frames transmitted since startup
+
+		/// @brief The number of received messages by the time between the driver's timestamp of
+		/// the frame and the start of its processing by the stack, since startup.
+		/// @details This is only measured for drivers that timestamp frames with the system (wall)
+		/// clock, like SocketCAN. See `get_latency_bucket_limit_us` for the bucket limits.
+		std::array<std::uint32_t, NUMBER_OF_LATENCY_BUCKETS> receiveLatencyHistogram = {};
+
+		/// @brief The number of received messages left out of `receiveLatencyHistogram` because their
+		/// timestamp was more than 10 seconds away from the system clock, since startup.
+		/// @details A count that grows with every message means the driver timestamps frames with
+		/// a clock other than the system clock, so the histogram can't be used for this channel.
+		std::uint64_t framesWithUnusableTimestamp = 0;
+
+		std::vector<ParameterGroupNumberRate> parameterGroupNumberRates; ///< The rate of each PGN seen during the last second, sorted by PGN
+	};
+} // namespace isobus
+
+#endif // CAN_CHANNEL_METRICS_HPP
@@ -153,6 +153,7 @@ namespace isobus
 		static constexpr std::uint16_t T2_T3_TIMEOUT_MS = 1250; ///< The t2/t3 timeouts as defined by the standard
 		static constexpr std::uint16_t T4_TIMEOUT_MS = 1050; ///< The t4 timeout as defined by the standard
 		static constexpr std::uint8_t TR_TIMEOUT_MS = 200; ///< The Tr Timeout as defined by the standard
+		static constexpr std::uint16_t TH_HOLD_INTERVAL_MS = 500; ///< The Th time between CTS messages that hold a connection open, as defined by the standard
 		static constexpr std::uint8_t SEQUENCE_NUMBER_DATA_INDEX = 0; ///< The index of the sequence number in a frame
 		static constexpr std::uint8_t PROTOCOL_BYTES_PER_FRAME = 7; ///< The number of payload bytes per frame minus overhead of sequence number
 
@@ -161,13 +162,24 @@ namespace isobus
 		/// @param[in] sendCANFrameCallback A callback for sending a CAN frame to hardware
 		/// @param[in] canMessageReceivedCallback A callback for when a complete CAN message is received using the ETP protocol
 		/// @param[in] configuration The configuration to use for this protocol
+		/// @param[in] memoryBudget The budget to reserve memory for received messages from, or `nullptr` for unlimited memory
+		/// @param[in] flowControl The flow control that sizes windows and bursts, or `nullptr` to use the configured sizes
+		/// @param[in] transmitScheduler The scheduler that shares the data frames of the CAN port between sessions, or `nullptr` to send them in each update
 		ExtendedTransportProtocolManager(const CANMessageFrameCallback &sendCANFrameCallback,
 		                                 const CANMessageCallback &canMessageReceivedCallback,
-		                                 const CANNetworkConfiguration *configuration);
+		                                 const CANNetworkConfiguration *configuration,
+		                                 TransportProtocolMemoryBudget *memoryBudget = nullptr,
+		                                 TransportProtocolFlowControl *flowControl = nullptr,
+		                                 TransportProtocolTransmitScheduler *transmitScheduler = nullptr);
 
 		/// @brief Updates all sessions managed by this protocol manager instance.
 		void update();
 
+		/// @brief Returns how long until a session's timer, like a timeout or the delay between BAM frames, needs an update.
+		/// @details Sessions that are only waiting to send are left to the regular updates.
+		/// @returns The time until the next timer expires in milliseconds, or the largest `std::uint32_t` if no session is waiting on a timer
+		std::uint32_t get_time_until_next_deadline_ms() const;
+
 		/// @brief Checks if the source and destination control function have an active session/connection.
 		/// @param[in] source The source control function for the session
 		/// @param[in] destination The destination control function for the session
@@ -190,13 +202,15 @@ namespace isobus
 		/// @param[in] destination The destination control function
 		/// @param[in] sessionCompleteCallback A callback for when the protocol completes its work
 		/// @param[in] parentPointer A generic context object for the tx complete and chunk callbacks
+		/// @param[in] priority The CAN priority of the message, which the transmit scheduler uses to share the bus
 		/// @returns true if the message was accepted by the protocol for processing
 		bool protocol_transmit_message(std::uint32_t parameterGroupNumber,
 		                               std::unique_ptr<CANMessageData> &data,
 		                               std::shared_ptr<ControlFunction> source,
 		                               std::shared_ptr<ControlFunction> destination,
 		                               TransmitCompleteCallback sessionCompleteCallback,
-		                               void *parentPointer);
+		                               void *parentPointer,
+		                               CANIdentifier::CANPriority priority = CANIdentifier::CANPriority::PriorityDefault6);
 
 	private:
 		/// @brief Aborts the session with the specified abort reason. Sends a CAN message.
@@ -228,8 +242,15 @@ namespace isobus
 
 		/// @brief Sends the "clear to send" message
 		/// @param[in] session The session for which we're sending the CTS
+		/// @param[in] packetLimit The number of packets to allow, or 0 to hold the connection open
 		/// @returns true if the CTS was sent, false if sending was not successful
-		bool send_clear_to_send(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const;
+		bool send_clear_to_send(const std::shared_ptr<ExtendedTransportProtocolSession> &session, std::uint8_t packetLimit) const;
+
+		/// @brief Sends the next "clear to send" message of a receiving session once memory is available for its packets,
+		/// otherwise holds the connection open, and aborts it when no memory became available in time
+		/// @param[in] session The session for which we're sending the CTS
+		/// @returns true if a CTS allowing packets was sent, otherwise false
+		bool send_clear_to_send_when_memory_available(const std::shared_ptr<ExtendedTransportProtocolSession> &session);
 
 		/// @brief Sends the "data packet offset" message for the provided session
 		/// @param[in] session The session for which we're sending the DPO
@@ -241,9 +262,21 @@ namespace isobus
 		/// @returns true if the EOM was sent, false if sending was not successful
 		bool send_end_of_session_acknowledgement(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const;
 
+		/// @brief Returns the max number of data frames a session may send during one update
+		/// @returns The configured number of frames, limited by the flow control
+		std::uint8_t get_max_frames_per_update() const;
+
 		///@brief Sends data transfer packets for the specified ExtendedTransportProtocolSession.
 		/// @param[in] session The ExtendedTransportProtocolSession for which to send data transfer packets.
-		void send_data_transfer_packets(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const;
+		/// @param[in] maximumFrames The max number of data frames to send
+		/// @returns The number of data frames that were sent
+		std::uint8_t send_data_transfer_packets(const std::shared_ptr<ExtendedTransportProtocolSession> &session, std::uint8_t maximumFrames) const;
+
+		/// @brief Sends data transfer packets of a session on behalf of the transmit scheduler
+		/// @param[in] session The session to send data transfer packets for
+		/// @param[in] maximumFrames The max number of data frames the scheduler allows
+		/// @returns The number of data frames that were sent, 0 if the session is not sending data right now
+		std::uint32_t transmit_scheduled_frames(const std::shared_ptr<ExtendedTransportProtocolSession> &session, std::uint32_t maximumFrames) const;
 
 		/// @brief Processes a request to send a message over the CAN transport protocol.
 		/// @param[in] source The shared pointer to the source control function.
@@ -300,10 +333,13 @@ namespace isobus
 		/// @param[in] session The session to update
 		void update_state_machine(std::shared_ptr<ExtendedTransportProtocolSession> &session);
 
-		std::vector<std::shared_ptr<ExtendedTransportProtocolSession>> activeSessions; ///< A list of all active ETP sessions
+		TransportProtocolSessionList<ExtendedTransportProtocolSession> activeSessions{ false }; ///< A list of all active ETP sessions, indexed by source and destination
 		const CANMessageFrameCallback sendCANFrameCallback; ///< A callback for sending a CAN frame
 		const CANMessageCallback canMessageReceivedCallback; ///< A callback for when a complete CAN message is received using the ETP protocol
 		const CANNetworkConfiguration *configuration; ///< The configuration to use for this protocol
+		TransportProtocolMemoryBudget *memoryBudget; ///< The budget to reserve memory for received messages from, or `nullptr` for unlimited memory
+		TransportProtocolFlowControl *flowControl; ///< The flow control that sizes windows and bursts, or `nullptr` to use the configured sizes
+		TransportProtocolTransmitScheduler *transmitScheduler; ///< The scheduler that sends the data frames of the sessions, or `nullptr`
 	};
 
 } // namespace isobus
@@ -32,6 +32,19 @@ namespace isobus
 	/// @brief The periodic update abstraction layer between the hardware and the stack
 	void periodic_update_from_hardware();
 
+	/// @brief The periodic update abstraction layer between the hardware and the stack for a single channel
+	/// @param[in] channelIndex The CAN channel index to update
+	void periodic_update_from_hardware(std::uint8_t channelIndex);
+
+	/// @brief The abstraction layer between the hardware and the stack for when the stack next needs an update
+	/// @returns The deadline as a timestamp from SystemTiming::get_timestamp_us, or the largest `std::uint64_t` if there is none
+	std::uint64_t get_next_update_deadline_from_hardware();
+
+	/// @brief The abstraction layer between the hardware and the stack for when a single channel next needs an update
+	/// @param[in] channelIndex The CAN channel index
+	/// @returns The deadline as a timestamp from SystemTiming::get_timestamp_us, or the largest `std::uint64_t` if there is none
+	std::uint64_t get_next_update_deadline_from_hardware(std::uint8_t channelIndex);
+
 } // namespace isobus
 
 #endif // CAN_HARDWARE_ABSTRACTION_HPP
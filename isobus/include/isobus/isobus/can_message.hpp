@@ -82,6 +82,25 @@ namespace isobus
 		           std::shared_ptr<ControlFunction> destination,
 		           std::uint8_t CANPort);
 
+		/// @brief Re-initializes the message in place with the parameters supplied
+		/// @details Unlike constructing a new message, this reuses the already allocated data buffer,
+		/// so recycling a message for frames of up to 8 bytes does not touch the heap after the first use.
+		/// The timestamp is reset to 0.
+		/// @param[in] type The type of the CAN message
+		/// @param[in] identifier The CAN ID of the message
+		/// @param[in] dataBuffer The start of the data payload
+		/// @param[in] length The length of the data payload in bytes
+		/// @param[in] source The source control function of the message
+		/// @param[in] destination The destination control function of the message
+		/// @param[in] CANPort The CAN channel index associated with the message
+		void reinitialize(Type type,
+		                  CANIdentifier identifier,
+		                  const std::uint8_t *dataBuffer,
+		                  std::uint32_t length,
+		                  std::shared_ptr<ControlFunction> source,
+		                  std::shared_ptr<ControlFunction> destination,
+		                  std::uint8_t CANPort);
+
 		/// @brief Factory method to construct an intentionally invalid CANMessage
 		/// @returns An invalid CANMessage
 		static CANMessage create_invalid_message();
@@ -145,6 +164,15 @@ namespace isobus
 		/// @returns The CAN channel index associated with the message
 		std::uint8_t get_can_port_index() const;
 
+		/// @brief Returns the timestamp of the frame the message was built from, as reported by the CAN driver
+		/// @details The time base depends on the driver, for example SocketCAN uses the system (wall) clock.
+		/// @returns The timestamp in microseconds, or 0 if the message has no timestamp
+		std::uint64_t get_timestamp_us() const;
+
+		/// @brief Sets the timestamp of the message
+		/// @param[in] timestamp_us The timestamp in microseconds, or 0 if the message has no timestamp
+		void set_timestamp_us(std::uint64_t timestamp_us);
+
 		/// @brief Sets the message data to the value supplied. Creates a copy.
 		/// @param[in] dataBuffer The data payload
 		/// @param[in] length the length of the data payload in bytes
@@ -266,6 +294,7 @@ namespace isobus
 		std::shared_ptr<ControlFunction> source; ///< The source control function of the message
 		std::shared_ptr<ControlFunction> destination; ///< The destination control function of the message
 		std::uint8_t CANPortIndex; ///< The CAN channel index associated with the message
+		std::uint64_t timestamp_us = 0; ///< The timestamp of the frame the message was built from, or 0 if unknown
 	};
 
 } // namespace isobus
@@ -37,6 +37,16 @@ namespace isobus
 		/// @return The byte at the given index.
 		virtual std::uint8_t get_byte(std::size_t index) = 0;
 
+		/// @brief Copy a range of bytes into a buffer.
+		/// @details This is the preferred way to read more than one byte, since implementations can
+		/// copy the whole range at once instead of checking every byte. The default implementation
+		/// copies the range byte by byte.
+		/// @param[in] offset The index of the first byte to copy.
+		/// @param[out] destination The buffer to copy the bytes into, which must hold at least `length` bytes.
+		/// @param[in] length The number of bytes to copy.
+		/// @return The number of bytes copied, which is less than `length` if the range exceeds the data.
+		virtual std::size_t copy_range(std::size_t offset, std::uint8_t *destination, std::size_t length);
+
 		/// @brief If the data isn't owned by this class, make a copy of the data.
 		/// @param[in] self A pointer to this object.
 		/// @return A copy of the data if it isn't owned by this class, otherwise a moved pointer.
@@ -70,6 +80,13 @@ namespace isobus
 		/// @return The byte at the given index.
 		std::uint8_t get_byte(std::size_t index) override;
 
+		/// @brief Copy a range of bytes into a buffer.
+		/// @param[in] offset The index of the first byte to copy.
+		/// @param[out] destination The buffer to copy the bytes into, which must hold at least `length` bytes.
+		/// @param[in] length The number of bytes to copy.
+		/// @return The number of bytes copied, which is less than `length` if the range exceeds the data.
+		std::size_t copy_range(std::size_t offset, std::uint8_t *destination, std::size_t length) override;
+
 		/// @brief Set the byte at the given index.
 		/// @param[in] index The index of the byte to set.
 		/// @param[in] value The value to set the byte to.
@@ -105,6 +122,13 @@ namespace isobus
 		/// @return The byte at the given index.
 		std::uint8_t get_byte(std::size_t index) override;
 
+		/// @brief Copy a range of bytes into a buffer.
+		/// @param[in] offset The index of the first byte to copy.
+		/// @param[out] destination The buffer to copy the bytes into, which must hold at least `length` bytes.
+		/// @param[in] length The number of bytes to copy.
+		/// @return The number of bytes copied, which is less than `length` if the range exceeds the data.
+		std::size_t copy_range(std::size_t offset, std::uint8_t *destination, std::size_t length) override;
+
 		/// @brief Get the data span.
 		/// @return The data span.
 		CANDataSpan data() const;
@@ -138,6 +162,14 @@ namespace isobus
 		/// @return The byte at the given index.
 		std::uint8_t get_byte(std::size_t index) override;
 
+		/// @brief Copy a range of bytes into a buffer.
+		/// @details The callback is only called when the range leaves the chunk that was last loaded.
+		/// @param[in] offset The index of the first byte to copy.
+		/// @param[out] destination The buffer to copy the bytes into, which must hold at least `length` bytes.
+		/// @param[in] length The number of bytes to copy.
+		/// @return The number of bytes copied, which is less than `length` if the range exceeds the data.
+		std::size_t copy_range(std::size_t offset, std::uint8_t *destination, std::size_t length) override;
+
 		/// @brief If the data isn't owned by this class, make a copy of the data.
 		/// @param[in] self A pointer to this object.
 		/// @return A copy of the data if it isn't owned by this class, otherwise it returns itself.
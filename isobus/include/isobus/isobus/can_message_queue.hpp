@@ -0,0 +1,100 @@
+//================================================================================================
+/// @file can_message_queue.hpp
+///
+/// @brief A queue of CAN messages that recycles its storage, so that messages translated from
+/// single CAN frames can be queued without allocating memory.
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#ifndef CAN_MESSAGE_QUEUE_HPP
+#define CAN_MESSAGE_QUEUE_HPP
+
+#include "isobus/isobus/can_message.hpp"
+#include "isobus/isobus/can_message_frame.hpp"
+#include "isobus/utility/thread_synchronization.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace isobus
+{
+	//================================================================================================
+	/// @class CANMessageQueue
+	///
+	/// @brief A bounded first-in-first-out queue of CAN messages backed by reusable message slots.
+	/// @details Messages are written into the slots in place, and read out by swapping them with
+	/// the caller's message, so the data buffers are handed back and forth instead of being freed.
+	/// Once every slot has held a frame, queuing frames does not allocate anymore.
+	/// Any number of threads may push to the queue concurrently without locking, while a single
+	/// thread pops from it. The capacity is fixed, the queue never grows. If the queue is full,
+	/// messages are dropped according to the overflow policy.
+	//================================================================================================
+	class CANMessageQueue
+	{
+	public:
+		/// @brief Constructor for the message queue
+		/// @param[in] capacity The maximum number of messages in the queue
+		explicit CANMessageQueue(std::size_t capacity = DEFAULT_CAPACITY);
+
+		/// @brief Adds a message built from a single CAN frame to the back of the queue
+		/// @param[in] type The type of the CAN message
+		/// @param[in] frame The frame to build the message from
+		/// @param[in] source The source control function of the message
+		/// @param[in] destination The destination control function of the message
+		/// @returns `true` if the message was queued, `false` if it was dropped because the queue is full
+		bool push(CANMessage::Type type,
+		          const CANMessageFrame &frame,
+		          std::shared_ptr<ControlFunction> source,
+		          std::shared_ptr<ControlFunction> destination);
+
+		/// @brief Adds a copy of a message to the back of the queue
+		/// @param[in] message The message to copy into the queue
+		/// @returns `true` if the message was queued, `false` if it was dropped because the queue is full
+		bool push(const CANMessage &message);
+
+		/// @brief Removes the message at the front of the queue
+		/// @details The message is swapped into `message`, and `message`'s old contents (and its
+		/// buffer) are kept in the queue for reuse.
+		/// @param[out] message The message that was at the front of the queue
+		/// @returns `true` if a message was removed, `false` if the queue was empty
+		bool pop(CANMessage &message);
+
+		/// @brief Returns if the queue is empty
+		/// @returns `true` if there are no messages in the queue, otherwise `false`
+		bool empty() const;
+
+		/// @brief Returns the number of messages in the queue
+		/// @returns The number of messages in the queue
+		std::size_t size() const;
+
+		/// @brief Removes all messages from the queue, keeping the storage for reuse
+		void clear();
+
+		/// @brief Removes all messages from the queue and changes how many messages it can hold.
+		/// The storage is only reallocated if the capacity changes.
+		/// @note This must not be called while other threads use the queue.
+		/// @param[in] capacity The maximum number of messages in the queue
+		void set_capacity(std::size_t capacity);
+
+		/// @brief Returns how many messages the queue can hold
+		/// @returns The maximum number of messages in the queue
+		std::size_t get_capacity() const;
+
+		/// @brief Sets what happens when a message is pushed while the queue is full
+		/// @param[in] policy The new overflow policy
+		void set_overflow_policy(QueueOverflowPolicy policy);
+
+		/// @brief Returns the number of messages dropped because the queue was full
+		/// @returns The number of dropped messages since construction, including before any capacity change
+		std::size_t get_overflow_count() const;
+
+	private:
+		static constexpr std::size_t DEFAULT_CAPACITY = 256; ///< The default number of message slots
+
+		std::unique_ptr<LockFreeMPSCQueue<CANMessage>> queue; ///< The underlying queue of message slots, replaced when the capacity changes
+		std::size_t queueCapacity; ///< The maximum number of messages in the queue
+		std::size_t previousOverflowCount = 0; ///< The number of messages dropped by queues that were replaced when the capacity changed
+	};
+} // namespace isobus
+
+#endif // CAN_MESSAGE_QUEUE_HPP
@@ -10,6 +10,9 @@
 #ifndef CAN_NETWORK_CONFIGURATION_HPP
 #define CAN_NETWORK_CONFIGURATION_HPP
 
+#include "isobus/utility/thread_synchronization.hpp"
+
+#include <cstddef>
 #include <cstdint>
 
 namespace isobus
@@ -37,6 +40,37 @@ namespace isobus
 		/// @returns The max number of concurrent TP sessions
 		std::uint32_t get_max_number_transport_protocol_sessions() const;
 
+		/// @brief Configures the max number of bytes that the TP, ETP and Fast Packet sessions of a single
+		/// CAN port may use together to receive messages. The default is 0, which means unlimited.
+		/// @details Connection mode sessions grow their buffer with each CTS window, and hold the connection
+		/// with a CTS for 0 packets while no memory is available. Broadcast and Fast Packet messages
+		/// that don't fit are ignored, and connection mode messages that can never fit are rejected.
+		/// @param[in] value The max number of bytes used for receiving messages per CAN port, or 0 for unlimited
+		void set_max_transport_protocol_receive_memory(std::uint32_t value);
+
+		/// @brief Returns the max number of bytes that the sessions of a single CAN port may use to receive messages
+		/// @returns The max number of bytes used for receiving messages per CAN port, or 0 if unlimited
+		std::uint32_t get_max_transport_protocol_receive_memory() const;
+
+		/// @brief Configures the max number of bytes that the TP, ETP and Fast Packet sessions from a single
+		/// source control function may use to receive messages. The default is 0, which means unlimited.
+		/// @details This keeps a single misbehaving control function from using all memory of a CAN port.
+		/// @param[in] value The max number of bytes used for receiving messages per source, or 0 for unlimited
+		void set_max_transport_protocol_receive_memory_per_source(std::uint32_t value);
+
+		/// @brief Returns the max number of bytes that the sessions from a single source may use to receive messages
+		/// @returns The max number of bytes used for receiving messages per source, or 0 if unlimited
+		std::uint32_t get_max_transport_protocol_receive_memory_per_source() const;
+
+		/// @brief Sets how long a receiving TP or ETP session may be held while waiting for memory to become
+		/// available, before it is aborted. The default is 5000 ms.
+		/// @param[in] value The max time to hold a session in milliseconds
+		void set_max_transport_protocol_memory_hold_time(std::uint32_t value);
+
+		/// @brief Returns how long a receiving TP or ETP session may be held while waiting for memory
+		/// @returns The max time to hold a session in milliseconds
+		std::uint32_t get_max_transport_protocol_memory_hold_time() const;
+
 		/// @brief Sets the minimum time to wait between sending BAM frames
 		/// (default is 50 ms for maximum J1939 compatibility)
 		/// @details The acceptable range as defined by ISO-11783 is 10 to 200 ms.
@@ -84,14 +118,98 @@ namespace isobus
 		/// @returns The number of packets per CTS packet for TP sessions.
 		std::uint8_t get_number_of_packets_per_cts_message() const;
 
+		/// @brief Enables or disables adaptive flow control for TP and ETP sessions. The default is disabled.
+		/// @details When enabled, the number of packets per CTS and DPO window, and the number of data frames
+		/// sent per update, are sized from the busload of the CAN channel and the round trip time measured
+		/// between CTS and data messages, so transfers use an idle bus fully but back off on a busy one.
+		/// The configured number of packets per CTS and DPO message and the configured max number of frames
+		/// per update remain the upper limits.
+		/// @param[in] enabled `true` to size windows and bursts adaptively, `false` to use the configured values
+		void set_adaptive_transport_protocol_flow_control(bool enabled);
+
+		/// @brief Returns if adaptive flow control is enabled for TP and ETP sessions
+		/// @returns `true` if windows and bursts are sized adaptively, otherwise `false`
+		bool get_adaptive_transport_protocol_flow_control() const;
+
+		/// @brief Sets the busload that adaptive flow control keeps the transfers below, which limits how
+		/// aggressively they use the bus. The default is 80 percent.
+		/// @param[in] busload The target busload, between 1 and 100 percent
+		void set_adaptive_flow_control_target_busload(float busload);
+
+		/// @brief Returns the busload that adaptive flow control keeps the transfers below
+		/// @returns The target busload in percent
+		float get_adaptive_flow_control_target_busload() const;
+
+		/// @brief Sets the max number of data frames that the TP, ETP and Fast Packet sessions of a CAN port
+		/// send together per update. The default is 0, which disables the transmit scheduler.
+		/// @details When set, the sessions of all three protocols share this budget in weighted round-robin,
+		/// with weights from the CAN priority of their messages, so a small message doesn't have to wait for
+		/// a large transfer to finish. The max number of frames per update of each protocol still applies.
+		/// When 0, each protocol sends the data frames of its sessions during its own update.
+		/// @param[in] numberFrames The max number of frames per update and CAN port, or 0 to disable the scheduler
+		void set_transport_protocol_transmit_scheduler_frames_per_update(std::uint8_t numberFrames);
+
+		/// @brief Returns the max number of data frames that the TP, ETP and Fast Packet sessions of a CAN port
+		/// send together per update
+		/// @returns The max number of frames per update and CAN port, or 0 if the transmit scheduler is disabled
+		std::uint8_t get_transport_protocol_transmit_scheduler_frames_per_update() const;
+
+		/// @brief Sets what the network manager does with a received or transmitted frame when its
+		/// internal message queue is full, for example because the stack is not updated often enough.
+		/// The default is to drop the newest frame.
+		/// @param[in] policy The overflow policy for the network manager's message queues
+		void set_message_queue_overflow_policy(QueueOverflowPolicy policy);
+
+		/// @brief Returns what the network manager does with a frame when its internal message queue is full
+		/// @returns The overflow policy for the network manager's message queues
+		QueueOverflowPolicy get_message_queue_overflow_policy() const;
+
+		/// @brief Sets how many frames each of the network manager's internal message queues can hold.
+		/// @details Frames wait in these queues between being received or sent by the hardware threads and
+		/// being processed by the network manager's update. If more frames arrive between two updates than
+		/// a queue can hold, frames are dropped according to the overflow policy. The default of 512 holds a
+		/// full ETP window of 255 frames plus the backlog of the hardware receive queues.
+		/// @note This must be set before the network manager is first updated, later changes are ignored.
+		/// @param[in] capacity The max number of frames in each message queue, at least 1
+		void set_message_queue_capacity(std::size_t capacity);
+
+		/// @brief Returns how many frames each of the network manager's internal message queues can hold
+		/// @returns The max number of frames in each message queue
+		std::size_t get_message_queue_capacity() const;
+
+		/// @brief Enables or disables processing each CAN port separately from the others.
+		/// @details When enabled, each CAN port gets its own message queues and lock, and is processed
+		/// by calling `CANNetworkManager::update(canPortIndex)` for that port, which can be done from a
+		/// thread per port at its own rate, so a busy bus does not delay processing of the other buses.
+		/// `CANNetworkManager::update()` then only handles the state shared between ports.
+		/// The `CANHardwareInterface` does this for you when its per-channel processing is enabled.
+		/// The default is disabled, where `CANNetworkManager::update()` processes all ports.
+		/// @note This must be set before the network manager is first updated, later changes are ignored.
+		/// @param[in] enabled `true` to process each CAN port separately, otherwise `false`
+		void set_per_port_processing(bool enabled);
+
+		/// @brief Returns if each CAN port is processed separately from the others
+		/// @returns `true` if each CAN port is processed separately, otherwise `false`
+		bool get_per_port_processing() const;
+
 	private:
 		static constexpr std::uint8_t DEFAULT_BAM_PACKET_DELAY_TIME_MS = 50; ///< The default time between BAM frames, as defined by J1939
+		static constexpr std::size_t DEFAULT_MESSAGE_QUEUE_CAPACITY = 512; ///< The default number of frames in each message queue, enough for a full ETP window plus the hardware receive backlog
 
 		std::uint32_t maxNumberTransportProtocolSessions = 4; ///< The max number of TP sessions allowed
+		std::uint32_t maxTransportProtocolReceiveMemory = 0; ///< The max number of bytes used for receiving messages per CAN port, 0 for unlimited
+		std::uint32_t maxTransportProtocolReceiveMemoryPerSource = 0; ///< The max number of bytes used for receiving messages per source, 0 for unlimited
+		std::uint32_t maxTransportProtocolMemoryHoldTime_ms = 5000; ///< The max time a receiving session may be held while waiting for memory
 		std::uint32_t minimumTimeBetweenTransportProtocolBAMFrames = DEFAULT_BAM_PACKET_DELAY_TIME_MS; ///< The configurable time between BAM frames
 		std::uint8_t networkManagerMaxFramesToSendPerUpdate = 0xFF; ///< Used to control the max number of transport layer frames added to the driver queue per network manager update
 		std::uint8_t numberOfPacketsPerDPOMessage = 16; ///< The number of packets per DPO message for ETP sessions
 		std::uint8_t numberOfPacketsPerCTSMessage = 16; ///< The number of packets per CTS message for TP sessions
+		std::uint8_t transmitSchedulerFramesPerUpdate = 0; ///< The max number of data frames the sessions of a CAN port send together per update, 0 disables the scheduler
+		float adaptiveFlowControlTargetBusload = 80.0f; ///< The busload that adaptive flow control keeps the transfers below
+		std::size_t messageQueueCapacity = DEFAULT_MESSAGE_QUEUE_CAPACITY; ///< The max number of frames in each of the network manager's message queues
+		QueueOverflowPolicy messageQueueOverflowPolicy = QueueOverflowPolicy::DropNewest; ///< What to do with frames when the network manager's message queues are full
+		bool perPortProcessing = false; ///< Whether each CAN port is processed separately from the others
+		bool adaptiveTransportProtocolFlowControl = false; ///< Whether TP and ETP windows and bursts are sized from the busload and round trip time
 	};
 } // namespace isobus
 
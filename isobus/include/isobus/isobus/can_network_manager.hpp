@@ -14,6 +14,7 @@
 
 #include "isobus/isobus/can_badge.hpp"
 #include "isobus/isobus/can_callbacks.hpp"
+#include "isobus/isobus/can_channel_metrics.hpp"
 #include "isobus/isobus/can_constants.hpp"
 #include "isobus/isobus/can_control_function.hpp"
 #include "isobus/isobus/can_extended_transport_protocol.hpp"
@@ -21,19 +22,22 @@
 #include "isobus/isobus/can_internal_control_function.hpp"
 #include "isobus/isobus/can_message.hpp"
 #include "isobus/isobus/can_message_frame.hpp"
+#include "isobus/isobus/can_message_queue.hpp"
 #include "isobus/isobus/can_network_configuration.hpp"
 #include "isobus/isobus/can_partnered_control_function.hpp"
 #include "isobus/isobus/can_transport_protocol.hpp"
 #include "isobus/isobus/isobus_heartbeat.hpp"
 #include "isobus/isobus/nmea2000_fast_packet_protocol.hpp"
 #include "isobus/utility/event_dispatcher.hpp"
+#include "isobus/utility/lock_free_event_dispatcher.hpp"
 #include "isobus/utility/thread_synchronization.hpp"
 
 #include <array>
-#include <deque>
+#include <atomic>
 #include <list>
 #include <memory>
 #include <queue>
+#include <unordered_map>
 
 /// @brief This namespace encompasses all of the ISO11783 stack's functionality to reduce global namespace pollution
 namespace isobus
@@ -113,7 +117,7 @@ namespace isobus
 		/// @brief Returns the network manager's event dispatcher for notifying consumers whenever a
 		/// message is transmitted by our application
 		/// @returns An event dispatcher which can be used to get notified about transmitted messages
-		EventDispatcher<CANMessage> &get_transmitted_message_event_dispatcher();
+		LockFreeEventDispatcher<CANMessage> &get_transmitted_message_event_dispatcher();
 
 		/// @brief Returns an internal control function if the passed-in control function is an internal type
 		/// @param[in] controlFunction The control function to get the internal control function from
@@ -129,6 +133,14 @@ namespace isobus
 		/// @returns Estimated busload over the last 1 second
 		float get_estimated_busload(std::uint8_t canChannel);
 
+		/// @brief Gets a snapshot of the traffic metrics of a CAN channel, like the frame and byte
+		/// rates, the receive latency and the rate of each PGN on the bus.
+		/// @details The memory of `metrics` is reused, so polling into the same object is cheap.
+		/// @param[in] canChannel The channel to get the metrics for
+		/// @param[out] metrics The metrics of the channel
+		/// @returns `true` if the metrics were retrieved, `false` if the channel is out of range
+		bool get_channel_metrics(std::uint8_t canChannel, CANChannelMetrics &metrics);
+
 		/// @brief This is the main way to send a CAN message of any length.
 		/// @details This function will automatically choose an appropriate transport protocol if needed.
 		/// If you don't specify a destination (or use nullptr) you message will be sent as a broadcast
@@ -155,8 +167,30 @@ namespace isobus
 		                      DataChunkCallback frameChunkCallback = nullptr);
 
 		/// @brief The main update function for the network manager. Updates all protocols.
+		/// @details If per-port processing is enabled in the configuration, this only updates the state
+		/// shared between the CAN ports, and each port must be updated with `update(canPortIndex)`.
 		void update();
 
+		/// @brief Updates a single CAN port, when per-port processing is enabled in the configuration.
+		/// @details Processes the messages received and transmitted on the port, and updates the port's
+		/// protocols and heartbeat interface. Each port has its own lock, so different ports can be
+		/// updated concurrently from different threads. Does nothing if per-port processing is disabled.
+		/// @param[in] canPortIndex The CAN channel index of the port to update
+		void update(std::uint8_t canPortIndex);
+
+		/// @brief Returns when the CAN ports next need an update to keep the timing of their protocols and heartbeats,
+		/// such as TP and ETP timeouts, the delay between BAM frames and heartbeat intervals.
+		/// @details The deadline is worked out at the end of each update. If per-port processing is enabled,
+		/// `update()` doesn't update the ports, so use `get_next_update_deadline_us(canPortIndex)` instead.
+		/// @returns The deadline as a timestamp from SystemTiming::get_timestamp_us, or the largest `std::uint64_t` if there is none
+		std::uint64_t get_next_update_deadline_us() const;
+
+		/// @brief Returns when a CAN port next needs an update to keep the timing of its protocols and heartbeat,
+		/// when per-port processing is enabled in the configuration.
+		/// @param[in] canPortIndex The CAN channel index of the port
+		/// @returns The deadline as a timestamp from SystemTiming::get_timestamp_us, or the largest `std::uint64_t` if there is none
+		std::uint64_t get_next_update_deadline_us(std::uint8_t canPortIndex) const;
+
 		/// @brief Used to tell the network manager when frames are received on the bus.
 		/// @param[in] rxFrame Frame to process
 		void process_receive_can_message_frame(const CANMessageFrame &rxFrame);
@@ -199,6 +233,27 @@ namespace isobus
 		/// @returns The class instance of the NMEA2k fast packet protocol.
 		std::unique_ptr<FastPacketProtocol> &get_fast_packet_protocol(std::uint8_t canPortIndex);
 
+		/// @brief Returns the budget that limits the memory the TP, ETP and Fast Packet protocols of a CAN channel
+		/// use to receive messages. Use this to see how much memory the receiving sessions currently reserve.
+		/// The limits themselves are set in the network configuration.
+		/// @param[in] canPortIndex The CAN channel index to get the budget for
+		/// @returns The receive memory budget of the CAN channel
+		const TransportProtocolMemoryBudget &get_transport_protocol_memory_budget(std::uint8_t canPortIndex) const;
+
+		/// @brief Returns the flow control that sizes the TP and ETP windows and bursts of a CAN channel.
+		/// Use this to see the busload and round trip time that adaptive flow control works with.
+		/// Adaptive flow control itself is enabled in the network configuration.
+		/// @param[in] canPortIndex The CAN channel index to get the flow control for
+		/// @returns The transport protocol flow control of the CAN channel
+		const TransportProtocolFlowControl &get_transport_protocol_flow_control(std::uint8_t canPortIndex) const;
+
+		/// @brief Returns the scheduler that shares the data frames of a CAN channel between the TP, ETP and Fast Packet sessions.
+		/// Use this to see the latency statistics of the scheduled sessions per priority class.
+		/// The scheduler itself is enabled in the network configuration.
+		/// @param[in] canPortIndex The CAN channel index to get the scheduler for
+		/// @returns The transport protocol transmit scheduler of the CAN channel
+		const TransportProtocolTransmitScheduler &get_transport_protocol_transmit_scheduler(std::uint8_t canPortIndex) const;
+
 		/// @brief Returns an interface which can be used to manage ISO11783-7 heartbeat messages.
 		/// @param[in] canPortIndex The index of the CAN channel associated to the interface you're requesting
 		/// @returns ISO11783-7 heartbeat interface
@@ -213,6 +268,18 @@ namespace isobus
 		/// @returns An event dispatcher which can be used to get notified about address violations
 		EventDispatcher<std::shared_ptr<InternalControlFunction>> &get_address_violation_event_dispatcher();
 
+		/// @brief Returns the number of received frames that were dropped because the internal
+		/// receive queue was full, which happens if the stack isn't updated often enough for the busload.
+		/// @note What is dropped depends on `CANNetworkConfiguration::set_message_queue_overflow_policy`, and the
+		/// size of the queue on `CANNetworkConfiguration::set_message_queue_capacity`
+		/// @returns The number of received frames dropped since startup
+		std::size_t get_number_of_dropped_received_messages() const;
+
+		/// @brief Returns the number of transmitted frames that were dropped from processing because
+		/// the internal transmitted message queue was full. The frames were still sent on the bus.
+		/// @returns The number of transmitted frames dropped from processing since startup
+		std::size_t get_number_of_dropped_transmitted_messages() const;
+
 		/// @brief Transmits a request for the address claim PGN on the specified channel.
 		/// @attention This is not to be used for normal address claiming. The Internal Control Functions handle this automatically.
 		/// This function is only for special cases where you need to request an address claim to forcefully reconstruct the address table.
@@ -292,13 +359,24 @@ namespace isobus
 		/// @param[in] message The message to process
 		void process_rx_message_for_address_claiming(const CANMessage &message) const;
 
-		/// @brief Processes a CAN message's contribution to the current busload
-		/// @param[in] channelIndex The CAN channel index associated to the message being processed
-		/// @param[in] numberOfBitsProcessed The number of bits to add to the busload calculation
-		void update_busload(std::uint8_t channelIndex, std::uint32_t numberOfBitsProcessed);
+		/// @brief Processes a CAN frame's contribution to the busload and other traffic metrics of its channel
+		/// @param[in] frame The frame that was received or transmitted
+		/// @param[in] transmitted `true` if the frame was transmitted by us, `false` if it was received
+		void update_traffic_metrics(const CANMessageFrame &frame, bool transmitted);
+
+		/// @brief Stores the traffic counted during the current sample window, for calculating
+		/// the busload and other traffic metrics over multiple sample windows
+		void update_traffic_history();
+
+		/// @brief Works out when the protocols and heartbeat of a CAN port next need an update
+		/// @param[in] canPortIndex The CAN channel index of the port
+		void update_next_update_deadline(std::uint8_t canPortIndex);
 
-		/// @brief Updates the stored bit accumulators for calculating the bus load over a multiple sample windows
-		void update_busload_history();
+		/// @brief Adds the time between the driver's timestamp of a received message and now to the
+		/// receive latency histogram of its channel, if the timestamp is based on the system clock,
+		/// or counts the message as having an unusable timestamp otherwise
+		/// @param[in] message The received message that is about to be processed
+		void update_receive_latency(const CANMessage &message);
 
 		/// @brief Creates new control function classes based on the frames coming in from the bus
 		/// @param[in] rxFrame Raw frames coming in from the bus
@@ -324,16 +402,6 @@ namespace isobus
 		                                const void *data,
 		                                std::uint32_t size) const;
 
-		/// @brief Get the next CAN message from the received message queue, and remove it from the queue.
-		/// @note This will only ever get an 8 byte message because they are directly translated from CAN frames.
-		/// @returns The message that was at the front of the queue, or an invalid message if the queue is empty
-		CANMessage get_next_can_message_from_rx_queue();
-
-		/// @brief Get the next CAN message from the received message queue, and remove it from the queue
-		/// @note This will only ever get an 8 byte message because they are directly translated from CAN frames.
-		/// @returns The message that was at the front of the queue, or an invalid message if the queue is empty
-		CANMessage get_next_can_message_from_tx_queue();
-
 		/// @brief Processes a can message for callbacks added with add_any_control_function_parameter_group_number_callback
 		/// @param[in] currentMessage The message to process
 		void process_any_control_function_pgn_callbacks(const CANMessage &currentMessage);
@@ -359,16 +427,36 @@ namespace isobus
 		/// @param[in] message A pointer to a CAN message to be processed
 		void process_can_message_for_global_and_partner_callbacks(const CANMessage &message) const;
 
-		/// @brief Processes the internal received message queue
-		void process_rx_messages();
+		/// @brief Processes a received message queue
+		/// @param[in] queue The queue of received messages to process
+		/// @param[in] currentMessage The message used to process the queue, kept to recycle its buffer
+		/// @param[in] lockControlFunctions `true` to lock the control function tables while they are updated
+		void process_rx_messages(CANMessageQueue &queue, CANMessage &currentMessage, bool lockControlFunctions);
 
-		/// @brief Processes the internal transmitted message queue
-		void process_tx_messages();
+		/// @brief Processes a transmitted message queue
+		/// @param[in] queue The queue of transmitted messages to process
+		/// @param[in] currentMessage The message used to process the queue, kept to recycle its buffer
+		void process_tx_messages(CANMessageQueue &queue, CANMessage &currentMessage);
 
 		/// @brief Checks to see if any control function didn't claim during a round of
 		/// address claiming and removes it if needed.
 		void prune_inactive_control_functions();
 
+		/// @brief Checks to see if any control function on a channel didn't claim during a round of
+		/// address claiming and removes it if needed.
+		/// @param[in] channelIndex The CAN channel index to check
+		void prune_inactive_control_functions(std::uint8_t channelIndex);
+
+		/// @brief Returns the queue that received messages on a CAN port are added to
+		/// @param[in] canPortIndex The CAN channel index of the port
+		/// @returns The port's own queue if per-port processing is enabled, otherwise the shared queue
+		CANMessageQueue &get_received_message_queue(std::uint8_t canPortIndex);
+
+		/// @brief Returns the queue that transmitted messages on a CAN port are added to
+		/// @param[in] canPortIndex The CAN channel index of the port
+		/// @returns The port's own queue if per-port processing is enabled, otherwise the shared queue
+		CANMessageQueue &get_transmitted_message_queue(std::uint8_t canPortIndex);
+
 		/// @brief Sends a CAN message using raw addresses. Used only by the stack.
 		/// @param[in] portIndex The CAN channel index to send the message from
 		/// @param[in] sourceAddress The source address to send the CAN message from
@@ -391,17 +479,63 @@ namespace isobus
 		/// @returns A structure containing the global PGN callback data
 		ParameterGroupNumberCallbackData get_global_parameter_group_number_callback(std::size_t index) const;
 
+		/// @brief The state used to process a single CAN port on its own, when per-port processing is enabled
+		struct PortProcessingShard
+		{
+			CANMessageQueue receivedMessageQueue; ///< A lock-free queue of messages received on this port
+			CANMessageQueue transmittedMessageQueue; ///< A lock-free queue of messages transmitted on this port
+			CANMessage currentReceivedMessage = CANMessage::create_invalid_message(); ///< The received message being processed, kept to recycle its buffer
+			CANMessage currentTransmittedMessage = CANMessage::create_invalid_message(); ///< The transmitted message being processed, kept to recycle its buffer
+			Mutex processingMutex; ///< Serializes updates of this port
+		};
+
 		static constexpr std::uint32_t BUSLOAD_SAMPLE_WINDOW_MS = 1000; ///< Using a 1s window to average the bus load, otherwise it's very erratic
 		static constexpr std::uint32_t BUSLOAD_UPDATE_FREQUENCY_MS = 100; ///< Bus load bit accumulation happens over a 100ms window
+		static constexpr std::size_t NUMBER_OF_TRAFFIC_SAMPLES = BUSLOAD_SAMPLE_WINDOW_MS / BUSLOAD_UPDATE_FREQUENCY_MS; ///< The number of sample windows in the busload window
+		static constexpr std::uint64_t MAXIMUM_RECEIVE_LATENCY_US = 10000000; ///< Frame timestamps further than this from the system clock are not on the system clock
+
+		/// @brief The traffic on a channel during one sample window
+		struct TrafficSample
+		{
+			std::uint32_t numberOfBits = 0; ///< The approximate number of bits on the bus, for the busload
+			std::uint32_t receivedFrames = 0; ///< The number of received frames
+			std::uint32_t transmittedFrames = 0; ///< The number of transmitted frames
+			std::uint32_t receivedBytes = 0; ///< The number of received data bytes
+			std::uint32_t transmittedBytes = 0; ///< The number of transmitted data bytes
+		};
+
+		/// @brief The number of frames with a PGN in the current and the previous busload window
+		struct ParameterGroupNumberFrameCount
+		{
+			std::uint32_t currentWindow = 0; ///< The number of frames in the current busload window
+			std::uint32_t previousWindow = 0; ///< The number of frames in the previous busload window
+		};
+
+		/// @brief The traffic metrics of a channel
+		struct ChannelTraffic
+		{
+			std::array<TrafficSample, NUMBER_OF_TRAFFIC_SAMPLES> history; ///< A ring buffer of the samples that make up the busload window
+			std::size_t nextSampleIndex = 0; ///< The position in `history` that the current sample will be stored at
+			std::size_t numberOfSamples = 0; ///< The number of valid samples in `history`
+			TrafficSample currentSample; ///< The traffic counted during the current sample window
+			std::uint64_t totalReceivedFrames = 0; ///< The number of frames received since startup
+			std::uint64_t totalTransmittedFrames = 0; ///< The number of frames transmitted since startup
+			std::array<std::uint32_t, CANChannelMetrics::NUMBER_OF_LATENCY_BUCKETS> receiveLatencyHistogram = {}; ///< The receive latency histogram since startup
+			std::uint64_t framesWithUnusableTimestamp = 0; ///< The number of received frames left out of the histogram because of their timestamp
+			std::unordered_map<std::uint32_t, ParameterGroupNumberFrameCount> parameterGroupNumberFrameCounts; ///< The number of frames per PGN
+		};
 
 		CANNetworkConfiguration configuration; ///< The configuration for this network manager
+		std::array<std::unique_ptr<TransportProtocolMemoryBudget>, CAN_PORT_MAXIMUM> transportProtocolMemoryBudgets; ///< Limits the memory the protocols of each channel use to receive messages
+		std::array<std::unique_ptr<TransportProtocolFlowControl>, CAN_PORT_MAXIMUM> transportProtocolFlowControls; ///< Sizes the TP and ETP windows and bursts of each channel
+		std::array<std::unique_ptr<TransportProtocolTransmitScheduler>, CAN_PORT_MAXIMUM> transportProtocolTransmitSchedulers; ///< Shares the data frames of each channel between the TP, ETP and FP sessions
 		std::array<std::unique_ptr<TransportProtocolManager>, CAN_PORT_MAXIMUM> transportProtocols; ///< One instance of the transport protocol manager for each channel
 		std::array<std::unique_ptr<ExtendedTransportProtocolManager>, CAN_PORT_MAXIMUM> extendedTransportProtocols; ///< One instance of the extended transport protocol manager for each channel
 		std::array<std::unique_ptr<FastPacketProtocol>, CAN_PORT_MAXIMUM> fastPacketProtocol; ///< One instance of the fast packet protocol for each channel
 		std::array<std::unique_ptr<HeartbeatInterface>, CAN_PORT_MAXIMUM> heartBeatInterfaces; ///< Manages ISOBUS heartbeat requests, one per channel
 
-		std::array<std::deque<std::uint32_t>, CAN_PORT_MAXIMUM> busloadMessageBitsHistory; ///< Stores the approximate number of bits processed on each channel over multiple previous time windows
-		std::array<std::uint32_t, CAN_PORT_MAXIMUM> currentBusloadBitAccumulator; ///< Accumulates the approximate number of bits processed on each channel during the current time window
+		std::array<ChannelTraffic, CAN_PORT_MAXIMUM> channelTraffic; ///< Stores the traffic on each channel over multiple previous time windows, for the busload and other metrics
+		std::array<std::atomic<std::uint64_t>, CAN_PORT_MAXIMUM> nextUpdateDeadlines_us; ///< When the protocols and heartbeat of each channel next need an update, read by the hardware threads
 		std::array<std::uint32_t, CAN_PORT_MAXIMUM> lastAddressClaimRequestTimestamp_ms; ///< Stores timestamps for when the last request for the address claim PGN was received. Used to prune stale CFs.
 
 		std::array<std::array<std::shared_ptr<ControlFunction>, NULL_CAN_ADDRESS>, CAN_PORT_MAXIMUM> controlFunctionTable; ///< Table to maintain address to NAME mappings
@@ -410,23 +544,26 @@ namespace isobus
 		Mutex internalControlFunctionsMutex; ///< A mutex for internal control functions thread safety
 		std::list<std::shared_ptr<PartneredControlFunction>> partneredControlFunctions; ///< A list of the partnered control functions
 
-		std::list<ParameterGroupNumberCallbackData> protocolPGNCallbacks; ///< A list of PGN callback registered by CAN protocols
-		std::queue<CANMessage> receivedMessageQueue; ///< A queue of received messages to process
-		std::queue<CANMessage> transmittedMessageQueue; ///< A queue of transmitted messages to process (already sent, so changes to the message won't affect the bus)
+		ParameterGroupNumberCallbackTable protocolPGNCallbacks; ///< A table of PGN callback registered by CAN protocols
+		CANMessageQueue receivedMessageQueue; ///< A lock-free queue of received messages to process, fed by the hardware threads
+		CANMessageQueue transmittedMessageQueue; ///< A lock-free queue of transmitted messages to process (already sent, so changes to the message won't affect the bus)
+		CANMessage currentReceivedMessage = CANMessage::create_invalid_message(); ///< The received message being processed, kept to recycle its buffer
+		CANMessage currentTransmittedMessage = CANMessage::create_invalid_message(); ///< The transmitted message being processed, kept to recycle its buffer
+		std::array<std::unique_ptr<PortProcessingShard>, CAN_PORT_MAXIMUM> portProcessingShards; ///< The state of each port when per-port processing is enabled, otherwise empty
 		std::list<ControlFunctionStateCallback> controlFunctionStateCallbacks; ///< List of all control function state callbacks
-		std::vector<ParameterGroupNumberCallbackData> globalParameterGroupNumberCallbacks; ///< A list of all global PGN callbacks
-		std::vector<ParameterGroupNumberCallbackData> anyControlFunctionParameterGroupNumberCallbacks; ///< A list of all global PGN callbacks
-		EventDispatcher<CANMessage> messageTransmittedEventDispatcher; ///< An event dispatcher for notifying consumers about transmitted messages by our application
+		ParameterGroupNumberCallbackTable globalParameterGroupNumberCallbacks; ///< A table of all global PGN callbacks
+		ParameterGroupNumberCallbackTable anyControlFunctionParameterGroupNumberCallbacks; ///< A table of all "any CF" PGN callbacks
+		LockFreeEventDispatcher<CANMessage> messageTransmittedEventDispatcher; ///< An event dispatcher for notifying consumers about transmitted messages by our application
 		EventDispatcher<std::shared_ptr<InternalControlFunction>> addressViolationEventDispatcher; ///< An event dispatcher for notifying consumers about address violations
-		Mutex receivedMessageQueueMutex; ///< A mutex for receive messages thread safety
 		Mutex protocolPGNCallbacksMutex; ///< A mutex for PGN callback thread safety
 		Mutex anyControlFunctionCallbacksMutex; ///< Mutex to protect the "any CF" callbacks
-		Mutex busloadUpdateMutex; ///< A mutex that protects the busload metrics since we calculate it on our own thread
+		Mutex busloadUpdateMutex; ///< A mutex that protects the busload and other traffic metrics since we calculate them on our own thread
 		Mutex controlFunctionStatusCallbacksMutex; ///< A Mutex that protects access to the control function status callback list
-		Mutex transmittedMessageQueueMutex; ///< A mutex for protecting the transmitted message queue
+		Mutex &controlFunctionProcessingMutex = ControlFunction::controlFunctionProcessingMutex; ///< Protects the control function tables, shared with the control functions themselves
 		std::uint32_t busloadUpdateTimestamp_ms = 0; ///< Tracks a time window for determining approximate busload
 		std::uint32_t updateTimestamp_ms = 0; ///< Keeps track of the last time the CAN stack was update in milliseconds
 		bool initialized = false; ///< True if the network manager has been initialized by the update function
+		bool perPortProcessing = false; ///< True if each port is processed separately, latched from the configuration on initialization
 	};
 
 } // namespace isobus
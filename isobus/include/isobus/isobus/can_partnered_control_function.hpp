@@ -89,15 +89,15 @@ namespace isobus
 		bool check_matches_name(NAME NAMEToCheck) const;
 
 	private:
-		friend class CANNetworkManager; ///< Allows the network manager to use get_parameter_group_number_callback
+		friend class CANNetworkManager; ///< Allows the network manager to use the parameter group number callbacks
 
 		/// @brief Returns a parameter group number associated with this control function by index
 		/// @param[in] index The index from which to get the PGN callback data object
 		/// @returns A reference to the PGN callback data object at the index specified
-		ParameterGroupNumberCallbackData &get_parameter_group_number_callback(std::size_t index);
+		const ParameterGroupNumberCallbackData &get_parameter_group_number_callback(std::size_t index) const;
 
 		const std::vector<NAMEFilter> NAMEFilterList; ///< A list of NAME parameters that describe this control function's identity
-		std::vector<ParameterGroupNumberCallbackData> parameterGroupNumberCallbacks; ///< A list of all parameter group number callbacks associated with this control function
+		ParameterGroupNumberCallbackTable parameterGroupNumberCallbacks; ///< All parameter group number callbacks associated with this control function
 		bool initialized = false; ///< A way to track if the network manager has processed this CF against existing CFs
 	};
 
@@ -13,9 +13,22 @@
 #include "isobus/isobus/can_control_function.hpp"
 #include "isobus/isobus/can_message.hpp"
 #include "isobus/isobus/can_message_data.hpp"
+#include "isobus/isobus/can_network_configuration.hpp"
+#include "isobus/utility/thread_synchronization.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace isobus
 {
+	class TransportProtocolMemoryBudget;
+	class TransportProtocolTransmitScheduler;
+
 	/// @brief An object to keep track of session information internally
 	class TransportProtocolSessionBase
 	{
@@ -103,6 +116,15 @@ namespace isobus
 		/// @return The PGN of the message
 		std::uint32_t get_parameter_group_number() const;
 
+		/// @brief Get the number of bytes this session has reserved from the receive memory budget of its CAN port
+		/// @return The number of reserved bytes
+		std::uint32_t get_reserved_memory() const;
+
+		/// @brief Get the time between queueing the session at the transmit scheduler of its CAN port
+		/// and the scheduler letting it send its first data frame
+		/// @return The time in microseconds, or 0 if the session wasn't scheduled or sent no data frame yet
+		std::uint64_t get_time_to_first_frame_us() const;
+
 	protected:
 		/// @brief Update the timestamp of the session
 		void update_timestamp();
@@ -111,11 +133,42 @@ namespace isobus
 		/// @return The duration in milliseconds
 		std::uint32_t get_time_since_last_update() const;
 
+		/// @brief Get the time left until a duration has passed since the last update of the timestamp
+		/// @param[in] duration_ms The duration since the last update of the timestamp, in milliseconds
+		/// @return The time left in milliseconds, or 0 if the duration has already passed
+		std::uint32_t get_time_until_elapsed(std::uint32_t duration_ms) const;
+
 		/// @brief Complete the session
 		/// @param[in] success True if the session was successful, false otherwise
 		void complete(bool success) const;
 
+		/// @brief Get the number of CTS messages sent in a row to hold the connection while waiting for memory
+		/// @return The number of hold messages sent since the last CTS that allowed packets
+		std::uint32_t get_number_of_memory_holds() const;
+
+		/// @brief Set the number of CTS messages sent in a row to hold the connection while waiting for memory
+		/// @param[in] value The number of hold messages sent since the last CTS that allowed packets
+		void set_number_of_memory_holds(std::uint32_t value);
+
+		/// @brief Grows the buffer of a receiving session to hold at least a number of bytes, reserving its memory from a budget
+		/// @details The buffer grows in steps of at least double its size, up to the message length, so large messages
+		/// aren't copied for each window. If the budget can't cover such a step, only the needed bytes are reserved.
+		/// @param[in] budget The budget to reserve the memory from, or `nullptr` if the memory is unlimited
+		/// @param[in] numberOfBytes The number of bytes the buffer must be able to hold, at most the message length
+		/// @returns `true` if the buffer can hold the bytes, or `false` if the budget can't cover them
+		bool grow_receive_buffer(TransportProtocolMemoryBudget *budget, std::uint32_t numberOfBytes);
+
+		/// @brief Starts measuring the time until the other side responds to a message, like the data after a CTS
+		void start_round_trip_measurement();
+
+		/// @brief Stops measuring the time until the other side responds to a message
+		/// @returns The time since the measurement was started in microseconds, or 0 if no measurement was running
+		std::uint64_t stop_round_trip_measurement();
+
 	private:
+		friend class TransportProtocolMemoryBudget; ///< Allows the budget to track the memory reserved by the session
+		friend class TransportProtocolTransmitScheduler; ///< Allows the scheduler to record the latency of the session
+
 		Direction direction; ///< The direction of the session
 		std::uint32_t parameterGroupNumber; ///< The PGN of the message
 		std::unique_ptr<CANMessageData> data; ///< The data buffer for the message
@@ -127,6 +180,378 @@ namespace isobus
 
 		TransmitCompleteCallback sessionCompleteCallback = nullptr; ///< A callback that is to be called when the session is completed
 		void *parent = nullptr; ///< A generic context variable that helps identify what object callbacks are destined for. Can be nullptr
+		std::uint32_t reservedMemory = 0; ///< The number of bytes reserved from the receive memory budget
+		std::uint32_t numberOfMemoryHolds = 0; ///< The number of CTS messages sent in a row to hold the connection while waiting for memory
+		std::uint64_t roundTripStartTimestamp_us = 0; ///< When the running round trip measurement started, or 0 if none is running
+		std::uint64_t timeToFirstFrame_us = 0; ///< The time between queueing the session at the transmit scheduler and its first data frame
+	};
+
+	/// @brief Limits the memory that the TP, ETP and Fast Packet sessions of a CAN port use for receiving messages
+	/// @details Receiving sessions reserve memory from the budget as their buffer grows, and release it
+	/// when they are closed. The total reservations of a CAN port, and the reservations of each source
+	/// control function, are limited by the network configuration, so a single misbehaving control
+	/// function can't use all memory. A limit of 0 means unlimited.
+	class TransportProtocolMemoryBudget
+	{
+	public:
+		/// @brief Constructor for the budget
+		/// @param[in] configuration The configuration to read the limits from
+		explicit TransportProtocolMemoryBudget(const CANNetworkConfiguration *configuration);
+
+		/// @brief Checks if a message of a certain size could ever be received within the limits
+		/// @param[in] messageSize The size of the message in bytes
+		/// @returns `true` if the message is not larger than the limits, otherwise `false`
+		bool is_within_limits(std::uint32_t messageSize) const;
+
+		/// @brief Grows the memory reserved by a session to a number of bytes
+		/// @param[in] session The session to reserve memory for
+		/// @param[in] numberOfBytes The total number of bytes the session needs to have reserved
+		/// @returns `true` if the memory is reserved, or `false` if the limits don't allow it, in which case
+		/// the reservation of the session is unchanged
+		bool reserve(TransportProtocolSessionBase &session, std::uint32_t numberOfBytes);
+
+		/// @brief Releases all memory reserved by a session
+		/// @param[in] session The session to release the memory of
+		void release(TransportProtocolSessionBase &session);
+
+		/// @brief Returns the number of bytes reserved by all sessions
+		/// @returns The number of reserved bytes
+		std::uint32_t get_reserved_memory() const;
+
+		/// @brief Returns the number of bytes reserved by the sessions from a source control function
+		/// @param[in] source The source control function
+		/// @returns The number of reserved bytes
+		std::uint32_t get_reserved_memory(const std::shared_ptr<ControlFunction> &source) const;
+
+	private:
+		const CANNetworkConfiguration *configuration; ///< The configuration to read the limits from
+		std::unordered_map<const ControlFunction *, std::uint32_t> reservedMemoryPerSource; ///< The bytes reserved by each source with any reservation
+		std::uint32_t reservedMemory = 0; ///< The bytes reserved by all sessions
+		mutable Mutex budgetMutex; ///< Allows the protocols to share the budget from different threads
+	};
+
+	/// @brief Sizes the CTS and DPO windows and the data bursts of the TP and ETP sessions of a CAN port
+	/// @details When adaptive flow control is enabled in the network configuration, this limits the transfers
+	/// to the headroom between the measured busload and the target busload. A window of packets followed by a
+	/// round trip to the other side occupies the bus for the fraction `packets * frameTime / (packets * frameTime + roundTripTime)`,
+	/// so windows are sized to keep that fraction within the headroom, and data is sent in bursts that fit the
+	/// headroom during one update interval. The load of the transfers themselves is not counted against the
+	/// headroom, and the transfers always keep a small share of the bus so they don't time out.
+	/// The configured window and burst sizes are the upper limits, so adaptive flow control never sends
+	/// more aggressively than the fixed configuration would.
+	/// When adaptive flow control is disabled, the configured sizes are used as they are.
+	class TransportProtocolFlowControl
+	{
+	public:
+		/// @brief Constructor for the flow control
+		/// @param[in] configuration The configuration to read the settings and limits from
+		explicit TransportProtocolFlowControl(const CANNetworkConfiguration *configuration);
+
+		/// @brief Updates the busload of the CAN port, should be called once per update of the protocols
+		/// @param[in] currentBusload The current busload of the CAN port, between 0.0f and 100.0f
+		void update(float currentBusload);
+
+		/// @brief Adds a measured round trip time between a message and the response of the other side
+		/// @param[in] roundTripTime_us The round trip time in microseconds, 0 is ignored
+		void add_round_trip_time(std::uint64_t roundTripTime_us);
+
+		/// @brief Counts a data or flow control frame of a transfer that was sent or received
+		/// @details The load of the transfers is excluded from the busload when computing the headroom,
+		/// so that a transfer doesn't throttle itself on an otherwise idle bus.
+		void add_transfer_frame();
+
+		/// @brief Counts a data frame that a session sent, which is taken from the frames the sessions of the CAN port
+		/// may send during this update, and is also counted as a transfer frame
+		void add_sent_data_frame();
+
+		/// @brief Returns the number of packets to allow in a CTS window or to announce in a DPO
+		/// @param[in] maximumPackets The configured number of packets, which is the upper limit
+		/// @returns The number of packets for the next window
+		std::uint8_t get_packets_per_window(std::uint8_t maximumPackets) const;
+
+		/// @brief Returns the number of data frames the sessions of the CAN port may still send during this update
+		/// @details The headroom of the bus is shared by all sessions of the CAN port, so every data frame
+		/// counted with `add_sent_data_frame` since the last update is taken from it.
+		/// @param[in] maximumFrames The configured number of frames per update, which is the upper limit
+		/// @returns The number of frames that may still be sent during this update
+		std::uint8_t get_frames_per_update(std::uint8_t maximumFrames) const;
+
+		/// @brief Returns the busload that was last passed to `update`
+		/// @returns The busload between 0.0f and 100.0f
+		float get_busload() const;
+
+		/// @brief Returns the smoothed round trip time between messages and the responses of the other side
+		/// @returns The round trip time in microseconds, or 0 if none was measured yet
+		std::uint32_t get_round_trip_time() const;
+
+	private:
+		/// @brief Returns the fraction of the bus that the transfers may use
+		/// @returns The headroom between the busload and the target busload, between 0.05f and 1.0f
+		float get_headroom() const;
+
+		static constexpr float FRAME_TIME_US = 540.0f; ///< The time an 8 byte extended frame takes on a 250 kbit/s bus, including typical bit stuffing
+
+		const CANNetworkConfiguration *configuration; ///< The configuration to read the settings and limits from
+		std::uint64_t lastUpdateTimestamp_us = 0; ///< When `update` was last called
+		std::uint32_t updateInterval_us = 0; ///< The time between the last two calls to `update`, or 0 if unknown
+		std::uint32_t smoothedRoundTripTime_us = 0; ///< The smoothed round trip time, or 0 if none was measured yet
+		std::uint32_t transferFramesSinceUpdate = 0; ///< The number of transfer data frames since the last call to `update`
+		float transferBusload = 0.0f; ///< The averaged share of the busload caused by the transfers, between 0.0f and 100.0f
+		float frameAllowance = 0.0f; ///< The fraction of a frame that was allowed but not sent during the last update
+		std::uint32_t framesPerUpdate = 0; ///< The number of frames the sessions of the CAN port may send together during this update
+		std::uint32_t framesSentThisUpdate = 0; ///< The number of data frames the sessions sent since the last call to `update`
+		float busload = 0.0f; ///< The busload that was last passed to `update`
+	};
+
+	/// @brief Shares the data frames that the TP, ETP and Fast Packet sessions of a CAN port may send during one update
+	/// @details Without the scheduler, each protocol sends the data frames of its sessions in list order during
+	/// its own update, so one large transfer fills the transmit queue of the port while a small message waits behind it.
+	/// With the scheduler, the protocols queue their transmitting sessions here instead, and the scheduler sends
+	/// the data frames of all of them in weighted round-robin after the protocols are updated. Each round, a session
+	/// may send as many frames as the weight of its priority class, which is derived from the CAN priority of the
+	/// message. A session that can't use its share, because it waits for a CTS for example, drops out until the next update,
+	/// and a session that was cut short by the frame budget keeps the rest of its share for the next update.
+	/// This bounds the latency of a small message during a bulk transfer to a few frames per round.
+	/// The scheduler is only used when a frame budget per update is set in the network configuration.
+	class TransportProtocolTransmitScheduler
+	{
+	public:
+		/// @brief Enumerates the priority classes of scheduled sessions
+		enum class PriorityClass : std::uint8_t
+		{
+			High = 0, ///< CAN priority 0 to 2, like time critical commands
+			Normal = 1, ///< CAN priority 3 to 5, like process data
+			Low = 2, ///< CAN priority 6 and 7, like bulk transfers of object pools
+			NumberOfClasses = 3 ///< The number of priority classes
+		};
+
+		/// @brief The latency statistics of all completed sessions of a priority class
+		struct ClassStatistics
+		{
+			std::uint32_t numberOfSessions = 0; ///< The number of removed sessions that sent at least one data frame
+			std::uint64_t numberOfFrames = 0; ///< The number of data frames sent by these sessions
+			std::uint64_t totalTimeToFirstFrame_us = 0; ///< The sum of the times from queueing the sessions to their first data frame
+			std::uint64_t maximumTimeToFirstFrame_us = 0; ///< The longest time from queueing a session to its first data frame
+			std::uint64_t totalSessionTime_us = 0; ///< The sum of the times from queueing the sessions to removing them
+			std::uint64_t maximumSessionTime_us = 0; ///< The longest time from queueing a session to removing it
+		};
+
+		/// @brief A callback that sends data frames of a session for the scheduler
+		/// @details The callback returns the number of frames it sent, which is less than the maximum if the
+		/// session can't send more frames right now.
+		using TransmitFramesCallback = std::function<std::uint32_t(const std::shared_ptr<TransportProtocolSessionBase> &session, std::uint32_t maximumFrames)>;
+
+		/// @brief Constructor for the scheduler
+		/// @param[in] configuration The configuration to read the frame budget from
+		/// @param[in] flowControl The flow control that limits the frame budget, or `nullptr` to use the configured budget
+		TransportProtocolTransmitScheduler(const CANNetworkConfiguration *configuration,
+		                                   const TransportProtocolFlowControl *flowControl = nullptr);
+
+		/// @brief Returns if the scheduler sends the data frames of the sessions
+		/// @returns `true` if a frame budget is configured, otherwise `false` if the protocols send their data frames themselves
+		bool is_enabled() const;
+
+		/// @brief Queues a transmitting session, which the scheduler will send the data frames of while it is enabled
+		/// @param[in] session The session to queue
+		/// @param[in] priority The CAN priority of the message, which decides its priority class
+		/// @param[in] transmitFrames The callback of the protocol that sends data frames of the session
+		void add(const std::shared_ptr<TransportProtocolSessionBase> &session,
+		         CANIdentifier::CANPriority priority,
+		         const TransmitFramesCallback &transmitFrames);
+
+		/// @brief Removes a session from the scheduler, and adds its latency to the statistics of its class
+		/// @param[in] session The session to remove, which may also not be queued
+		void remove(const TransportProtocolSessionBase &session);
+
+		/// @brief Sends the data frames of the queued sessions, should be called after each update of the protocols
+		void update();
+
+		/// @brief Returns the priority class of messages with a CAN priority
+		/// @param[in] priority The CAN priority of the message
+		/// @returns The priority class
+		static PriorityClass get_priority_class(CANIdentifier::CANPriority priority);
+
+		/// @brief Returns the latency statistics of the completed sessions of a priority class
+		/// @param[in] priorityClass The priority class
+		/// @returns The statistics of the class
+		ClassStatistics get_statistics(PriorityClass priorityClass) const;
+
+		/// @brief Returns the number of queued sessions
+		/// @returns The number of sessions
+		std::size_t get_number_of_sessions() const;
+
+	private:
+		/// @brief A queued session
+		struct Entry
+		{
+			std::shared_ptr<TransportProtocolSessionBase> session; ///< The queued session
+			TransmitFramesCallback transmitFrames; ///< Sends data frames of the session
+			PriorityClass priorityClass; ///< The priority class of the session
+			std::uint32_t deficit = 0; ///< The number of frames the session may still send from its share
+			std::uint64_t queuedTimestamp_us = 0; ///< When the session was queued
+			std::uint64_t numberOfFrames = 0; ///< The number of data frames the session sent
+			std::atomic<bool> removed = { false }; ///< Set when the session is removed while the scheduler is sending
+		};
+
+		/// @brief Returns the number of frames a session of a priority class may send per round
+		/// @param[in] priorityClass The priority class
+		/// @returns The weight of the class
+		static std::uint32_t get_weight(PriorityClass priorityClass);
+
+		const CANNetworkConfiguration *configuration; ///< The configuration to read the frame budget from
+		const TransportProtocolFlowControl *flowControl; ///< The flow control that limits the frame budget, or `nullptr`
+		std::vector<std::shared_ptr<Entry>> entries; ///< The queued sessions in the order they were queued
+		std::vector<std::shared_ptr<Entry>> roundEntries; ///< The sessions that can still send during the current update, kept to reuse its memory
+		std::array<ClassStatistics, static_cast<std::size_t>(PriorityClass::NumberOfClasses)> statistics; ///< The statistics per priority class
+		std::size_t nextEntryIndex = 0; ///< The session to start the next update with, so no session is always served first
+		mutable Mutex schedulerMutex; ///< Allows sessions to be queued from other threads than the one updating the scheduler
+	};
+
+	/// @brief The active sessions of a protocol, with an index to look them up by their control functions
+	/// @details Sessions are kept in the order they were added, and additionally indexed by their
+	/// source, destination and optionally their PGN, so finding the session of a received frame
+	/// doesn't have to search all sessions. The control functions are compared by identity like in
+	/// `TransportProtocolSessionBase::matches`, which also distinguishes the CAN ports.
+	/// @note The list is not thread-safe, the protocol must synchronize access to it if needed.
+	template<typename T>
+	class TransportProtocolSessionList
+	{
+	public:
+		/// @brief Constructor for the list
+		/// @param[in] indexByParameterGroupNumber `true` if sessions are identified by their PGN as well, otherwise
+		/// only by their source and destination
+		explicit TransportProtocolSessionList(bool indexByParameterGroupNumber) :
+		  indexByParameterGroupNumber(indexByParameterGroupNumber)
+		{
+		}
+
+		/// @brief Adds a session to the end of the list
+		/// @param[in] session The session to add
+		void add(const std::shared_ptr<T> &session)
+		{
+			sessions.push_back(session);
+			index.emplace(get_key(*session), session);
+		}
+
+		/// @brief Removes a session from the list
+		/// @param[in] session The session to remove
+		/// @returns `true` if the session was in the list, otherwise `false`
+		bool remove(const std::shared_ptr<T> &session)
+		{
+			bool retVal = false;
+
+			for (auto sessionLocation = sessions.begin(); sessionLocation != sessions.end(); sessionLocation++)
+			{
+				if (*sessionLocation == session)
+				{
+					sessions.erase(sessionLocation);
+					retVal = true;
+					break;
+				}
+			}
+
+			if (retVal)
+			{
+				const SessionKey key = get_key(*session);
+				auto indexLocation = index.find(key);
+				if ((index.end() != indexLocation) && (indexLocation->second == session))
+				{
+					index.erase(indexLocation);
+
+					// Another session with the same key is unusual, but if there is one it takes over the index entry
+					for (const auto &otherSession : sessions)
+					{
+						if (get_key(*otherSession) == key)
+						{
+							index.emplace(key, otherSession);
+							break;
+						}
+					}
+				}
+			}
+			return retVal;
+		}
+
+		/// @brief Finds the first session added with the given control functions and PGN
+		/// @param[in] source The source control function of the session
+		/// @param[in] destination The destination control function of the session, or `nullptr` for broadcast sessions
+		/// @param[in] parameterGroupNumber The PGN of the session, ignored if the list doesn't index by PGN
+		/// @returns The matching session, or `nullptr` if no session matched
+		std::shared_ptr<T> find(const std::shared_ptr<ControlFunction> &source,
+		                        const std::shared_ptr<ControlFunction> &destination,
+		                        std::uint32_t parameterGroupNumber = 0) const
+		{
+			auto indexLocation = index.find(SessionKey{ source.get(), destination.get(), indexByParameterGroupNumber ? parameterGroupNumber : 0 });
+			return (index.end() != indexLocation) ? indexLocation->second : nullptr;
+		}
+
+		/// @brief Returns the session at a position in the list
+		/// @param[in] position The position of the session
+		/// @returns The session at the position
+		const std::shared_ptr<T> &at(std::size_t position) const
+		{
+			return sessions.at(position);
+		}
+
+		/// @brief Returns the number of sessions in the list
+		/// @returns The number of sessions in the list
+		std::size_t size() const
+		{
+			return sessions.size();
+		}
+
+		/// @brief Returns all sessions in the order they were added
+		/// @returns All sessions in the list
+		const std::vector<std::shared_ptr<T>> &get_sessions() const
+		{
+			return sessions;
+		}
+
+	private:
+		/// @brief The values that identify a session
+		struct SessionKey
+		{
+			const ControlFunction *source; ///< The source control function of the session
+			const ControlFunction *destination; ///< The destination control function of the session
+			std::uint32_t parameterGroupNumber; ///< The PGN of the session, or 0 if the list doesn't index by PGN
+
+			/// @brief Compares two keys for equality
+			/// @param[in] other The key to compare to
+			/// @returns `true` if the keys are equal, otherwise `false`
+			bool operator==(const SessionKey &other) const
+			{
+				return (source == other.source) && (destination == other.destination) && (parameterGroupNumber == other.parameterGroupNumber);
+			}
+		};
+
+		/// @brief Hashes a session key
+		struct SessionKeyHash
+		{
+			/// @brief Hashes a session key
+			/// @param[in] key The key to hash
+			/// @returns The hash of the key
+			std::size_t operator()(const SessionKey &key) const
+			{
+				std::size_t retVal = std::hash<const ControlFunction *>()(key.source);
+				retVal = (retVal * 31) ^ std::hash<const ControlFunction *>()(key.destination);
+				retVal = (retVal * 31) ^ std::hash<std::uint32_t>()(key.parameterGroupNumber);
+				return retVal;
+			}
+		};
+
+		/// @brief Gets the key that identifies a session
+		/// @param[in] session The session to get the key of
+		/// @returns The key of the session
+		SessionKey get_key(const T &session) const
+		{
+			return SessionKey{ session.get_source().get(),
+				                 session.get_destination().get(),
+				                 indexByParameterGroupNumber ? session.get_parameter_group_number() : 0 };
+		}
+
+		std::vector<std::shared_ptr<T>> sessions; ///< The sessions in the order they were added
+		std::unordered_map<SessionKey, std::shared_ptr<T>, SessionKeyHash> index; ///< The first added session for each key
+		const bool indexByParameterGroupNumber; ///< Whether sessions are identified by their PGN as well
 	};
 } // namespace isobus
 
@@ -15,6 +15,8 @@
 
 #include <functional>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace isobus
 {
@@ -22,9 +24,13 @@ namespace isobus
 	/// @details This class can be used to build up a task controller DDOP by adding objects to it
 	/// in a hierarchy, then calling generate_binary_object_pool to get the object pool in
 	/// binary form.
+	/// The pool keeps an index of its objects by object ID, element number, parent object and DDI,
+	/// so that looking objects up doesn't have to search the whole pool.
 	/// @note To ensure maximum compatibility with task controllers, it may be best to stick to
 	/// limits that were defined for TC 3 and older when providing things like labels for
 	/// device element designators.
+	/// @note If you change the object ID, element number, parent object, child objects or DDI of an object
+	/// that is already in the pool, call rebuild_indices afterwards so that lookups can find it.
 	class DeviceDescriptorObjectPool
 	{
 	public:
@@ -164,6 +170,38 @@ namespace isobus
 		/// @returns Pointer to the object matching the provided ID, or nullptr if no match was found
 		std::shared_ptr<task_controller_object::Object> get_object_by_id(std::uint16_t objectID);
 
+		/// @brief Gets a device element object from the DDOP by its element number
+		/// @param[in] elementNumber The element number of the device element to get
+		/// @returns Pointer to the first device element with the provided element number, or nullptr if no match was found
+		std::shared_ptr<task_controller_object::DeviceElementObject> get_device_element_by_number(std::uint16_t elementNumber);
+
+		/// @brief Gets the device element objects whose parent is a certain object, in the order they were added
+		/// @param[in] parentObjectID The object ID of the parent device or device element object
+		/// @returns The device elements whose parent is the provided object
+		std::vector<std::shared_ptr<task_controller_object::DeviceElementObject>> get_child_device_elements(std::uint16_t parentObjectID);
+
+		/// @brief Gets the device process data objects referenced by a device element
+		/// @param[in] elementNumber The element number of the device element
+		/// @returns The process data objects the device element references, in the order it references them
+		std::vector<std::shared_ptr<task_controller_object::DeviceProcessDataObject>> get_device_element_process_data(std::uint16_t elementNumber);
+
+		/// @brief Gets the device process data object that a device element references for a certain DDI
+		/// @param[in] elementNumber The element number of the device element
+		/// @param[in] DDI The DDI of the process data
+		/// @returns Pointer to the process data object, or nullptr if the element doesn't reference process data with that DDI
+		std::shared_ptr<task_controller_object::DeviceProcessDataObject> get_device_process_data(std::uint16_t elementNumber, std::uint16_t DDI);
+
+		/// @brief Gets every device process data and device property object that has a certain DDI, in the order they were added
+		/// @param[in] DDI The DDI to look up
+		/// @returns The process data and property objects with the provided DDI
+		std::vector<std::shared_ptr<task_controller_object::Object>> get_objects_by_ddi(std::uint16_t DDI);
+
+		/// @brief Rebuilds the pool's indices of its objects
+		/// @details Adding, removing and deserializing objects keep the indices up to date on their own.
+		/// This is only needed after changing the object ID, element number, parent object, child objects
+		/// or DDI of an object that is already in the pool.
+		void rebuild_indices();
+
 		/// @brief Gets an object from the DDOP by index based on object creation
 		/// @param[in] index The index of the object to get
 		/// @returns Pointer to the object matching the index, or nullptr if no match was found
@@ -208,9 +246,24 @@ namespace isobus
 		/// @returns true if the object ID parameter is unique in the DDOP, otherwise false
 		bool check_object_id_unique(std::uint16_t uniqueID) const;
 
+		/// @brief Adds the object that was added last to the object ID index
+		void add_last_object_to_index();
+
+		/// @brief Rebuilds the object ID index, which has to be done when objects are removed since the objects after them move
+		void rebuild_object_index();
+
+		/// @brief Rebuilds the element, child element and DDI indices if objects were added or removed since they were last built
+		void update_element_indices();
+
 		static constexpr std::uint8_t MAX_TC_VERSION_SUPPORTED = 4; ///< The max TC version a DDOP object can support as of today
 
 		std::vector<std::shared_ptr<task_controller_object::Object>> objectList; ///< Maintains a list of all added objects
+		std::unordered_map<std::uint16_t, std::size_t> objectIndices; ///< The position of each object in the object list by object ID, kept up to date on every change
+		std::unordered_map<std::uint16_t, std::size_t> elementIndices; ///< The position of each device element in the object list by element number
+		std::unordered_map<std::uint16_t, std::vector<std::size_t>> childElementIndices; ///< The positions of the device elements in the object list by the object ID of their parent
+		std::unordered_map<std::uint16_t, std::vector<std::size_t>> ddiIndices; ///< The positions of the process data and property objects in the object list by DDI
+		std::unordered_map<std::uint32_t, std::size_t> elementProcessDataIndices; ///< The position of each element's process data in the object list, by element number in the upper 16 bits and DDI in the lower 16 bits
+		bool elementIndicesValid = false; ///< Tells if the element, child element and DDI indices match the object list
 		std::uint8_t taskControllerCompatibilityLevel = MAX_TC_VERSION_SUPPORTED; ///< Stores the max TC version
 	};
 } // namespace isobus
@@ -0,0 +1,262 @@
+//================================================================================================
+/// @file isobus_device_descriptor_object_pool_view.hpp
+///
+/// @brief Defines a read-only view of a binary DDOP, which reads objects straight out of
+/// the binary data instead of converting them into objects.
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#ifndef ISOBUS_DEVICE_DESCRIPTOR_OBJECT_POOL_VIEW_HPP
+#define ISOBUS_DEVICE_DESCRIPTOR_OBJECT_POOL_VIEW_HPP
+
+#include "isobus/isobus/can_NAME.hpp"
+#include "isobus/isobus/isobus_task_controller_client_objects.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace isobus
+{
+	class DeviceDescriptorObjectPool;
+
+	//================================================================================================
+	/// @class DeviceDescriptorObjectPoolView
+	///
+	/// @brief A read-only view of a binary device descriptor object pool.
+	/// @details A task controller server receives a client's DDOP in binary form, but often only needs
+	/// to read a few things from it, like the structure label or the DDIs of each element.
+	/// Deserializing it into a DeviceDescriptorObjectPool allocates every object and copies every
+	/// string, which costs far more than reading the binary data itself.
+	/// The view checks the binary data once, using the same rules as
+	/// DeviceDescriptorObjectPool::deserialize_binary_object_pool, and remembers where each object starts.
+	/// After that, looking up an object and reading its fields never allocates or copies anything,
+	/// they're read directly out of the binary data. The view doesn't own the binary data, so the data
+	/// must not be changed or freed while the view is in use.
+	/// If the full object model is needed after all, call materialize to fill a DeviceDescriptorObjectPool.
+	//================================================================================================
+	class DeviceDescriptorObjectPoolView
+	{
+	public:
+		/// @brief A range of bytes inside the binary DDOP, such as a designator
+		struct ByteSpan
+		{
+			/// @brief Returns the bytes as a string, which copies them
+			/// @returns The bytes as a string
+			std::string to_string() const;
+
+			const std::uint8_t *data; ///< The first byte of the range, or nullptr if the range is empty
+			std::size_t length; ///< The number of bytes in the range
+		};
+
+		/// @brief A handle to one object in the binary DDOP, with accessors that read its fields
+		/// directly out of the binary data.
+		/// @details The handle is only as valid as the view that returned it. Accessors for fields that
+		/// the object's type doesn't have return zero, an empty span, or NULL_OBJECT_ID for object IDs.
+		class Object
+		{
+		public:
+			/// @brief Constructs a handle that doesn't refer to any object
+			Object() = default;
+
+			/// @brief Returns if the handle refers to an object
+			/// @returns true if the handle refers to an object, otherwise false
+			bool get_is_valid() const;
+
+			/// @brief Returns the type of the object
+			/// @returns The type of the object
+			task_controller_object::ObjectTypes get_object_type() const;
+
+			/// @brief Returns the object ID of the object
+			/// @returns The object ID of the object, or NULL_OBJECT_ID if the handle doesn't refer to an object
+			std::uint16_t get_object_id() const;
+
+			/// @brief Returns the designator of the object
+			/// @returns The designator of the object
+			ByteSpan get_designator() const;
+
+			/// @brief Returns the software version of a device object
+			/// @returns The software version of a device object
+			ByteSpan get_software_version() const;
+
+			/// @brief Returns the serial number of a device object
+			/// @returns The serial number of a device object
+			ByteSpan get_serial_number() const;
+
+			/// @brief Returns the structure label of a device object
+			/// @returns The structure label of a device object
+			ByteSpan get_structure_label() const;
+
+			/// @brief Returns the localization label of a device object
+			/// @returns The localization label of a device object
+			ByteSpan get_localization_label() const;
+
+			/// @brief Returns the extended structure label of a device object
+			/// @returns The extended structure label of a device object, which is empty for TC versions before 4
+			ByteSpan get_extended_structure_label() const;
+
+			/// @brief Returns the ISO NAME of a device object
+			/// @returns The ISO NAME of a device object
+			std::uint64_t get_iso_name() const;
+
+			/// @brief Returns the type of a device element object
+			/// @returns The type of a device element object
+			task_controller_object::DeviceElementObject::Type get_element_type() const;
+
+			/// @brief Returns the element number of a device element object
+			/// @returns The element number of a device element object
+			std::uint16_t get_element_number() const;
+
+			/// @brief Returns the object ID of the parent of a device element object
+			/// @returns The object ID of the parent of a device element object
+			std::uint16_t get_parent_object() const;
+
+			/// @brief Returns the number of child objects a device element object references
+			/// @returns The number of child objects a device element object references
+			std::uint16_t get_number_child_objects() const;
+
+			/// @brief Returns a child object ID of a device element object by index
+			/// @param[in] index The index of the child object ID to return
+			/// @returns Child object ID by index, or NULL_OBJECT_ID if the index is out of range
+			std::uint16_t get_child_object_id(std::size_t index) const;
+
+			/// @brief Returns the DDI of a device process data or device property object
+			/// @returns The DDI of a device process data or device property object
+			std::uint16_t get_ddi() const;
+
+			/// @brief Returns the properties of a device process data object
+			/// @returns The properties of a device process data object, as a bitfield of `PropertiesBit`
+			std::uint8_t get_properties_bitfield() const;
+
+			/// @brief Returns the available trigger methods of a device process data object
+			/// @returns The available trigger methods of a device process data object, as a bitfield of `AvailableTriggerMethods`
+			std::uint8_t get_trigger_methods_bitfield() const;
+
+			/// @brief Returns the value of a device property object
+			/// @returns The value of a device property object
+			std::int32_t get_value() const;
+
+			/// @brief Returns the object ID of the value presentation of a device process data or device property object
+			/// @returns The object ID of the value presentation, or NULL_OBJECT_ID if there isn't one
+			std::uint16_t get_device_value_presentation_object_id() const;
+
+			/// @brief Returns the offset of a device value presentation object
+			/// @returns The offset of a device value presentation object
+			std::int32_t get_offset() const;
+
+			/// @brief Returns the scale of a device value presentation object
+			/// @returns The scale of a device value presentation object
+			float get_scale() const;
+
+			/// @brief Returns the number of decimals of a device value presentation object
+			/// @returns The number of decimals of a device value presentation object
+			std::uint8_t get_number_of_decimals() const;
+
+		private:
+			friend class DeviceDescriptorObjectPoolView;
+
+			/// @brief Constructs a handle to an object in the binary DDOP
+			/// @param[in] objectData The first byte of the object
+			/// @param[in] objectSize The number of bytes in the object
+			/// @param[in] type The type of the object
+			Object(const std::uint8_t *objectData, std::uint32_t objectSize, task_controller_object::ObjectTypes type);
+
+			/// @brief Reads a little endian 16 bit value out of the object
+			/// @param[in] offset The offset of the value from the start of the object
+			/// @returns The value
+			std::uint16_t read_uint16(std::size_t offset) const;
+
+			/// @brief Reads a little endian 32 bit value out of the object
+			/// @param[in] offset The offset of the value from the start of the object
+			/// @returns The value
+			std::uint32_t read_uint32(std::size_t offset) const;
+
+			/// @brief Returns the offset of the serial number length of a device object, which comes after two variable length fields
+			/// @returns The offset of the serial number length from the start of the object
+			std::size_t get_serial_number_length_offset() const;
+
+			const std::uint8_t *data = nullptr; ///< The first byte of the object
+			std::uint32_t size = 0; ///< The number of bytes in the object
+			task_controller_object::ObjectTypes objectType = task_controller_object::ObjectTypes::Device; ///< The type of the object
+		};
+
+		/// @brief Constructs an empty view
+		DeviceDescriptorObjectPoolView() = default;
+
+		/// @brief Checks a binary DDOP and makes the view refer to it.
+		/// @details The view doesn't copy the data, so it must outlive the view and not be changed.
+		/// If the DDOP isn't valid, the view is left empty.
+		/// @param[in] binaryPool The binary DDOP
+		/// @param[in] binaryPoolSizeBytes The number of bytes in the binary DDOP
+		/// @param[in] taskControllerServerVersion The version of TC the DDOP was made for, which decides if the device object has an extended structure label
+		/// @param[in] clientNAME The NAME of the client the DDOP came from, which must match the NAME in the device object. Leave it as 0 to skip that check.
+		/// @returns true if the DDOP is valid, otherwise false
+		bool parse(const std::uint8_t *binaryPool, std::uint32_t binaryPoolSizeBytes, std::uint8_t taskControllerServerVersion = 4, NAME clientNAME = NAME(0));
+
+		/// @brief Checks a binary DDOP and makes the view refer to it.
+		/// @details The view doesn't copy the data, so the vector must outlive the view and not be changed.
+		/// If the DDOP isn't valid, the view is left empty.
+		/// @param[in] binaryPool The binary DDOP
+		/// @param[in] taskControllerServerVersion The version of TC the DDOP was made for, which decides if the device object has an extended structure label
+		/// @param[in] clientNAME The NAME of the client the DDOP came from, which must match the NAME in the device object. Leave it as 0 to skip that check.
+		/// @returns true if the DDOP is valid, otherwise false
+		bool parse(const std::vector<std::uint8_t> &binaryPool, std::uint8_t taskControllerServerVersion = 4, NAME clientNAME = NAME(0));
+
+		/// @brief Makes the view empty
+		void clear();
+
+		/// @brief Returns the number of objects in the DDOP
+		/// @returns The number of objects in the DDOP
+		std::size_t size() const;
+
+		/// @brief Returns an object by its position in the DDOP
+		/// @param[in] index The position of the object in the DDOP
+		/// @returns The object, or a handle that doesn't refer to an object if the index is out of range
+		Object get_object_by_index(std::size_t index) const;
+
+		/// @brief Returns an object by its object ID.
+		/// If more than one object has the ID, the last one is returned, since that is the one deserializing keeps.
+		/// @param[in] objectID The object ID of the object
+		/// @returns The object, or a handle that doesn't refer to an object if there isn't one with that ID
+		Object get_object_by_id(std::uint16_t objectID) const;
+
+		/// @brief Returns the device object of the DDOP
+		/// @returns The device object, or a handle that doesn't refer to an object if the DDOP doesn't have one
+		Object get_device() const;
+
+		/// @brief Fills a DeviceDescriptorObjectPool with the objects in the view, for when the full object model is needed
+		/// @param[in,out] pool The pool to add the objects to. Its TC compatibility level is set to the version the view was parsed with.
+		/// @returns true if the objects were added to the pool, otherwise false
+		bool materialize(DeviceDescriptorObjectPool &pool) const;
+
+	private:
+		/// @brief Stores where an object is in the binary DDOP
+		struct ObjectLocation
+		{
+			std::uint32_t offset; ///< The offset of the object from the start of the binary DDOP
+			std::uint32_t size; ///< The number of bytes in the object
+			task_controller_object::ObjectTypes type; ///< The type of the object
+		};
+
+		/// @brief Checks the object at the start of some binary DDOP data and finds its size
+		/// @param[in] objectData The first byte of the object
+		/// @param[in] remainingBytes The number of bytes from the start of the object to the end of the DDOP
+		/// @param[in] taskControllerServerVersion The version of TC the DDOP was made for
+		/// @param[in,out] clientNAME The NAME the device object must have, or 0 to set it to the NAME in the device object
+		/// @param[out] location Where the object is. Only the size and type are set.
+		/// @returns true if the object is valid, otherwise false
+		static bool parse_object(const std::uint8_t *objectData, std::uint32_t remainingBytes, std::uint8_t taskControllerServerVersion, NAME &clientNAME, ObjectLocation &location);
+
+		std::vector<ObjectLocation> objectLocations; ///< Where each object is, in the order they appear in the binary DDOP
+		std::vector<std::pair<std::uint16_t, std::uint32_t>> objectIDIndices; ///< The object IDs paired with the position of their object in objectLocations, sorted by object ID
+		const std::uint8_t *binaryData = nullptr; ///< The binary DDOP the view refers to
+		std::uint32_t binaryDataSize = 0; ///< The number of bytes in the binary DDOP
+		std::size_t deviceIndex = 0; ///< The position of the device object in objectLocations, or the number of objects if there isn't one
+		NAME poolNAME = NAME(0); ///< The NAME in the device object of the DDOP
+		std::uint8_t taskControllerVersion = 4; ///< The version of TC the DDOP was made for
+	};
+} // namespace isobus
+
+#endif // ISOBUS_DEVICE_DESCRIPTOR_OBJECT_POOL_VIEW_HPP
@@ -97,6 +97,10 @@ namespace isobus
 		/// so there is no need for you to call it in your application.
 		void update();
 
+		/// @brief Returns how long until a heartbeat is due to be sent, or a tracked heartbeat times out
+		/// @returns The time until the next heartbeat deadline in milliseconds, or the largest `std::uint32_t` if there is none
+		std::uint32_t get_time_until_next_deadline_ms() const;
+
 	private:
 		/// @brief This enum is used to define special values for the sequence counter.
 		enum class SequenceCounterSpecialValue : std::uint8_t
@@ -14,8 +14,11 @@
 #include "isobus/isobus/isobus_device_descriptor_object_pool.hpp"
 #include "isobus/isobus/isobus_language_command_interface.hpp"
 #include "isobus/utility/processing_flags.hpp"
+#include "isobus/utility/timer_wheel.hpp"
 
+#include <array>
 #include <list>
+#include <map>
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 #include <thread>
 #endif
@@ -83,6 +86,24 @@ namespace isobus
 			ReservedOption3 = 0x80
 		};
 
+		/// @brief Enumerates the states of a section in the condensed work state DDIs
+		enum class SectionWorkState : std::uint8_t
+		{
+			Off = 0, ///< The section is off
+			On = 1, ///< The section is on
+			Error = 2, ///< The section's state is in error
+			NotInstalled = 3 ///< The section doesn't exist, which is the state of every section until it is set
+		};
+
+		/// @brief Metrics about the condensed work state frames sent for the sections set with set_section_work_state
+		struct SectionWorkStateMetrics
+		{
+			std::uint64_t sectionStateChanges = 0; ///< The number of times the application changed the state of a section
+			std::uint64_t framesQueued = 0; ///< The number of condensed work state values queued to be sent to the TC
+			std::uint64_t totalLatency_ms = 0; ///< The sum of how long each queued value waited since the first change it contains
+			std::uint32_t maximumLatency_ms = 0; ///< The longest any queued value waited since the first change it contains
+		};
+
 		/// @brief A callback for handling a value request command from the TC
 		using RequestValueCommandCallback = bool (*)(std::uint16_t elementNumber,
 		                                             std::uint16_t DDI,
@@ -312,6 +333,53 @@ namespace isobus
 		/// @param[in] DDI The DDI of the process data variable that changed
 		void on_value_changed_trigger(std::uint16_t elementNumber, std::uint16_t DDI);
 
+		/// @brief Tells the TC client the current value of one of your process data variables.
+		/// @details Once a value has been published for an element number and DDI, the TC client no longer
+		/// calls the request value callbacks for that variable. Time interval sends and value requests from the TC
+		/// use the last published value, and the minimum, maximum and change thresholds are only checked
+		/// on the next update after the published value changes. So keep publishing the variable every time it changes.
+		/// Publishing a value that didn't change costs next to nothing.
+		/// Variables that are never published are polled through the request value callbacks on every update.
+		/// The callbacks are called without holding the client's lock, so they can call this function too.
+		/// The values that need to be sent during an update are sent together at the end of it,
+		/// with at most one frame per variable.
+		/// @param[in] elementNumber The element number of the process data variable
+		/// @param[in] DDI The DDI of the process data variable
+		/// @param[in] value The current value of the process data variable
+		void publish_value(std::uint16_t elementNumber, std::uint16_t DDI, std::int32_t value);
+
+		/// @brief Sets the actual work state of a section, which the TC client reports in the actual condensed work state DDIs.
+		/// @details The TC client keeps the condensed work state of each element, and at each update only sends
+		/// the condensed work state DDIs whose value differs from what was last sent. A section that is switched
+		/// and switched back before the next update is never sent. Sections that are never set are reported as not installed.
+		/// The condensed values are also published with publish_value, so value requests for them don't call the request value callbacks.
+		/// @param[in] elementNumber The element number that the actual condensed work state DDIs belong to, usually the boom
+		/// @param[in] sectionIndex The index of the section, from 0 to 255
+		/// @param[in] state The section's new actual work state
+		void set_section_work_state(std::uint16_t elementNumber, std::uint8_t sectionIndex, SectionWorkState state);
+
+		/// @brief Sets the actual work state of several sections at once, starting from the first section
+		/// @param[in] elementNumber The element number that the actual condensed work state DDIs belong to, usually the boom
+		/// @param[in] states The actual work state of each section, up to 256 of them, indexed by section
+		void set_section_work_states(std::uint16_t elementNumber, const std::vector<SectionWorkState> &states);
+
+		/// @brief Sets how long the TC client waits after a section changes before it sends the changed condensed work states
+		/// @details Any other sections of the element that change within the window are sent with the first change,
+		/// which coalesces a headland where sections switch one after another into one frame per condensed DDI.
+		/// @param[in] window_ms The coalescing window in milliseconds, or 0 to send changes on the next update
+		void set_section_work_state_coalescing_window(std::uint32_t window_ms);
+
+		/// @brief Returns how long the TC client waits after a section changes before it sends the changed condensed work states
+		/// @returns The coalescing window in milliseconds
+		std::uint32_t get_section_work_state_coalescing_window() const;
+
+		/// @brief Gets the metrics of the condensed work state frames queued since startup, or since they were last reset
+		/// @param[out] metrics The metrics
+		void get_section_work_state_metrics(SectionWorkStateMetrics &metrics);
+
+		/// @brief Resets the metrics of the condensed work state frames to 0
+		void reset_section_work_state_metrics();
+
 		/// @brief Sends a broadcast request to TCs to identify themseleves.
 		/// @details Upon receipt of this message, the TC shall display, for a period of 3 s, the TC Number
 		/// @returns `true` if the message was sent, otherwise `false`
@@ -418,7 +486,7 @@ namespace isobus
 		                                                         std::uint8_t *chunkBuffer,
 		                                                         void *parentPointer);
 
-		/// @brief Clears all queued TC commands and responses
+		/// @brief Clears all queued TC commands and responses, and marks the section work states to be sent again
 		void clear_queues();
 
 		/// @brief Checks if a DDOP was provided via one of the configure functions
@@ -549,6 +617,7 @@ namespace isobus
 		                             bool reportToTCSupportsImplementSectionControl);
 
 		/// @brief Changes the internal state machine state and updates the associated timestamp
+		/// @details Disconnecting clears the queues under the client mutex, so the mutex must not be held by the caller then.
 		/// @param[in] newState The new state for the state machine
 		void set_state(StateMachineState newState);
 
@@ -566,6 +635,8 @@ namespace isobus
 
 		static constexpr std::uint32_t SIX_SECOND_TIMEOUT_MS = 6000; ///< The startup delay time defined in the standard
 		static constexpr std::uint16_t TWO_SECOND_TIMEOUT_MS = 2000; ///< Used for sending the status message to the TC
+		static constexpr std::size_t NUMBER_OF_CONDENSED_WORK_STATE_DDIS = 16; ///< The number of actual condensed work state DDIs, each with 16 sections
+		static constexpr std::uint8_t NUMBER_OF_SECTIONS_PER_CONDENSED_WORK_STATE = 16; ///< The number of sections in each condensed work state DDI
 
 	private:
 		/// @brief Stores data related to requests and commands from the TC
@@ -576,11 +647,58 @@ namespace isobus
 			/// @returns true if the ddi and element numbers of the provided objects match, otherwise false
 			bool operator==(const ProcessDataCallbackInfo &obj) const;
 			std::int32_t processDataValue; ///< The value of the value set command
-			std::int32_t lastValue; ///< Used for measurement commands to store timestamp or previous values
 			std::uint16_t elementNumber; ///< The element number for the command
 			std::uint16_t ddi; ///< The DDI for the command
 			bool ackRequested; ///< Stores if the TC used the mux that also requires a PDACK
-			bool thresholdPassed; ///< Used when the structure is being used to track measurement command thresholds to know if the threshold has been passed
+		};
+
+		/// @brief Stores the measurement commands the TC has sent for one process data variable
+		struct MeasurementTriggers
+		{
+			std::uint32_t timeInterval_ms = 0; ///< How often the TC wants the value to be sent
+			std::uint32_t lastTimeIntervalTimestamp_ms = 0; ///< When the time interval last started counting
+			std::uint32_t nextTimeIntervalTimestamp_ms = 0; ///< When the value is next due to be sent because of the time interval
+			std::int32_t minimumThreshold = 0; ///< The value is sent when it drops below this threshold
+			std::int32_t maximumThreshold = 0; ///< The value is sent when it goes above this threshold
+			std::int32_t changeThreshold = 0; ///< The value is sent when it changes by at least this much
+			std::int32_t lastValueSentOnChange = 0; ///< The value that was last sent because of the change threshold
+			std::int32_t publishedValue = 0; ///< The last value the application passed to publish_value
+			std::int32_t queuedValue = 0; ///< The value waiting to be sent at the end of the update
+			std::uint16_t elementNumber = 0; ///< The element number of the process data variable
+			std::uint16_t ddi = 0; ///< The DDI of the process data variable
+			bool hasTimeInterval = false; ///< Tells if the TC set a time interval for the value
+			bool hasMinimumThreshold = false; ///< Tells if the TC set a minimum threshold for the value
+			bool hasMaximumThreshold = false; ///< Tells if the TC set a maximum threshold for the value
+			bool hasChangeThreshold = false; ///< Tells if the TC set a change threshold for the value
+			bool minimumThresholdPassed = false; ///< Tells if the value was sent for being below the minimum threshold, and hasn't gone back above it
+			bool maximumThresholdPassed = false; ///< Tells if the value was sent for being above the maximum threshold, and hasn't gone back below it
+			bool valuePublished = false; ///< Tells if the application publishes the value, so its thresholds don't need to be polled
+			bool thresholdsPolled = false; ///< Tells if the thresholds are in the list of thresholds to poll on every update
+			bool thresholdCheckPending = false; ///< Set when the published value changes, and cleared once the thresholds have been checked against it
+			bool valueQueued = false; ///< Tells if the variable is in the list of values to send at the end of the update
+		};
+
+		/// @brief A value of a process data variable the application is asked for during an update
+		struct ApplicationValueRequest
+		{
+			std::size_t index; ///< The index of the variable's measurement triggers
+			std::uint32_t timerExpiryTime_ms; ///< The expiry time of the time interval timer the value is for
+			std::int32_t value; ///< The value the application provided
+			std::uint16_t elementNumber; ///< The element number of the process data variable
+			std::uint16_t ddi; ///< The DDI of the process data variable
+			bool timeInterval; ///< Tells if the value is sent for a time interval, otherwise it's polled to check thresholds
+			bool valueAvailable; ///< Tells if the application provided the value
+		};
+
+		/// @brief Stores the actual condensed work states of one element's sections
+		struct SectionWorkStates
+		{
+			std::array<std::uint32_t, NUMBER_OF_CONDENSED_WORK_STATE_DDIS> workStates; ///< The current condensed work state of each DDI, 2 bits per section
+			std::array<std::uint32_t, NUMBER_OF_CONDENSED_WORK_STATE_DDIS> sentWorkStates; ///< The condensed work state of each DDI that was last queued to be sent
+			std::array<std::uint32_t, NUMBER_OF_CONDENSED_WORK_STATE_DDIS> changeTimestamps_ms; ///< When each DDI first differed from what was last sent
+			std::uint32_t firstChangeTimestamp_ms = 0; ///< When the first of the element's currently changed DDIs changed, which starts the coalescing window
+			std::uint16_t changedWorkStates = 0; ///< One bit per DDI that differs from what was last sent
+			std::uint16_t elementNumber = 0; ///< The element number the DDIs belong to
 		};
 
 		/// @brief Stores a TC value command callback along with its parent pointer
@@ -613,6 +731,78 @@ namespace isobus
 			UserProvidedVector ///< Uses a vector of bytes that comprise a binary DDOP
 		};
 
+		/// @brief Returns an element's section work states, adding them if they aren't there yet
+		/// @param[in] elementNumber The element number the actual condensed work state DDIs belong to
+		/// @returns The element's section work states
+		SectionWorkStates &get_section_work_states(std::uint16_t elementNumber);
+
+		/// @brief Changes the state of one section in an element's condensed work states. The mutex must be held by the caller.
+		/// @param[in] workStates The element's section work states
+		/// @param[in] sectionIndex The index of the section
+		/// @param[in] state The section's new state
+		/// @param[in] timestamp_ms The current time
+		void update_section_work_state(SectionWorkStates &workStates, std::uint8_t sectionIndex, SectionWorkState state, std::uint32_t timestamp_ms);
+
+		/// @brief Queues the condensed work states that changed, for the elements whose coalescing window has passed
+		void process_section_work_states();
+
+		/// @brief Returns the index of a process data variable in the measurement triggers, adding it if it isn't there yet
+		/// @param[in] elementNumber The element number of the process data variable
+		/// @param[in] DDI The DDI of the process data variable
+		/// @returns The index of the variable's measurement triggers
+		std::size_t get_measurement_triggers_index(std::uint16_t elementNumber, std::uint16_t DDI);
+
+		/// @brief Stores a published value for a variable, and stops polling its thresholds
+		/// @param[in] index The index of the variable's measurement triggers
+		/// @param[in] value The value to store
+		/// @returns true if the variable wasn't published before or its value changed, otherwise false
+		bool store_published_value(std::size_t index, std::int32_t value);
+
+		/// @brief Makes sure a variable's thresholds get checked, either by polling or against its published value
+		/// @param[in] index The index of the variable's measurement triggers
+		void queue_threshold_check(std::size_t index);
+
+		/// @brief Removes the first command from one of the queues of TC commands
+		/// @param[in] queue The queue to take the command from
+		/// @param[out] command The command that was removed
+		/// @returns true if the queue had a command, otherwise false
+		bool pop_queued_command(std::list<ProcessDataCallbackInfo> &queue, ProcessDataCallbackInfo &command);
+
+		/// @brief Gets the value the application last published for a process data variable
+		/// @param[in] elementNumber The element number of the process data variable
+		/// @param[in] DDI The DDI of the process data variable
+		/// @param[out] value The published value of the process data variable
+		/// @returns true if the application publishes the variable, otherwise false
+		bool get_published_value(std::uint16_t elementNumber, std::uint16_t DDI, std::int32_t &value);
+
+		/// @brief Queues a variable's value for its time interval and schedules the next one,
+		/// or retries on the next update if no value is available
+		/// @param[in] index The index of the variable's measurement triggers
+		/// @param[in] valueAvailable Tells if there is a value to send
+		/// @param[in] value The value to send
+		void process_time_interval(std::size_t index, bool valueAvailable, std::int32_t value);
+
+		/// @brief Gets the current value of a process data variable from the request value callbacks
+		/// @details Called without holding the client mutex, using the callbacks copied at the start of the update
+		/// @param[in] elementNumber The element number of the process data variable
+		/// @param[in] DDI The DDI of the process data variable
+		/// @param[out] value The current value of the process data variable
+		/// @returns true if one of the callbacks provided the value, otherwise false
+		bool request_value_from_application(std::uint16_t elementNumber, std::uint16_t DDI, std::int32_t &value);
+
+		/// @brief Checks a variable's thresholds against its current value, and queues the value to be sent if any threshold requires it
+		/// @param[in] index The index of the variable's measurement triggers
+		/// @param[in] value The current value of the variable
+		void process_measurement_thresholds(std::size_t index, std::int32_t value);
+
+		/// @brief Queues a value to be sent to the TC at the end of the current update, replacing any value already queued for the variable
+		/// @param[in] index The index of the variable's measurement triggers
+		/// @param[in] value The value to send
+		void queue_measurement_value(std::size_t index, std::int32_t value);
+
+		/// @brief Sends the queued measurement values, keeping any that can't be sent yet for the next update
+		void send_queued_measurement_values();
+
 		std::shared_ptr<PartneredControlFunction> partnerControlFunction; ///< The partner control function this client will send to
 		std::shared_ptr<InternalControlFunction> myControlFunction; ///< The internal control function the client uses to send from
 		std::shared_ptr<PartneredControlFunction> primaryVirtualTerminal; ///< A pointer to the primary VT's control function. Used for TCs < version 4 and language command compatibility
@@ -622,12 +812,21 @@ namespace isobus
 		std::vector<std::uint8_t> generatedBinaryDDOP; ///< Stores the DDOP in binary form after it has been generated
 		std::vector<RequestValueCommandCallbackInfo> requestValueCallbacks; ///< A list of callbacks that will be called when the TC requests a process data value
 		std::vector<ValueCommandCallbackInfo> valueCommandsCallbacks; ///< A list of callbacks that will be called when the TC sets a process data value
+		std::vector<RequestValueCommandCallbackInfo> applicationRequestValueCallbacks; ///< The request value callbacks used during the current update, so they can be called without holding the mutex
+		std::vector<ValueCommandCallbackInfo> applicationValueCommandCallbacks; ///< The value command callbacks used during the current update, so they can be called without holding the mutex
+		std::vector<ApplicationValueRequest> applicationValueRequests; ///< The values the application is asked for during the current update
 		std::list<ProcessDataCallbackInfo> queuedValueRequests; ///< A list of queued value requests that will be processed on the next update
 		std::list<ProcessDataCallbackInfo> queuedValueCommands; ///< A list of queued value commands that will be processed on the next update
-		std::list<ProcessDataCallbackInfo> measurementTimeIntervalCommands; ///< A list of measurement commands that will be processed on a time interval
-		std::list<ProcessDataCallbackInfo> measurementMinimumThresholdCommands; ///< A list of measurement commands that will be processed when the value drops below a threshold
-		std::list<ProcessDataCallbackInfo> measurementMaximumThresholdCommands; ///< A list of measurement commands that will be processed when the value above a threshold
-		std::list<ProcessDataCallbackInfo> measurementOnChangeThresholdCommands; ///< A list of measurement commands that will be processed when the value changes by the specified amount
+		std::vector<MeasurementTriggers> measurementTriggers; ///< The measurement commands for each process data variable. Entries are never removed, so indices stay valid.
+		std::map<std::uint32_t, std::size_t> measurementTriggerIndices; ///< Finds a variable's index in the measurement triggers, keyed by element number in the upper 16 bits and DDI in the lower 16 bits
+		std::vector<std::size_t> polledThresholdTriggers; ///< Indices of the variables with thresholds that have to be polled, because the application doesn't publish them
+		std::vector<std::size_t> pendingThresholdTriggers; ///< Indices of the published variables whose thresholds need to be checked on the next update
+		TimerWheel measurementTimeIntervalTimers; ///< Schedules sending the variables that have a time interval, using their indices as timer IDs
+		std::vector<TimerWheel::Timer> expiredMeasurementTimers; ///< The time interval timers that expired during the current update
+		std::vector<std::size_t> queuedMeasurementValues; ///< Indices of the variables with a value to send at the end of the update, in the order they were queued
+		std::vector<SectionWorkStates> sectionWorkStates; ///< The actual condensed work states of each element that has sections
+		SectionWorkStateMetrics sectionWorkStateMetrics; ///< Metrics of the condensed work state values that were queued
+		std::uint32_t sectionWorkStateCoalescingWindow_ms = 0; ///< How long to wait after a section changes before sending the changed condensed work states
 		Mutex clientMutex; ///< A general mutex to protect data in the worker thread against data accessed by the app or the network manager
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
 		std::thread *workerThread = nullptr; ///< The worker thread that updates this interface
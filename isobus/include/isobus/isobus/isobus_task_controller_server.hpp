@@ -145,7 +145,8 @@ namespace isobus
 		/// @brief This function will be called by the server when the client wants to activate its DDOP.
 		/// You should implement this function to activate the DDOP and return whether or not it was successful.
 		/// Generally this means that you will want to parse the pool, and make sure its schema is valid at this time.
-		/// You can use our DeviceDescriptorObjectPool class to help you with this.
+		/// You can use our DeviceDescriptorObjectPool class to help you with this, or DeviceDescriptorObjectPoolView
+		/// if you only need to read the pool, which checks it and reads it without copying it into objects.
 		/// @param[in] clientControlFunction The control function which is requesting the activation.
 		/// @param[out] activationError The error code to return if the activation fails.
 		/// @param[out] objectPoolError This error code tells the client if there was an error in the DDOP.
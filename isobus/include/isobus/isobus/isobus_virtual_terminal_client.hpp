@@ -1257,6 +1257,11 @@ namespace isobus
 		/// To configure that behavior, see the initialize function.
 		void update();
 
+		/// @brief Returns how long until one of the client's timers, like the maintenance messages or the VT status timeout, needs an update
+		/// @details The worker thread uses this to update sooner than its regular interval when needed.
+		/// @returns The time until the next timer expires in milliseconds, or the largest `std::uint32_t` if no timer is running
+		std::uint32_t get_time_until_next_deadline_ms() const;
+
 		/// @brief Used to determine the language and unit systems in use by the VT server
 		LanguageCommandInterface languageCommandInterface;
 
@@ -1310,7 +1315,6 @@ namespace isobus
 		{
 			const std::uint8_t *objectPoolDataPointer; ///< A pointer to an object pool
 			const std::vector<std::uint8_t> *objectPoolVectorPointer; ///< A pointer to an object pool (vector format)
-			std::vector<std::uint8_t> scaledObjectPool; ///< Stores a copy of a pool to auto-scale in RAM before uploading it
 			DataChunkCallback dataCallback; ///< A callback used to get data in chunks as an alternative to loading the whole pool at once
 			std::string versionLabel; ///< An optional version label that will be used to load/store the pool to the VT. 7 character max!
 			std::uint32_t objectPoolSize; ///< The size of the object pool
@@ -1508,13 +1512,32 @@ namespace isobus
 		                                                         std::uint8_t *chunkBuffer,
 		                                                         void *parentPointer);
 
-		/// @brief Returns if any object pool had scaling configured
-		/// @returns true if any pool has both data mask and softkey scaling configured
-		bool get_any_pool_needs_scaling() const;
-
-		/// @brief Iterates through each object pool and scales each object in the pool automatically
-		/// @returns true if all object pools scaled with no error
-		bool scale_object_pools();
+		/// @brief Copies object pool data into a buffer from whichever source the pool was supplied with
+		/// @param[in] poolIndex The index of the object pool to read from
+		/// @param[in] callbackIndex The callback index to pass on to the pool's data chunk callback, if it has one
+		/// @param[in] poolOffset The offset into the object pool to start reading at
+		/// @param[in] numberOfBytes The number of bytes to read
+		/// @param[out] destination The buffer to copy the data into
+		/// @returns true if the data was read, otherwise false
+		bool read_object_pool_data(std::uint32_t poolIndex, std::uint32_t callbackIndex, std::uint32_t poolOffset, std::uint32_t numberOfBytes, std::uint8_t *destination);
+
+		/// @brief Copies auto-scaled object pool data into a buffer, scaling each object when the upload reaches it.
+		/// @details Only the object that the upload is currently in is kept in RAM, and only the part of it
+		/// that scaling can change. Everything else is read from the pool's source as it is needed.
+		/// @param[in] poolIndex The index of the object pool to read from
+		/// @param[in] callbackIndex The callback index to pass on to the pool's data chunk callback, if it has one
+		/// @param[in] poolOffset The offset into the object pool to start reading at
+		/// @param[in] numberOfBytes The number of bytes to read
+		/// @param[out] destination The buffer to copy the scaled data into
+		/// @returns true if the data was read and scaled, otherwise false
+		bool read_scaled_object_pool_data(std::uint32_t poolIndex, std::uint32_t callbackIndex, std::uint32_t poolOffset, std::uint32_t numberOfBytes, std::uint8_t *destination);
+
+		/// @brief Reads the object at an offset into an object pool into the scaling buffer, and scales it
+		/// @param[in] poolIndex The index of the object pool to read from
+		/// @param[in] callbackIndex The callback index to pass on to the pool's data chunk callback, if it has one
+		/// @param[in] objectOffset The offset into the object pool where the object starts
+		/// @returns true if the object was read and scaled, otherwise false
+		bool load_scaled_object(std::uint32_t poolIndex, std::uint32_t callbackIndex, std::uint32_t objectOffset);
 
 		/// @brief Returns if the specified object type can be scaled
 		/// @param[in] type The object type to check
@@ -1678,6 +1701,10 @@ namespace isobus
 		// Object Pool info
 		DataChunkCallback objectPoolDataCallback = nullptr; ///< The callback to use to get pool data
 		std::uint32_t lastObjectPoolIndex = 0; ///< The last object pool index that was processed
+		std::vector<std::uint8_t> scaledObjectBuffer; ///< The scaled bytes of the object that the pool upload is currently in
+		std::uint32_t scaledObjectOffset = 0; ///< The offset into the object pool of the object in the scaling buffer
+		std::uint32_t scaledObjectLength = 0; ///< The total length of the object in the scaling buffer, or 0 if there isn't one
+		bool objectPoolScalingFailed = false; ///< Tells if an object pool upload failed because an object in it couldn't be scaled
 	};
 
 } // namespace isobus
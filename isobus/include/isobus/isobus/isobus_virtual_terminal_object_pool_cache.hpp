@@ -0,0 +1,137 @@
+//================================================================================================
+/// @file isobus_virtual_terminal_object_pool_cache.hpp
+///
+/// @brief Defines a cache of parsed VT object pools, keyed by the content of their IOP data.
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#ifndef ISOBUS_VIRTUAL_TERMINAL_OBJECT_POOL_CACHE_HPP
+#define ISOBUS_VIRTUAL_TERMINAL_OBJECT_POOL_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace isobus
+{
+	class VTObject;
+
+	//================================================================================================
+	/// @class VTObjectPoolCache
+	///
+	/// @brief Keeps unmodified copies of the objects parsed from blocks of IOP data, so that a VT server
+	/// can skip parsing when it receives the same IOP data again.
+	/// @details Entries are keyed by a 64 bit FNV-1a hash of the IOP data and also keep the data itself,
+	/// so a hash collision can never hand out the wrong objects. The most common hit is a working set
+	/// that reconnects and sends a Load Version command for a pool the server has already seen,
+	/// either because it was parsed before or because it was stored with Store Version.
+	/// Objects in the cache are never given out directly, because working sets change their objects
+	/// at runtime. Every hit returns new copies instead. Copying is much cheaper than parsing objects
+	/// like picture graphics, but costs about the same as parsing small objects, since both are mostly
+	/// memory allocation. So objects are only kept if their IOP data averages at least a minimum number
+	/// of bytes per object, which is 32 by default. Above that, copying a pool measured at less than a quarter
+	/// of the time parsing it took, while pools of tiny objects gained little or nothing from the cache.
+	/// The rule only depends on the IOP data, so every server keeps the same pools no matter how fast it is.
+	/// The cache is in memory only. Persisting pools is still up to the server application's
+	/// save_version and load_version implementations.
+	//================================================================================================
+	class VTObjectPoolCache
+	{
+	public:
+		/// @brief Constructs an empty cache
+		VTObjectPoolCache() = default;
+
+		/// @brief Computes the content hash used to key the cache
+		/// @param[in] data The data to hash
+		/// @param[in] length The number of bytes of data to hash
+		/// @param[in] hash The hash of any data that came before this data, which allows hashing data in pieces
+		/// @returns The 64 bit FNV-1a hash of the data
+		static std::uint64_t get_content_hash(const std::uint8_t *data, std::size_t length, std::uint64_t hash = 0xCBF29CE484222325);
+
+		/// @brief Returns copies of the objects that were parsed from some IOP data, if the cache has them
+		/// @param[in] iopData The IOP data to look up
+		/// @param[out] objects Copies of the cached objects, in the order they appear in the IOP data
+		/// @returns true if the IOP data was in the cache, otherwise false
+		bool get_objects(const std::vector<std::uint8_t> &iopData, std::vector<std::shared_ptr<VTObject>> &objects);
+
+		/// @brief Adds the objects parsed from some IOP data to the cache
+		/// @details The objects are copied, so the caller is free to modify the ones it passed in.
+		/// @param[in] iopData The IOP data the objects were parsed from
+		/// @param[in] objects The objects parsed from the IOP data, in the order they appear in the IOP data
+		/// @returns true if the objects were added to the cache, otherwise false
+		bool add_objects(const std::vector<std::uint8_t> &iopData, const std::vector<std::shared_ptr<VTObject>> &objects);
+
+		/// @brief Adds an entry for several blocks of IOP data joined end to end, made from their existing entries.
+		/// @details This is how a stored version is cached: the server application is asked to
+		/// append each IOP file of the pool into one, so that is what Load Version will return later.
+		/// @param[in] iopFiles The blocks of IOP data, in the order they were received
+		/// @returns true if every block was already in the cache and the joined entry was added, otherwise false
+		bool add_joined_objects(const std::vector<std::vector<std::uint8_t>> &iopFiles);
+
+		/// @brief Sets how many bytes of IOP data the cache may hold before it drops the least recently used entries
+		/// @param[in] value The maximum number of bytes of IOP data to keep in the cache
+		void set_maximum_cached_bytes(std::size_t value);
+
+		/// @brief Returns how many bytes of IOP data the cache may hold
+		/// @returns The maximum number of bytes of IOP data to keep in the cache
+		std::size_t get_maximum_cached_bytes() const;
+
+		/// @brief Sets how many bytes of IOP data each object must average for the cache to keep a pool's objects
+		/// @param[in] value The minimum average number of bytes of IOP data per object, or 0 to keep every pool
+		void set_minimum_bytes_per_cached_object(std::size_t value);
+
+		/// @brief Returns how many bytes of IOP data each object must average for the cache to keep a pool's objects
+		/// @returns The minimum average number of bytes of IOP data per object
+		std::size_t get_minimum_bytes_per_cached_object() const;
+
+		/// @brief Returns the number of blocks of IOP data in the cache
+		/// @returns The number of blocks of IOP data in the cache
+		std::size_t size() const;
+
+		/// @brief Removes every entry from the cache
+		void clear();
+
+	private:
+		/// @brief Stores the objects parsed from one block of IOP data
+		struct Entry
+		{
+			std::vector<std::uint8_t> iopData; ///< The IOP data the objects were parsed from
+			std::vector<std::shared_ptr<VTObject>> objects; ///< Unmodified objects in the order they appear in the IOP data
+			std::uint64_t lastUsed = 0; ///< The value of the use counter when the entry was last added or returned
+		};
+
+		static constexpr std::size_t DEFAULT_MINIMUM_BYTES_PER_CACHED_OBJECT = 32; ///< The default number of bytes of IOP data each object must average for the cache to keep them
+		static constexpr std::size_t DEFAULT_MAXIMUM_CACHED_BYTES = 16 * 1024 * 1024; ///< The default amount of IOP data to keep in the cache
+
+		/// @brief Returns a new copy of a VT object
+		/// @param[in] object The object to copy
+		/// @returns A copy of the object, or an empty shared pointer if the object type can't be copied
+		static std::shared_ptr<VTObject> copy_object(const VTObject &object);
+
+		/// @brief Finds the entry for some IOP data. The mutex must be held by the caller.
+		/// @param[in] iopData The IOP data to look up
+		/// @param[in] hash The content hash of the IOP data
+		/// @returns An iterator to the entry, or the end of the entries if there isn't one
+		std::multimap<std::uint64_t, Entry>::iterator find_entry(const std::vector<std::uint8_t> &iopData, std::uint64_t hash);
+
+		/// @brief Adds an entry and drops old entries until the cache fits in its size limit. The mutex must be held by the caller.
+		/// @param[in] hash The content hash of the entry's IOP data
+		/// @param[in] entry The entry to add
+		void insert_entry(std::uint64_t hash, Entry &&entry);
+
+		/// @brief Drops the least recently used entries until the cache fits in its size limit. The mutex must be held by the caller.
+		void remove_least_recently_used_entries();
+
+		mutable std::mutex cacheMutex; ///< Protects the cache, which is shared by the parsing threads of every working set
+		std::multimap<std::uint64_t, Entry> entries; ///< The cached entries, keyed by the content hash of their IOP data
+		std::size_t cachedBytes = 0; ///< The number of bytes of IOP data held by the entries
+		std::size_t maximumCachedBytes = DEFAULT_MAXIMUM_CACHED_BYTES; ///< The most bytes of IOP data the entries may hold
+		std::size_t minimumBytesPerCachedObject = DEFAULT_MINIMUM_BYTES_PER_CACHED_OBJECT; ///< The fewest bytes of IOP data each object must average for the entries to keep them
+		std::uint64_t useCounter = 0; ///< Counts uses of the cache, to find the least recently used entry
+	};
+} // namespace isobus
+
+#endif // ISOBUS_VIRTUAL_TERMINAL_OBJECT_POOL_CACHE_HPP
@@ -0,0 +1,119 @@
+//================================================================================================
+/// @file isobus_virtual_terminal_object_table.hpp
+///
+/// @brief Defines a table that stores a VT object pool indexed directly by object ID.
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#ifndef ISOBUS_VIRTUAL_TERMINAL_OBJECT_TABLE_HPP
+#define ISOBUS_VIRTUAL_TERMINAL_OBJECT_TABLE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+
+namespace isobus
+{
+	class VTObject;
+
+	//================================================================================================
+	/// @class VTObjectTable
+	///
+	/// @brief Stores the objects of a VT object pool, indexed directly by their 16 bit object ID.
+	/// @details The table is split into pages of 256 object IDs, which are only allocated once an
+	/// object in their range is added. Looking up an object is two array indexing operations
+	/// regardless of how many objects are in the pool, which matters for a VT server where most
+	/// commands look up several objects by ID.
+	/// A table can be constructed from a map of objects so that code which still keeps
+	/// an object pool in a map can call functions that take a table, at the cost of a copy.
+	//================================================================================================
+	class VTObjectTable
+	{
+	public:
+		/// @brief Constructs an empty table
+		VTObjectTable() = default;
+
+		/// @brief Constructs a table that holds the same objects as a map keyed by object ID
+		/// @param[in] objects The objects to put in the table
+		VTObjectTable(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objects);
+
+		/// @brief Move constructor
+		VTObjectTable(VTObjectTable &&) = default;
+
+		/// @brief Move assignment operator
+		/// @returns A reference to this table
+		VTObjectTable &operator=(VTObjectTable &&) = default;
+
+		/// @brief Returns an object by its object ID
+		/// @param[in] objectID The ID of the object to look up
+		/// @returns The object with the specified ID, or an empty shared pointer if there isn't one
+		std::shared_ptr<VTObject> get_object_by_id(std::uint16_t objectID) const
+		{
+			const auto &page = pages[objectID / PAGE_SIZE];
+			return (nullptr != page) ? (*page)[objectID % PAGE_SIZE] : nullptr;
+		}
+
+		/// @brief Checks if the table contains an object with the specified ID
+		/// @param[in] objectID The object ID to check for
+		/// @returns true if the table contains an object with the specified ID
+		bool get_object_id_exists(std::uint16_t objectID) const
+		{
+			const auto &page = pages[objectID / PAGE_SIZE];
+			return (nullptr != page) && (nullptr != (*page)[objectID % PAGE_SIZE]);
+		}
+
+		/// @brief Adds an object to the table, replacing any object that already has the same ID
+		/// @param[in] objectToAdd The object to add
+		/// @returns true if the object was added or replaced, otherwise false
+		bool add_or_replace_object(std::shared_ptr<VTObject> objectToAdd);
+
+		/// @brief Removes an object from the table
+		/// @param[in] objectID The ID of the object to remove
+		/// @returns true if an object was removed, otherwise false
+		bool remove_object(std::uint16_t objectID);
+
+		/// @brief Removes every object from the table
+		void clear();
+
+		/// @brief Returns the number of objects in the table
+		/// @returns The number of objects in the table
+		std::size_t size() const;
+
+		/// @brief Calls a function for every object in the table, in order of object ID
+		/// @param[in] function The function to call with each object
+		template<typename Function>
+		void for_each_object(Function function) const
+		{
+			for (const auto &page : pages)
+			{
+				if (nullptr != page)
+				{
+					for (const auto &object : *page)
+					{
+						if (nullptr != object)
+						{
+							function(object);
+						}
+					}
+				}
+			}
+		}
+
+		/// @brief Returns a map keyed by object ID that holds the same objects as the table
+		/// @returns A map that holds the same objects as the table
+		std::map<std::uint16_t, std::shared_ptr<VTObject>> to_map() const;
+
+	private:
+		static constexpr std::size_t PAGE_SIZE = 256; ///< The number of object IDs in each page of the table
+		static constexpr std::size_t NUMBER_OF_PAGES = 256; ///< The number of pages it takes to cover every 16 bit object ID
+
+		using Page = std::array<std::shared_ptr<VTObject>, PAGE_SIZE>; ///< A page of objects indexed by the low byte of their ID
+
+		std::array<std::unique_ptr<Page>, NUMBER_OF_PAGES> pages; ///< The pages of the table indexed by the high byte of the object ID
+		std::size_t numberOfObjects = 0; ///< The number of objects in the table
+	};
+} // namespace isobus
+
+#endif // ISOBUS_VIRTUAL_TERMINAL_OBJECT_TABLE_HPP
@@ -10,6 +10,7 @@
 #define ISOBUS_VIRTUAL_TERMINAL_OBJECTS_HPP
 
 #include "isobus/isobus/can_constants.hpp"
+#include "isobus/isobus/isobus_virtual_terminal_object_table.hpp"
 
 #include <algorithm>
 #include <array>
@@ -22,6 +23,7 @@
 namespace isobus
 {
 	class VirtualTerminalServerManagedWorkingSet;
+	class ColourMap;
 
 	/// @brief The types of objects in an object pool by object type byte value
 	enum class VirtualTerminalObjectType : std::uint8_t
@@ -210,19 +212,19 @@ namespace isobus
 		virtual std::uint32_t get_minumum_object_length() const = 0;
 
 		/// @brief Performs basic error checking on the object and returns if the object is valid
-		/// @param[in] objectPool A map of all objects in the current object pool, keyed by their object ID
+		/// @param[in] objectPool A table of all objects in the current object pool, indexed by their object ID
 		/// @returns `true` if the object passed basic error checks
-		virtual bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const = 0;
+		virtual bool get_is_valid(const VTObjectTable &objectPool) const = 0;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
 		/// @param[in] rawAttributeData The raw data to change the attribute to, as decoded in little endian format with unused
 		/// bytes/bits set to zero.
-		/// @param[in] objectPool A map of all objects in the current object pool, keyed by their object ID. Used to validate some object references.
+		/// @param[in] objectPool A table of all objects in the current object pool, indexed by their object ID. Used to validate some object references.
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		virtual bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) = 0;
+		virtual bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) = 0;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -336,7 +338,7 @@ namespace isobus
 		/// @param[in] objectID The object ID to search for
 		/// @param[in] objectPool The object pool to search in
 		/// @returns The object with the corresponding ID
-		static std::shared_ptr<VTObject> get_object_by_id(std::uint16_t objectID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool);
+		static std::shared_ptr<VTObject> get_object_by_id(std::uint16_t objectID, const VTObjectTable &objectPool);
 
 	protected:
 		/// @brief Storage for child object data
@@ -418,7 +420,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating this object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -428,7 +430,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -494,7 +496,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -504,7 +506,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -519,7 +521,7 @@ namespace isobus
 		/// @param[in] newMaskID The object ID of the new soft key mask to associate with this data mask
 		/// @param[in] objectPool The object pool to use when validating the objects affected by setting this attribute
 		/// @returns True if the mask was changed, false if the new ID was not valid and the mask was not changed
-		bool change_soft_key_mask(std::uint16_t newMaskID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool);
+		bool change_soft_key_mask(std::uint16_t newMaskID, const VTObjectTable &objectPool);
 
 		/// @brief Changes the soft key mask associated to this data mask to a new object ID, but
 		/// does no checking on the validity of the new object ID.
@@ -587,7 +589,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -597,7 +599,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -632,7 +634,7 @@ namespace isobus
 		/// @param[in] newMaskID The object ID of the new soft key mask to associate with this data mask
 		/// @param[in] objectPool The object pool to use when validating the objects affected by setting this attribute
 		/// @returns True if the mask was changed, false if the new ID was not valid and the mask was not changed
-		bool change_soft_key_mask(std::uint16_t newMaskID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool);
+		bool change_soft_key_mask(std::uint16_t newMaskID, const VTObjectTable &objectPool);
 
 		/// @brief Changes the soft key mask associated to this alarm mask to a new object ID, but
 		/// does no checking on the validity of the new object ID.
@@ -686,7 +688,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -696,7 +698,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -754,7 +756,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -764,7 +766,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -811,7 +813,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -821,7 +823,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -884,7 +886,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -894,7 +896,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -943,7 +945,7 @@ namespace isobus
 		/// @param[in] nameIDToValidate The name's object ID to validate
 		/// @param[in] objectPool The object pool to use when validating the name object
 		/// @returns True if the name ID is valid for this object, otherwise false
-		bool validate_name(std::uint16_t nameIDToValidate, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const;
+		bool validate_name(std::uint16_t nameIDToValidate, const VTObjectTable &objectPool) const;
 
 		static constexpr std::uint32_t MIN_OBJECT_LENGTH = 10; ///< The fewest bytes of IOP data that can represent this object
 
@@ -1003,7 +1005,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1013,7 +1015,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1097,7 +1099,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1107,7 +1109,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1267,7 +1269,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1277,7 +1279,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1460,7 +1462,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1470,7 +1472,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1594,7 +1596,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1604,7 +1606,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1633,7 +1635,7 @@ namespace isobus
 		/// @param[in] newListItem The object ID to use as the new list item at the specified index
 		/// @param[in] objectPool The object pool to use to look up the object ID
 		/// @returns True if the operation was successful, otherwise false (perhaps the index is out of bounds?)
-		bool change_list_item(std::uint8_t index, std::uint16_t newListItem, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool);
+		bool change_list_item(std::uint8_t index, std::uint16_t newListItem, const VTObjectTable &objectPool);
 
 	private:
 		static constexpr std::uint32_t MIN_OBJECT_LENGTH = 13; ///< The fewest bytes of IOP data that can represent this object
@@ -1678,7 +1680,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1688,7 +1690,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1768,7 +1770,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1778,7 +1780,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1826,7 +1828,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1836,7 +1838,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1851,7 +1853,7 @@ namespace isobus
 		/// @param[in] newListItem The object ID to use as the new list item at the specified index
 		/// @param[in] objectPool The object pool to use to look up the object ID
 		/// @returns True if the operation was successful, otherwise false (perhaps the index is out of bounds?)
-		bool change_list_item(std::uint8_t index, std::uint16_t newListItem, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool);
+		bool change_list_item(std::uint8_t index, std::uint16_t newListItem, const VTObjectTable &objectPool);
 
 	private:
 		static constexpr std::uint32_t MIN_OBJECT_LENGTH = 12; ///< The fewest bytes of IOP data that can represent this object
@@ -1898,7 +1900,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -1908,7 +1910,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -1991,7 +1993,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2001,7 +2003,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2093,7 +2095,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2103,7 +2105,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2223,7 +2225,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2233,7 +2235,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2350,7 +2352,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2360,7 +2362,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2528,7 +2530,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2538,7 +2540,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2699,7 +2701,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2709,7 +2711,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2889,7 +2891,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -2899,7 +2901,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -2922,6 +2924,25 @@ namespace isobus
 		/// @param[in] dataByte One byte of bitmap data
 		void add_raw_data(std::uint8_t dataByte);
 
+		/// @brief Sets the underlying bitmap from raw data in the format it has in IOP data.
+		/// @details The data is expanded to one VT colour index per pixel based on the object's format and
+		/// run length encoding option, so those and the actual width and height must be set first.
+		/// Each line of the picture starts on a new byte, so unused bits at the end of a line are skipped.
+		/// Pixels past the actual width times the actual height are ignored.
+		/// @param[in] data Pointer to the raw data
+		/// @param[in] size The number of bytes of raw data
+		/// @returns true if the data was expanded, false if it is run length encoded with an odd number of bytes
+		bool decode_raw_data(const std::uint8_t *data, std::uint32_t size);
+
+		/// @brief Returns the underlying bitmap converted to 8 bit per channel RGBA pixels, line by line.
+		/// @details The converted bitmap is kept in the object, and is only converted again when the bitmap,
+		/// the transparency settings, or the colours it is drawn with have changed since the last call.
+		/// When the transparent option is set, pixels of the transparency colour get an alpha of 0.
+		/// @param[in] colourTable The colour table of the working set that owns this object
+		/// @param[in] colourMap The working set's active colour map, or nullptr if it doesn't have one
+		/// @returns The converted bitmap, 4 bytes per pixel in red, green, blue, alpha order
+		const std::vector<std::uint8_t> &get_rgba_data(const VTColourTable &colourTable, const ColourMap *colourMap = nullptr);
+
 		/// @brief Returns the number of bytes in the raw data that comprises the underlying bitmap
 		/// @returns The number of bytes in the raw data that comprises the underlying bitmap
 		std::uint32_t get_number_of_bytes_in_raw_data() const;
@@ -2980,12 +3001,15 @@ namespace isobus
 		static constexpr std::uint32_t MIN_OBJECT_LENGTH = 17; ///< The fewest bytes of IOP data that can represent this object
 
 		std::vector<std::uint8_t> rawData; ///< The raw picture data. Not a standard bitmap, but rather indicies into the VT colour table.
+		std::vector<std::uint8_t> rgbaData; ///< The raw picture data converted to RGBA pixels by the last call to get_rgba_data
+		std::vector<std::uint32_t> rgbaPalette; ///< The RGBA value of each VT colour index used to convert the RGBA pixels
 		std::uint32_t numberOfBytesInRawData = 0; ///< Number of bytes of raw data
 		std::uint16_t actualWidth = 0; ///< The actual width of the bitmap
 		std::uint16_t actualHeight = 0; ///< The actual height of the bitmap
 		std::uint8_t formatByte = 0; ///< The format option byte
 		std::uint8_t optionsBitfield = 0; ///< Options bitfield, see the `options` enum
 		std::uint8_t transparencyColour = 0; ///< The colour to render as transparent if so set in the options
+		bool rgbaDataValid = false; ///< Tells if the RGBA pixels still match the raw picture data
 	};
 
 	/// @brief A number variable holds a 32-bit unsigned integer value
@@ -3019,7 +3043,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3029,7 +3053,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3083,7 +3107,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3093,7 +3117,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3200,7 +3224,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3210,7 +3234,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3312,7 +3336,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3322,7 +3346,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3388,7 +3412,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3398,7 +3422,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3470,7 +3494,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3480,7 +3504,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3553,7 +3577,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3563,7 +3587,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3636,7 +3660,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3646,7 +3670,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3704,7 +3728,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3714,7 +3738,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3833,7 +3857,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3843,7 +3867,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -3917,7 +3941,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -3927,7 +3951,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4027,7 +4051,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4037,7 +4061,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4148,7 +4172,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4158,7 +4182,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4244,7 +4268,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4254,7 +4278,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4327,7 +4351,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4337,7 +4361,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4413,7 +4437,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4423,7 +4447,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -4489,7 +4513,7 @@ namespace isobus
 		/// @brief Performs basic error checking on the object and returns if the object is valid
 		/// @param[in] objectPool The object pool to use when validating the object
 		/// @returns `true` if the object passed basic error checks
-		bool get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const override;
+		bool get_is_valid(const VTObjectTable &objectPool) const override;
 
 		/// @brief Sets an attribute and optionally returns an error code in the last parameter
 		/// @param[in] attributeID The ID of the attribute to change
@@ -4499,7 +4523,7 @@ namespace isobus
 		/// @param[out] returnedError If this function returns false, this will be the error code. If the function
 		/// returns true, this value is undefined.
 		/// @returns True if the attribute was changed, otherwise false (check the returnedError in this case to know why).
-		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError) override;
+		bool set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError) override;
 
 		/// @brief Gets an attribute and returns the raw data in the last parameter
 		/// @param[in] attributeID The ID of the attribute to get
@@ -282,6 +282,12 @@ namespace isobus
 		/// @returns The language command interface for the server
 		LanguageCommandInterface &get_language_command_interface();
 
+		/// @brief Returns the cache of parsed object pools that the server's working sets share.
+		/// The cache lets a working set that loads a version the server has already parsed, or that was
+		/// stored while the server was running, skip parsing it again. You can use this to limit its size or clear it.
+		/// @returns The cache of parsed object pools
+		VTObjectPoolCache &get_object_pool_cache();
+
 	protected:
 		/// @brief Enumerates the bit indices of the error fields that can be set in a change active mask response
 		enum class ChangeActiveMaskErrorBit : std::uint8_t
@@ -760,6 +766,7 @@ namespace isobus
 		EventDispatcher<std::shared_ptr<VirtualTerminalServerManagedWorkingSet>, std::uint16_t, std::uint16_t> onChangeActiveSoftKeyMaskEventDispatcher; ///< Event dispatcher for active softkey mask change events
 		EventDispatcher<std::shared_ptr<VirtualTerminalServerManagedWorkingSet>, std::uint16_t, bool> onFocusObjectEventDispatcher; ///< Event dispatcher for focus object events
 		LanguageCommandInterface languageCommandInterface; ///< The language command interface for the server
+		std::shared_ptr<VTObjectPoolCache> objectPoolCache; ///< Parsed object pools shared by all managed working sets
 		std::shared_ptr<InternalControlFunction> serverInternalControlFunction; ///< The internal control function for the server
 		std::vector<std::shared_ptr<VirtualTerminalServerManagedWorkingSet>> managedWorkingSetList; ///< The list of managed working sets
 		std::map<std::shared_ptr<VirtualTerminalServerManagedWorkingSet>, bool> managedWorkingSetIopLoadStateMap; ///< A map to hold the IOP load state per session
@@ -16,6 +16,7 @@
 
 #include "isobus/isobus/can_badge.hpp"
 #include "isobus/isobus/can_control_function.hpp"
+#include "isobus/isobus/isobus_virtual_terminal_object_pool_cache.hpp"
 #include "isobus/isobus/isobus_virtual_terminal_objects.hpp"
 #include "isobus/isobus/isobus_virtual_terminal_working_set_base.hpp"
 #include "isobus/utility/event_dispatcher.hpp"
@@ -129,6 +130,16 @@ namespace isobus
 		/// @returns state of the IOP loading in percentage (0-100.0). Returns 0 if the IOP size is not set.
 		float iop_load_percentage() const;
 
+		/// @brief Sets the cache of parsed object pools this working set uses to avoid parsing
+		/// IOP data the server has parsed before, for example when a working set reconnects and loads a stored version.
+		/// @param[in] cache The cache to use, or an empty shared pointer to always parse the IOP data
+		void set_object_pool_cache(std::shared_ptr<VTObjectPoolCache> cache);
+
+		/// @brief Adds this working set's IOP files to the object pool cache, joined the same way
+		/// the server application stores them, so that loading the stored version later won't need parsing.
+		/// @returns true if the stored version was added to the cache, otherwise false
+		bool add_stored_version_to_object_pool_cache();
+
 		/// @brief Function to check the IOP loading state
 		/// @returns returns true if the IOP size is known but the transfer is not finished
 		bool is_object_pool_transfer_in_progress() const;
@@ -144,6 +155,8 @@ namespace isobus
 		std::unique_ptr<std::thread> objectPoolProcessingThread = nullptr; ///< A thread to process the object pool with, since that can be fairly time consuming.
 		std::shared_ptr<ControlFunction> workingSetControlFunction = nullptr; ///< Stores the control function associated with this working set
 		std::vector<isobus::EventCallbackHandle> callbackHandles; ///< A convenient way to associate callback handles to a working set
+		std::shared_ptr<VTObjectPoolCache> objectPoolCache = nullptr; ///< A cache of parsed object pools shared with the server's other working sets
+		std::size_t numberOfProcessedIopFiles = 0; ///< The number of IOP files that have already been parsed into the object pool
 		ObjectPoolProcessingThreadState processingState = ObjectPoolProcessingThreadState::None; ///< Stores the state of processing the object pool
 		std::uint32_t workingSetMaintenanceMessageTimestamp_ms = 0; ///< A timestamp (in ms) to track sending of the maintenance message
 		std::uint32_t auxiliaryInputMaintenanceMessageTimestamp_ms = 0; ///< A timestamp (in ms) to track if/when the working set sent an auxiliary input maintenance message
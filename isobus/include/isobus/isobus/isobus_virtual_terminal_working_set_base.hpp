@@ -12,6 +12,8 @@
 
 #include "isobus/isobus/isobus_virtual_terminal_objects.hpp"
 
+#include <atomic>
+#include <initializer_list>
 #include <mutex>
 
 namespace isobus
@@ -32,7 +34,13 @@ namespace isobus
 		/// @returns A colour from this working set's current colour table, by index
 		VTColourVector get_colour(std::uint8_t colourIndex) const;
 
-		/// @brief Returns the working set's object tree
+		/// @brief Returns the working set's objects, indexed by object ID
+		/// @returns The working set's objects, indexed by object ID
+		const VTObjectTable &get_object_table() const;
+
+		/// @brief Returns the working set's object tree as a map keyed by object ID.
+		/// @details The map is a copy of the object table that is rebuilt the first time
+		/// this is called after the object pool changes. Prefer get_object_table for lookups.
 		/// @returns The working set's object tree
 		const std::map<std::uint16_t, std::shared_ptr<VTObject>> &get_object_tree() const;
 
@@ -75,6 +83,27 @@ namespace isobus
 		/// @returns true if an object was parsed
 		bool parse_next_object(std::uint8_t *&iopData, std::uint32_t &iopLength);
 
+		/// @brief Takes a raw block of IOP data, parses it into VT objects, and also returns the objects that were parsed
+		/// @param[in] iopData A pointer to the raw IOP data
+		/// @param[in] iopLength The length of the raw IOP data
+		/// @param[out] parsedObjects The objects parsed from the IOP data, in the order they appear in it
+		/// @returns true if the IOP data was parsed successfully, otherwise false
+		bool parse_iop_into_objects(std::uint8_t *iopData, std::uint32_t iopLength, std::vector<std::shared_ptr<VTObject>> &parsedObjects);
+
+		/// @brief Adds constructed objects to the object table in pool order
+		/// @param[in] parsedObjects The constructed objects, in pool order
+		/// @param[in] numberOfObjects The number of objects at the start of parsedObjects to add
+		/// @returns The number of objects that were accepted, which is less than numberOfObjects if a second working set object was found
+		std::size_t add_parsed_objects(const std::vector<std::shared_ptr<VTObject>> &parsedObjects, std::size_t numberOfObjects);
+
+		/// @brief Parses one object in the remaining object pool data without adding it to the object tree.
+		/// This only reads the IOP data, so it may be called from several threads at once.
+		/// @param[in,out] iopData A pointer to some object pool data
+		/// @param[in,out] iopLength The number of bytes remaining in the object pool
+		/// @param[out] parsedObject The object that was parsed, if parsing succeeded
+		/// @returns true if an object was parsed
+		bool parse_object(std::uint8_t *&iopData, std::uint32_t &iopLength, std::shared_ptr<VTObject> &parsedObject) const;
+
 		/// @brief Checks if the object pool contains an object with the supplied object ID
 		/// @param[in] objectID The object ID to check for in the object pool
 		/// @returns true if an object with the specified ID exists in the object pool
@@ -105,10 +134,62 @@ namespace isobus
 		VTColourTable workingSetColourTable; ///< This working set's colour table
 		std::uint32_t iopSize = 0; ///< Total size of the IOP in bytes
 		std::uint32_t transferredIopSize = 0; ///< Total number of IOP bytes transferred
-		std::map<std::uint16_t, std::shared_ptr<VTObject>> vtObjectTree; ///< The C++ object representation (deserialized) of the object pool being managed
+		VTObjectTable vtObjectTable; ///< The C++ object representation (deserialized) of the object pool being managed
 		std::vector<std::vector<std::uint8_t>> iopFilesRawData; ///< Raw IOP File data from the client
 		std::uint16_t workingSetID = NULL_OBJECT_ID; ///< Stores the object ID of the working set object itself
 		std::uint16_t faultingObjectID = NULL_OBJECT_ID; ///< Stores the faulting object ID to send to a client when parsing the pool fails
+
+	private:
+		/// @brief Stores where one object is located in a block of IOP data
+		struct IopObjectLocation
+		{
+			std::uint32_t offset; ///< The offset of the object's first byte from the start of the IOP data
+			std::uint32_t length; ///< The number of bytes the object occupies in the IOP data
+		};
+
+		static constexpr std::size_t PARSE_BLOCK_SIZE = 64; ///< The number of scanned objects a parsing thread constructs before taking more work
+		static constexpr std::size_t MINIMUM_OBJECTS_PER_PARSING_THREAD = 512; ///< The fewest scanned objects that are worth starting another parsing thread for
+
+		/// @brief Returns the number of bytes the object at the start of some IOP data occupies, without constructing it
+		/// @param[in] iopData A pointer to the start of an object in the IOP data
+		/// @param[in] iopLength The number of bytes remaining in the object pool
+		/// @returns The length of the object in bytes, or 0 if the object is unsupported, malformed, or truncated
+		static std::uint32_t get_serialized_object_length(const std::uint8_t *iopData, std::uint32_t iopLength);
+
+		/// @brief Returns the length of an object made of a fixed part followed by lists whose sizes are stored in the fixed part
+		/// @param[in] iopData A pointer to the start of an object in the IOP data
+		/// @param[in] iopLength The number of bytes remaining in the object pool
+		/// @param[in] fixedLength The number of bytes in the fixed part of the object
+		/// @param[in] countedFields Pairs of the offset of a count byte in the fixed part and the number of bytes per counted element
+		/// @returns The length of the object in bytes, or 0 if it's truncated
+		static std::uint32_t get_counted_object_length(const std::uint8_t *iopData,
+		                                               std::uint32_t iopLength,
+		                                               std::uint32_t fixedLength,
+		                                               std::initializer_list<std::pair<std::uint8_t, std::uint8_t>> countedFields);
+
+		/// @brief Records the offset and length of each object at the start of a block of IOP data.
+		/// Scanning stops at the first object whose length can't be determined.
+		/// @param[in] iopData A pointer to the raw IOP data
+		/// @param[in] iopLength The length of the raw IOP data
+		/// @param[out] objectLocations The location of every object that was scanned, in pool order
+		static void scan_iop_objects(const std::uint8_t *iopData, std::uint32_t iopLength, std::vector<IopObjectLocation> &objectLocations);
+
+		/// @brief Constructs scanned objects in blocks until there are none left or one fails to parse
+		/// @param[in] iopData A pointer to the raw IOP data
+		/// @param[in] iopLength The length of the raw IOP data
+		/// @param[in] objectLocations The scanned locations of the objects to construct
+		/// @param[out] parsedObjects The constructed objects, indexed the same as objectLocations
+		/// @param[in,out] nextObjectIndex The index of the next block of objects that no thread has taken yet
+		/// @param[in,out] firstFailedObjectIndex The lowest index of an object that failed to parse
+		void parse_scanned_objects(std::uint8_t *iopData,
+		                           std::uint32_t iopLength,
+		                           const std::vector<IopObjectLocation> &objectLocations,
+		                           std::vector<std::shared_ptr<VTObject>> &parsedObjects,
+		                           std::atomic<std::size_t> &nextObjectIndex,
+		                           std::atomic<std::size_t> &firstFailedObjectIndex) const;
+
+		mutable std::map<std::uint16_t, std::shared_ptr<VTObject>> objectTreeMap; ///< A copy of the object table for callers of get_object_tree
+		mutable bool objectTreeMapValid = true; ///< Tells if objectTreeMap matches the object table
 	};
 } // namespace isobus
 #endif // ISOBUS_VIRTUAL_TERMINAL_WORKING_SET_BASE_HPP
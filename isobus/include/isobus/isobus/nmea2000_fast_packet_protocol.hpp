@@ -31,6 +31,9 @@
 #include "isobus/utility/event_dispatcher.hpp"
 #include "isobus/utility/thread_synchronization.hpp"
 
+#include <map>
+#include <utility>
+
 namespace isobus
 {
 	/// @brief A protocol that handles the NMEA 2000 fast packet protocol.
@@ -102,18 +105,14 @@ namespace isobus
 			CANIdentifier::CANPriority priority; ///< The priority to encode in the IDs of the component CAN messages
 		};
 
-		/// @brief A structure for keeping track of past sessions so we can resume with the right session number
-		struct FastPacketHistory
-		{
-			NAME isoName; ///< The ISO name of the internal control function used in a session
-			std::uint32_t parameterGroupNumber; ///< The PGN of the session being saved
-			std::uint8_t sequenceNumber; ///< The sequence number to use in the next matching session
-		};
-
 		/// @brief The constructor for the FastPacketProtocol, for advanced use only.
 		/// In most cases, you should use the CANNetworkManager::get_fast_packet_protocol().send_message() function to transmit messages.
 		/// @param[in] sendCANFrameCallback A callback for sending a CAN frame to hardware
-		explicit FastPacketProtocol(const CANMessageFrameCallback &sendCANFrameCallback);
+		/// @param[in] memoryBudget The budget to reserve memory for received messages from, or `nullptr` for unlimited memory
+		/// @param[in] transmitScheduler The scheduler that shares the data frames of the CAN port between sessions, or `nullptr` to send them in each update
+		explicit FastPacketProtocol(const CANMessageFrameCallback &sendCANFrameCallback,
+		                            TransportProtocolMemoryBudget *memoryBudget = nullptr,
+		                            TransportProtocolTransmitScheduler *transmitScheduler = nullptr);
 
 		/// @brief Add a callback to be called when a message is received by the Fast Packet protocol
 		/// @param[in] parameterGroupNumber The PGN to parse as fast packet
@@ -164,6 +163,11 @@ namespace isobus
 		/// @brief Updates all sessions managed by this protocol manager instance.
 		void update();
 
+		/// @brief Returns how long until a session's timer, like a timeout or the delay between BAM frames, needs an update.
+		/// @details Sessions that are only waiting to send are left to the regular updates.
+		/// @returns The time until the next timer expires in milliseconds, or the largest `std::uint32_t` if no session is waiting on a timer
+		std::uint32_t get_time_until_next_deadline_ms() const;
+
 		/// @brief A generic way for a protocol to process a received message
 		/// @param[in] message A received CAN message
 		void process_message(const CANMessage &message);
@@ -207,6 +211,18 @@ namespace isobus
 		/// @param[in] session The session to update
 		void update_session(const std::shared_ptr<FastPacketProtocolSession> &session);
 
+		/// @brief Sends the next frames of a transmitting session, and closes it once all frames are sent
+		/// @param[in] session The session to send frames for
+		/// @param[in] maximumFrames The max number of frames to send
+		/// @returns The number of frames that were sent
+		std::uint8_t send_frames(const std::shared_ptr<FastPacketProtocolSession> &session, std::uint8_t maximumFrames);
+
+		/// @brief Sends frames of a session on behalf of the transmit scheduler
+		/// @param[in] session The session to send frames for
+		/// @param[in] maximumFrames The max number of frames the scheduler allows
+		/// @returns The number of frames that were sent
+		std::uint32_t transmit_scheduled_frames(const std::shared_ptr<FastPacketProtocolSession> &session, std::uint32_t maximumFrames);
+
 		static constexpr std::uint32_t FP_MIN_PARAMETER_GROUP_NUMBER = 0x1F000; ///< Start of PGNs that can be received via Fast Packet
 		static constexpr std::uint32_t FP_MAX_PARAMETER_GROUP_NUMBER = 0x1FFFF; ///< End of PGNs that can be received via Fast Packet
 		static constexpr std::uint32_t FP_TIMEOUT_MS = 750; ///< Protocol timeout in milliseconds
@@ -216,12 +232,14 @@ namespace isobus
 		static constexpr std::uint8_t SEQUENCE_NUMBER_BIT_OFFSET = 5; ///< The bit offset into the first byte of data to get the seq number
 		static constexpr std::uint8_t PROTOCOL_BYTES_PER_FRAME = 7; ///< The number of payload bytes per frame for all but the first message, which has 6
 
-		std::vector<std::shared_ptr<FastPacketProtocolSession>> activeSessions; ///< A list of all active TP sessions
-		Mutex sessionMutex; ///< A mutex to lock the sessions list in case someone starts a Tx while the stack is processing sessions
-		std::vector<FastPacketHistory> sessionHistory; ///< Used to keep track of sequence numbers for future sessions
+		TransportProtocolSessionList<FastPacketProtocolSession> activeSessions{ true }; ///< A list of all active FP sessions, indexed by source, destination and PGN
+		mutable Mutex sessionMutex; ///< A mutex to lock the sessions list in case someone starts a Tx while the stack is processing sessions
+		std::map<std::pair<std::uint64_t, std::uint32_t>, std::uint8_t> sessionHistory; ///< The last sequence number used by each ISO NAME and PGN, to continue the sequence in future sessions
 		std::vector<ParameterGroupNumberCallbackData> parameterGroupNumberCallbacks; ///< A list of all parameter group number callbacks that will be parsed as fast packet messages
 		bool allowAnyControlFunction = false; ///< Denotes if messages for non-internal control functions should be parsed by this protocol
 		const CANMessageFrameCallback sendCANFrameCallback; ///< A callback for sending a CAN frame
+		TransportProtocolMemoryBudget *memoryBudget; ///< The budget to reserve memory for received messages from, or `nullptr` for unlimited memory
+		TransportProtocolTransmitScheduler *transmitScheduler; ///< The scheduler that sends the frames of the sessions, or `nullptr`
 	};
 
 } // namespace isobus
@@ -8,6 +8,9 @@
 //================================================================================================
 #include "isobus/isobus/can_callbacks.hpp"
 
+#include <algorithm>
+#include <cassert>
+
 namespace isobus
 {
 	ParameterGroupNumberCallbackData::ParameterGroupNumberCallbackData(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parentPointer, std::shared_ptr<InternalControlFunction> internalControlFunction) :
@@ -45,4 +48,60 @@ namespace isobus
 	{
 		return internalControlFunctionFilter;
 	}
+
+	const std::vector<ParameterGroupNumberCallbackData> ParameterGroupNumberCallbackTable::EMPTY_CALLBACK_LIST;
+
+	void ParameterGroupNumberCallbackTable::add(const ParameterGroupNumberCallbackData &callbackData)
+	{
+		callbacks.push_back(callbackData);
+		callbacksByParameterGroupNumber[callbackData.get_parameter_group_number()].push_back(callbackData);
+	}
+
+	bool ParameterGroupNumberCallbackTable::remove(const ParameterGroupNumberCallbackData &callbackData)
+	{
+		bool retVal = false;
+		auto callbackLocation = std::find(callbacks.begin(), callbacks.end(), callbackData);
+
+		if (callbacks.end() != callbackLocation)
+		{
+			callbacks.erase(callbackLocation);
+
+			auto &parameterGroupNumberCallbacks = callbacksByParameterGroupNumber[callbackData.get_parameter_group_number()];
+			auto indexedLocation = std::find(parameterGroupNumberCallbacks.begin(), parameterGroupNumberCallbacks.end(), callbackData);
+			if (parameterGroupNumberCallbacks.end() != indexedLocation)
+			{
+				parameterGroupNumberCallbacks.erase(indexedLocation);
+			}
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	bool ParameterGroupNumberCallbackTable::contains(const ParameterGroupNumberCallbackData &callbackData) const
+	{
+		const auto &parameterGroupNumberCallbacks = get_callbacks(callbackData.get_parameter_group_number());
+		return parameterGroupNumberCallbacks.end() != std::find(parameterGroupNumberCallbacks.begin(), parameterGroupNumberCallbacks.end(), callbackData);
+	}
+
+	std::size_t ParameterGroupNumberCallbackTable::size() const
+	{
+		return callbacks.size();
+	}
+
+	const ParameterGroupNumberCallbackData &ParameterGroupNumberCallbackTable::get(std::size_t index) const
+	{
+		assert(index < callbacks.size());
+		return callbacks[index];
+	}
+
+	const std::vector<ParameterGroupNumberCallbackData> &ParameterGroupNumberCallbackTable::get_callbacks(std::uint32_t parameterGroupNumber) const
+	{
+		auto result = callbacksByParameterGroupNumber.find(parameterGroupNumber);
+
+		if (callbacksByParameterGroupNumber.end() != result)
+		{
+			return result->second;
+		}
+		return EMPTY_CALLBACK_LIST;
+	}
 } // namespace isobus
@@ -18,6 +18,7 @@
 #include "isobus/utility/to_string.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 
 namespace isobus
@@ -121,10 +122,16 @@ namespace isobus
 
 	ExtendedTransportProtocolManager::ExtendedTransportProtocolManager(const CANMessageFrameCallback &sendCANFrameCallback,
 	                                                                   const CANMessageCallback &canMessageReceivedCallback,
-	                                                                   const CANNetworkConfiguration *configuration) :
+	                                                                   const CANNetworkConfiguration *configuration,
+	                                                                   TransportProtocolMemoryBudget *memoryBudget,
+	                                                                   TransportProtocolFlowControl *flowControl,
+	                                                                   TransportProtocolTransmitScheduler *transmitScheduler) :
 	  sendCANFrameCallback(sendCANFrameCallback),
 	  canMessageReceivedCallback(canMessageReceivedCallback),
-	  configuration(configuration)
+	  configuration(configuration),
+	  memoryBudget(memoryBudget),
+	  flowControl(flowControl),
+	  transmitScheduler(transmitScheduler)
 	{
 	}
 
@@ -135,11 +142,17 @@ namespace isobus
 	{
 		if (activeSessions.size() >= configuration->get_max_number_transport_protocol_sessions())
 		{
-			// TODO: consider using maximum memory instead of maximum number of sessions
 			LOG_WARNING("[ETP]: Replying with abort to Request To Send (RTS) for 0x%05X, configured maximum number of sessions reached.",
 			            parameterGroupNumber);
 			send_abort(std::static_pointer_cast<InternalControlFunction>(destination), source, parameterGroupNumber, ConnectionAbortReason::AlreadyInCMSession);
 		}
+		else if ((nullptr != memoryBudget) && (!memoryBudget->is_within_limits(totalMessageSize)))
+		{
+			LOG_WARNING("[ETP]: Replying with abort to Request To Send (RTS) for 0x%05X, message size (%u) is greater than the configured receive memory limits.",
+			            parameterGroupNumber,
+			            totalMessageSize);
+			send_abort(std::static_pointer_cast<InternalControlFunction>(destination), source, parameterGroupNumber, ConnectionAbortReason::SystemResourcesNeeded);
+		}
 		else
 		{
 			auto oldSession = get_session(source, destination);
@@ -160,7 +173,7 @@ namespace isobus
 			}
 
 			auto newSession = std::make_shared<ExtendedTransportProtocolSession>(ExtendedTransportProtocolSession::Direction::Receive,
-			                                                                     std::unique_ptr<CANMessageData>(new CANMessageDataVector(totalMessageSize)),
+			                                                                     std::unique_ptr<CANMessageData>(new CANMessageDataVector(0)), // Grown with each CTS
 			                                                                     parameterGroupNumber,
 			                                                                     totalMessageSize,
 			                                                                     source,
@@ -172,7 +185,7 @@ namespace isobus
 			newSession->set_cts_number_of_packet_limit(configuration->get_number_of_packets_per_dpo_message());
 
 			newSession->set_state(StateMachineState::SendClearToSend);
-			activeSessions.push_back(newSession);
+			activeSessions.add(newSession);
 			LOG_DEBUG("[ETP]: New rx session for 0x%05X. Source: %hu, destination: %hu", parameterGroupNumber, source->get_address(), destination->get_address());
 			update_state_machine(newSession);
 		}
@@ -206,6 +219,12 @@ namespace isobus
 			}
 			else
 			{
+				if (nullptr != flowControl)
+				{
+					flowControl->add_round_trip_time(session->stop_round_trip_measurement());
+					flowControl->add_transfer_frame();
+				}
+
 				session->set_acknowledged_packet_number(nextPacketNumber - 1);
 				session->set_cts_number_of_packet_limit(packetsToBeSent);
 
@@ -257,6 +276,12 @@ namespace isobus
 			}
 			else
 			{
+				if (nullptr != flowControl)
+				{
+					flowControl->add_round_trip_time(session->stop_round_trip_measurement());
+					flowControl->add_transfer_frame();
+				}
+
 				session->set_dpo_number_of_packets(numberOfPackets);
 				session->set_sequence_number_offset(packetOffset);
 				session->set_last_sequency_number(0);
@@ -436,21 +461,15 @@ namespace isobus
 				// Convert data type to a vector to allow for manipulation
 				auto &data = static_cast<CANMessageDataVector &>(session->get_data());
 
-				// Correct sequence number, copy the data
-				for (std::uint8_t i = 0; i < PROTOCOL_BYTES_PER_FRAME; i++)
+				if (nullptr != flowControl)
 				{
-					std::uint32_t currentDataIndex = (PROTOCOL_BYTES_PER_FRAME * session->get_last_packet_number()) + i;
-					if (currentDataIndex < session->get_message_length())
-					{
-						data.set_byte(currentDataIndex, message.get_uint8_at(1 + i));
-					}
-					else
-					{
-						// Reached the end of the message, no need to copy any more data
-						break;
-					}
+					flowControl->add_transfer_frame();
 				}
 
+				// Correct sequence number, append the data to the buffer that was grown for it
+				const auto bytesThisFrame = std::min<std::size_t>(PROTOCOL_BYTES_PER_FRAME, session->get_message_length() - data.size());
+				data.insert(data.end(), message.get_data().begin() + 1, message.get_data().begin() + 1 + bytesThisFrame);
+
 				session->set_last_sequency_number(sequenceNumber);
 				if (session->get_number_of_remaining_packets() == 0)
 				{
@@ -518,7 +537,8 @@ namespace isobus
 	                                                                 std::shared_ptr<ControlFunction> source,
 	                                                                 std::shared_ptr<ControlFunction> destination,
 	                                                                 TransmitCompleteCallback sessionCompleteCallback,
-	                                                                 void *parentPointer)
+	                                                                 void *parentPointer,
+	                                                                 CANIdentifier::CANPriority priority)
 	{
 		// Return false early if we can't send the message
 		if ((nullptr == data) || (data->size() <= 1785) || (data->size() > MAX_PROTOCOL_DATA_LENGTH))
@@ -553,7 +573,13 @@ namespace isobus
 		          source->get_address(),
 		          destination->get_address());
 
-		activeSessions.push_back(session);
+		activeSessions.add(session);
+		if (nullptr != transmitScheduler)
+		{
+			transmitScheduler->add(session, priority, [this](const std::shared_ptr<TransportProtocolSessionBase> &scheduledSession, std::uint32_t maximumFrames) {
+				return transmit_scheduled_frames(std::static_pointer_cast<ExtendedTransportProtocolSession>(scheduledSession), maximumFrames);
+			});
+		}
 		update_state_machine(session);
 		return true;
 	}
@@ -581,13 +607,63 @@ namespace isobus
 		}
 	}
 
-	void ExtendedTransportProtocolManager::send_data_transfer_packets(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const
+	std::uint32_t ExtendedTransportProtocolManager::get_time_until_next_deadline_ms() const
+	{
+		std::uint32_t retVal = std::numeric_limits<std::uint32_t>::max();
+
+		// The timeouts in update_state_machine expire once more than their duration has passed, hence the + 1
+		for (const auto &session : activeSessions.get_sessions())
+		{
+			switch (session->state)
+			{
+				case StateMachineState::WaitForClearToSend:
+				case StateMachineState::WaitForDataPacketOffset:
+				case StateMachineState::WaitForEndOfMessageAcknowledge:
+				{
+					retVal = std::min(retVal, session->get_time_until_elapsed(T2_T3_TIMEOUT_MS + 1));
+				}
+				break;
+
+				case StateMachineState::WaitForDataTransferPacket:
+				{
+					retVal = std::min(retVal, session->get_time_until_elapsed(T1_TIMEOUT_MS + 1));
+				}
+				break;
+
+				case StateMachineState::SendClearToSend:
+				{
+					if (0 != session->get_number_of_memory_holds())
+					{
+						retVal = std::min(retVal, session->get_time_until_elapsed(TH_HOLD_INTERVAL_MS));
+					}
+				}
+				break;
+
+				default:
+					break;
+			}
+		}
+		return retVal;
+	}
+
+	std::uint8_t ExtendedTransportProtocolManager::get_max_frames_per_update() const
+	{
+		std::uint8_t retVal = configuration->get_max_number_of_network_manager_protocol_frames_per_update();
+		if (nullptr != flowControl)
+		{
+			retVal = flowControl->get_frames_per_update(retVal);
+		}
+		return retVal;
+	}
+
+	std::uint8_t ExtendedTransportProtocolManager::send_data_transfer_packets(const std::shared_ptr<ExtendedTransportProtocolSession> &session, std::uint8_t maximumFrames) const
 	{
 		std::array<std::uint8_t, CAN_DATA_LENGTH> buffer;
 		std::uint8_t framesToSend = session->get_dpo_number_of_packets_remaining();
-		if (framesToSend > configuration->get_max_number_of_network_manager_protocol_frames_per_update())
+		std::uint8_t framesSent = 0;
+		if (framesToSend > maximumFrames)
 		{
-			framesToSend = configuration->get_max_number_of_network_manager_protocol_frames_per_update();
+			framesToSend = maximumFrames;
 		}
 
 		// Try and send packets
@@ -596,18 +672,12 @@ namespace isobus
 			buffer[0] = session->get_last_sequence_number() + 1;
 
 			std::uint32_t dataOffset = session->get_last_packet_number() * PROTOCOL_BYTES_PER_FRAME;
-			for (std::uint8_t j = 0; j < PROTOCOL_BYTES_PER_FRAME; j++)
+			std::size_t bytesCopied = 0;
+			if (dataOffset < session->get_message_length())
 			{
-				std::uint32_t index = dataOffset + j;
-				if (index < session->get_message_length())
-				{
-					buffer[1 + j] = session->get_data().get_byte(index);
-				}
-				else
-				{
-					buffer[1 + j] = 0xFF;
-				}
+				bytesCopied = session->get_data().copy_range(dataOffset, &buffer[1], std::min<std::size_t>(PROTOCOL_BYTES_PER_FRAME, session->get_message_length() - dataOffset));
 			}
+			std::fill(buffer.begin() + 1 + bytesCopied, buffer.end(), 0xFF);
 
 			if (sendCANFrameCallback(static_cast<std::uint32_t>(CANLibParameterGroupNumber::ExtendedTransportProtocolDataTransfer),
 			                         CANDataSpan(buffer.data(), buffer.size()),
@@ -616,6 +686,11 @@ namespace isobus
 			                         CANIdentifier::CANPriority::PriorityLowest7))
 			{
 				session->set_last_sequency_number(session->get_last_sequence_number() + 1);
+				framesSent++;
+				if (nullptr != flowControl)
+				{
+					flowControl->add_sent_data_frame();
+				}
 			}
 			else
 			{
@@ -631,7 +706,20 @@ namespace isobus
 		else if (session->get_dpo_number_of_packets_remaining() == 0)
 		{
 			session->set_state(StateMachineState::WaitForClearToSend);
+			session->start_round_trip_measurement();
+		}
+		return framesSent;
+	}
+
+	std::uint32_t ExtendedTransportProtocolManager::transmit_scheduled_frames(const std::shared_ptr<ExtendedTransportProtocolSession> &session, std::uint32_t maximumFrames) const
+	{
+		std::uint32_t retVal = 0;
+
+		if (StateMachineState::SendDataTransferPackets == session->state)
+		{
+			retVal = send_data_transfer_packets(session, static_cast<std::uint8_t>(std::min<std::uint32_t>(maximumFrames, get_max_frames_per_update())));
 		}
+		return retVal;
 	}
 
 	void ExtendedTransportProtocolManager::update_state_machine(std::shared_ptr<ExtendedTransportProtocolSession> &session)
@@ -646,6 +734,7 @@ namespace isobus
 				if (send_request_to_send(session))
 				{
 					session->set_state(StateMachineState::WaitForClearToSend);
+					session->start_round_trip_measurement();
 				}
 			}
 			break;
@@ -671,7 +760,7 @@ namespace isobus
 
 			case StateMachineState::SendClearToSend:
 			{
-				if (send_clear_to_send(session))
+				if (send_clear_to_send_when_memory_available(session))
 				{
 					session->set_state(StateMachineState::WaitForDataPacketOffset);
 				}
@@ -699,7 +788,14 @@ namespace isobus
 
 			case StateMachineState::SendDataTransferPackets:
 			{
-				send_data_transfer_packets(session);
+				if ((nullptr != transmitScheduler) && transmitScheduler->is_enabled())
+				{
+					// The transmit scheduler sends the data frames, shared with the other sessions of the CAN port
+				}
+				else
+				{
+					send_data_transfer_packets(session, get_max_frames_per_update());
+				}
 			}
 			break;
 
@@ -774,10 +870,19 @@ namespace isobus
 	void ExtendedTransportProtocolManager::close_session(const std::shared_ptr<ExtendedTransportProtocolSession> &session, bool successful)
 	{
 		session->complete(successful);
-		auto sessionLocation = std::find(activeSessions.begin(), activeSessions.end(), session);
-		if (activeSessions.end() != sessionLocation)
+
+		if (nullptr != memoryBudget)
+		{
+			memoryBudget->release(*session);
+		}
+
+		if (nullptr != transmitScheduler)
+		{
+			transmitScheduler->remove(*session);
+		}
+
+		if (activeSessions.remove(session))
 		{
-			activeSessions.erase(sessionLocation);
 			LOG_DEBUG("[ETP]: Session Closed");
 		}
 	}
@@ -801,15 +906,9 @@ namespace isobus
 		                            CANIdentifier::CANPriority::PriorityLowest7);
 	}
 
-	bool ExtendedTransportProtocolManager::send_clear_to_send(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const
+	bool ExtendedTransportProtocolManager::send_clear_to_send(const std::shared_ptr<ExtendedTransportProtocolSession> &session, std::uint8_t packetLimit) const
 	{
 		std::uint32_t nextPacketNumber = session->get_last_packet_number() + 1;
-		std::uint8_t packetLimit = session->get_cts_number_of_packet_limit();
-
-		if (packetLimit > session->get_number_of_remaining_packets())
-		{
-			packetLimit = static_cast<std::uint8_t>(session->get_number_of_remaining_packets());
-		}
 
 		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer{
 			CLEAR_TO_SEND_MULTIPLEXOR,
@@ -833,6 +932,54 @@ namespace isobus
 		return retVal;
 	}
 
+	bool ExtendedTransportProtocolManager::send_clear_to_send_when_memory_available(const std::shared_ptr<ExtendedTransportProtocolSession> &session)
+	{
+		bool retVal = false;
+		std::uint8_t packetLimit = session->get_cts_number_of_packet_limit();
+
+		if (nullptr != flowControl)
+		{
+			packetLimit = flowControl->get_packets_per_window(packetLimit);
+		}
+
+		if (packetLimit > session->get_number_of_remaining_packets())
+		{
+			packetLimit = static_cast<std::uint8_t>(session->get_number_of_remaining_packets());
+		}
+
+		const std::uint64_t bytesThroughSegment = std::min(static_cast<std::uint64_t>(session->get_last_packet_number() + packetLimit) * PROTOCOL_BYTES_PER_FRAME,
+		                                                   static_cast<std::uint64_t>(session->get_message_length()));
+
+		if (session->grow_receive_buffer(memoryBudget, static_cast<std::uint32_t>(bytesThroughSegment)))
+		{
+			retVal = send_clear_to_send(session, packetLimit);
+			if (retVal)
+			{
+				session->set_number_of_memory_holds(0);
+				session->start_round_trip_measurement();
+				if (nullptr != flowControl)
+				{
+					flowControl->add_transfer_frame();
+				}
+			}
+		}
+		else if ((0 == session->get_number_of_memory_holds()) || (session->get_time_since_last_update() >= TH_HOLD_INTERVAL_MS))
+		{
+			if ((static_cast<std::uint64_t>(session->get_number_of_memory_holds()) * TH_HOLD_INTERVAL_MS) >= configuration->get_max_transport_protocol_memory_hold_time())
+			{
+				LOG_ERROR("[ETP]: Aborting rx session for 0x%05X, no receive memory became available in time", session->get_parameter_group_number());
+				abort_session(session, ConnectionAbortReason::SystemResourcesNeeded);
+			}
+			else if (send_clear_to_send(session, 0))
+			{
+				// A CTS for 0 packets asks the sender to wait, and has to be repeated to keep the connection open
+				LOG_DEBUG("[ETP]: Holding rx session for 0x%05X until receive memory is available", session->get_parameter_group_number());
+				session->set_number_of_memory_holds(session->get_number_of_memory_holds() + 1);
+			}
+		}
+		return retVal;
+	}
+
 	bool isobus::ExtendedTransportProtocolManager::send_data_packet_offset(const std::shared_ptr<ExtendedTransportProtocolSession> &session) const
 	{
 		std::uint8_t packetsThisSegment = 0xFF;
@@ -853,6 +1000,11 @@ namespace isobus
 			packetsThisSegment = configuration->get_number_of_packets_per_dpo_message();
 		}
 
+		if (nullptr != flowControl)
+		{
+			packetsThisSegment = flowControl->get_packets_per_window(packetsThisSegment);
+		}
+
 		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer{
 			DATA_PACKET_OFFSET_MULTIPLXOR,
 			packetsThisSegment,
@@ -902,22 +1054,17 @@ namespace isobus
 
 	bool ExtendedTransportProtocolManager::has_session(std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination)
 	{
-		return std::any_of(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<ExtendedTransportProtocolSession> &session) {
-			return session->matches(source, destination);
-		});
+		return (nullptr != activeSessions.find(source, destination));
 	}
 
 	std::shared_ptr<ExtendedTransportProtocolManager::ExtendedTransportProtocolSession> ExtendedTransportProtocolManager::get_session(std::shared_ptr<ControlFunction> source,
 	                                                                                                                                  std::shared_ptr<ControlFunction> destination)
 	{
-		auto result = std::find_if(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<ExtendedTransportProtocolSession> &session) {
-			return session->matches(source, destination);
-		});
-		return (activeSessions.end() != result) ? (*result) : nullptr;
+		return activeSessions.find(source, destination);
 	}
 
 	const std::vector<std::shared_ptr<ExtendedTransportProtocolManager::ExtendedTransportProtocolSession>> &ExtendedTransportProtocolManager::get_sessions() const
 	{
-		return activeSessions;
+		return activeSessions.get_sessions();
 	}
 }
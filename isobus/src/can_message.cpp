@@ -24,8 +24,8 @@ namespace isobus
 	  messageType(type),
 	  identifier(identifier),
 	  data(dataBuffer, dataBuffer + length),
-	  source(source),
-	  destination(destination),
+	  source(std::move(source)),
+	  destination(std::move(destination)),
 	  CANPortIndex(CANPort)
 	{
 	}
@@ -39,12 +39,34 @@ namespace isobus
 	  messageType(type),
 	  identifier(identifier),
 	  data(std::move(data)),
-	  source(source),
-	  destination(destination),
+	  source(std::move(source)),
+	  destination(std::move(destination)),
 	  CANPortIndex(CANPort)
 	{
 	}
 
+	void CANMessage::reinitialize(Type type,
+	                              CANIdentifier identifier,
+	                              const std::uint8_t *dataBuffer,
+	                              std::uint32_t length,
+	                              std::shared_ptr<ControlFunction> source,
+	                              std::shared_ptr<ControlFunction> destination,
+	                              std::uint8_t CANPort)
+	{
+		if (data.capacity() < CAN_DATA_LENGTH)
+		{
+			// Reserve a full frame up front, so that the buffer can be reused for any later frame
+			data.reserve(CAN_DATA_LENGTH);
+		}
+		messageType = type;
+		this->identifier = identifier;
+		data.assign(dataBuffer, dataBuffer + length);
+		this->source = std::move(source);
+		this->destination = std::move(destination);
+		CANPortIndex = CANPort;
+		timestamp_us = 0;
+	}
+
 	CANMessage CANMessage::create_invalid_message()
 	{
 		return CANMessage(CANMessage::Type::Receive, CANIdentifier(CANIdentifier::UNDEFINED_PARAMETER_GROUP_NUMBER), {}, nullptr, nullptr, 0);
@@ -120,6 +142,16 @@ namespace isobus
 		return CANPortIndex;
 	}
 
+	std::uint64_t CANMessage::get_timestamp_us() const
+	{
+		return timestamp_us;
+	}
+
+	void CANMessage::set_timestamp_us(std::uint64_t timestamp_us)
+	{
+		this->timestamp_us = timestamp_us;
+	}
+
 	void CANMessage::set_data(const std::uint8_t *dataBuffer, std::uint32_t length)
 	{
 		assert(length <= ABSOLUTE_MAX_MESSAGE_LENGTH && "CANMessage::set_data() called with length greater than maximum supported");
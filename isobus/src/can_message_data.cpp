@@ -13,6 +13,17 @@
 
 namespace isobus
 {
+	std::size_t CANMessageData::copy_range(std::size_t offset, std::uint8_t *destination, std::size_t length)
+	{
+		std::size_t bytesCopied = 0;
+		while ((bytesCopied < length) && ((offset + bytesCopied) < size()))
+		{
+			destination[bytesCopied] = get_byte(offset + bytesCopied);
+			bytesCopied++;
+		}
+		return bytesCopied;
+	}
+
 	CANMessageDataVector::CANMessageDataVector(std::size_t size)
 	{
 		vector::resize(size);
@@ -38,6 +49,18 @@ namespace isobus
 		return vector::at(index);
 	}
 
+	std::size_t CANMessageDataVector::copy_range(std::size_t offset, std::uint8_t *destination, std::size_t length)
+	{
+		if (offset >= vector::size())
+		{
+			return 0;
+		}
+
+		const std::size_t bytesToCopy = std::min(length, vector::size() - offset);
+		std::copy_n(vector::data() + offset, bytesToCopy, destination);
+		return bytesToCopy;
+	}
+
 	void CANMessageDataVector::set_byte(std::size_t index, std::uint8_t value)
 	{
 		vector::at(index) = value;
@@ -69,6 +92,18 @@ namespace isobus
 		return DataSpan::operator[](index);
 	}
 
+	std::size_t CANMessageDataView::copy_range(std::size_t offset, std::uint8_t *destination, std::size_t length)
+	{
+		if (offset >= DataSpan::size())
+		{
+			return 0;
+		}
+
+		const std::size_t bytesToCopy = std::min(length, DataSpan::size() - offset);
+		std::copy_n(DataSpan::begin() + offset, bytesToCopy, destination);
+		return bytesToCopy;
+	}
+
 	CANDataSpan CANMessageDataView::data() const
 	{
 		return CANDataSpan(DataSpan::begin(), DataSpan::size());
@@ -113,6 +148,32 @@ namespace isobus
 		return buffer[index - dataOffset];
 	}
 
+	std::size_t CANMessageDataCallback::copy_range(std::size_t offset, std::uint8_t *destination, std::size_t length)
+	{
+		if (offset >= totalSize)
+		{
+			return 0;
+		}
+
+		const std::size_t bytesToCopy = std::min(length, totalSize - offset);
+		std::size_t bytesCopied = 0;
+		while (bytesCopied < bytesToCopy)
+		{
+			const std::size_t index = offset + bytesCopied;
+			if ((index >= dataOffset + bufferSize) || (index < dataOffset) || (!initialized))
+			{
+				initialized = true;
+				dataOffset = index;
+				callback(0, dataOffset, std::min(totalSize - dataOffset, bufferSize), buffer.data(), parentPointer);
+			}
+
+			const std::size_t bytesFromChunk = std::min(bytesToCopy - bytesCopied, dataOffset + bufferSize - index);
+			std::copy_n(buffer.begin() + (index - dataOffset), bytesFromChunk, destination + bytesCopied);
+			bytesCopied += bytesFromChunk;
+		}
+		return bytesCopied;
+	}
+
 	std::unique_ptr<CANMessageData> CANMessageDataCallback::copy_if_not_owned(std::unique_ptr<CANMessageData> self) const
 	{
 		// A callback doesn't own it's data, but it does own the callback function, so we can just return itself.
@@ -0,0 +1,103 @@
+//================================================================================================
+/// @file can_message_queue.cpp
+///
+/// @brief A queue of CAN messages that recycles its storage, so that messages translated from
+/// single CAN frames can be queued without allocating memory.
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/can_message_queue.hpp"
+
+#include <utility>
+
+namespace isobus
+{
+	CANMessageQueue::CANMessageQueue(std::size_t capacity) :
+	  queue(new LockFreeMPSCQueue<CANMessage>(capacity, CANMessage::create_invalid_message())),
+	  queueCapacity(capacity)
+	{
+	}
+
+	bool CANMessageQueue::push(CANMessage::Type type,
+	                           const CANMessageFrame &frame,
+	                           std::shared_ptr<ControlFunction> source,
+	                           std::shared_ptr<ControlFunction> destination)
+	{
+		return queue->push_with([&](CANMessage &slot) {
+			slot.reinitialize(type,
+			                  CANIdentifier(frame.identifier),
+			                  frame.data,
+			                  frame.dataLength,
+			                  std::move(source),
+			                  std::move(destination),
+			                  frame.channel);
+			slot.set_timestamp_us(frame.timestamp_us);
+		});
+	}
+
+	bool CANMessageQueue::push(const CANMessage &message)
+	{
+		return queue->push_with([&message](CANMessage &slot) {
+			slot.reinitialize(message.get_type(),
+			                  message.get_identifier(),
+			                  message.get_data().data(),
+			                  message.get_data_length(),
+			                  message.get_source_control_function(),
+			                  message.get_destination_control_function(),
+			                  message.get_can_port_index());
+			slot.set_timestamp_us(message.get_timestamp_us());
+		});
+	}
+
+	bool CANMessageQueue::pop(CANMessage &message)
+	{
+		return queue->pop(message);
+	}
+
+	bool CANMessageQueue::empty() const
+	{
+		return queue->empty();
+	}
+
+	std::size_t CANMessageQueue::size() const
+	{
+		return queue->size();
+	}
+
+	void CANMessageQueue::clear()
+	{
+		queue->clear();
+	}
+
+	void CANMessageQueue::set_capacity(std::size_t capacity)
+	{
+		if (capacity != queueCapacity)
+		{
+			const QueueOverflowPolicy policy = queue->get_overflow_policy();
+
+			previousOverflowCount += queue->get_overflow_count();
+			queue.reset(new LockFreeMPSCQueue<CANMessage>(capacity, CANMessage::create_invalid_message()));
+			queue->set_overflow_policy(policy);
+			queueCapacity = capacity;
+		}
+		else
+		{
+			queue->clear();
+		}
+	}
+
+	std::size_t CANMessageQueue::get_capacity() const
+	{
+		return queueCapacity;
+	}
+
+	void CANMessageQueue::set_overflow_policy(QueueOverflowPolicy policy)
+	{
+		queue->set_overflow_policy(policy);
+	}
+
+	std::size_t CANMessageQueue::get_overflow_count() const
+	{
+		return previousOverflowCount + queue->get_overflow_count();
+	}
+} // namespace isobus
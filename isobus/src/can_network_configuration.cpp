@@ -21,6 +21,36 @@ namespace isobus
 		return maxNumberTransportProtocolSessions;
 	}
 
+	void CANNetworkConfiguration::set_max_transport_protocol_receive_memory(std::uint32_t value)
+	{
+		maxTransportProtocolReceiveMemory = value;
+	}
+
+	std::uint32_t CANNetworkConfiguration::get_max_transport_protocol_receive_memory() const
+	{
+		return maxTransportProtocolReceiveMemory;
+	}
+
+	void CANNetworkConfiguration::set_max_transport_protocol_receive_memory_per_source(std::uint32_t value)
+	{
+		maxTransportProtocolReceiveMemoryPerSource = value;
+	}
+
+	std::uint32_t CANNetworkConfiguration::get_max_transport_protocol_receive_memory_per_source() const
+	{
+		return maxTransportProtocolReceiveMemoryPerSource;
+	}
+
+	void CANNetworkConfiguration::set_max_transport_protocol_memory_hold_time(std::uint32_t value)
+	{
+		maxTransportProtocolMemoryHoldTime_ms = value;
+	}
+
+	std::uint32_t CANNetworkConfiguration::get_max_transport_protocol_memory_hold_time() const
+	{
+		return maxTransportProtocolMemoryHoldTime_ms;
+	}
+
 	void CANNetworkConfiguration::set_minimum_time_between_transport_protocol_bam_frames(std::uint32_t value)
 	{
 		constexpr std::uint32_t MAX_BAM_FRAME_DELAY_MS = 200;
@@ -67,4 +97,67 @@ namespace isobus
 	{
 		return numberOfPacketsPerCTSMessage;
 	}
+
+	void CANNetworkConfiguration::set_adaptive_transport_protocol_flow_control(bool enabled)
+	{
+		adaptiveTransportProtocolFlowControl = enabled;
+	}
+
+	bool CANNetworkConfiguration::get_adaptive_transport_protocol_flow_control() const
+	{
+		return adaptiveTransportProtocolFlowControl;
+	}
+
+	void CANNetworkConfiguration::set_adaptive_flow_control_target_busload(float busload)
+	{
+		if ((busload >= 1.0f) && (busload <= 100.0f))
+		{
+			adaptiveFlowControlTargetBusload = busload;
+		}
+	}
+
+	float CANNetworkConfiguration::get_adaptive_flow_control_target_busload() const
+	{
+		return adaptiveFlowControlTargetBusload;
+	}
+
+	void CANNetworkConfiguration::set_transport_protocol_transmit_scheduler_frames_per_update(std::uint8_t numberFrames)
+	{
+		transmitSchedulerFramesPerUpdate = numberFrames;
+	}
+
+	std::uint8_t CANNetworkConfiguration::get_transport_protocol_transmit_scheduler_frames_per_update() const
+	{
+		return transmitSchedulerFramesPerUpdate;
+	}
+
+	void CANNetworkConfiguration::set_message_queue_overflow_policy(QueueOverflowPolicy policy)
+	{
+		messageQueueOverflowPolicy = policy;
+	}
+
+	QueueOverflowPolicy CANNetworkConfiguration::get_message_queue_overflow_policy() const
+	{
+		return messageQueueOverflowPolicy;
+	}
+
+	void CANNetworkConfiguration::set_message_queue_capacity(std::size_t capacity)
+	{
+		messageQueueCapacity = (0 != capacity) ? capacity : 1;
+	}
+
+	std::size_t CANNetworkConfiguration::get_message_queue_capacity() const
+	{
+		return messageQueueCapacity;
+	}
+
+	void CANNetworkConfiguration::set_per_port_processing(bool enabled)
+	{
+		perPortProcessing = enabled;
+	}
+
+	bool CANNetworkConfiguration::get_per_port_processing() const
+	{
+		return perPortProcessing;
+	}
 }
@@ -22,8 +22,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstring>
-#include <numeric>
+#include <limits>
 
 namespace isobus
 {
@@ -31,15 +32,25 @@ namespace isobus
 
 	void CANNetworkManager::initialize()
 	{
-		// Clear queues
-		while (!receivedMessageQueue.empty())
-		{
-			get_next_can_message_from_rx_queue();
-		}
-		while (!transmittedMessageQueue.empty())
+		perPortProcessing = configuration.get_per_port_processing();
+
+		for (auto &shard : portProcessingShards)
 		{
-			get_next_can_message_from_tx_queue();
+			if (perPortProcessing && (nullptr == shard))
+			{
+				shard.reset(new PortProcessingShard());
+			}
+
+			if (nullptr != shard)
+			{
+				shard->receivedMessageQueue.set_capacity(configuration.get_message_queue_capacity());
+				shard->transmittedMessageQueue.set_capacity(configuration.get_message_queue_capacity());
+			}
 		}
+
+		// Clear the queues and size them. Nothing is pushed to them until the manager is initialized.
+		receivedMessageQueue.set_capacity(configuration.get_message_queue_capacity());
+		transmittedMessageQueue.set_capacity(configuration.get_message_queue_capacity());
 		initialized = true;
 	}
 
@@ -77,17 +88,12 @@ namespace isobus
 
 	void CANNetworkManager::add_global_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent)
 	{
-		globalParameterGroupNumberCallbacks.emplace_back(parameterGroupNumber, callback, parent, nullptr);
+		globalParameterGroupNumberCallbacks.add(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, nullptr));
 	}
 
 	void CANNetworkManager::remove_global_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent)
 	{
-		ParameterGroupNumberCallbackData tempObject(parameterGroupNumber, callback, parent, nullptr);
-		auto callbackLocation = std::find(globalParameterGroupNumberCallbacks.begin(), globalParameterGroupNumberCallbacks.end(), tempObject);
-		if (globalParameterGroupNumberCallbacks.end() != callbackLocation)
-		{
-			globalParameterGroupNumberCallbacks.erase(callbackLocation);
-		}
+		globalParameterGroupNumberCallbacks.remove(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, nullptr));
 	}
 
 	std::size_t CANNetworkManager::get_number_global_parameter_group_number_callbacks() const
@@ -98,21 +104,16 @@ namespace isobus
 	void CANNetworkManager::add_any_control_function_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent)
 	{
 		LOCK_GUARD(Mutex, anyControlFunctionCallbacksMutex);
-		anyControlFunctionParameterGroupNumberCallbacks.emplace_back(parameterGroupNumber, callback, parent, nullptr);
+		anyControlFunctionParameterGroupNumberCallbacks.add(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, nullptr));
 	}
 
 	void CANNetworkManager::remove_any_control_function_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent)
 	{
-		ParameterGroupNumberCallbackData tempObject(parameterGroupNumber, callback, parent, nullptr);
 		LOCK_GUARD(Mutex, anyControlFunctionCallbacksMutex);
-		auto callbackLocation = std::find(anyControlFunctionParameterGroupNumberCallbacks.begin(), anyControlFunctionParameterGroupNumberCallbacks.end(), tempObject);
-		if (anyControlFunctionParameterGroupNumberCallbacks.end() != callbackLocation)
-		{
-			anyControlFunctionParameterGroupNumberCallbacks.erase(callbackLocation);
-		}
+		anyControlFunctionParameterGroupNumberCallbacks.remove(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, nullptr));
 	}
 
-	EventDispatcher<CANMessage> &CANNetworkManager::get_transmitted_message_event_dispatcher()
+	LockFreeEventDispatcher<CANMessage> &CANNetworkManager::get_transmitted_message_event_dispatcher()
 	{
 		return messageTransmittedEventDispatcher;
 	}
@@ -137,13 +138,66 @@ namespace isobus
 
 		if (canChannel < CAN_PORT_MAXIMUM)
 		{
-			float totalTimeInAccumulatorWindow = (busloadMessageBitsHistory.at(canChannel).size() * BUSLOAD_UPDATE_FREQUENCY_MS) / 1000.0f;
-			std::uint32_t totalBitCount = std::accumulate(busloadMessageBitsHistory.at(canChannel).begin(), busloadMessageBitsHistory.at(canChannel).end(), 0);
+			const ChannelTraffic &traffic = channelTraffic[canChannel];
+			float totalTimeInAccumulatorWindow = (traffic.numberOfSamples * BUSLOAD_UPDATE_FREQUENCY_MS) / 1000.0f;
+			std::uint32_t totalBitCount = 0;
+
+			for (std::size_t i = 0; i < traffic.numberOfSamples; i++)
+			{
+				totalBitCount += traffic.history[i].numberOfBits;
+			}
 			retVal = (0 != totalTimeInAccumulatorWindow) ? ((totalBitCount / (totalTimeInAccumulatorWindow * ISOBUS_BAUD_RATE_BPS)) * 100.0f) : 0.0f;
 		}
 		return retVal;
 	}
 
+	bool CANNetworkManager::get_channel_metrics(std::uint8_t canChannel, CANChannelMetrics &metrics)
+	{
+		bool retVal = false;
+
+		if (canChannel < CAN_PORT_MAXIMUM)
+		{
+			metrics.busload = get_estimated_busload(canChannel);
+
+			LOCK_GUARD(Mutex, busloadUpdateMutex);
+			const ChannelTraffic &traffic = channelTraffic[canChannel];
+			TrafficSample totals;
+
+			// The samples in the ring make up the last second, since that's the busload window
+			for (std::size_t i = 0; i < traffic.numberOfSamples; i++)
+			{
+				totals.receivedFrames += traffic.history[i].receivedFrames;
+				totals.transmittedFrames += traffic.history[i].transmittedFrames;
+				totals.receivedBytes += traffic.history[i].receivedBytes;
+				totals.transmittedBytes += traffic.history[i].transmittedBytes;
+			}
+			metrics.receivedFramesPerSecond = totals.receivedFrames;
+			metrics.transmittedFramesPerSecond = totals.transmittedFrames;
+			metrics.receivedBytesPerSecond = totals.receivedBytes;
+			metrics.transmittedBytesPerSecond = totals.transmittedBytes;
+			metrics.totalReceivedFrames = traffic.totalReceivedFrames;
+			metrics.totalTransmittedFrames = traffic.totalTransmittedFrames;
+			metrics.receiveLatencyHistogram = traffic.receiveLatencyHistogram;
+			metrics.framesWithUnusableTimestamp = traffic.framesWithUnusableTimestamp;
+
+			metrics.parameterGroupNumberRates.clear();
+			for (const auto &frameCount : traffic.parameterGroupNumberFrameCounts)
+			{
+				if (0 != frameCount.second.previousWindow)
+				{
+					metrics.parameterGroupNumberRates.push_back({ frameCount.first, frameCount.second.previousWindow });
+				}
+			}
+			std::sort(metrics.parameterGroupNumberRates.begin(),
+			          metrics.parameterGroupNumberRates.end(),
+			          [](const CANChannelMetrics::ParameterGroupNumberRate &lhs, const CANChannelMetrics::ParameterGroupNumberRate &rhs) {
+				          return lhs.parameterGroupNumber < rhs.parameterGroupNumber;
+			          });
+			retVal = true;
+		}
+		return retVal;
+	}
+
 	bool CANNetworkManager::send_can_message(std::uint32_t parameterGroupNumber,
 	                                         const std::uint8_t *dataBuffer,
 	                                         std::uint32_t dataLength,
@@ -178,7 +232,8 @@ namespace isobus
 			                                                                                         sourceControlFunction,
 			                                                                                         destinationControlFunction,
 			                                                                                         transmitCompleteCallback,
-			                                                                                         parentPointer))
+			                                                                                         parentPointer,
+			                                                                                         priority))
 			{
 				// Successfully sent via the transport protocol
 				retVal = true;
@@ -188,7 +243,8 @@ namespace isobus
 			                                                                                                      sourceControlFunction,
 			                                                                                                      destinationControlFunction,
 			                                                                                                      transmitCompleteCallback,
-			                                                                                                      parentPointer))
+			                                                                                                      parentPointer,
+			                                                                                                      priority))
 			{
 				// Successfully sent via the extended transport protocol
 				retVal = true;
@@ -221,8 +277,7 @@ namespace isobus
 
 	void CANNetworkManager::update()
 	{
-		auto &processingMutex = ControlFunction::controlFunctionProcessingMutex;
-		LOCK_GUARD(Mutex, processingMutex);
+		LOCK_GUARD(Mutex, controlFunctionProcessingMutex);
 
 		if (!initialized)
 		{
@@ -231,30 +286,109 @@ namespace isobus
 
 		update_new_partners();
 
-		process_rx_messages();
+		if (perPortProcessing)
+		{
+			// Each port is processed by update(canPortIndex), so only update what is shared between ports
+			update_internal_cfs();
+		}
+		else
+		{
+			receivedMessageQueue.set_overflow_policy(configuration.get_message_queue_overflow_policy());
+			transmittedMessageQueue.set_overflow_policy(configuration.get_message_queue_overflow_policy());
+			process_rx_messages(receivedMessageQueue, currentReceivedMessage, false);
+
+			// Update ISOBUS heartbeats (should be done before process_tx_messages
+			// to minimize latency in safety critical paths)
+			for (std::uint32_t i = 0; i < CAN_PORT_MAXIMUM; i++)
+			{
+				heartBeatInterfaces.at(i)->update();
+			}
+
+			process_tx_messages(transmittedMessageQueue, currentTransmittedMessage);
+
+			update_internal_cfs();
+
+			prune_inactive_control_functions();
+
+			// Update transport protocols
+			for (std::uint8_t i = 0; i < CAN_PORT_MAXIMUM; i++)
+			{
+				transportProtocolFlowControls[i]->update(get_estimated_busload(i));
+				transportProtocols[i]->update();
+				extendedTransportProtocols[i]->update();
+				fastPacketProtocol[i]->update();
+				transportProtocolTransmitSchedulers[i]->update();
+				update_next_update_deadline(i);
+			}
+		}
+		update_traffic_history();
+		updateTimestamp_ms = SystemTiming::get_timestamp_ms();
+	}
 
-		// Update ISOBUS heartbeats (should be done before process_tx_messages
-		// to minimize latency in safety critical paths)
-		for (std::uint32_t i = 0; i < CAN_PORT_MAXIMUM; i++)
+	void CANNetworkManager::update(std::uint8_t canPortIndex)
+	{
+		PortProcessingShard *shard = nullptr;
+		{
+			LOCK_GUARD(Mutex, controlFunctionProcessingMutex);
+
+			if (initialized && perPortProcessing && (canPortIndex < CAN_PORT_MAXIMUM))
+			{
+				shard = portProcessingShards[canPortIndex].get();
+			}
+		}
+
+		if (nullptr != shard)
 		{
-			heartBeatInterfaces.at(i)->update();
+			auto &portProcessingMutex = shard->processingMutex;
+			LOCK_GUARD(Mutex, portProcessingMutex);
+			(void)portProcessingMutex; // Only used by the lock guard, which is empty if threads are disabled
+
+			shard->receivedMessageQueue.set_overflow_policy(configuration.get_message_queue_overflow_policy());
+			shard->transmittedMessageQueue.set_overflow_policy(configuration.get_message_queue_overflow_policy());
+			process_rx_messages(shard->receivedMessageQueue, shard->currentReceivedMessage, true);
+
+			// Update the ISOBUS heartbeat before processing transmitted messages, same as in update()
+			heartBeatInterfaces.at(canPortIndex)->update();
+
+			process_tx_messages(shard->transmittedMessageQueue, shard->currentTransmittedMessage);
+
+			{
+				LOCK_GUARD(Mutex, controlFunctionProcessingMutex);
+				prune_inactive_control_functions(canPortIndex);
+			}
+
+			transportProtocolFlowControls[canPortIndex]->update(get_estimated_busload(canPortIndex));
+			transportProtocols[canPortIndex]->update();
+			extendedTransportProtocols[canPortIndex]->update();
+			fastPacketProtocol[canPortIndex]->update();
+			transportProtocolTransmitSchedulers[canPortIndex]->update();
+			update_next_update_deadline(canPortIndex);
 		}
+	}
 
-		process_tx_messages();
+	std::uint64_t CANNetworkManager::get_next_update_deadline_us() const
+	{
+		std::uint64_t retVal = std::numeric_limits<std::uint64_t>::max();
 
-		update_internal_cfs();
+		if (!perPortProcessing)
+		{
+			for (const auto &deadline_us : nextUpdateDeadlines_us)
+			{
+				retVal = std::min(retVal, deadline_us.load());
+			}
+		}
+		return retVal;
+	}
 
-		prune_inactive_control_functions();
+	std::uint64_t CANNetworkManager::get_next_update_deadline_us(std::uint8_t canPortIndex) const
+	{
+		std::uint64_t retVal = std::numeric_limits<std::uint64_t>::max();
 
-		// Update transport protocols
-		for (std::uint32_t i = 0; i < CAN_PORT_MAXIMUM; i++)
+		if (perPortProcessing && (canPortIndex < CAN_PORT_MAXIMUM))
 		{
-			transportProtocols[i]->update();
-			extendedTransportProtocols[i]->update();
-			fastPacketProtocol[i]->update();
+			retVal = nextUpdateDeadlines_us[canPortIndex].load();
 		}
-		update_busload_history();
-		updateTimestamp_ms = SystemTiming::get_timestamp_ms();
+		return retVal;
 	}
 
 	bool CANNetworkManager::send_can_message_raw(std::uint32_t portIndex,
@@ -275,7 +409,7 @@ namespace isobus
 
 		if (index < get_number_global_parameter_group_number_callbacks())
 		{
-			retVal = globalParameterGroupNumberCallbacks[index];
+			retVal = globalParameterGroupNumberCallbacks.get(index);
 		}
 		return retVal;
 	}
@@ -295,57 +429,73 @@ namespace isobus
 		CANNetworkManager::CANNetwork.update();
 	}
 
+	void periodic_update_from_hardware(std::uint8_t channelIndex)
+	{
+		CANNetworkManager::CANNetwork.update(channelIndex);
+	}
+
+	std::uint64_t get_next_update_deadline_from_hardware()
+	{
+		return CANNetworkManager::CANNetwork.get_next_update_deadline_us();
+	}
+
+	std::uint64_t get_next_update_deadline_from_hardware(std::uint8_t channelIndex)
+	{
+		return CANNetworkManager::CANNetwork.get_next_update_deadline_us(channelIndex);
+	}
+
 	void CANNetworkManager::process_receive_can_message_frame(const CANMessageFrame &rxFrame)
 	{
-		update_control_functions(rxFrame);
+		const CANIdentifier identifier(rxFrame.identifier);
+		std::shared_ptr<ControlFunction> source;
+		std::shared_ptr<ControlFunction> destination;
+
+		{
+			// Frames of different ports may be received on different threads, and the control function tables are shared between them.
+			// Only the table accesses are locked, so that a frame doesn't wait for a whole update of the stack more than needed.
+			LOCK_GUARD(Mutex, controlFunctionProcessingMutex);
+			update_control_functions(rxFrame);
 
-		CANIdentifier identifier(rxFrame.identifier);
-		CANMessage message(CANMessage::Type::Receive,
-		                   identifier,
-		                   rxFrame.data,
-		                   rxFrame.dataLength,
-		                   get_control_function(rxFrame.channel, identifier.get_source_address()),
-		                   get_control_function(rxFrame.channel, identifier.get_destination_address()),
-		                   rxFrame.channel);
+			if (initialized)
+			{
+				source = get_control_function(rxFrame.channel, identifier.get_source_address());
+				destination = get_control_function(rxFrame.channel, identifier.get_destination_address());
+			}
+		}
 
-		update_busload(rxFrame.channel, rxFrame.get_number_bits_in_message());
+		update_traffic_metrics(rxFrame, false);
 
 		if (initialized)
 		{
-			LOCK_GUARD(Mutex, receivedMessageQueueMutex);
-			receivedMessageQueue.push(std::move(message));
+			get_received_message_queue(rxFrame.channel).push(CANMessage::Type::Receive, rxFrame, std::move(source), std::move(destination));
 		}
 	}
 
 	void CANNetworkManager::process_transmitted_can_message_frame(const CANMessageFrame &txFrame)
 	{
-		update_busload(txFrame.channel, txFrame.get_number_bits_in_message());
-
-		CANIdentifier identifier(txFrame.identifier);
-		CANMessage message(CANMessage::Type::Transmit,
-		                   identifier,
-		                   txFrame.data,
-		                   txFrame.dataLength,
-		                   get_control_function(txFrame.channel, identifier.get_source_address()),
-		                   get_control_function(txFrame.channel, identifier.get_destination_address()),
-		                   txFrame.channel);
+		update_traffic_metrics(txFrame, true);
 
 		if (initialized)
 		{
+			const CANIdentifier identifier(txFrame.identifier);
+			std::shared_ptr<ControlFunction> source;
+			std::shared_ptr<ControlFunction> destination;
+
 			{
-				LOCK_GUARD(Mutex, transmittedMessageQueueMutex);
-				transmittedMessageQueue.push(message);
+				LOCK_GUARD(Mutex, controlFunctionProcessingMutex);
+				source = get_control_function(txFrame.channel, identifier.get_source_address());
+				destination = get_control_function(txFrame.channel, identifier.get_destination_address());
 			}
 
 			// We need to receive manual requests for the address claim PGN.
-			if ((CANIdentifier::Type::Extended == message.get_identifier().get_identifier_type()) &&
-			    (static_cast<std::uint32_t>(CANLibParameterGroupNumber::ParameterGroupNumberRequest) == message.get_identifier().get_parameter_group_number()) &&
-			    (3 == message.get_data_length()) &&
-			    (static_cast<std::uint32_t>(CANLibParameterGroupNumber::AddressClaim) == message.get_data_custom_length(0, 24)))
+			if (txFrame.isExtendedFrame &&
+			    (static_cast<std::uint32_t>(CANLibParameterGroupNumber::ParameterGroupNumberRequest) == identifier.get_parameter_group_number()) &&
+			    (3 == txFrame.dataLength) &&
+			    (static_cast<std::uint32_t>(CANLibParameterGroupNumber::AddressClaim) == (txFrame.data[0] | (static_cast<std::uint32_t>(txFrame.data[1]) << 8) | (static_cast<std::uint32_t>(txFrame.data[2]) << 16))))
 			{
-				LOCK_GUARD(Mutex, receivedMessageQueueMutex);
-				receivedMessageQueue.push(std::move(message));
+				get_received_message_queue(txFrame.channel).push(CANMessage::Type::Transmit, txFrame, source, destination);
 			}
+			get_transmitted_message_queue(txFrame.channel).push(CANMessage::Type::Transmit, txFrame, std::move(source), std::move(destination));
 		}
 	}
 
@@ -453,6 +603,24 @@ namespace isobus
 		return fastPacketProtocol[canPortIndex];
 	}
 
+	const TransportProtocolMemoryBudget &CANNetworkManager::get_transport_protocol_memory_budget(std::uint8_t canPortIndex) const
+	{
+		assert(canPortIndex < CAN_PORT_MAXIMUM); // You passed in an out of range index!
+		return *transportProtocolMemoryBudgets.at(canPortIndex);
+	}
+
+	const TransportProtocolFlowControl &CANNetworkManager::get_transport_protocol_flow_control(std::uint8_t canPortIndex) const
+	{
+		assert(canPortIndex < CAN_PORT_MAXIMUM); // You passed in an out of range index!
+		return *transportProtocolFlowControls.at(canPortIndex);
+	}
+
+	const TransportProtocolTransmitScheduler &CANNetworkManager::get_transport_protocol_transmit_scheduler(std::uint8_t canPortIndex) const
+	{
+		assert(canPortIndex < CAN_PORT_MAXIMUM); // You passed in an out of range index!
+		return *transportProtocolTransmitSchedulers.at(canPortIndex);
+	}
+
 	HeartbeatInterface &CANNetworkManager::get_heartbeat_interface(std::uint8_t canPortIndex)
 	{
 		assert(canPortIndex < CAN_PORT_MAXIMUM); // You passed in an out of range index!
@@ -469,6 +637,34 @@ namespace isobus
 		return addressViolationEventDispatcher;
 	}
 
+	std::size_t CANNetworkManager::get_number_of_dropped_received_messages() const
+	{
+		std::size_t retVal = receivedMessageQueue.get_overflow_count();
+
+		for (const auto &shard : portProcessingShards)
+		{
+			if (nullptr != shard)
+			{
+				retVal += shard->receivedMessageQueue.get_overflow_count();
+			}
+		}
+		return retVal;
+	}
+
+	std::size_t CANNetworkManager::get_number_of_dropped_transmitted_messages() const
+	{
+		std::size_t retVal = transmittedMessageQueue.get_overflow_count();
+
+		for (const auto &shard : portProcessingShards)
+		{
+			if (nullptr != shard)
+			{
+				retVal += shard->transmittedMessageQueue.get_overflow_count();
+			}
+		}
+		return retVal;
+	}
+
 	bool CANNetworkManager::send_request_for_address_claim(std::uint8_t canPortIndex) const
 	{
 		const auto parameterGroupNumber = static_cast<std::uint32_t>(CANLibParameterGroupNumber::AddressClaim);
@@ -496,9 +692,9 @@ namespace isobus
 		bool retVal = false;
 		ParameterGroupNumberCallbackData callbackInfo(parameterGroupNumber, callback, parentPointer, nullptr);
 		LOCK_GUARD(Mutex, protocolPGNCallbacksMutex);
-		if ((nullptr != callback) && (protocolPGNCallbacks.end() == find(protocolPGNCallbacks.begin(), protocolPGNCallbacks.end(), callbackInfo)))
+		if ((nullptr != callback) && (!protocolPGNCallbacks.contains(callbackInfo)))
 		{
-			protocolPGNCallbacks.push_back(callbackInfo);
+			protocolPGNCallbacks.add(callbackInfo);
 			retVal = true;
 		}
 		return retVal;
@@ -511,23 +707,19 @@ namespace isobus
 		LOCK_GUARD(Mutex, protocolPGNCallbacksMutex);
 		if (nullptr != callback)
 		{
-			std::list<ParameterGroupNumberCallbackData>::iterator callbackLocation;
-			callbackLocation = find(protocolPGNCallbacks.begin(), protocolPGNCallbacks.end(), callbackInfo);
-
-			if (protocolPGNCallbacks.end() != callbackLocation)
-			{
-				protocolPGNCallbacks.erase(callbackLocation);
-				retVal = true;
-			}
+			retVal = protocolPGNCallbacks.remove(callbackInfo);
 		}
 		return retVal;
 	}
 
 	CANNetworkManager::CANNetworkManager()
 	{
-		currentBusloadBitAccumulator.fill(0);
 		lastAddressClaimRequestTimestamp_ms.fill(0);
 		controlFunctionTable.fill({ nullptr });
+		for (auto &deadline_us : nextUpdateDeadlines_us)
+		{
+			deadline_us = std::numeric_limits<std::uint64_t>::max();
+		}
 
 		auto send_frame_callback = [this](std::uint32_t parameterGroupNumber,
 		                                  CANDataSpan data,
@@ -547,9 +739,24 @@ namespace isobus
 				                       i);
 				this->protocol_message_callback(message);
 			};
-			transportProtocols.at(i).reset(new TransportProtocolManager(send_frame_callback, receive_message_callback, &configuration));
-			extendedTransportProtocols.at(i).reset(new ExtendedTransportProtocolManager(send_frame_callback, receive_message_callback, &configuration));
-			fastPacketProtocol.at(i).reset(new FastPacketProtocol(send_frame_callback));
+			transportProtocolMemoryBudgets.at(i).reset(new TransportProtocolMemoryBudget(&configuration));
+			transportProtocolFlowControls.at(i).reset(new TransportProtocolFlowControl(&configuration));
+			transportProtocolTransmitSchedulers.at(i).reset(new TransportProtocolTransmitScheduler(&configuration, transportProtocolFlowControls.at(i).get()));
+			transportProtocols.at(i).reset(new TransportProtocolManager(send_frame_callback,
+			                                                            receive_message_callback,
+			                                                            &configuration,
+			                                                            transportProtocolMemoryBudgets.at(i).get(),
+			                                                            transportProtocolFlowControls.at(i).get(),
+			                                                            transportProtocolTransmitSchedulers.at(i).get()));
+			extendedTransportProtocols.at(i).reset(new ExtendedTransportProtocolManager(send_frame_callback,
+			                                                                            receive_message_callback,
+			                                                                            &configuration,
+			                                                                            transportProtocolMemoryBudgets.at(i).get(),
+			                                                                            transportProtocolFlowControls.at(i).get(),
+			                                                                            transportProtocolTransmitSchedulers.at(i).get()));
+			fastPacketProtocol.at(i).reset(new FastPacketProtocol(send_frame_callback,
+			                                                      transportProtocolMemoryBudgets.at(i).get(),
+			                                                      transportProtocolTransmitSchedulers.at(i).get()));
 			heartBeatInterfaces.at(i).reset(new HeartbeatInterface(send_frame_callback));
 		}
 	}
@@ -682,31 +889,122 @@ namespace isobus
 		}
 	}
 
-	void CANNetworkManager::update_busload(std::uint8_t channelIndex, std::uint32_t numberOfBitsProcessed)
+	void CANNetworkManager::update_traffic_metrics(const CANMessageFrame &frame, bool transmitted)
 	{
-		LOCK_GUARD(Mutex, busloadUpdateMutex);
-		currentBusloadBitAccumulator.at(channelIndex) += numberOfBitsProcessed;
+		if (frame.channel < CAN_PORT_MAXIMUM)
+		{
+			LOCK_GUARD(Mutex, busloadUpdateMutex);
+			ChannelTraffic &traffic = channelTraffic[frame.channel];
+
+			traffic.currentSample.numberOfBits += frame.get_number_bits_in_message();
+			if (transmitted)
+			{
+				traffic.currentSample.transmittedFrames++;
+				traffic.currentSample.transmittedBytes += frame.dataLength;
+				traffic.totalTransmittedFrames++;
+			}
+			else
+			{
+				traffic.currentSample.receivedFrames++;
+				traffic.currentSample.receivedBytes += frame.dataLength;
+				traffic.totalReceivedFrames++;
+			}
+			traffic.parameterGroupNumberFrameCounts[CANIdentifier(frame.identifier).get_parameter_group_number()].currentWindow++;
+		}
 	}
 
-	void CANNetworkManager::update_busload_history()
+	void CANNetworkManager::update_traffic_history()
 	{
 		LOCK_GUARD(Mutex, busloadUpdateMutex);
 		if (SystemTiming::time_expired_ms(busloadUpdateTimestamp_ms, BUSLOAD_UPDATE_FREQUENCY_MS))
 		{
-			for (std::size_t i = 0; i < busloadMessageBitsHistory.size(); i++)
+			for (auto &traffic : channelTraffic)
 			{
-				busloadMessageBitsHistory.at(i).push_back(currentBusloadBitAccumulator.at(i));
+				traffic.history[traffic.nextSampleIndex] = traffic.currentSample;
+				traffic.currentSample = TrafficSample();
+				traffic.nextSampleIndex = (traffic.nextSampleIndex + 1) % traffic.history.size();
+
+				if (traffic.numberOfSamples < traffic.history.size())
+				{
+					traffic.numberOfSamples++;
+				}
 
-				while (busloadMessageBitsHistory.at(i).size() > (BUSLOAD_SAMPLE_WINDOW_MS / BUSLOAD_UPDATE_FREQUENCY_MS))
+				if (0 == traffic.nextSampleIndex)
 				{
-					busloadMessageBitsHistory.at(i).pop_front();
+					// A full busload window has passed, so start counting the PGNs for the next one
+					for (auto frameCount = traffic.parameterGroupNumberFrameCounts.begin(); frameCount != traffic.parameterGroupNumberFrameCounts.end();)
+					{
+						if ((0 == frameCount->second.currentWindow) && (0 == frameCount->second.previousWindow))
+						{
+							frameCount = traffic.parameterGroupNumberFrameCounts.erase(frameCount);
+						}
+						else
+						{
+							frameCount->second.previousWindow = frameCount->second.currentWindow;
+							frameCount->second.currentWindow = 0;
+							frameCount++;
+						}
+					}
 				}
-				currentBusloadBitAccumulator.at(i) = 0;
 			}
 			busloadUpdateTimestamp_ms = SystemTiming::get_timestamp_ms();
 		}
 	}
 
+	void CANNetworkManager::update_next_update_deadline(std::uint8_t canPortIndex)
+	{
+		std::uint32_t delay_ms = heartBeatInterfaces.at(canPortIndex)->get_time_until_next_deadline_ms();
+		delay_ms = std::min(delay_ms, transportProtocols[canPortIndex]->get_time_until_next_deadline_ms());
+		delay_ms = std::min(delay_ms, extendedTransportProtocols[canPortIndex]->get_time_until_next_deadline_ms());
+		delay_ms = std::min(delay_ms, fastPacketProtocol[canPortIndex]->get_time_until_next_deadline_ms());
+
+		if (std::numeric_limits<std::uint32_t>::max() == delay_ms)
+		{
+			nextUpdateDeadlines_us[canPortIndex] = std::numeric_limits<std::uint64_t>::max();
+		}
+		else
+		{
+			// A timer that has already expired is retried a millisecond later rather than straight away, so a
+			// session that can't make progress doesn't keep the update thread spinning
+			nextUpdateDeadlines_us[canPortIndex] = SystemTiming::get_timestamp_us() + (static_cast<std::uint64_t>(std::max<std::uint32_t>(delay_ms, 1)) * 1000);
+		}
+	}
+
+	void CANNetworkManager::update_receive_latency(const CANMessage &message)
+	{
+		const std::uint64_t frameTimestamp_us = message.get_timestamp_us();
+		const std::uint64_t systemTimestamp_us = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+
+		// A zero timestamp means the driver doesn't timestamp frames at all, so there's nothing to count
+		if ((CANMessage::Type::Receive == message.get_type()) &&
+		    (message.get_can_port_index() < CAN_PORT_MAXIMUM) &&
+		    (0 != frameTimestamp_us))
+		{
+			ChannelTraffic &traffic = channelTraffic[message.get_can_port_index()];
+
+			if ((frameTimestamp_us <= systemTimestamp_us) &&
+			    ((systemTimestamp_us - frameTimestamp_us) < MAXIMUM_RECEIVE_LATENCY_US))
+			{
+				const std::uint64_t latency_us = systemTimestamp_us - frameTimestamp_us;
+				std::size_t bucketIndex = 0;
+
+				while ((bucketIndex < (CANChannelMetrics::NUMBER_OF_LATENCY_BUCKETS - 1)) &&
+				       (latency_us >= CANChannelMetrics::get_latency_bucket_limit_us(bucketIndex)))
+				{
+					bucketIndex++;
+				}
+
+				LOCK_GUARD(Mutex, busloadUpdateMutex);
+				traffic.receiveLatencyHistogram[bucketIndex]++;
+			}
+			else
+			{
+				LOCK_GUARD(Mutex, busloadUpdateMutex);
+				traffic.framesWithUnusableTimestamp++;
+			}
+		}
+	}
+
 	void CANNetworkManager::update_control_functions(const CANMessageFrame &rxFrame)
 	{
 		if ((static_cast<std::uint32_t>(CANLibParameterGroupNumber::AddressClaim) == CANIdentifier(rxFrame.identifier).get_parameter_group_number()) &&
@@ -981,38 +1279,31 @@ namespace isobus
 		return retVal;
 	}
 
-	CANMessage CANNetworkManager::get_next_can_message_from_rx_queue()
+	CANMessageQueue &CANNetworkManager::get_received_message_queue(std::uint8_t canPortIndex)
 	{
-		LOCK_GUARD(Mutex, receivedMessageQueueMutex);
-		if (!receivedMessageQueue.empty())
+		if (perPortProcessing && (canPortIndex < CAN_PORT_MAXIMUM) && (nullptr != portProcessingShards[canPortIndex]))
 		{
-			CANMessage retVal = std::move(receivedMessageQueue.front());
-			receivedMessageQueue.pop();
-			return retVal;
+			return portProcessingShards[canPortIndex]->receivedMessageQueue;
 		}
-		return CANMessage::create_invalid_message();
+		return receivedMessageQueue;
 	}
 
-	CANMessage CANNetworkManager::get_next_can_message_from_tx_queue()
+	CANMessageQueue &CANNetworkManager::get_transmitted_message_queue(std::uint8_t canPortIndex)
 	{
-		LOCK_GUARD(Mutex, transmittedMessageQueueMutex);
-		if (!transmittedMessageQueue.empty())
+		if (perPortProcessing && (canPortIndex < CAN_PORT_MAXIMUM) && (nullptr != portProcessingShards[canPortIndex]))
 		{
-			CANMessage retVal = std::move(transmittedMessageQueue.front());
-			transmittedMessageQueue.pop();
-			return retVal;
+			return portProcessingShards[canPortIndex]->transmittedMessageQueue;
 		}
-		return CANMessage::create_invalid_message();
+		return transmittedMessageQueue;
 	}
 
 	void CANNetworkManager::process_any_control_function_pgn_callbacks(const CANMessage &currentMessage)
 	{
-		LOCK_GUARD(Mutex, anyControlFunctionCallbacksMutex);
-		for (const auto &currentCallback : anyControlFunctionParameterGroupNumberCallbacks)
+		if ((nullptr == currentMessage.get_destination_control_function()) ||
+		    (ControlFunction::Type::Internal == currentMessage.get_destination_control_function()->get_type()))
 		{
-			if ((currentCallback.get_parameter_group_number() == currentMessage.get_identifier().get_parameter_group_number()) &&
-			    ((nullptr == currentMessage.get_destination_control_function()) ||
-			     (ControlFunction::Type::Internal == currentMessage.get_destination_control_function()->get_type())))
+			LOCK_GUARD(Mutex, anyControlFunctionCallbacksMutex);
+			for (const auto &currentCallback : anyControlFunctionParameterGroupNumberCallbacks.get_callbacks(currentMessage.get_identifier().get_parameter_group_number()))
 			{
 				currentCallback.get_callback()(currentMessage, currentCallback.get_parent());
 			}
@@ -1043,12 +1334,9 @@ namespace isobus
 	void CANNetworkManager::process_protocol_pgn_callbacks(const CANMessage &currentMessage)
 	{
 		LOCK_GUARD(Mutex, protocolPGNCallbacksMutex);
-		for (const auto &currentCallback : protocolPGNCallbacks)
+		for (const auto &currentCallback : protocolPGNCallbacks.get_callbacks(currentMessage.get_identifier().get_parameter_group_number()))
 		{
-			if (currentCallback.get_parameter_group_number() == currentMessage.get_identifier().get_parameter_group_number())
-			{
-				currentCallback.get_callback()(currentMessage, currentCallback.get_parent());
-			}
+			currentCallback.get_callback()(currentMessage, currentCallback.get_parent());
 		}
 	}
 
@@ -1062,53 +1350,60 @@ namespace isobus
 		     ((static_cast<std::uint32_t>(CANLibParameterGroupNumber::ParameterGroupNumberRequest) == message.get_identifier().get_parameter_group_number()) &&
 		      (NULL_CAN_ADDRESS == message.get_identifier().get_source_address()))))
 		{
-			// Message destined to global
-			for (std::size_t i = 0; i < get_number_global_parameter_group_number_callbacks(); i++)
+			// Message destined to global.
+			// Iterate by index, since a callback is allowed to add or remove global callbacks.
+			const auto &matchingCallbacks = globalParameterGroupNumberCallbacks.get_callbacks(message.get_identifier().get_parameter_group_number());
+			for (std::size_t i = 0; i < matchingCallbacks.size(); i++)
 			{
-				if ((message.get_identifier().get_parameter_group_number() == get_global_parameter_group_number_callback(i).get_parameter_group_number()) &&
-				    (nullptr != get_global_parameter_group_number_callback(i).get_callback()))
+				if (nullptr != matchingCallbacks[i].get_callback())
 				{
 					// We have a callback that matches this PGN
-					get_global_parameter_group_number_callback(i).get_callback()(message, get_global_parameter_group_number_callback(i).get_parent());
+					matchingCallbacks[i].get_callback()(message, matchingCallbacks[i].get_parent());
 				}
 			}
 		}
-		else if ((messageDestination != nullptr) && (messageDestination->get_type() == ControlFunction::Type::Internal))
+		else if ((messageDestination != nullptr) &&
+		         (messageDestination->get_type() == ControlFunction::Type::Internal) &&
+		         (nullptr != messageSource) &&
+		         (ControlFunction::Type::Partnered == messageSource->get_type()) &&
+		         (messageSource->get_can_port() == message.get_can_port_index()))
 		{
-			// Message is destined to us
-			for (const auto &partner : partneredControlFunctions)
+			// Message is destined to us, from a partnered control function
+			auto partner = std::static_pointer_cast<PartneredControlFunction>(messageSource);
+			const auto &matchingCallbacks = partner->parameterGroupNumberCallbacks.get_callbacks(message.get_identifier().get_parameter_group_number());
+			for (std::size_t i = 0; i < matchingCallbacks.size(); i++)
 			{
-				if ((nullptr != partner) &&
-				    (partner->get_can_port() == message.get_can_port_index()) &&
-				    (partner == messageSource))
+				if ((nullptr != matchingCallbacks[i].get_callback()) &&
+				    ((nullptr == matchingCallbacks[i].get_internal_control_function()) ||
+				     (matchingCallbacks[i].get_internal_control_function()->get_address() == message.get_identifier().get_destination_address())))
 				{
-					// Message matches CAN port for a partnered control function
-					for (std::size_t k = 0; k < partner->get_number_parameter_group_number_callbacks(); k++)
-					{
-						if ((message.get_identifier().get_parameter_group_number() == partner->get_parameter_group_number_callback(k).get_parameter_group_number()) &&
-						    (nullptr != partner->get_parameter_group_number_callback(k).get_callback()) &&
-						    ((nullptr == partner->get_parameter_group_number_callback(k).get_internal_control_function()) ||
-						     (partner->get_parameter_group_number_callback(k).get_internal_control_function()->get_address() == message.get_identifier().get_destination_address())))
-						{
-							// We have a callback matching this message
-							partner->get_parameter_group_number_callback(k).get_callback()(message, partner->get_parameter_group_number_callback(k).get_parent());
-						}
-					}
+					// We have a callback matching this message
+					matchingCallbacks[i].get_callback()(message, matchingCallbacks[i].get_parent());
 				}
 			}
 		}
 	}
 
-	void CANNetworkManager::process_rx_messages()
+	void CANNetworkManager::process_rx_messages(CANMessageQueue &queue, CANMessage &currentMessage, bool lockControlFunctions)
 	{
-		// We may miss a message without locking the mutex when checking if empty, but that's okay. It will be picked up on the next iteration
-		while (!receivedMessageQueue.empty())
+		// The current message is swapped with the front of the queue, so its buffer gets recycled for a future frame
+		while (queue.pop(currentMessage))
 		{
-			CANMessage currentMessage = get_next_can_message_from_rx_queue();
+			if (lockControlFunctions)
+			{
+				LOCK_GUARD(Mutex, controlFunctionProcessingMutex);
+				update_address_table(currentMessage);
+				process_can_message_for_address_violations(currentMessage);
+				process_rx_message_for_address_claiming(currentMessage);
+			}
+			else
+			{
+				update_address_table(currentMessage);
+				process_can_message_for_address_violations(currentMessage);
+				process_rx_message_for_address_claiming(currentMessage);
+			}
 
-			update_address_table(currentMessage);
-			process_can_message_for_address_violations(currentMessage);
-			process_rx_message_for_address_claiming(currentMessage);
+			update_receive_latency(currentMessage);
 
 			// Update Special Callbacks, like protocols and non-cf specific ones
 			transportProtocols.at(currentMessage.get_can_port_index())->process_message(currentMessage);
@@ -1123,13 +1418,11 @@ namespace isobus
 		}
 	}
 
-	void CANNetworkManager::process_tx_messages()
+	void CANNetworkManager::process_tx_messages(CANMessageQueue &queue, CANMessage &currentMessage)
 	{
-		// We may miss a message without locking the mutex when checking if empty, but that's okay. It will be picked up on the next iteration
-		while (!transmittedMessageQueue.empty())
+		// The current message is swapped with the front of the queue, so its buffer gets recycled for a future frame
+		while (queue.pop(currentMessage))
 		{
-			CANMessage currentMessage = get_next_can_message_from_tx_queue();
-
 			// Update listen-only callbacks
 			messageTransmittedEventDispatcher.call(currentMessage);
 		}
@@ -1139,31 +1432,36 @@ namespace isobus
 	{
 		for (std::uint_fast8_t channelIndex = 0; channelIndex < CAN_PORT_MAXIMUM; channelIndex++)
 		{
-			constexpr std::uint32_t MAX_ADDRESS_CLAIM_RESOLUTION_TIME = 755; // This is 250ms + RTxD + 250ms
-			if ((0 != lastAddressClaimRequestTimestamp_ms.at(channelIndex)) &&
-			    (SystemTiming::time_expired_ms(lastAddressClaimRequestTimestamp_ms.at(channelIndex), MAX_ADDRESS_CLAIM_RESOLUTION_TIME)))
+			prune_inactive_control_functions(channelIndex);
+		}
+	}
+
+	void CANNetworkManager::prune_inactive_control_functions(std::uint8_t channelIndex)
+	{
+		constexpr std::uint32_t MAX_ADDRESS_CLAIM_RESOLUTION_TIME = 755; // This is 250ms + RTxD + 250ms
+		if ((0 != lastAddressClaimRequestTimestamp_ms.at(channelIndex)) &&
+		    (SystemTiming::time_expired_ms(lastAddressClaimRequestTimestamp_ms.at(channelIndex), MAX_ADDRESS_CLAIM_RESOLUTION_TIME)))
+		{
+			for (std::uint_fast8_t i = 0; i < NULL_CAN_ADDRESS; i++)
 			{
-				for (std::uint_fast8_t i = 0; i < NULL_CAN_ADDRESS; i++)
+				auto controlFunction = controlFunctionTable[channelIndex][i];
+				if ((nullptr != controlFunction) &&
+				    (!controlFunction->claimedAddressSinceLastAddressClaimRequest) &&
+				    (ControlFunction::Type::Internal != controlFunction->get_type()))
 				{
-					auto controlFunction = controlFunctionTable[channelIndex][i];
-					if ((nullptr != controlFunction) &&
-					    (!controlFunction->claimedAddressSinceLastAddressClaimRequest) &&
-					    (ControlFunction::Type::Internal != controlFunction->get_type()))
-					{
-						inactiveControlFunctions.push_back(controlFunction);
-						LOG_INFO("[NM]: Control function with address %u and NAME %016llx is now offline on channel %u.", controlFunction->get_address(), controlFunction->get_NAME(), channelIndex);
-						controlFunctionTable[channelIndex][i] = nullptr;
-						controlFunction->address = NULL_CAN_ADDRESS;
-						process_control_function_state_change_callback(controlFunction, ControlFunctionState::Offline);
-					}
-					else if ((nullptr != controlFunction) &&
-					         (!controlFunction->claimedAddressSinceLastAddressClaimRequest))
-					{
-						process_control_function_state_change_callback(controlFunction, ControlFunctionState::Offline);
-					}
+					inactiveControlFunctions.push_back(controlFunction);
+					LOG_INFO("[NM]: Control function with address %u and NAME %016llx is now offline on channel %u.", controlFunction->get_address(), controlFunction->get_NAME(), channelIndex);
+					controlFunctionTable[channelIndex][i] = nullptr;
+					controlFunction->address = NULL_CAN_ADDRESS;
+					process_control_function_state_change_callback(controlFunction, ControlFunctionState::Offline);
+				}
+				else if ((nullptr != controlFunction) &&
+				         (!controlFunction->claimedAddressSinceLastAddressClaimRequest))
+				{
+					process_control_function_state_change_callback(controlFunction, ControlFunctionState::Offline);
 				}
-				lastAddressClaimRequestTimestamp_ms.at(channelIndex) = 0;
 			}
+			lastAddressClaimRequestTimestamp_ms.at(channelIndex) = 0;
 		}
 	}
 
@@ -12,9 +12,6 @@
 
 #include "isobus/isobus/can_constants.hpp"
 
-#include <algorithm>
-#include <cassert>
-
 namespace isobus
 {
 	PartneredControlFunction::PartneredControlFunction(std::uint8_t CANPort, const std::vector<NAMEFilter> &NAMEFilters) :
@@ -27,17 +24,12 @@ namespace isobus
 
 	void PartneredControlFunction::add_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
 	{
-		parameterGroupNumberCallbacks.emplace_back(parameterGroupNumber, callback, parent, internalControlFunction);
+		parameterGroupNumberCallbacks.add(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, internalControlFunction));
 	}
 
 	void PartneredControlFunction::remove_parameter_group_number_callback(std::uint32_t parameterGroupNumber, CANLibCallback callback, void *parent, std::shared_ptr<InternalControlFunction> internalControlFunction)
 	{
-		ParameterGroupNumberCallbackData tempObject(parameterGroupNumber, callback, parent, internalControlFunction);
-		auto callbackLocation = std::find(parameterGroupNumberCallbacks.begin(), parameterGroupNumberCallbacks.end(), tempObject);
-		if (parameterGroupNumberCallbacks.end() != callbackLocation)
-		{
-			parameterGroupNumberCallbacks.erase(callbackLocation);
-		}
+		parameterGroupNumberCallbacks.remove(ParameterGroupNumberCallbackData(parameterGroupNumber, callback, parent, internalControlFunction));
 	}
 
 	std::size_t PartneredControlFunction::get_number_parameter_group_number_callbacks() const
@@ -163,10 +155,9 @@ namespace isobus
 		return retVal;
 	}
 
-	ParameterGroupNumberCallbackData &PartneredControlFunction::get_parameter_group_number_callback(std::size_t index)
+	const ParameterGroupNumberCallbackData &PartneredControlFunction::get_parameter_group_number_callback(std::size_t index) const
 	{
-		assert(index < get_number_parameter_group_number_callbacks());
-		return parameterGroupNumberCallbacks[index];
+		return parameterGroupNumberCallbacks.get(index);
 	}
 
 } // namespace isobus
@@ -19,6 +19,7 @@
 #include "isobus/utility/to_string.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 
 namespace isobus
@@ -122,10 +123,16 @@ namespace isobus
 
 	TransportProtocolManager::TransportProtocolManager(const CANMessageFrameCallback &sendCANFrameCallback,
 	                                                   const CANMessageCallback &canMessageReceivedCallback,
-	                                                   const CANNetworkConfiguration *configuration) :
+	                                                   const CANNetworkConfiguration *configuration,
+	                                                   TransportProtocolMemoryBudget *memoryBudget,
+	                                                   TransportProtocolFlowControl *flowControl,
+	                                                   TransportProtocolTransmitScheduler *transmitScheduler) :
 	  sendCANFrameCallback(sendCANFrameCallback),
 	  canMessageReceivedCallback(canMessageReceivedCallback),
-	  configuration(configuration)
+	  configuration(configuration),
+	  memoryBudget(memoryBudget),
+	  flowControl(flowControl),
+	  transmitScheduler(transmitScheduler)
 	{
 	}
 
@@ -137,7 +144,6 @@ namespace isobus
 		// The standard defines that we may not send aborts for messages with a global destination, we can only ignore them if we need to
 		if (activeSessions.size() >= configuration->get_max_number_transport_protocol_sessions())
 		{
-			// TODO: consider using maximum memory instead of maximum number of sessions
 			LOG_WARNING("[TP]: Ignoring Broadcast Announcement Message (BAM) for 0x%05X, configured maximum number of sessions reached.",
 			            parameterGroupNumber);
 		}
@@ -160,7 +166,7 @@ namespace isobus
 			}
 
 			auto newSession = std::make_shared<TransportProtocolSession>(TransportProtocolSession::Direction::Receive,
-			                                                             std::unique_ptr<CANMessageData>(new CANMessageDataVector(totalMessageSize)),
+			                                                             std::unique_ptr<CANMessageData>(new CANMessageDataVector(0)), // Grown once admitted
 			                                                             parameterGroupNumber,
 			                                                             totalMessageSize,
 			                                                             0xFF, // Arbitrary - unused for broadcast
@@ -173,10 +179,17 @@ namespace isobus
 			{
 				LOG_WARNING("[TP]: Received Broadcast Announcement Message (BAM) for 0x%05X with a bad number of packets, aborting...", parameterGroupNumber);
 			}
+			else if (!newSession->grow_receive_buffer(memoryBudget, totalMessageSize))
+			{
+				// Without flow control the whole message has to fit right away
+				LOG_WARNING("[TP]: Ignoring Broadcast Announcement Message (BAM) for 0x%05X, not enough receive memory available for %hu bytes.",
+				            parameterGroupNumber,
+				            totalMessageSize);
+			}
 			else
 			{
 				newSession->set_state(StateMachineState::WaitForDataTransferPacket);
-				activeSessions.push_back(newSession);
+				activeSessions.add(newSession);
 				update_state_machine(newSession);
 				LOG_DEBUG("[TP]: New rx broadcast message session for 0x%05X. Source: %hu", parameterGroupNumber, source->get_address());
 			}
@@ -192,10 +205,16 @@ namespace isobus
 	{
 		if (activeSessions.size() >= configuration->get_max_number_transport_protocol_sessions())
 		{
-			// TODO: consider using maximum memory instead of maximum number of sessions
 			LOG_WARNING("[TP]: Replying with abort to Request To Send (RTS) for 0x%05X, configured maximum number of sessions reached.", parameterGroupNumber);
 			send_abort(std::static_pointer_cast<InternalControlFunction>(destination), source, parameterGroupNumber, ConnectionAbortReason::AlreadyInCMSession);
 		}
+		else if ((nullptr != memoryBudget) && (!memoryBudget->is_within_limits(totalMessageSize)))
+		{
+			LOG_WARNING("[TP]: Replying with abort to Request To Send (RTS) for 0x%05X, message size (%hu) is greater than the configured receive memory limits.",
+			            parameterGroupNumber,
+			            totalMessageSize);
+			send_abort(std::static_pointer_cast<InternalControlFunction>(destination), source, parameterGroupNumber, ConnectionAbortReason::SystemResourcesNeeded);
+		}
 		else
 		{
 			auto oldSession = get_session(source, destination);
@@ -215,8 +234,6 @@ namespace isobus
 				}
 			}
 
-			auto data = std::unique_ptr<CANMessageData>(new CANMessageDataVector(totalMessageSize));
-
 			if (clearToSendPacketMax > configuration->get_number_of_packets_per_cts_message())
 			{
 				LOG_DEBUG("[TP]: Received Request To Send (RTS) with a CTS packet count of %hu, which is greater than the configured maximum of %hu, using the configured maximum instead.",
@@ -226,7 +243,7 @@ namespace isobus
 			}
 
 			auto newSession = std::make_shared<TransportProtocolSession>(TransportProtocolSession::Direction::Receive,
-			                                                             std::unique_ptr<CANMessageData>(new CANMessageDataVector(totalMessageSize)),
+			                                                             std::unique_ptr<CANMessageData>(new CANMessageDataVector(0)), // Grown with each CTS
 			                                                             parameterGroupNumber,
 			                                                             totalMessageSize,
 			                                                             clearToSendPacketMax,
@@ -243,7 +260,7 @@ namespace isobus
 			else
 			{
 				newSession->set_state(StateMachineState::SendClearToSend);
-				activeSessions.push_back(newSession);
+				activeSessions.add(newSession);
 				LOG_DEBUG("[TP]: New rx session for 0x%05X. Source: %hu, destination: %hu", parameterGroupNumber, source->get_address(), destination->get_address());
 				update_state_machine(newSession);
 			}
@@ -278,6 +295,12 @@ namespace isobus
 			}
 			else
 			{
+				if (nullptr != flowControl)
+				{
+					flowControl->add_round_trip_time(session->stop_round_trip_measurement());
+					flowControl->add_transfer_frame();
+				}
+
 				session->set_acknowledged_packet_number(nextPacketNumber - 1);
 				session->set_cts_number_of_packets(packetsToBeSent);
 
@@ -496,21 +519,16 @@ namespace isobus
 				// Convert data type to a vector to allow for manipulation
 				auto &data = static_cast<CANMessageDataVector &>(session->get_data());
 
-				// Correct sequence number, copy the data
-				for (std::uint8_t i = 0; i < PROTOCOL_BYTES_PER_FRAME; i++)
+				if (nullptr != flowControl)
 				{
-					std::uint32_t currentDataIndex = (PROTOCOL_BYTES_PER_FRAME * session->get_last_packet_number()) + i;
-					if (currentDataIndex < session->get_message_length())
-					{
-						data.set_byte(currentDataIndex, message.get_uint8_at(1 + i));
-					}
-					else
-					{
-						// Reached the end of the message, no need to copy any more data
-						break;
-					}
+					flowControl->add_round_trip_time(session->stop_round_trip_measurement());
+					flowControl->add_transfer_frame();
 				}
 
+				// Correct sequence number, append the data to the buffer that was grown for it
+				const auto bytesThisFrame = std::min<std::size_t>(PROTOCOL_BYTES_PER_FRAME, session->get_message_length() - data.size());
+				data.insert(data.end(), message.get_data().begin() + 1, message.get_data().begin() + 1 + bytesThisFrame);
+
 				session->set_last_sequency_number(sequenceNumber);
 				if (session->get_number_of_remaining_packets() == 0)
 				{
@@ -539,7 +557,8 @@ namespace isobus
 				}
 				else if (session->get_cts_number_of_packets_remaining() == 0)
 				{
-					send_clear_to_send(session);
+					session->set_state(StateMachineState::SendClearToSend);
+					update_state_machine(session);
 				}
 			}
 			else
@@ -584,7 +603,8 @@ namespace isobus
 	                                                         std::shared_ptr<ControlFunction> source,
 	                                                         std::shared_ptr<ControlFunction> destination,
 	                                                         TransmitCompleteCallback sessionCompleteCallback,
-	                                                         void *parentPointer)
+	                                                         void *parentPointer,
+	                                                         CANIdentifier::CANPriority priority)
 	{
 		// Return false early if we can't send the message
 		if ((nullptr == data) || (data->size() <= CAN_DATA_LENGTH) || (data->size() > MAX_PROTOCOL_DATA_LENGTH))
@@ -629,7 +649,13 @@ namespace isobus
 			          source->get_address(),
 			          destination->get_address());
 		}
-		activeSessions.push_back(session);
+		activeSessions.add(session);
+		if (nullptr != transmitScheduler)
+		{
+			transmitScheduler->add(session, priority, [this](const std::shared_ptr<TransportProtocolSessionBase> &scheduledSession, std::uint32_t maximumFrames) {
+				return transmit_scheduled_frames(std::static_pointer_cast<TransportProtocolSession>(scheduledSession), maximumFrames);
+			});
+		}
 		update_state_machine(session);
 		return true;
 	}
@@ -657,17 +683,82 @@ namespace isobus
 		}
 	}
 
-	void TransportProtocolManager::send_data_transfer_packets(const std::shared_ptr<TransportProtocolSession> &session)
+	std::uint32_t TransportProtocolManager::get_time_until_next_deadline_ms() const
+	{
+		std::uint32_t retVal = std::numeric_limits<std::uint32_t>::max();
+
+		// The timeouts in update_state_machine expire once more than their duration has passed, hence the + 1
+		for (const auto &session : activeSessions.get_sessions())
+		{
+			switch (session->state)
+			{
+				case StateMachineState::WaitForClearToSend:
+				case StateMachineState::WaitForEndOfMessageAcknowledge:
+				{
+					retVal = std::min(retVal, session->get_time_until_elapsed(T2_T3_TIMEOUT_MS + 1));
+				}
+				break;
+
+				case StateMachineState::WaitForDataTransferPacket:
+				{
+					if ((!session->is_broadcast()) && (session->get_cts_number_of_packets_remaining() == session->get_cts_number_of_packets()))
+					{
+						retVal = std::min(retVal, session->get_time_until_elapsed(T2_T3_TIMEOUT_MS + 1));
+					}
+					else
+					{
+						retVal = std::min(retVal, session->get_time_until_elapsed(T1_TIMEOUT_MS + 1));
+					}
+				}
+				break;
+
+				case StateMachineState::SendDataTransferPackets:
+				{
+					if (session->is_broadcast())
+					{
+						retVal = std::min(retVal, session->get_time_until_elapsed(configuration->get_minimum_time_between_transport_protocol_bam_frames()));
+					}
+				}
+				break;
+
+				case StateMachineState::SendClearToSend:
+				{
+					if (0 != session->get_number_of_memory_holds())
+					{
+						retVal = std::min(retVal, session->get_time_until_elapsed(TH_HOLD_INTERVAL_MS));
+					}
+				}
+				break;
+
+				default:
+					break;
+			}
+		}
+		return retVal;
+	}
+
+	std::uint8_t TransportProtocolManager::get_max_frames_per_update() const
+	{
+		std::uint8_t retVal = configuration->get_max_number_of_network_manager_protocol_frames_per_update();
+		if (nullptr != flowControl)
+		{
+			retVal = flowControl->get_frames_per_update(retVal);
+		}
+		return retVal;
+	}
+
+	std::uint8_t TransportProtocolManager::send_data_transfer_packets(const std::shared_ptr<TransportProtocolSession> &session, std::uint8_t maximumFrames)
 	{
 		std::array<std::uint8_t, CAN_DATA_LENGTH> buffer;
 		std::uint8_t framesToSend = session->get_cts_number_of_packets_remaining();
+		std::uint8_t framesSent = 0;
 		if (session->is_broadcast())
 		{
 			framesToSend = 1;
 		}
-		else if (framesToSend > configuration->get_max_number_of_network_manager_protocol_frames_per_update())
+		else if (framesToSend > maximumFrames)
 		{
-			framesToSend = configuration->get_max_number_of_network_manager_protocol_frames_per_update();
+			framesToSend = maximumFrames;
 		}
 
 		// Try and send packets
@@ -676,18 +767,12 @@ namespace isobus
 			buffer[0] = session->get_last_sequence_number() + 1;
 
 			std::uint16_t dataOffset = session->get_last_packet_number() * PROTOCOL_BYTES_PER_FRAME;
-			for (std::uint8_t j = 0; j < PROTOCOL_BYTES_PER_FRAME; j++)
+			std::size_t bytesCopied = 0;
+			if (dataOffset < session->get_message_length())
 			{
-				std::uint16_t index = dataOffset + j;
-				if (index < session->get_message_length())
-				{
-					buffer[1 + j] = session->get_data().get_byte(index);
-				}
-				else
-				{
-					buffer[1 + j] = 0xFF;
-				}
+				bytesCopied = session->get_data().copy_range(dataOffset, &buffer[1], std::min<std::size_t>(PROTOCOL_BYTES_PER_FRAME, session->get_message_length() - dataOffset));
 			}
+			std::fill(buffer.begin() + 1 + bytesCopied, buffer.end(), 0xFF);
 
 			if (sendCANFrameCallback(static_cast<std::uint32_t>(CANLibParameterGroupNumber::TransportProtocolDataTransfer),
 			                         CANDataSpan(buffer.data(), buffer.size()),
@@ -696,6 +781,11 @@ namespace isobus
 			                         CANIdentifier::CANPriority::PriorityLowest7))
 			{
 				session->set_last_sequency_number(session->get_last_sequence_number() + 1);
+				framesSent++;
+				if (nullptr != flowControl)
+				{
+					flowControl->add_sent_data_frame();
+				}
 			}
 			else
 			{
@@ -719,7 +809,22 @@ namespace isobus
 		else if ((session->get_cts_number_of_packets_remaining() == 0) && !session->is_broadcast())
 		{
 			session->set_state(StateMachineState::WaitForClearToSend);
+			session->start_round_trip_measurement();
 		}
+		return framesSent;
+	}
+
+	std::uint32_t TransportProtocolManager::transmit_scheduled_frames(const std::shared_ptr<TransportProtocolSession> &session, std::uint32_t maximumFrames)
+	{
+		std::uint32_t retVal = 0;
+
+		if ((StateMachineState::SendDataTransferPackets == session->state) &&
+		    ((!session->is_broadcast()) ||
+		     (session->get_time_since_last_update() >= configuration->get_minimum_time_between_transport_protocol_bam_frames())))
+		{
+			retVal = send_data_transfer_packets(session, static_cast<std::uint8_t>(std::min<std::uint32_t>(maximumFrames, get_max_frames_per_update())));
+		}
+		return retVal;
 	}
 
 	void TransportProtocolManager::update_state_machine(std::shared_ptr<TransportProtocolSession> &session)
@@ -743,6 +848,7 @@ namespace isobus
 				if (send_request_to_send(session))
 				{
 					session->set_state(StateMachineState::WaitForClearToSend);
+					session->start_round_trip_measurement();
 				}
 			}
 			break;
@@ -768,7 +874,7 @@ namespace isobus
 
 			case StateMachineState::SendClearToSend:
 			{
-				if (send_clear_to_send(session))
+				if (send_clear_to_send_when_memory_available(session))
 				{
 					session->set_state(StateMachineState::WaitForDataTransferPacket);
 				}
@@ -777,13 +883,17 @@ namespace isobus
 
 			case StateMachineState::SendDataTransferPackets:
 			{
-				if (session->is_broadcast() && (session->get_time_since_last_update() < configuration->get_minimum_time_between_transport_protocol_bam_frames()))
+				if ((nullptr != transmitScheduler) && transmitScheduler->is_enabled())
+				{
+					// The transmit scheduler sends the data frames, shared with the other sessions of the CAN port
+				}
+				else if (session->is_broadcast() && (session->get_time_since_last_update() < configuration->get_minimum_time_between_transport_protocol_bam_frames()))
 				{
 					// Need to wait before sending the next data frame of the broadcast session
 				}
 				else
 				{
-					send_data_transfer_packets(session);
+					send_data_transfer_packets(session, get_max_frames_per_update());
 				}
 			}
 			break;
@@ -882,10 +992,18 @@ namespace isobus
 	{
 		session->complete(successful);
 
-		auto sessionLocation = std::find(activeSessions.begin(), activeSessions.end(), session);
-		if (activeSessions.end() != sessionLocation)
+		if (nullptr != memoryBudget)
+		{
+			memoryBudget->release(*session);
+		}
+
+		if (nullptr != transmitScheduler)
+		{
+			transmitScheduler->remove(*session);
+		}
+
+		if (activeSessions.remove(session))
 		{
-			activeSessions.erase(sessionLocation);
 			LOG_DEBUG("[TP]: Session Closed");
 		}
 	}
@@ -928,10 +1046,8 @@ namespace isobus
 		                            CANIdentifier::CANPriority::PriorityLowest7);
 	}
 
-	bool TransportProtocolManager::send_clear_to_send(const std::shared_ptr<TransportProtocolSession> &session) const
+	std::uint8_t TransportProtocolManager::get_clear_to_send_number_of_packets(const std::shared_ptr<TransportProtocolSession> &session) const
 	{
-		bool retVal = false;
-
 		std::uint8_t packetsThisSegment = session->get_number_of_remaining_packets();
 		if (packetsThisSegment > session->get_rts_number_of_packet_limit())
 		{
@@ -943,6 +1059,17 @@ namespace isobus
 			packetsThisSegment = 16;
 		}
 
+		if (nullptr != flowControl)
+		{
+			packetsThisSegment = flowControl->get_packets_per_window(packetsThisSegment);
+		}
+		return packetsThisSegment;
+	}
+
+	bool TransportProtocolManager::send_clear_to_send(const std::shared_ptr<TransportProtocolSession> &session, std::uint8_t packetsThisSegment) const
+	{
+		bool retVal = false;
+
 		const std::array<std::uint8_t, CAN_DATA_LENGTH> buffer{
 			CLEAR_TO_SEND_MULTIPLEXOR,
 			packetsThisSegment,
@@ -966,6 +1093,43 @@ namespace isobus
 		return retVal;
 	}
 
+	bool TransportProtocolManager::send_clear_to_send_when_memory_available(const std::shared_ptr<TransportProtocolSession> &session)
+	{
+		bool retVal = false;
+		const std::uint8_t packetsThisSegment = get_clear_to_send_number_of_packets(session);
+		const std::uint32_t bytesThroughSegment = std::min(static_cast<std::uint32_t>(session->get_last_packet_number() + packetsThisSegment) * PROTOCOL_BYTES_PER_FRAME,
+		                                                   static_cast<std::uint32_t>(session->get_message_length()));
+
+		if (session->grow_receive_buffer(memoryBudget, bytesThroughSegment))
+		{
+			retVal = send_clear_to_send(session, packetsThisSegment);
+			if (retVal)
+			{
+				session->set_number_of_memory_holds(0);
+				session->start_round_trip_measurement();
+				if (nullptr != flowControl)
+				{
+					flowControl->add_transfer_frame();
+				}
+			}
+		}
+		else if ((0 == session->get_number_of_memory_holds()) || (session->get_time_since_last_update() >= TH_HOLD_INTERVAL_MS))
+		{
+			if ((static_cast<std::uint64_t>(session->get_number_of_memory_holds()) * TH_HOLD_INTERVAL_MS) >= configuration->get_max_transport_protocol_memory_hold_time())
+			{
+				LOG_ERROR("[TP]: Aborting rx session for 0x%05X, no receive memory became available in time", session->get_parameter_group_number());
+				abort_session(session, ConnectionAbortReason::SystemResourcesNeeded);
+			}
+			else if (send_clear_to_send(session, 0))
+			{
+				// A CTS for 0 packets asks the sender to wait, and has to be repeated to keep the connection open
+				LOG_DEBUG("[TP]: Holding rx session for 0x%05X until receive memory is available", session->get_parameter_group_number());
+				session->set_number_of_memory_holds(session->get_number_of_memory_holds() + 1);
+			}
+		}
+		return retVal;
+	}
+
 	bool TransportProtocolManager::send_end_of_session_acknowledgement(const std::shared_ptr<TransportProtocolSession> &session) const
 	{
 		std::uint32_t messageLength = session->get_message_length();
@@ -992,22 +1156,17 @@ namespace isobus
 
 	bool TransportProtocolManager::has_session(std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination)
 	{
-		return std::any_of(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<TransportProtocolManager::TransportProtocolSession> &session) {
-			return session->matches(source, destination);
-		});
+		return (nullptr != activeSessions.find(source, destination));
 	}
 
 	std::shared_ptr<TransportProtocolManager::TransportProtocolSession> TransportProtocolManager::get_session(std::shared_ptr<ControlFunction> source,
 	                                                                                                          std::shared_ptr<ControlFunction> destination)
 	{
-		auto result = std::find_if(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<TransportProtocolManager::TransportProtocolSession> &session) {
-			return session->matches(source, destination);
-		});
-		return (activeSessions.end() != result) ? (*result) : nullptr;
+		return activeSessions.find(source, destination);
 	}
 
 	const std::vector<std::shared_ptr<TransportProtocolManager::TransportProtocolSession>> &TransportProtocolManager::get_sessions() const
 	{
-		return activeSessions;
+		return activeSessions.get_sessions();
 	}
 }
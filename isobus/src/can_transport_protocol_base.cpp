@@ -11,6 +11,8 @@
 #include "isobus/isobus/can_internal_control_function.hpp"
 #include "isobus/utility/system_timing.hpp"
 
+#include <algorithm>
+
 namespace isobus
 {
 	TransportProtocolSessionBase::TransportProtocolSessionBase(TransportProtocolSessionBase::Direction direction,
@@ -81,6 +83,16 @@ namespace isobus
 		return parameterGroupNumber;
 	}
 
+	std::uint32_t TransportProtocolSessionBase::get_reserved_memory() const
+	{
+		return reservedMemory;
+	}
+
+	std::uint64_t TransportProtocolSessionBase::get_time_to_first_frame_us() const
+	{
+		return timeToFirstFrame_us;
+	}
+
 	void isobus::TransportProtocolSessionBase::update_timestamp()
 	{
 		timestamp_ms = SystemTiming::get_timestamp_ms();
@@ -91,6 +103,12 @@ namespace isobus
 		return SystemTiming::get_time_elapsed_ms(timestamp_ms);
 	}
 
+	std::uint32_t TransportProtocolSessionBase::get_time_until_elapsed(std::uint32_t duration_ms) const
+	{
+		const std::uint32_t elapsed_ms = get_time_since_last_update();
+		return (duration_ms > elapsed_ms) ? (duration_ms - elapsed_ms) : 0;
+	}
+
 	void TransportProtocolSessionBase::complete(bool success) const
 	{
 		if ((nullptr != sessionCompleteCallback) && (Direction::Transmit == direction))
@@ -103,4 +121,449 @@ namespace isobus
 			                        parent);
 		}
 	}
+
+	std::uint32_t TransportProtocolSessionBase::get_number_of_memory_holds() const
+	{
+		return numberOfMemoryHolds;
+	}
+
+	void TransportProtocolSessionBase::set_number_of_memory_holds(std::uint32_t value)
+	{
+		numberOfMemoryHolds = value;
+	}
+
+	bool TransportProtocolSessionBase::grow_receive_buffer(TransportProtocolMemoryBudget *budget, std::uint32_t numberOfBytes)
+	{
+		bool retVal = true;
+		auto &buffer = static_cast<CANMessageDataVector &>(*data);
+
+		if (numberOfBytes > buffer.capacity())
+		{
+			std::uint32_t newCapacity = std::max(numberOfBytes, std::min(static_cast<std::uint32_t>(2 * buffer.capacity()), totalMessageSize));
+
+			if ((nullptr != budget) && (!budget->reserve(*this, newCapacity)))
+			{
+				newCapacity = numberOfBytes;
+				retVal = budget->reserve(*this, newCapacity);
+			}
+
+			if (retVal)
+			{
+				buffer.reserve(newCapacity);
+			}
+		}
+		return retVal;
+	}
+
+	void TransportProtocolSessionBase::start_round_trip_measurement()
+	{
+		roundTripStartTimestamp_us = SystemTiming::get_timestamp_us();
+	}
+
+	std::uint64_t TransportProtocolSessionBase::stop_round_trip_measurement()
+	{
+		std::uint64_t retVal = 0;
+		if (0 != roundTripStartTimestamp_us)
+		{
+			retVal = SystemTiming::get_time_elapsed_us(roundTripStartTimestamp_us);
+			roundTripStartTimestamp_us = 0;
+		}
+		return retVal;
+	}
+
+	TransportProtocolMemoryBudget::TransportProtocolMemoryBudget(const CANNetworkConfiguration *configuration) :
+	  configuration(configuration)
+	{
+	}
+
+	bool TransportProtocolMemoryBudget::is_within_limits(std::uint32_t messageSize) const
+	{
+		const std::uint32_t maxMemory = configuration->get_max_transport_protocol_receive_memory();
+		const std::uint32_t maxMemoryPerSource = configuration->get_max_transport_protocol_receive_memory_per_source();
+		return ((0 == maxMemory) || (messageSize <= maxMemory)) &&
+		       ((0 == maxMemoryPerSource) || (messageSize <= maxMemoryPerSource));
+	}
+
+	bool TransportProtocolMemoryBudget::reserve(TransportProtocolSessionBase &session, std::uint32_t numberOfBytes)
+	{
+		bool retVal = true;
+
+		if (numberOfBytes > session.reservedMemory)
+		{
+			const std::uint32_t additionalBytes = numberOfBytes - session.reservedMemory;
+			const std::uint64_t maxMemory = configuration->get_max_transport_protocol_receive_memory();
+			const std::uint64_t maxMemoryPerSource = configuration->get_max_transport_protocol_receive_memory_per_source();
+
+			LOCK_GUARD(Mutex, budgetMutex);
+			std::uint32_t reservedBySource = 0;
+			auto sourceReservation = reservedMemoryPerSource.find(session.get_source().get());
+			if (reservedMemoryPerSource.end() != sourceReservation)
+			{
+				reservedBySource = sourceReservation->second;
+			}
+
+			// The limits may have been lowered below the current reservations, so compare with 64 bit sums instead of remaining space
+			if (((0 != maxMemory) && ((static_cast<std::uint64_t>(reservedMemory) + additionalBytes) > maxMemory)) ||
+			    ((0 != maxMemoryPerSource) && ((static_cast<std::uint64_t>(reservedBySource) + additionalBytes) > maxMemoryPerSource)))
+			{
+				retVal = false;
+			}
+			else
+			{
+				reservedMemoryPerSource[session.get_source().get()] = reservedBySource + additionalBytes;
+				reservedMemory += additionalBytes;
+				session.reservedMemory = numberOfBytes;
+			}
+		}
+		return retVal;
+	}
+
+	void TransportProtocolMemoryBudget::release(TransportProtocolSessionBase &session)
+	{
+		if (0 != session.reservedMemory)
+		{
+			LOCK_GUARD(Mutex, budgetMutex);
+			auto sourceReservation = reservedMemoryPerSource.find(session.get_source().get());
+			if (reservedMemoryPerSource.end() != sourceReservation)
+			{
+				if (sourceReservation->second > session.reservedMemory)
+				{
+					sourceReservation->second -= session.reservedMemory;
+				}
+				else
+				{
+					reservedMemoryPerSource.erase(sourceReservation);
+				}
+			}
+			reservedMemory -= session.reservedMemory;
+			session.reservedMemory = 0;
+		}
+	}
+
+	std::uint32_t TransportProtocolMemoryBudget::get_reserved_memory() const
+	{
+		LOCK_GUARD(Mutex, budgetMutex);
+		return reservedMemory;
+	}
+
+	std::uint32_t TransportProtocolMemoryBudget::get_reserved_memory(const std::shared_ptr<ControlFunction> &source) const
+	{
+		std::uint32_t retVal = 0;
+		LOCK_GUARD(Mutex, budgetMutex);
+		auto sourceReservation = reservedMemoryPerSource.find(source.get());
+		if (reservedMemoryPerSource.end() != sourceReservation)
+		{
+			retVal = sourceReservation->second;
+		}
+		return retVal;
+	}
+
+	TransportProtocolFlowControl::TransportProtocolFlowControl(const CANNetworkConfiguration *configuration) :
+	  configuration(configuration)
+	{
+	}
+
+	void TransportProtocolFlowControl::update(float currentBusload)
+	{
+		constexpr std::uint64_t MAXIMUM_UPDATE_INTERVAL_US = 100000;
+		const std::uint64_t timestamp_us = SystemTiming::get_timestamp_us();
+
+		if ((0 != lastUpdateTimestamp_us) && (timestamp_us > lastUpdateTimestamp_us))
+		{
+			const std::uint64_t elapsed_us = timestamp_us - lastUpdateTimestamp_us;
+
+			// Long pauses between updates shouldn't turn into one huge burst
+			updateInterval_us = static_cast<std::uint32_t>(std::min(elapsed_us, MAXIMUM_UPDATE_INTERVAL_US));
+
+			// Average the load of the transfers over about a second, like the busload is measured
+			const float transferLoad = std::min((static_cast<float>(transferFramesSinceUpdate) * FRAME_TIME_US * 100.0f) / static_cast<float>(elapsed_us), 100.0f);
+			const float gain = std::min(static_cast<float>(elapsed_us) / 1000000.0f, 1.0f);
+			transferBusload += (transferLoad - transferBusload) * gain;
+		}
+		lastUpdateTimestamp_us = timestamp_us;
+		transferFramesSinceUpdate = 0;
+		framesSentThisUpdate = 0;
+		busload = currentBusload;
+
+		if (0 != updateInterval_us)
+		{
+			// Send as many frames as fit in the headroom of the bus until the next update.
+			// The fraction of a frame that doesn't fit is carried over, so short update intervals don't round the rate down.
+			frameAllowance += (get_headroom() * static_cast<float>(updateInterval_us)) / FRAME_TIME_US;
+			framesPerUpdate = static_cast<std::uint32_t>(frameAllowance);
+			frameAllowance -= static_cast<float>(framesPerUpdate);
+		}
+	}
+
+	void TransportProtocolFlowControl::add_round_trip_time(std::uint64_t roundTripTime_us)
+	{
+		constexpr std::uint64_t MAXIMUM_ROUND_TRIP_TIME_US = 1250000; // The T2/T3 timeout, anything slower would have timed out
+
+		if (0 != roundTripTime_us)
+		{
+			const auto sample_us = static_cast<std::uint32_t>(std::min(roundTripTime_us, MAXIMUM_ROUND_TRIP_TIME_US));
+			if (0 == smoothedRoundTripTime_us)
+			{
+				smoothedRoundTripTime_us = sample_us;
+			}
+			else
+			{
+				// Smooth with a gain of 1/8, like TCP does for its round trip time
+				smoothedRoundTripTime_us = static_cast<std::uint32_t>((7 * static_cast<std::uint64_t>(smoothedRoundTripTime_us) + sample_us) / 8);
+			}
+		}
+	}
+
+	void TransportProtocolFlowControl::add_transfer_frame()
+	{
+		transferFramesSinceUpdate++;
+	}
+
+	void TransportProtocolFlowControl::add_sent_data_frame()
+	{
+		transferFramesSinceUpdate++;
+		framesSentThisUpdate++;
+	}
+
+	std::uint8_t TransportProtocolFlowControl::get_packets_per_window(std::uint8_t maximumPackets) const
+	{
+		constexpr float MINIMUM_PACKETS_PER_WINDOW = 2.0f;
+		constexpr float ASSUMED_ROUND_TRIP_TIME_US = 20000.0f; // Two 10 ms update loops, until a round trip is measured
+
+		std::uint8_t retVal = maximumPackets;
+
+		if (configuration->get_adaptive_transport_protocol_flow_control())
+		{
+			const float headroom = get_headroom();
+			const float roundTripTime_us = (0 != smoothedRoundTripTime_us) ? static_cast<float>(smoothedRoundTripTime_us) : ASSUMED_ROUND_TRIP_TIME_US;
+
+			if (headroom < 1.0f)
+			{
+				// Solve packets * frameTime / (packets * frameTime + roundTripTime) <= headroom for the number of packets
+				const float packets = std::max((headroom * roundTripTime_us) / ((1.0f - headroom) * FRAME_TIME_US), MINIMUM_PACKETS_PER_WINDOW);
+				if (packets < static_cast<float>(maximumPackets))
+				{
+					retVal = static_cast<std::uint8_t>(packets);
+				}
+			}
+		}
+		return retVal;
+	}
+
+	std::uint8_t TransportProtocolFlowControl::get_frames_per_update(std::uint8_t maximumFrames) const
+	{
+		std::uint8_t retVal = maximumFrames;
+
+		if (configuration->get_adaptive_transport_protocol_flow_control() && (0 != updateInterval_us))
+		{
+			// All sessions of the port share the headroom, so only what they haven't sent yet is left
+			const std::uint32_t framesLeft = (framesSentThisUpdate < framesPerUpdate) ? (framesPerUpdate - framesSentThisUpdate) : 0;
+
+			if (framesLeft < maximumFrames)
+			{
+				retVal = static_cast<std::uint8_t>(framesLeft);
+			}
+		}
+		return retVal;
+	}
+
+	float TransportProtocolFlowControl::get_busload() const
+	{
+		return busload;
+	}
+
+	std::uint32_t TransportProtocolFlowControl::get_round_trip_time() const
+	{
+		return smoothedRoundTripTime_us;
+	}
+
+	float TransportProtocolFlowControl::get_headroom() const
+	{
+		// The measured busload includes the transfers themselves, which shouldn't take away their own headroom
+		const float backgroundBusload = std::max(busload - transferBusload, 0.0f);
+		const float headroom = (configuration->get_adaptive_flow_control_target_busload() - backgroundBusload) / 100.0f;
+		// Transfers always keep a small share of the bus, so they make progress instead of timing out
+		constexpr float MINIMUM_HEADROOM = 0.05f;
+
+		return std::min(std::max(headroom, MINIMUM_HEADROOM), 1.0f);
+	}
+
+	TransportProtocolTransmitScheduler::TransportProtocolTransmitScheduler(const CANNetworkConfiguration *configuration,
+	                                                                       const TransportProtocolFlowControl *flowControl) :
+	  configuration(configuration),
+	  flowControl(flowControl)
+	{
+	}
+
+	bool TransportProtocolTransmitScheduler::is_enabled() const
+	{
+		return 0 != configuration->get_transport_protocol_transmit_scheduler_frames_per_update();
+	}
+
+	void TransportProtocolTransmitScheduler::add(const std::shared_ptr<TransportProtocolSessionBase> &session,
+	                                             CANIdentifier::CANPriority priority,
+	                                             const TransmitFramesCallback &transmitFrames)
+	{
+		auto entry = std::make_shared<Entry>();
+		entry->session = session;
+		entry->transmitFrames = transmitFrames;
+		entry->priorityClass = get_priority_class(priority);
+		entry->queuedTimestamp_us = SystemTiming::get_timestamp_us();
+
+		LOCK_GUARD(Mutex, schedulerMutex);
+		entries.push_back(entry);
+	}
+
+	void TransportProtocolTransmitScheduler::remove(const TransportProtocolSessionBase &session)
+	{
+		LOCK_GUARD(Mutex, schedulerMutex);
+		for (auto entryLocation = entries.begin(); entryLocation != entries.end(); entryLocation++)
+		{
+			auto &entry = *entryLocation;
+			if (entry->session.get() == &session)
+			{
+				if (0 != entry->numberOfFrames)
+				{
+					const std::uint64_t sessionTime_us = SystemTiming::get_timestamp_us() - entry->queuedTimestamp_us;
+					auto &classStatistics = statistics.at(static_cast<std::size_t>(entry->priorityClass));
+					classStatistics.numberOfSessions++;
+					classStatistics.numberOfFrames += entry->numberOfFrames;
+					classStatistics.totalTimeToFirstFrame_us += session.timeToFirstFrame_us;
+					classStatistics.maximumTimeToFirstFrame_us = std::max(classStatistics.maximumTimeToFirstFrame_us, session.timeToFirstFrame_us);
+					classStatistics.totalSessionTime_us += sessionTime_us;
+					classStatistics.maximumSessionTime_us = std::max(classStatistics.maximumSessionTime_us, sessionTime_us);
+				}
+
+				// The entry may still be in the round of an update that is sending right now
+				entry->removed = true;
+				entries.erase(entryLocation);
+				break;
+			}
+		}
+	}
+
+	void TransportProtocolTransmitScheduler::update()
+	{
+		std::uint8_t frameBudget = configuration->get_transport_protocol_transmit_scheduler_frames_per_update();
+		if ((0 != frameBudget) && (nullptr != flowControl))
+		{
+			frameBudget = flowControl->get_frames_per_update(frameBudget);
+		}
+
+		if (0 != frameBudget)
+		{
+			{
+				LOCK_GUARD(Mutex, schedulerMutex);
+				roundEntries.clear();
+				if (!entries.empty())
+				{
+					// Rotate the order, so that no session is always first when the budget runs out
+					nextEntryIndex %= entries.size();
+					roundEntries.insert(roundEntries.end(), entries.begin() + nextEntryIndex, entries.end());
+					roundEntries.insert(roundEntries.end(), entries.begin(), entries.begin() + nextEntryIndex);
+					nextEntryIndex++;
+				}
+			}
+
+			// The lock isn't held while sending, because the protocols remove sessions that complete
+			const std::uint64_t timestamp_us = SystemTiming::get_timestamp_us();
+			std::uint32_t remainingFrames = frameBudget;
+			while ((0 != remainingFrames) && (!roundEntries.empty()))
+			{
+				for (std::size_t i = 0; (i < roundEntries.size()) && (0 != remainingFrames);)
+				{
+					Entry &entry = *roundEntries.at(i);
+					bool canSendMore = false;
+
+					if (!entry.removed)
+					{
+						entry.deficit += get_weight(entry.priorityClass);
+
+						// A session that is the only one left doesn't have to share the budget
+						const std::uint32_t maximumFrames = (1 == roundEntries.size()) ? remainingFrames : std::min(entry.deficit, remainingFrames);
+						const std::uint32_t framesSent = entry.transmitFrames(entry.session, maximumFrames);
+
+						if ((0 != framesSent) && (0 == entry.numberOfFrames))
+						{
+							entry.session->timeToFirstFrame_us = timestamp_us - entry.queuedTimestamp_us;
+						}
+						entry.numberOfFrames += framesSent;
+						remainingFrames -= framesSent;
+
+						if (framesSent < maximumFrames)
+						{
+							// The session can't send more right now, so it doesn't keep a share it can't use
+							entry.deficit = 0;
+						}
+						else
+						{
+							entry.deficit -= std::min(entry.deficit, framesSent);
+							canSendMore = true;
+						}
+					}
+
+					if (canSendMore)
+					{
+						i++;
+					}
+					else
+					{
+						roundEntries.erase(roundEntries.begin() + i);
+					}
+				}
+			}
+			roundEntries.clear();
+		}
+	}
+
+	TransportProtocolTransmitScheduler::PriorityClass TransportProtocolTransmitScheduler::get_priority_class(CANIdentifier::CANPriority priority)
+	{
+		PriorityClass retVal = PriorityClass::Low;
+
+		if (priority <= CANIdentifier::CANPriority::Priority2)
+		{
+			retVal = PriorityClass::High;
+		}
+		else if (priority <= CANIdentifier::CANPriority::Priority5)
+		{
+			retVal = PriorityClass::Normal;
+		}
+		return retVal;
+	}
+
+	TransportProtocolTransmitScheduler::ClassStatistics TransportProtocolTransmitScheduler::get_statistics(PriorityClass priorityClass) const
+	{
+		LOCK_GUARD(Mutex, schedulerMutex);
+		return statistics.at(static_cast<std::size_t>(priorityClass));
+	}
+
+	std::size_t TransportProtocolTransmitScheduler::get_number_of_sessions() const
+	{
+		LOCK_GUARD(Mutex, schedulerMutex);
+		return entries.size();
+	}
+
+	std::uint32_t TransportProtocolTransmitScheduler::get_weight(PriorityClass priorityClass)
+	{
+		std::uint32_t retVal = 1;
+
+		switch (priorityClass)
+		{
+			case PriorityClass::High:
+			{
+				retVal = 4;
+			}
+			break;
+
+			case PriorityClass::Normal:
+			{
+				retVal = 2;
+			}
+			break;
+
+			default:
+				break;
+		}
+		return retVal;
+	}
 }
@@ -125,6 +125,7 @@ namespace isobus
 			                                                                 deviceExtendedStructureLabel,
 			                                                                 clientIsoNAME,
 			                                                                 (taskControllerCompatibilityLevel >= 4)));
+			add_last_object_to_index();
 		}
 		else
 		{
@@ -167,6 +168,7 @@ namespace isobus
 			                                                                        parentObjectID,
 			                                                                        deviceElementType,
 			                                                                        uniqueID));
+			add_last_object_to_index();
 		}
 		else
 		{
@@ -229,6 +231,7 @@ namespace isobus
 			                                                                            processDataProperties,
 			                                                                            processDataTriggerMethods,
 			                                                                            uniqueID));
+			add_last_object_to_index();
 		}
 		else
 		{
@@ -282,6 +285,7 @@ namespace isobus
 			                                                                         propertyDDI,
 			                                                                         valuePresentationObject,
 			                                                                         uniqueID));
+			add_last_object_to_index();
 		}
 		else
 		{
@@ -335,6 +339,7 @@ namespace isobus
 			                                                                                  scaleFactor,
 			                                                                                  numberDecimals,
 			                                                                                  uniqueID));
+			add_last_object_to_index();
 		}
 		else
 		{
@@ -352,7 +357,14 @@ namespace isobus
 
 	bool DeviceDescriptorObjectPool::remove_object_with_id(std::uint16_t objectID)
 	{
-		return remove_where([objectID](const task_controller_object::Object &object) { return object.get_object_id() == objectID; });
+		bool retVal = false;
+
+		// Deserializing calls this for every object, so skip searching the pool when the ID isn't in it
+		if (objectIndices.end() != objectIndices.find(objectID))
+		{
+			retVal = remove_where([objectID](const task_controller_object::Object &object) { return object.get_object_id() == objectID; });
+		}
+		return retVal;
 	}
 
 	bool DeviceDescriptorObjectPool::remove_where(std::function<bool(const task_controller_object::Object &)> predicate)
@@ -371,6 +383,11 @@ namespace isobus
 				++it;
 			}
 		}
+
+		if (retVal)
+		{
+			rebuild_object_index();
+		}
 		return retVal;
 	}
 
@@ -539,7 +556,7 @@ namespace isobus
 					{
 						// Process a device element object
 						std::uint8_t numberDesignatorBytes = 0;
-						std::uint8_t numberOfObjectIDs = 0;
+						std::uint16_t numberOfObjectIDs = 0;
 
 						if (binaryPoolSizeBytes >= 7)
 						{
@@ -551,9 +568,9 @@ namespace isobus
 							retVal = false;
 						}
 
-						if (binaryPoolSizeBytes >= static_cast<std::uint32_t>(12 + numberDesignatorBytes))
+						if (binaryPoolSizeBytes >= static_cast<std::uint32_t>(13 + numberDesignatorBytes))
 						{
-							numberOfObjectIDs = binaryPool[11 + numberDesignatorBytes];
+							numberOfObjectIDs = static_cast<std::uint16_t>(static_cast<std::uint16_t>(binaryPool[11 + numberDesignatorBytes]) | (static_cast<std::uint16_t>(binaryPool[12 + numberDesignatorBytes]) << 8));
 						}
 						else
 						{
@@ -589,7 +606,7 @@ namespace isobus
 
 								if (nullptr != DETObject)
 								{
-									for (std::uint8_t i = 0; i < numberOfObjectIDs; i++)
+									for (std::uint16_t i = 0; i < numberOfObjectIDs; i++)
 									{
 										std::uint16_t childID = static_cast<std::uint16_t>(static_cast<std::uint16_t>(binaryPool[13 + (2 * i) + numberDesignatorBytes]) | (static_cast<std::uint16_t>(binaryPool[14 + (2 * i) + numberDesignatorBytes]) << 8));
 										DETObject->add_reference_to_child_object(childID);
@@ -1018,18 +1035,105 @@ namespace isobus
 	std::shared_ptr<task_controller_object::Object> DeviceDescriptorObjectPool::get_object_by_id(std::uint16_t objectID)
 	{
 		std::shared_ptr<task_controller_object::Object> retVal;
+		auto result = objectIndices.find(objectID);
 
-		for (const auto &currentObject : objectList)
+		if (objectIndices.end() != result)
+		{
+			retVal = objectList[result->second];
+		}
+		return retVal;
+	}
+
+	std::shared_ptr<task_controller_object::DeviceElementObject> DeviceDescriptorObjectPool::get_device_element_by_number(std::uint16_t elementNumber)
+	{
+		std::shared_ptr<task_controller_object::DeviceElementObject> retVal;
+
+		update_element_indices();
+		auto result = elementIndices.find(elementNumber);
+
+		if (elementIndices.end() != result)
 		{
-			if (currentObject->get_object_id() == objectID)
+			retVal = std::static_pointer_cast<task_controller_object::DeviceElementObject>(objectList[result->second]);
+		}
+		return retVal;
+	}
+
+	std::vector<std::shared_ptr<task_controller_object::DeviceElementObject>> DeviceDescriptorObjectPool::get_child_device_elements(std::uint16_t parentObjectID)
+	{
+		std::vector<std::shared_ptr<task_controller_object::DeviceElementObject>> retVal;
+
+		update_element_indices();
+		auto result = childElementIndices.find(parentObjectID);
+
+		if (childElementIndices.end() != result)
+		{
+			retVal.reserve(result->second.size());
+			for (const auto index : result->second)
 			{
-				retVal = currentObject;
-				break;
+				retVal.push_back(std::static_pointer_cast<task_controller_object::DeviceElementObject>(objectList[index]));
 			}
 		}
 		return retVal;
 	}
 
+	std::vector<std::shared_ptr<task_controller_object::DeviceProcessDataObject>> DeviceDescriptorObjectPool::get_device_element_process_data(std::uint16_t elementNumber)
+	{
+		std::vector<std::shared_ptr<task_controller_object::DeviceProcessDataObject>> retVal;
+		auto element = get_device_element_by_number(elementNumber);
+
+		if (nullptr != element)
+		{
+			for (std::uint16_t i = 0; i < element->get_number_child_objects(); i++)
+			{
+				auto child = get_object_by_id(element->get_child_object_id(i));
+
+				if ((nullptr != child) &&
+				    (task_controller_object::ObjectTypes::DeviceProcessData == child->get_object_type()))
+				{
+					retVal.push_back(std::static_pointer_cast<task_controller_object::DeviceProcessDataObject>(child));
+				}
+			}
+		}
+		return retVal;
+	}
+
+	std::shared_ptr<task_controller_object::DeviceProcessDataObject> DeviceDescriptorObjectPool::get_device_process_data(std::uint16_t elementNumber, std::uint16_t DDI)
+	{
+		std::shared_ptr<task_controller_object::DeviceProcessDataObject> retVal;
+
+		update_element_indices();
+		auto result = elementProcessDataIndices.find((static_cast<std::uint32_t>(elementNumber) << 16) | DDI);
+
+		if (elementProcessDataIndices.end() != result)
+		{
+			retVal = std::static_pointer_cast<task_controller_object::DeviceProcessDataObject>(objectList[result->second]);
+		}
+		return retVal;
+	}
+
+	std::vector<std::shared_ptr<task_controller_object::Object>> DeviceDescriptorObjectPool::get_objects_by_ddi(std::uint16_t DDI)
+	{
+		std::vector<std::shared_ptr<task_controller_object::Object>> retVal;
+
+		update_element_indices();
+		auto result = ddiIndices.find(DDI);
+
+		if (ddiIndices.end() != result)
+		{
+			retVal.reserve(result->second.size());
+			for (const auto index : result->second)
+			{
+				retVal.push_back(objectList[index]);
+			}
+		}
+		return retVal;
+	}
+
+	void DeviceDescriptorObjectPool::rebuild_indices()
+	{
+		rebuild_object_index();
+	}
+
 	std::shared_ptr<task_controller_object::Object> DeviceDescriptorObjectPool::get_object_by_index(std::uint16_t index)
 	{
 		std::shared_ptr<task_controller_object::Object> retVal = nullptr;
@@ -1045,14 +1149,13 @@ namespace isobus
 	{
 		bool retVal = false;
 
-		for (auto object = objectList.begin(); object != objectList.end(); object++)
+		auto result = objectIndices.find(objectID);
+
+		if (objectIndices.end() != result)
 		{
-			if ((nullptr != *object) && (*object)->get_object_id() == objectID)
-			{
-				objectList.erase(object);
-				retVal = true;
-				break;
-			}
+			objectList.erase(objectList.begin() + static_cast<std::ptrdiff_t>(result->second));
+			rebuild_object_index();
+			retVal = true;
 		}
 		return retVal;
 	}
@@ -1084,6 +1187,7 @@ namespace isobus
 	void DeviceDescriptorObjectPool::clear()
 	{
 		objectList.clear();
+		rebuild_object_index();
 	}
 
 	std::uint16_t DeviceDescriptorObjectPool::size() const
@@ -1250,14 +1354,7 @@ namespace isobus
 
 		if ((0 != uniqueID) && (NULL_OBJECT_ID != uniqueID))
 		{
-			for (const auto &currentObject : objectList)
-			{
-				if (uniqueID == currentObject->get_object_id())
-				{
-					retVal = false;
-					break;
-				}
-			}
+			retVal = (objectIndices.end() == objectIndices.find(uniqueID));
 		}
 		else
 		{
@@ -1266,4 +1363,85 @@ namespace isobus
 		return retVal;
 	}
 
+	void DeviceDescriptorObjectPool::add_last_object_to_index()
+	{
+		// If the ID is already used, like a second device object would, the first object with the ID keeps it
+		objectIndices.emplace(objectList.back()->get_object_id(), objectList.size() - 1);
+		elementIndicesValid = false;
+	}
+
+	void DeviceDescriptorObjectPool::rebuild_object_index()
+	{
+		objectIndices.clear();
+
+		for (std::size_t i = 0; i < objectList.size(); i++)
+		{
+			objectIndices.emplace(objectList[i]->get_object_id(), i);
+		}
+		elementIndicesValid = false;
+	}
+
+	void DeviceDescriptorObjectPool::update_element_indices()
+	{
+		if (!elementIndicesValid)
+		{
+			elementIndices.clear();
+			childElementIndices.clear();
+			ddiIndices.clear();
+			elementProcessDataIndices.clear();
+
+			for (std::size_t i = 0; i < objectList.size(); i++)
+			{
+				switch (objectList[i]->get_object_type())
+				{
+					case task_controller_object::ObjectTypes::DeviceElement:
+					{
+						auto element = std::static_pointer_cast<task_controller_object::DeviceElementObject>(objectList[i]);
+
+						elementIndices.emplace(element->get_element_number(), i);
+						childElementIndices[element->get_parent_object()].push_back(i);
+					}
+					break;
+
+					case task_controller_object::ObjectTypes::DeviceProcessData:
+					{
+						ddiIndices[std::static_pointer_cast<task_controller_object::DeviceProcessDataObject>(objectList[i])->get_ddi()].push_back(i);
+					}
+					break;
+
+					case task_controller_object::ObjectTypes::DeviceProperty:
+					{
+						ddiIndices[std::static_pointer_cast<task_controller_object::DevicePropertyObject>(objectList[i])->get_ddi()].push_back(i);
+					}
+					break;
+
+					default:
+					{
+						// Other objects are only looked up by object ID
+					}
+					break;
+				}
+			}
+
+			// Process data belongs to the elements that reference it, so resolve each element's references once
+			for (const auto &element : elementIndices)
+			{
+				auto elementObject = std::static_pointer_cast<task_controller_object::DeviceElementObject>(objectList[element.second]);
+
+				for (std::uint16_t i = 0; i < elementObject->get_number_child_objects(); i++)
+				{
+					auto child = objectIndices.find(elementObject->get_child_object_id(i));
+
+					if ((objectIndices.end() != child) &&
+					    (task_controller_object::ObjectTypes::DeviceProcessData == objectList[child->second]->get_object_type()))
+					{
+						const auto ddi = std::static_pointer_cast<task_controller_object::DeviceProcessDataObject>(objectList[child->second])->get_ddi();
+						elementProcessDataIndices.emplace((static_cast<std::uint32_t>(element.first) << 16) | ddi, child->second);
+					}
+				}
+			}
+			elementIndicesValid = true;
+		}
+	}
+
 } // namespace isobus
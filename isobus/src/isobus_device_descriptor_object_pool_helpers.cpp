@@ -63,32 +63,21 @@ namespace isobus
 				bool foundFunction = false;
 				std::shared_ptr<task_controller_object::DeviceElementObject> deviceElementObject;
 
-				// Next, iterate through all elements whose parent is the device object
-				for (std::uint16_t j = 0; j < ddop.size(); j++)
+				// Next, find the first element whose parent is the device object
+				auto deviceElements = ddop.get_child_device_elements(deviceObject->get_object_id());
+
+				if (!deviceElements.empty())
 				{
-					auto currentElementObject = ddop.get_object_by_index(j);
+					deviceElementObject = deviceElements.front();
 
-					if ((nullptr != currentElementObject) &&
-					    (task_controller_object::ObjectTypes::DeviceElement == currentElementObject->get_object_type()) &&
-					    (std::static_pointer_cast<task_controller_object::DeviceElementObject>(currentElementObject)->get_parent_object() == deviceObject->get_object_id()))
+					// All the things we care about are likely in here, under the device element.
+					for (const auto &potentialFunction : ddop.get_child_device_elements(deviceElementObject->get_object_id()))
 					{
-						deviceElementObject = std::static_pointer_cast<task_controller_object::DeviceElementObject>(currentElementObject);
-
-						// All the things we care about are likely in here, under the device element.
-						for (std::uint16_t k = 0; k < ddop.size(); k++)
+						if (task_controller_object::DeviceElementObject::Type::Function == potentialFunction->get_type())
 						{
-							auto potentialFunction = ddop.get_object_by_index(k);
-
-							if ((nullptr != potentialFunction) &&
-							    (task_controller_object::ObjectTypes::DeviceElement == potentialFunction->get_object_type()) &&
-							    (std::static_pointer_cast<task_controller_object::DeviceElementObject>(potentialFunction)->get_parent_object() == currentElementObject->get_object_id()) &&
-							    (task_controller_object::DeviceElementObject::Type::Function == std::static_pointer_cast<task_controller_object::DeviceElementObject>(potentialFunction)->get_type()))
-							{
-								parse_element(ddop, std::static_pointer_cast<task_controller_object::DeviceElementObject>(potentialFunction), retVal);
-								foundFunction = true;
-							}
+							parse_element(ddop, potentialFunction, retVal);
+							foundFunction = true;
 						}
-						break;
 					}
 				}
 
@@ -100,16 +89,11 @@ namespace isobus
 
 					// Search all elements whose parent is the device element object
 					// To look for bins as well, since we didn't find any functions.
-					for (std::uint16_t k = 0; k < ddop.size(); k++)
+					for (const auto &potentialBin : ddop.get_child_device_elements(deviceElementObject->get_object_id()))
 					{
-						auto potentialBin = ddop.get_object_by_index(k);
-
-						if ((nullptr != potentialBin) &&
-						    (task_controller_object::ObjectTypes::DeviceElement == potentialBin->get_object_type()) &&
-						    (std::static_pointer_cast<task_controller_object::DeviceElementObject>(potentialBin)->get_parent_object() == deviceElementObject->get_object_id()) &&
-						    (task_controller_object::DeviceElementObject::Type::Bin == std::static_pointer_cast<task_controller_object::DeviceElementObject>(potentialBin)->get_type()))
+						if (task_controller_object::DeviceElementObject::Type::Bin == potentialBin->get_type())
 						{
-							auto binInfo = parse_bin(ddop, std::static_pointer_cast<task_controller_object::DeviceElementObject>(potentialBin));
+							auto binInfo = parse_bin(ddop, potentialBin);
 
 							if (binInfo.is_valid() && !retVal.booms.empty())
 							{
@@ -135,27 +119,19 @@ namespace isobus
 		if (task_controller_object::DeviceElementObject::Type::Function == elementObject->get_type())
 		{
 			// Accumulate the number of functions under this function.
-			// Need to search the whole pool because elements have parent links, not child links, which is not very efficient.
-			for (std::uint16_t i = 0; i < ddop.size(); i++)
+			for (const auto &element : ddop.get_child_device_elements(elementObject->get_object_id()))
 			{
-				auto element = ddop.get_object_by_index(i);
-
-				if ((nullptr != element) &&
-				    (task_controller_object::ObjectTypes::DeviceElement == element->get_object_type()) &&
-				    (std::static_pointer_cast<task_controller_object::DeviceElementObject>(element)->get_parent_object() == elementObject->get_object_id()))
+				if (task_controller_object::DeviceElementObject::Type::Function == element->get_type())
 				{
-					if (task_controller_object::DeviceElementObject::Type::Function == std::static_pointer_cast<task_controller_object::DeviceElementObject>(element)->get_type())
-					{
-						boomToPopulate.subBooms.push_back(parse_sub_boom(ddop, std::static_pointer_cast<task_controller_object::DeviceElementObject>(element)));
-					}
-					else if (task_controller_object::DeviceElementObject::Type::Bin == std::static_pointer_cast<task_controller_object::DeviceElementObject>(element)->get_type())
-					{
-						auto binInfo = parse_bin(ddop, std::static_pointer_cast<task_controller_object::DeviceElementObject>(element));
+					boomToPopulate.subBooms.push_back(parse_sub_boom(ddop, element));
+				}
+				else if (task_controller_object::DeviceElementObject::Type::Bin == element->get_type())
+				{
+					auto binInfo = parse_bin(ddop, element);
 
-						if (binInfo.is_valid())
-						{
-							boomToPopulate.rates.push_back(binInfo);
-						}
+					if (binInfo.is_valid())
+					{
+						boomToPopulate.rates.push_back(binInfo);
 					}
 				}
 			}
@@ -164,16 +140,11 @@ namespace isobus
 		if (boomToPopulate.subBooms.empty())
 		{
 			// Find all sections in this boom
-			for (std::uint16_t i = 0; i < ddop.size(); i++)
+			for (const auto &section : ddop.get_child_device_elements(elementObject->get_object_id()))
 			{
-				auto section = ddop.get_object_by_index(i);
-
-				if ((nullptr != section) &&
-				    (task_controller_object::ObjectTypes::DeviceElement == section->get_object_type()) &&
-				    (task_controller_object::DeviceElementObject::Type::Section == std::static_pointer_cast<task_controller_object::DeviceElementObject>(section)->get_type()) &&
-				    (std::static_pointer_cast<task_controller_object::DeviceElementObject>(section)->get_parent_object() == elementObject->get_object_id()))
+				if (task_controller_object::DeviceElementObject::Type::Section == section->get_type())
 				{
-					boomToPopulate.sections.push_back(parse_section(ddop, std::static_pointer_cast<task_controller_object::DeviceElementObject>(section)));
+					boomToPopulate.sections.push_back(parse_section(ddop, section));
 				}
 			}
 
@@ -268,17 +239,11 @@ namespace isobus
 		retVal.elementNumber = elementObject->get_element_number();
 
 		// Find all sections in this sub boom
-		// We again have to search the whole pool because elements have parent links, not child links
-		for (std::uint16_t i = 0; i < ddop.size(); i++)
+		for (const auto &section : ddop.get_child_device_elements(elementObject->get_object_id()))
 		{
-			auto section = ddop.get_object_by_index(i);
-
-			if ((nullptr != section) &&
-			    (task_controller_object::ObjectTypes::DeviceElement == section->get_object_type()) &&
-			    (task_controller_object::DeviceElementObject::Type::Section == std::static_pointer_cast<task_controller_object::DeviceElementObject>(section)->get_type()) &&
-			    (std::static_pointer_cast<task_controller_object::DeviceElementObject>(section)->get_parent_object() == elementObject->get_object_id()))
+			if (task_controller_object::DeviceElementObject::Type::Section == section->get_type())
 			{
-				retVal.sections.push_back(parse_section(ddop, std::static_pointer_cast<task_controller_object::DeviceElementObject>(section)));
+				retVal.sections.push_back(parse_section(ddop, section));
 			}
 		}
 
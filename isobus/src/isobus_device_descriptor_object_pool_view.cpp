@@ -0,0 +1,683 @@
+//================================================================================================
+/// @file isobus_device_descriptor_object_pool_view.cpp
+///
+/// @brief Implements a read-only view of a binary DDOP, which reads objects straight out of
+/// the binary data instead of converting them into objects.
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/isobus_device_descriptor_object_pool_view.hpp"
+
+#include "isobus/isobus/can_constants.hpp"
+#include "isobus/isobus/can_stack_logger.hpp"
+#include "isobus/isobus/isobus_device_descriptor_object_pool.hpp"
+#include "isobus/utility/platform_endianness.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace isobus
+{
+	std::string DeviceDescriptorObjectPoolView::ByteSpan::to_string() const
+	{
+		std::string retVal;
+
+		if (nullptr != data)
+		{
+			retVal.assign(reinterpret_cast<const char *>(data), length);
+		}
+		return retVal;
+	}
+
+	bool DeviceDescriptorObjectPoolView::Object::get_is_valid() const
+	{
+		return nullptr != data;
+	}
+
+	task_controller_object::ObjectTypes DeviceDescriptorObjectPoolView::Object::get_object_type() const
+	{
+		return objectType;
+	}
+
+	std::uint16_t DeviceDescriptorObjectPoolView::Object::get_object_id() const
+	{
+		return (nullptr != data) ? read_uint16(3) : NULL_OBJECT_ID;
+	}
+
+	DeviceDescriptorObjectPoolView::ByteSpan DeviceDescriptorObjectPoolView::Object::get_designator() const
+	{
+		ByteSpan retVal = { nullptr, 0 };
+
+		if (nullptr != data)
+		{
+			switch (objectType)
+			{
+				case task_controller_object::ObjectTypes::Device:
+				{
+					retVal = { data + 6, data[5] };
+				}
+				break;
+
+				case task_controller_object::ObjectTypes::DeviceElement:
+				{
+					retVal = { data + 7, data[6] };
+				}
+				break;
+
+				case task_controller_object::ObjectTypes::DeviceProcessData:
+				{
+					retVal = { data + 10, data[9] };
+				}
+				break;
+
+				case task_controller_object::ObjectTypes::DeviceProperty:
+				{
+					retVal = { data + 12, data[11] };
+				}
+				break;
+
+				case task_controller_object::ObjectTypes::DeviceValuePresentation:
+				{
+					retVal = { data + 15, data[14] };
+				}
+				break;
+			}
+		}
+		return retVal;
+	}
+
+	DeviceDescriptorObjectPoolView::ByteSpan DeviceDescriptorObjectPoolView::Object::get_software_version() const
+	{
+		ByteSpan retVal = { nullptr, 0 };
+
+		if ((nullptr != data) && (task_controller_object::ObjectTypes::Device == objectType))
+		{
+			const std::size_t lengthOffset = 6 + data[5];
+			retVal = { data + lengthOffset + 1, data[lengthOffset] };
+		}
+		return retVal;
+	}
+
+	DeviceDescriptorObjectPoolView::ByteSpan DeviceDescriptorObjectPoolView::Object::get_serial_number() const
+	{
+		ByteSpan retVal = { nullptr, 0 };
+
+		if ((nullptr != data) && (task_controller_object::ObjectTypes::Device == objectType))
+		{
+			const std::size_t lengthOffset = get_serial_number_length_offset();
+			retVal = { data + lengthOffset + 1, data[lengthOffset] };
+		}
+		return retVal;
+	}
+
+	DeviceDescriptorObjectPoolView::ByteSpan DeviceDescriptorObjectPoolView::Object::get_structure_label() const
+	{
+		ByteSpan retVal = { nullptr, 0 };
+
+		if ((nullptr != data) && (task_controller_object::ObjectTypes::Device == objectType))
+		{
+			const std::size_t serialNumberLengthOffset = get_serial_number_length_offset();
+			retVal = { data + serialNumberLengthOffset + 1 + data[serialNumberLengthOffset], task_controller_object::DeviceObject::MAX_STRUCTURE_AND_LOCALIZATION_LABEL_LENGTH };
+		}
+		return retVal;
+	}
+
+	DeviceDescriptorObjectPoolView::ByteSpan DeviceDescriptorObjectPoolView::Object::get_localization_label() const
+	{
+		ByteSpan retVal = get_structure_label();
+
+		if (nullptr != retVal.data)
+		{
+			retVal.data += task_controller_object::DeviceObject::MAX_STRUCTURE_AND_LOCALIZATION_LABEL_LENGTH;
+		}
+		return retVal;
+	}
+
+	DeviceDescriptorObjectPoolView::ByteSpan DeviceDescriptorObjectPoolView::Object::get_extended_structure_label() const
+	{
+		ByteSpan retVal = { nullptr, 0 };
+		ByteSpan localizationLabel = get_localization_label();
+
+		if (nullptr != localizationLabel.data)
+		{
+			// The extended structure label length is only there for TC version 4 and later, in which case the object is longer
+			const std::size_t lengthOffset = static_cast<std::size_t>(localizationLabel.data - data) + localizationLabel.length;
+
+			if ((lengthOffset < size) && (0 != data[lengthOffset]))
+			{
+				retVal = { data + lengthOffset + 1, data[lengthOffset] };
+			}
+		}
+		return retVal;
+	}
+
+	std::uint64_t DeviceDescriptorObjectPoolView::Object::get_iso_name() const
+	{
+		std::uint64_t retVal = 0;
+
+		if ((nullptr != data) && (task_controller_object::ObjectTypes::Device == objectType))
+		{
+			const std::size_t nameOffset = get_serial_number_length_offset() - 8;
+			retVal = static_cast<std::uint64_t>(read_uint32(nameOffset)) | (static_cast<std::uint64_t>(read_uint32(nameOffset + 4)) << 32);
+		}
+		return retVal;
+	}
+
+	task_controller_object::DeviceElementObject::Type DeviceDescriptorObjectPoolView::Object::get_element_type() const
+	{
+		auto retVal = task_controller_object::DeviceElementObject::Type::Device;
+
+		if ((nullptr != data) && (task_controller_object::ObjectTypes::DeviceElement == objectType))
+		{
+			retVal = static_cast<task_controller_object::DeviceElementObject::Type>(data[5]);
+		}
+		return retVal;
+	}
+
+	std::uint16_t DeviceDescriptorObjectPoolView::Object::get_element_number() const
+	{
+		std::uint16_t retVal = 0;
+
+		if ((nullptr != data) && (task_controller_object::ObjectTypes::DeviceElement == objectType))
+		{
+			retVal = read_uint16(7 + data[6]);
+		}
+		return retVal;
+	}
+
+	std::uint16_t DeviceDescriptorObjectPoolView::Object::get_parent_object() const
+	{
+		std::uint16_t retVal = NULL_OBJECT_ID;
+
+		if ((nullptr != data) && (task_controller_object::ObjectTypes::DeviceElement == objectType))
+		{
+			retVal = read_uint16(9 + data[6]);
+		}
+		return retVal;
+	}
+
+	std::uint16_t DeviceDescriptorObjectPoolView::Object::get_number_child_objects() const
+	{
+		std::uint16_t retVal = 0;
+
+		if ((nullptr != data) && (task_controller_object::ObjectTypes::DeviceElement == objectType))
+		{
+			retVal = read_uint16(11 + data[6]);
+		}
+		return retVal;
+	}
+
+	std::uint16_t DeviceDescriptorObjectPoolView::Object::get_child_object_id(std::size_t index) const
+	{
+		std::uint16_t retVal = NULL_OBJECT_ID;
+
+		if (index < get_number_child_objects())
+		{
+			retVal = read_uint16(13 + data[6] + (2 * index));
+		}
+		return retVal;
+	}
+
+	std::uint16_t DeviceDescriptorObjectPoolView::Object::get_ddi() const
+	{
+		std::uint16_t retVal = 0;
+
+		if ((nullptr != data) &&
+		    ((task_controller_object::ObjectTypes::DeviceProcessData == objectType) ||
+		     (task_controller_object::ObjectTypes::DeviceProperty == objectType)))
+		{
+			retVal = read_uint16(5);
+		}
+		return retVal;
+	}
+
+	std::uint8_t DeviceDescriptorObjectPoolView::Object::get_properties_bitfield() const
+	{
+		std::uint8_t retVal = 0;
+
+		if ((nullptr != data) && (task_controller_object::ObjectTypes::DeviceProcessData == objectType))
+		{
+			retVal = data[7];
+		}
+		return retVal;
+	}
+
+	std::uint8_t DeviceDescriptorObjectPoolView::Object::get_trigger_methods_bitfield() const
+	{
+		std::uint8_t retVal = 0;
+
+		if ((nullptr != data) && (task_controller_object::ObjectTypes::DeviceProcessData == objectType))
+		{
+			retVal = data[8];
+		}
+		return retVal;
+	}
+
+	std::int32_t DeviceDescriptorObjectPoolView::Object::get_value() const
+	{
+		std::int32_t retVal = 0;
+
+		if ((nullptr != data) && (task_controller_object::ObjectTypes::DeviceProperty == objectType))
+		{
+			retVal = static_cast<std::int32_t>(read_uint32(7));
+		}
+		return retVal;
+	}
+
+	std::uint16_t DeviceDescriptorObjectPoolView::Object::get_device_value_presentation_object_id() const
+	{
+		std::uint16_t retVal = NULL_OBJECT_ID;
+
+		if (nullptr != data)
+		{
+			if (task_controller_object::ObjectTypes::DeviceProcessData == objectType)
+			{
+				retVal = read_uint16(10 + data[9]);
+			}
+			else if (task_controller_object::ObjectTypes::DeviceProperty == objectType)
+			{
+				retVal = read_uint16(12 + data[11]);
+			}
+		}
+		return retVal;
+	}
+
+	std::int32_t DeviceDescriptorObjectPoolView::Object::get_offset() const
+	{
+		std::int32_t retVal = 0;
+
+		if ((nullptr != data) && (task_controller_object::ObjectTypes::DeviceValuePresentation == objectType))
+		{
+			retVal = static_cast<std::int32_t>(read_uint32(5));
+		}
+		return retVal;
+	}
+
+	float DeviceDescriptorObjectPoolView::Object::get_scale() const
+	{
+		float retVal = 0.0f;
+
+		if ((nullptr != data) && (task_controller_object::ObjectTypes::DeviceValuePresentation == objectType))
+		{
+			std::array<std::uint8_t, sizeof(float)> scaleBytes = { { data[9], data[10], data[11], data[12] } };
+
+			if (is_big_endian())
+			{
+				std::reverse(scaleBytes.begin(), scaleBytes.end());
+			}
+			memcpy(&retVal, scaleBytes.data(), sizeof(float));
+		}
+		return retVal;
+	}
+
+	std::uint8_t DeviceDescriptorObjectPoolView::Object::get_number_of_decimals() const
+	{
+		std::uint8_t retVal = 0;
+
+		if ((nullptr != data) && (task_controller_object::ObjectTypes::DeviceValuePresentation == objectType))
+		{
+			retVal = data[13];
+		}
+		return retVal;
+	}
+
+	DeviceDescriptorObjectPoolView::Object::Object(const std::uint8_t *objectData, std::uint32_t objectSize, task_controller_object::ObjectTypes type) :
+	  data(objectData),
+	  size(objectSize),
+	  objectType(type)
+	{
+	}
+
+	std::uint16_t DeviceDescriptorObjectPoolView::Object::read_uint16(std::size_t offset) const
+	{
+		return static_cast<std::uint16_t>(static_cast<std::uint16_t>(data[offset]) | (static_cast<std::uint16_t>(data[offset + 1]) << 8));
+	}
+
+	std::uint32_t DeviceDescriptorObjectPoolView::Object::read_uint32(std::size_t offset) const
+	{
+		return static_cast<std::uint32_t>(data[offset]) |
+		  (static_cast<std::uint32_t>(data[offset + 1]) << 8) |
+		  (static_cast<std::uint32_t>(data[offset + 2]) << 16) |
+		  (static_cast<std::uint32_t>(data[offset + 3]) << 24);
+	}
+
+	std::size_t DeviceDescriptorObjectPoolView::Object::get_serial_number_length_offset() const
+	{
+		const std::size_t softwareVersionLengthOffset = 6 + data[5];
+		return softwareVersionLengthOffset + 1 + data[softwareVersionLengthOffset] + 8;
+	}
+
+	bool DeviceDescriptorObjectPoolView::parse(const std::uint8_t *binaryPool, std::uint32_t binaryPoolSizeBytes, std::uint8_t taskControllerServerVersion, NAME clientNAME)
+	{
+		bool retVal = true;
+
+		clear();
+
+		if ((nullptr != binaryPool) && (0 != binaryPoolSizeBytes))
+		{
+			std::uint32_t offset = 0;
+
+			LOG_DEBUG("[DDOP]: Checking a binary object pool with size %u.", binaryPoolSizeBytes);
+
+			while (offset < binaryPoolSizeBytes)
+			{
+				ObjectLocation location = { offset, 0, task_controller_object::ObjectTypes::Device };
+
+				if (parse_object(binaryPool + offset, binaryPoolSizeBytes - offset, taskControllerServerVersion, clientNAME, location))
+				{
+					if (task_controller_object::ObjectTypes::Device == location.type)
+					{
+						// Deserializing replaces earlier device objects with later ones, so the last one is the device
+						deviceIndex = objectLocations.size();
+					}
+					objectIDIndices.emplace_back(static_cast<std::uint16_t>(static_cast<std::uint16_t>(binaryPool[offset + 3]) | (static_cast<std::uint16_t>(binaryPool[offset + 4]) << 8)),
+					                             static_cast<std::uint32_t>(objectLocations.size()));
+					objectLocations.push_back(location);
+					offset += location.size;
+				}
+				else
+				{
+					LOG_ERROR("[DDOP]: Binary DDOP check aborted.");
+					retVal = false;
+					break;
+				}
+			}
+		}
+		else
+		{
+			retVal = false;
+			LOG_ERROR("[DDOP]: Cannot check a DDOP with zero length.");
+		}
+
+		if (retVal)
+		{
+			// Sort by object ID, keeping objects with the same ID in DDOP order so the last one can be kept
+			std::stable_sort(objectIDIndices.begin(), objectIDIndices.end(), [](const std::pair<std::uint16_t, std::uint32_t> &lhs, const std::pair<std::uint16_t, std::uint32_t> &rhs) {
+				return lhs.first < rhs.first;
+			});
+			auto lastOfEachID = std::unique(objectIDIndices.rbegin(), objectIDIndices.rend(), [](const std::pair<std::uint16_t, std::uint32_t> &lhs, const std::pair<std::uint16_t, std::uint32_t> &rhs) {
+				return lhs.first == rhs.first;
+			});
+			objectIDIndices.erase(objectIDIndices.begin(), lastOfEachID.base());
+
+			binaryData = binaryPool;
+			binaryDataSize = binaryPoolSizeBytes;
+			poolNAME = clientNAME;
+			taskControllerVersion = taskControllerServerVersion;
+		}
+		else
+		{
+			clear();
+		}
+		return retVal;
+	}
+
+	bool DeviceDescriptorObjectPoolView::parse(const std::vector<std::uint8_t> &binaryPool, std::uint8_t taskControllerServerVersion, NAME clientNAME)
+	{
+		return parse(binaryPool.data(), static_cast<std::uint32_t>(binaryPool.size()), taskControllerServerVersion, clientNAME);
+	}
+
+	void DeviceDescriptorObjectPoolView::clear()
+	{
+		objectLocations.clear();
+		objectIDIndices.clear();
+		binaryData = nullptr;
+		binaryDataSize = 0;
+		deviceIndex = 0;
+		poolNAME = NAME(0);
+		taskControllerVersion = 4;
+	}
+
+	std::size_t DeviceDescriptorObjectPoolView::size() const
+	{
+		return objectLocations.size();
+	}
+
+	DeviceDescriptorObjectPoolView::Object DeviceDescriptorObjectPoolView::get_object_by_index(std::size_t index) const
+	{
+		Object retVal;
+
+		if (index < objectLocations.size())
+		{
+			const auto &location = objectLocations[index];
+			retVal = Object(binaryData + location.offset, location.size, location.type);
+		}
+		return retVal;
+	}
+
+	DeviceDescriptorObjectPoolView::Object DeviceDescriptorObjectPoolView::get_object_by_id(std::uint16_t objectID) const
+	{
+		Object retVal;
+		auto result = std::lower_bound(objectIDIndices.begin(), objectIDIndices.end(), objectID, [](const std::pair<std::uint16_t, std::uint32_t> &entry, std::uint16_t id) {
+			return entry.first < id;
+		});
+
+		if ((objectIDIndices.end() != result) && (objectID == result->first))
+		{
+			retVal = get_object_by_index(result->second);
+		}
+		return retVal;
+	}
+
+	DeviceDescriptorObjectPoolView::Object DeviceDescriptorObjectPoolView::get_device() const
+	{
+		Object retVal;
+
+		if ((deviceIndex < objectLocations.size()) &&
+		    (task_controller_object::ObjectTypes::Device == objectLocations[deviceIndex].type))
+		{
+			retVal = get_object_by_index(deviceIndex);
+		}
+		return retVal;
+	}
+
+	bool DeviceDescriptorObjectPoolView::materialize(DeviceDescriptorObjectPool &pool) const
+	{
+		bool retVal = false;
+
+		if (nullptr != binaryData)
+		{
+			pool.set_task_controller_compatibility_level(taskControllerVersion);
+			retVal = pool.deserialize_binary_object_pool(binaryData, binaryDataSize, poolNAME);
+		}
+		return retVal;
+	}
+
+	bool DeviceDescriptorObjectPoolView::parse_object(const std::uint8_t *objectData, std::uint32_t remainingBytes, std::uint8_t taskControllerServerVersion, NAME &clientNAME, ObjectLocation &location)
+	{
+		bool retVal = true;
+		std::uint32_t expectedSize = 0;
+
+		// These are the same checks deserialize_binary_object_pool makes, so that a DDOP the view
+		// accepts can always be materialized
+		if (remainingBytes <= 3)
+		{
+			LOG_ERROR("[DDOP]: Not enough binary DDOP data left to contain an object.");
+			retVal = false;
+		}
+		else if (('D' == objectData[0]) && ('V' == objectData[1]) && ('C' == objectData[2]))
+		{
+			std::uint8_t numberDesignatorBytes = 0;
+			std::uint8_t numberSoftwareVersionBytes = 0;
+			std::uint8_t numberDeviceSerialNumberBytes = 0;
+			std::uint8_t numberExtendedStructureLabelBytes = 0;
+
+			location.type = task_controller_object::ObjectTypes::Device;
+
+			if ((remainingBytes >= 6) && (objectData[5] < 128))
+			{
+				numberDesignatorBytes = objectData[5];
+			}
+			else
+			{
+				LOG_ERROR("[DDOP]: Binary device object designator has invalid length.");
+				retVal = false;
+			}
+
+			if (retVal &&
+			    (remainingBytes >= static_cast<std::uint32_t>(7 + numberDesignatorBytes)) &&
+			    (objectData[6 + numberDesignatorBytes] < 128))
+			{
+				numberSoftwareVersionBytes = objectData[6 + numberDesignatorBytes];
+			}
+			else if (retVal)
+			{
+				LOG_ERROR("[DDOP]: Binary device object software version has invalid length.");
+				retVal = false;
+			}
+
+			if (retVal &&
+			    (remainingBytes >= static_cast<std::uint32_t>(16 + numberDesignatorBytes + numberSoftwareVersionBytes)) &&
+			    (objectData[15 + numberDesignatorBytes + numberSoftwareVersionBytes] < 128))
+			{
+				numberDeviceSerialNumberBytes = objectData[15 + numberDesignatorBytes + numberSoftwareVersionBytes];
+			}
+			else if (retVal)
+			{
+				LOG_ERROR("[DDOP]: Binary device object serial number has invalid length.");
+				retVal = false;
+			}
+
+			expectedSize = (30 + numberDeviceSerialNumberBytes + numberDesignatorBytes + numberSoftwareVersionBytes);
+
+			if (retVal && (taskControllerServerVersion >= 4))
+			{
+				if ((remainingBytes > expectedSize) &&
+				    (objectData[expectedSize] <= task_controller_object::DeviceObject::MAX_EXTENDED_STRUCTURE_LABEL_LENGTH))
+				{
+					numberExtendedStructureLabelBytes = objectData[expectedSize];
+					expectedSize += (1 + numberExtendedStructureLabelBytes);
+				}
+				else
+				{
+					LOG_ERROR("[DDOP]: Binary device object with version 4 contains invalid extended structure label length.");
+					retVal = false;
+				}
+			}
+
+			if (retVal && (remainingBytes >= expectedSize))
+			{
+				std::uint64_t ddopClientNAME = 0;
+
+				for (std::uint8_t i = 0; i < 8; i++)
+				{
+					ddopClientNAME |= (static_cast<std::uint64_t>(objectData[7 + numberDesignatorBytes + numberSoftwareVersionBytes + i]) << (8 * i));
+				}
+
+				if (0 == clientNAME.get_full_name())
+				{
+					clientNAME.set_full_name(ddopClientNAME);
+				}
+				else if (ddopClientNAME != clientNAME.get_full_name())
+				{
+					LOG_ERROR("[DDOP]: Binary device object NAME doesn't match client's actual NAME.");
+					retVal = false;
+				}
+			}
+			else if (retVal)
+			{
+				LOG_ERROR("[DDOP]: Not enough binary DDOP data left to parse device object. DDOP schema is not valid");
+				retVal = false;
+			}
+		}
+		else if (('D' == objectData[0]) && ('E' == objectData[1]) && ('T' == objectData[2]))
+		{
+			location.type = task_controller_object::ObjectTypes::DeviceElement;
+
+			if ((remainingBytes < 7) ||
+			    (remainingBytes < static_cast<std::uint32_t>(13 + objectData[6])))
+			{
+				LOG_ERROR("[DDOP]: Binary device element object has invalid length.");
+				retVal = false;
+			}
+			else if (objectData[5] > static_cast<std::uint8_t>(task_controller_object::DeviceElementObject::Type::NavigationReference))
+			{
+				LOG_ERROR("[DDOP]: Binary device element object has invalid element type.");
+				retVal = false;
+			}
+			else
+			{
+				const std::uint8_t numberDesignatorBytes = objectData[6];
+				const std::uint32_t numberOfObjectIDs = static_cast<std::uint32_t>(objectData[11 + numberDesignatorBytes]) |
+				  (static_cast<std::uint32_t>(objectData[12 + numberDesignatorBytes]) << 8);
+
+				expectedSize = (13 + (2 * numberOfObjectIDs) + numberDesignatorBytes);
+
+				if (remainingBytes < expectedSize)
+				{
+					LOG_ERROR("[DDOP]: Not enough binary DDOP data left to parse device element object. DDOP schema is not valid");
+					retVal = false;
+				}
+			}
+		}
+		else if (('D' == objectData[0]) && ('P' == objectData[1]) && ('D' == objectData[2]))
+		{
+			location.type = task_controller_object::ObjectTypes::DeviceProcessData;
+
+			if ((remainingBytes >= 10) && (objectData[9] < 128))
+			{
+				expectedSize = (12 + objectData[9]);
+
+				if (remainingBytes < expectedSize)
+				{
+					LOG_ERROR("[DDOP]: Not enough binary DDOP data left to parse device process data object. DDOP schema is not valid");
+					retVal = false;
+				}
+			}
+			else
+			{
+				LOG_ERROR("[DDOP]: Binary device process data object has invalid length.");
+				retVal = false;
+			}
+		}
+		else if (('D' == objectData[0]) && ('P' == objectData[1]) && ('T' == objectData[2]))
+		{
+			location.type = task_controller_object::ObjectTypes::DeviceProperty;
+
+			if ((remainingBytes >= 12) && (objectData[11] < 128))
+			{
+				expectedSize = (14 + objectData[11]);
+
+				if (remainingBytes < expectedSize)
+				{
+					LOG_ERROR("[DDOP]: Not enough binary DDOP data left to parse device property object. DDOP schema is not valid");
+					retVal = false;
+				}
+			}
+			else
+			{
+				LOG_ERROR("[DDOP]: Binary device property object has invalid length.");
+				retVal = false;
+			}
+		}
+		else if (('D' == objectData[0]) && ('V' == objectData[1]) && ('P' == objectData[2]))
+		{
+			location.type = task_controller_object::ObjectTypes::DeviceValuePresentation;
+
+			if ((remainingBytes >= 15) && (objectData[14] < 128))
+			{
+				expectedSize = (15 + objectData[14]);
+
+				if (remainingBytes < expectedSize)
+				{
+					LOG_ERROR("[DDOP]: Not enough binary DDOP data left to parse device value presentation object. DDOP schema is not valid");
+					retVal = false;
+				}
+			}
+			else
+			{
+				LOG_ERROR("[DDOP]: Binary device value presentation object has invalid length.");
+				retVal = false;
+			}
+		}
+		else
+		{
+			LOG_ERROR("[DDOP]: Cannot process an unknown XML namespace from binary DDOP. DDOP schema is invalid.");
+			retVal = false;
+		}
+
+		location.size = expectedSize;
+		return retVal;
+	}
+} // namespace isobus
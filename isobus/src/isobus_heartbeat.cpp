@@ -21,6 +21,9 @@
 #include "isobus/isobus/can_stack_logger.hpp"
 #include "isobus/utility/system_timing.hpp"
 
+#include <algorithm>
+#include <limits>
+
 namespace isobus
 {
 	HeartbeatInterface::HeartbeatInterface(const CANMessageFrameCallback &sendCANFrameCallback) :
@@ -128,6 +131,26 @@ namespace isobus
 		}
 	}
 
+	std::uint32_t HeartbeatInterface::get_time_until_next_deadline_ms() const
+	{
+		std::uint32_t retVal = std::numeric_limits<std::uint32_t>::max();
+
+		if (enabled)
+		{
+			for (const auto &heartbeat : trackedHeartbeats)
+			{
+				if (nullptr != heartbeat.controlFunction)
+				{
+					const std::uint32_t elapsed_ms = SystemTiming::get_time_elapsed_ms(heartbeat.timestamp_ms);
+					const std::uint32_t interval_ms = (ControlFunction::Type::Internal == heartbeat.controlFunction->get_type()) ? heartbeat.repetitionRate_ms : SEQUENCE_TIMEOUT_MS;
+
+					retVal = std::min(retVal, (interval_ms > elapsed_ms) ? (interval_ms - elapsed_ms) : 0);
+				}
+			}
+		}
+		return retVal;
+	}
+
 	HeartbeatInterface::Heartbeat::Heartbeat(std::shared_ptr<ControlFunction> sendingControlFunction) :
 	  controlFunction(sendingControlFunction),
 	  timestamp_ms(SystemTiming::get_timestamp_ms())
@@ -11,6 +11,7 @@
 #include "isobus/isobus/can_general_parameter_group_numbers.hpp"
 #include "isobus/isobus/can_network_manager.hpp"
 #include "isobus/isobus/can_stack_logger.hpp"
+#include "isobus/isobus/isobus_standard_data_description_indices.hpp"
 #include "isobus/utility/system_timing.hpp"
 #include "isobus/utility/to_string.hpp"
 
@@ -227,7 +228,7 @@ namespace isobus
 	{
 		if (initialized)
 		{
-			LOCK_GUARD(Mutex, clientMutex);
+			// Disconnecting takes the client mutex itself
 			set_state(StateMachineState::Disconnected);
 		}
 	}
@@ -890,10 +891,40 @@ namespace isobus
 	{
 		queuedValueRequests.clear();
 		queuedValueCommands.clear();
-		measurementTimeIntervalCommands.clear();
-		measurementMinimumThresholdCommands.clear();
-		measurementMaximumThresholdCommands.clear();
-		measurementOnChangeThresholdCommands.clear();
+
+		// Forget what the TC asked for, but keep what the application published
+		for (auto &triggers : measurementTriggers)
+		{
+			MeasurementTriggers publishedTriggers;
+			publishedTriggers.elementNumber = triggers.elementNumber;
+			publishedTriggers.ddi = triggers.ddi;
+			publishedTriggers.publishedValue = triggers.publishedValue;
+			publishedTriggers.valuePublished = triggers.valuePublished;
+			triggers = publishedTriggers;
+		}
+		polledThresholdTriggers.clear();
+		pendingThresholdTriggers.clear();
+		queuedMeasurementValues.clear();
+		measurementTimeIntervalTimers.clear();
+
+		// A TC that reconnects no longer knows the work states, so every section that isn't
+		// in its default state is sent again once the client is connected
+		const std::uint32_t timestamp_ms = SystemTiming::get_timestamp_ms();
+		for (auto &workStates : sectionWorkStates)
+		{
+			workStates.sentWorkStates.fill(0xFFFFFFFF);
+			workStates.changedWorkStates = 0;
+			workStates.firstChangeTimestamp_ms = timestamp_ms;
+
+			for (std::uint8_t i = 0; i < NUMBER_OF_CONDENSED_WORK_STATE_DDIS; i++)
+			{
+				if (workStates.workStates[i] != workStates.sentWorkStates[i])
+				{
+					workStates.changedWorkStates |= static_cast<std::uint16_t>(1 << i);
+					workStates.changeTimestamps_ms[i] = timestamp_ms;
+				}
+			}
+		}
 	}
 
 	bool TaskControllerClient::get_was_ddop_supplied() const
@@ -1031,36 +1062,36 @@ namespace isobus
 
 	void TaskControllerClient::process_queued_commands()
 	{
-		LOCK_GUARD(Mutex, clientMutex);
+		// The application's callbacks are called without holding the lock,
+		// so that they can use the client too, for example to publish values
 		bool transmitSuccessful = true;
+		ProcessDataCallbackInfo currentRequest;
+
+		{
+			LOCK_GUARD(Mutex, clientMutex);
+			applicationRequestValueCallbacks = requestValueCallbacks;
+			applicationValueCommandCallbacks = valueCommandsCallbacks;
+		}
 
-		while (!queuedValueRequests.empty() && transmitSuccessful)
+		while (transmitSuccessful && pop_queued_command(queuedValueRequests, currentRequest))
 		{
-			const auto &currentRequest = queuedValueRequests.front();
+			std::int32_t newValue = 0;
 
-			for (auto &currentCallback : requestValueCallbacks)
+			if (get_published_value(currentRequest.elementNumber, currentRequest.ddi, newValue) ||
+			    request_value_from_application(currentRequest.elementNumber, currentRequest.ddi, newValue))
 			{
-				std::int32_t newValue = 0;
-				if (currentCallback.callback(currentRequest.elementNumber, currentRequest.ddi, newValue, currentCallback.parent))
-				{
-					transmitSuccessful = send_value_command(currentRequest.elementNumber, currentRequest.ddi, newValue);
-					break;
-				}
+				transmitSuccessful = send_value_command(currentRequest.elementNumber, currentRequest.ddi, newValue);
 			}
-			queuedValueRequests.pop_front();
 		}
-		while (!queuedValueCommands.empty() && transmitSuccessful)
+		while (transmitSuccessful && pop_queued_command(queuedValueCommands, currentRequest))
 		{
-			const auto &currentRequest = queuedValueCommands.front();
-
-			for (auto &currentCallback : valueCommandsCallbacks)
+			for (auto &currentCallback : applicationValueCommandCallbacks)
 			{
 				if (currentCallback.callback(currentRequest.elementNumber, currentRequest.ddi, currentRequest.processDataValue, currentCallback.parent))
 				{
 					break;
 				}
 			}
-			queuedValueCommands.pop_front();
 
 			//! @todo process PDACKs better
 			if (currentRequest.ackRequested)
@@ -1070,114 +1101,388 @@ namespace isobus
 		}
 	}
 
-	void TaskControllerClient::process_queued_threshold_commands()
+	bool TaskControllerClient::pop_queued_command(std::list<ProcessDataCallbackInfo> &queue, ProcessDataCallbackInfo &command)
 	{
-		bool transmitSuccessful = false;
+		LOCK_GUARD(Mutex, clientMutex);
+		bool retVal = false;
 
-		for (auto &measurementTimeCommand : measurementTimeIntervalCommands)
+		if (!queue.empty())
 		{
-			if (SystemTiming::time_expired_ms(static_cast<std::uint32_t>(measurementTimeCommand.lastValue), static_cast<std::uint32_t>(measurementTimeCommand.processDataValue)))
+			command = queue.front();
+			queue.pop_front();
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	bool TaskControllerClient::get_published_value(std::uint16_t elementNumber, std::uint16_t DDI, std::int32_t &value)
+	{
+		LOCK_GUARD(Mutex, clientMutex);
+		bool retVal = false;
+		const auto publishedIndex = measurementTriggerIndices.find((static_cast<std::uint32_t>(elementNumber) << 16) | DDI);
+
+		if ((measurementTriggerIndices.end() != publishedIndex) &&
+		    (measurementTriggers[publishedIndex->second].valuePublished))
+		{
+			value = measurementTriggers[publishedIndex->second].publishedValue;
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	void TaskControllerClient::process_queued_threshold_commands()
+	{
+		// Collect the values to ask the application for under the lock, ask for them without it so that
+		// the request value callbacks can call publish_value, then lock again to use the values
+		applicationValueRequests.clear();
+		{
+			LOCK_GUARD(Mutex, clientMutex);
+			applicationRequestValueCallbacks = requestValueCallbacks;
+
+			// Only the variables whose time interval has passed come out of the timer wheel
+			expiredMeasurementTimers.clear();
+			measurementTimeIntervalTimers.get_expired_timers(expiredMeasurementTimers);
+
+			for (const auto &timer : expiredMeasurementTimers)
 			{
-				// Time to update this time interval variable
-				transmitSuccessful = false;
-				for (auto &currentCallback : requestValueCallbacks)
+				const auto &triggers = measurementTriggers[timer.id];
+
+				// Timers can't be removed from the wheel, so skip any left over from a changed interval
+				if (triggers.hasTimeInterval && (timer.expiryTime_ms == triggers.nextTimeIntervalTimestamp_ms))
 				{
-					std::int32_t newValue = 0;
-					if (currentCallback.callback(measurementTimeCommand.elementNumber, measurementTimeCommand.ddi, newValue, currentCallback.parent))
+					if (triggers.valuePublished)
 					{
-						transmitSuccessful = send_value_command(measurementTimeCommand.elementNumber, measurementTimeCommand.ddi, newValue);
-						break;
+						process_time_interval(timer.id, true, triggers.publishedValue);
+					}
+					else
+					{
+						applicationValueRequests.push_back({ timer.id, timer.expiryTime_ms, 0, triggers.elementNumber, triggers.ddi, true, false });
 					}
 				}
+			}
 
-				if (transmitSuccessful)
-				{
-					measurementTimeCommand.lastValue = static_cast<std::int32_t>(SystemTiming::get_timestamp_ms());
-				}
+			for (const auto index : polledThresholdTriggers)
+			{
+				applicationValueRequests.push_back({ index, 0, 0, measurementTriggers[index].elementNumber, measurementTriggers[index].ddi, false, false });
 			}
 		}
-		for (auto &measurementMaxCommand : measurementMaximumThresholdCommands)
+
+		for (auto &request : applicationValueRequests)
 		{
-			// Get the current process data value
-			std::int32_t newValue = 0;
-			for (auto &currentCallback : requestValueCallbacks)
+			request.valueAvailable = request_value_from_application(request.elementNumber, request.ddi, request.value);
+		}
+
+		LOCK_GUARD(Mutex, clientMutex);
+		for (const auto &request : applicationValueRequests)
+		{
+			const auto &triggers = measurementTriggers[request.index];
+
+			// The TC might have changed or cleared the measurement commands while the application was asked
+			if (!request.timeInterval)
 			{
-				if (currentCallback.callback(measurementMaxCommand.elementNumber, measurementMaxCommand.ddi, newValue, currentCallback.parent))
+				if (request.valueAvailable)
 				{
-					break;
+					process_measurement_thresholds(request.index, request.value);
 				}
 			}
+			else if (triggers.hasTimeInterval && (request.timerExpiryTime_ms == triggers.nextTimeIntervalTimestamp_ms))
+			{
+				process_time_interval(request.index, request.valueAvailable, request.value);
+			}
+		}
+
+		// Published values only need checking when they change
+		for (const auto index : pendingThresholdTriggers)
+		{
+			measurementTriggers[index].thresholdCheckPending = false;
+			process_measurement_thresholds(index, measurementTriggers[index].publishedValue);
+		}
+		pendingThresholdTriggers.clear();
+
+		process_section_work_states();
+		send_queued_measurement_values();
+	}
+
+	void TaskControllerClient::process_time_interval(std::size_t index, bool valueAvailable, std::int32_t value)
+	{
+		auto &triggers = measurementTriggers[index];
+
+		if (valueAvailable)
+		{
+			queue_measurement_value(index, value);
+			triggers.lastTimeIntervalTimestamp_ms = SystemTiming::get_timestamp_ms();
+			triggers.nextTimeIntervalTimestamp_ms = triggers.lastTimeIntervalTimestamp_ms + triggers.timeInterval_ms;
+		}
+		else
+		{
+			// Try again on the next update
+			triggers.nextTimeIntervalTimestamp_ms = SystemTiming::get_timestamp_ms();
+		}
+		measurementTimeIntervalTimers.add_timer(index, triggers.nextTimeIntervalTimestamp_ms);
+	}
+
+	TaskControllerClient::SectionWorkStates &TaskControllerClient::get_section_work_states(std::uint16_t elementNumber)
+	{
+		SectionWorkStates *retVal = nullptr;
 
-			if (!measurementMaxCommand.thresholdPassed)
+		for (auto &workStates : sectionWorkStates)
+		{
+			if (elementNumber == workStates.elementNumber)
 			{
-				if ((newValue > measurementMaxCommand.processDataValue) &&
-				    (send_value_command(measurementMaxCommand.elementNumber, measurementMaxCommand.ddi, newValue)))
-				{
-					measurementMaxCommand.thresholdPassed = true;
-				}
+				retVal = &workStates;
+				break;
 			}
-			else
+		}
+
+		if (nullptr == retVal)
+		{
+			// Every section starts out as not installed
+			SectionWorkStates newWorkStates;
+			newWorkStates.workStates.fill(0xFFFFFFFF);
+			newWorkStates.sentWorkStates.fill(0xFFFFFFFF);
+			newWorkStates.changeTimestamps_ms.fill(0);
+			newWorkStates.elementNumber = elementNumber;
+			sectionWorkStates.push_back(newWorkStates);
+			retVal = &sectionWorkStates.back();
+		}
+		return *retVal;
+	}
+
+	void TaskControllerClient::update_section_work_state(SectionWorkStates &workStates, std::uint8_t sectionIndex, SectionWorkState state, std::uint32_t timestamp_ms)
+	{
+		const std::uint8_t ddiIndex = sectionIndex / NUMBER_OF_SECTIONS_PER_CONDENSED_WORK_STATE;
+		const std::uint8_t bitOffset = 2 * (sectionIndex % NUMBER_OF_SECTIONS_PER_CONDENSED_WORK_STATE);
+		const std::uint32_t newWorkState = (workStates.workStates[ddiIndex] & ~(static_cast<std::uint32_t>(0x03) << bitOffset)) |
+		  (static_cast<std::uint32_t>(state) << bitOffset);
+		const std::uint16_t ddiBit = static_cast<std::uint16_t>(1 << ddiIndex);
+
+		if (newWorkState != workStates.workStates[ddiIndex])
+		{
+			workStates.workStates[ddiIndex] = newWorkState;
+			sectionWorkStateMetrics.sectionStateChanges++;
+
+			if (newWorkState == workStates.sentWorkStates[ddiIndex])
+			{
+				// Switched back to what the TC already has, so there's nothing to send
+				workStates.changedWorkStates &= static_cast<std::uint16_t>(~ddiBit);
+			}
+			else if (0 == (workStates.changedWorkStates & ddiBit))
 			{
-				if (newValue < measurementMaxCommand.processDataValue)
+				if (0 == workStates.changedWorkStates)
 				{
-					measurementMaxCommand.thresholdPassed = false;
+					workStates.firstChangeTimestamp_ms = timestamp_ms;
 				}
+				workStates.changedWorkStates |= ddiBit;
+				workStates.changeTimestamps_ms[ddiIndex] = timestamp_ms;
 			}
 		}
-		for (auto &measurementMinCommand : measurementMinimumThresholdCommands)
+	}
+
+	void TaskControllerClient::process_section_work_states()
+	{
+		const std::uint32_t timestamp_ms = SystemTiming::get_timestamp_ms();
+
+		for (auto &workStates : sectionWorkStates)
 		{
-			// Get the current process data value
-			std::int32_t newValue = 0;
-			for (auto &currentCallback : requestValueCallbacks)
+			if ((0 != workStates.changedWorkStates) &&
+			    ((timestamp_ms - workStates.firstChangeTimestamp_ms) >= sectionWorkStateCoalescingWindow_ms))
 			{
-				if (currentCallback.callback(measurementMinCommand.elementNumber, measurementMinCommand.ddi, newValue, currentCallback.parent))
+				for (std::uint8_t i = 0; i < NUMBER_OF_CONDENSED_WORK_STATE_DDIS; i++)
 				{
-					break;
+					if (0 != (workStates.changedWorkStates & (1 << i)))
+					{
+						const auto ddi = static_cast<std::uint16_t>(static_cast<std::uint16_t>(DataDescriptionIndex::ActualCondensedWorkState1_16) + i);
+						const std::size_t index = get_measurement_triggers_index(workStates.elementNumber, ddi);
+						const auto value = static_cast<std::int32_t>(workStates.workStates[i]);
+						const std::uint32_t latency_ms = timestamp_ms - workStates.changeTimestamps_ms[i];
+
+						// The value is sent either way, so an on change trigger for it doesn't need to send it again
+						store_published_value(index, value);
+						measurementTriggers[index].lastValueSentOnChange = value;
+						queue_measurement_value(index, value);
+						workStates.sentWorkStates[i] = workStates.workStates[i];
+
+						sectionWorkStateMetrics.framesQueued++;
+						sectionWorkStateMetrics.totalLatency_ms += latency_ms;
+						if (latency_ms > sectionWorkStateMetrics.maximumLatency_ms)
+						{
+							sectionWorkStateMetrics.maximumLatency_ms = latency_ms;
+						}
+					}
 				}
+				workStates.changedWorkStates = 0;
 			}
+		}
+	}
 
-			if (!measurementMinCommand.thresholdPassed)
+	std::size_t TaskControllerClient::get_measurement_triggers_index(std::uint16_t elementNumber, std::uint16_t DDI)
+	{
+		const std::uint32_t key = (static_cast<std::uint32_t>(elementNumber) << 16) | DDI;
+		auto result = measurementTriggerIndices.find(key);
+
+		if (measurementTriggerIndices.end() == result)
+		{
+			MeasurementTriggers newTriggers;
+			newTriggers.elementNumber = elementNumber;
+			newTriggers.ddi = DDI;
+			measurementTriggers.push_back(newTriggers);
+			result = measurementTriggerIndices.emplace(key, measurementTriggers.size() - 1).first;
+		}
+		return result->second;
+	}
+
+	bool TaskControllerClient::store_published_value(std::size_t index, std::int32_t value)
+	{
+		auto &triggers = measurementTriggers[index];
+		bool retVal = false;
+
+		if (!triggers.valuePublished)
+		{
+			triggers.valuePublished = true;
+			triggers.publishedValue = value;
+			retVal = true;
+
+			if (triggers.thresholdsPolled)
 			{
-				if ((newValue < measurementMinCommand.processDataValue) &&
-				    (send_value_command(measurementMinCommand.elementNumber, measurementMinCommand.ddi, newValue)))
-				{
-					measurementMinCommand.thresholdPassed = true;
-				}
+				// The application publishes this value from now on, so stop polling it
+				triggers.thresholdsPolled = false;
+				polledThresholdTriggers.erase(std::find(polledThresholdTriggers.begin(), polledThresholdTriggers.end(), index));
 			}
-			else
+		}
+		else if (value != triggers.publishedValue)
+		{
+			triggers.publishedValue = value;
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	void TaskControllerClient::queue_threshold_check(std::size_t index)
+	{
+		auto &triggers = measurementTriggers[index];
+
+		if (triggers.hasMinimumThreshold || triggers.hasMaximumThreshold || triggers.hasChangeThreshold)
+		{
+			if (triggers.valuePublished)
 			{
-				if (newValue > measurementMinCommand.processDataValue)
+				if (!triggers.thresholdCheckPending)
 				{
-					measurementMinCommand.thresholdPassed = false;
+					triggers.thresholdCheckPending = true;
+					pendingThresholdTriggers.push_back(index);
 				}
 			}
+			else if (!triggers.thresholdsPolled)
+			{
+				triggers.thresholdsPolled = true;
+				polledThresholdTriggers.push_back(index);
+			}
 		}
-		for (auto &measurementChangeCommand : measurementOnChangeThresholdCommands)
+	}
+
+	bool TaskControllerClient::request_value_from_application(std::uint16_t elementNumber, std::uint16_t DDI, std::int32_t &value)
+	{
+		bool retVal = false;
+
+		for (auto &currentCallback : applicationRequestValueCallbacks)
 		{
-			// Get the current process data value
-			std::int32_t newValue = 0;
-			for (auto &currentCallback : requestValueCallbacks)
+			if (currentCallback.callback(elementNumber, DDI, value, currentCallback.parent))
 			{
-				if (currentCallback.callback(measurementChangeCommand.elementNumber, measurementChangeCommand.ddi, newValue, currentCallback.parent))
-				{
-					break;
-				}
+				retVal = true;
+				break;
 			}
+		}
+		return retVal;
+	}
+
+	void TaskControllerClient::process_measurement_thresholds(std::size_t index, std::int32_t value)
+	{
+		auto &triggers = measurementTriggers[index];
+		bool maximumThresholdTriggered = false;
+		bool minimumThresholdTriggered = false;
+		bool changeThresholdTriggered = false;
 
-			std::int64_t lowerLimit = (static_cast<int64_t>(measurementChangeCommand.lastValue) - measurementChangeCommand.processDataValue);
+		if (triggers.hasMaximumThreshold)
+		{
+			if (!triggers.maximumThresholdPassed)
+			{
+				maximumThresholdTriggered = (value > triggers.maximumThreshold);
+			}
+			else if (value < triggers.maximumThreshold)
+			{
+				triggers.maximumThresholdPassed = false;
+			}
+		}
+
+		if (triggers.hasMinimumThreshold)
+		{
+			if (!triggers.minimumThresholdPassed)
+			{
+				minimumThresholdTriggered = (value < triggers.minimumThreshold);
+			}
+			else if (value > triggers.minimumThreshold)
+			{
+				triggers.minimumThresholdPassed = false;
+			}
+		}
+
+		if (triggers.hasChangeThreshold)
+		{
+			std::int64_t lowerLimit = (static_cast<std::int64_t>(triggers.lastValueSentOnChange) - triggers.changeThreshold);
 			if (lowerLimit < 0)
 			{
 				lowerLimit = 0;
 			}
 
-			if ((newValue != measurementChangeCommand.lastValue) &&
-			    ((newValue >= (measurementChangeCommand.lastValue + measurementChangeCommand.processDataValue)) ||
-			     (newValue <= lowerLimit)) &&
-			    (send_value_command(measurementChangeCommand.elementNumber, measurementChangeCommand.ddi, newValue)))
+			changeThresholdTriggered = ((value != triggers.lastValueSentOnChange) &&
+			                            ((value >= (static_cast<std::int64_t>(triggers.lastValueSentOnChange) + triggers.changeThreshold)) ||
+			                             (value <= lowerLimit)));
+		}
+
+		// One frame covers every threshold that was passed, since they all send the same value
+		if (maximumThresholdTriggered || minimumThresholdTriggered || changeThresholdTriggered)
+		{
+			queue_measurement_value(index, value);
+			triggers.maximumThresholdPassed = (triggers.maximumThresholdPassed || maximumThresholdTriggered);
+			triggers.minimumThresholdPassed = (triggers.minimumThresholdPassed || minimumThresholdTriggered);
+
+			if (changeThresholdTriggered)
 			{
-				measurementChangeCommand.lastValue = newValue;
+				triggers.lastValueSentOnChange = value;
+			}
+		}
+	}
+
+	void TaskControllerClient::queue_measurement_value(std::size_t index, std::int32_t value)
+	{
+		auto &triggers = measurementTriggers[index];
+
+		// If the variable is already queued, only its newest value is worth sending
+		triggers.queuedValue = value;
+
+		if (!triggers.valueQueued)
+		{
+			triggers.valueQueued = true;
+			queuedMeasurementValues.push_back(index);
+		}
+	}
+
+	void TaskControllerClient::send_queued_measurement_values()
+	{
+		std::size_t numberOfValuesSent = 0;
+
+		for (const auto index : queuedMeasurementValues)
+		{
+			auto &triggers = measurementTriggers[index];
+
+			if (!send_value_command(triggers.elementNumber, triggers.ddi, triggers.queuedValue))
+			{
+				// The transmit queue is full, so the rest have to wait for the next update
+				break;
 			}
+			triggers.valueQueued = false;
+			numberOfValuesSent++;
 		}
+		queuedMeasurementValues.erase(queuedMeasurementValues.begin(), queuedMeasurementValues.begin() + numberOfValuesSent);
 	}
 
 	void TaskControllerClient::process_rx_message(const CANMessage &message, void *parentPointer)
@@ -1557,7 +1862,7 @@ namespace isobus
 
 						case ProcessDataCommands::RequestValue:
 						{
-							ProcessDataCallbackInfo requestData = { 0, 0, 0, 0, false, false };
+							ProcessDataCallbackInfo requestData = { 0, 0, 0, false };
 							LOCK_GUARD(Mutex, clientMutex);
 
 							requestData.ackRequested = false;
@@ -1574,7 +1879,7 @@ namespace isobus
 
 						case ProcessDataCommands::Value:
 						{
-							ProcessDataCallbackInfo requestData = { 0, 0, 0, 0, false, false };
+							ProcessDataCallbackInfo requestData = { 0, 0, 0, false };
 							LOCK_GUARD(Mutex, clientMutex);
 
 							requestData.ackRequested = false;
@@ -1591,7 +1896,7 @@ namespace isobus
 
 						case ProcessDataCommands::SetValueAndAcknowledge:
 						{
-							ProcessDataCallbackInfo requestData = { 0, 0, 0, 0, false, false };
+							ProcessDataCallbackInfo requestData = { 0, 0, 0, false };
 							LOCK_GUARD(Mutex, clientMutex);
 
 							requestData.ackRequested = true;
@@ -1608,141 +1913,129 @@ namespace isobus
 
 						case ProcessDataCommands::MeasurementTimeInterval:
 						{
-							ProcessDataCallbackInfo commandData = { 0, 0, 0, 0, false, false };
 							LOCK_GUARD(Mutex, clientMutex);
-
-							commandData.elementNumber = (static_cast<std::uint16_t>(messageData[0] >> 4) | (static_cast<std::uint16_t>(messageData[1]) << 4));
-							commandData.ddi = static_cast<std::uint16_t>(messageData[2]) |
+							const std::uint16_t elementNumber = (static_cast<std::uint16_t>(messageData[0] >> 4) | (static_cast<std::uint16_t>(messageData[1]) << 4));
+							const std::uint16_t ddi = static_cast<std::uint16_t>(messageData[2]) |
 							  (static_cast<std::uint16_t>(messageData[3]) << 8);
-							commandData.processDataValue = (static_cast<std::int32_t>(messageData[4]) |
-							                                (static_cast<std::int32_t>(messageData[5]) << 8) |
-							                                (static_cast<std::int32_t>(messageData[6]) << 16) |
-							                                (static_cast<std::int32_t>(messageData[7]) << 24));
-							commandData.lastValue = static_cast<std::int32_t>(SystemTiming::get_timestamp_ms());
+							const std::size_t index = parentTC->get_measurement_triggers_index(elementNumber, ddi);
+							auto &triggers = parentTC->measurementTriggers[index];
 
-							auto previousCommand = std::find(parentTC->measurementTimeIntervalCommands.begin(), parentTC->measurementTimeIntervalCommands.end(), commandData);
-							if (parentTC->measurementTimeIntervalCommands.end() == previousCommand)
+							triggers.timeInterval_ms = (static_cast<std::uint32_t>(messageData[4]) |
+							                            (static_cast<std::uint32_t>(messageData[5]) << 8) |
+							                            (static_cast<std::uint32_t>(messageData[6]) << 16) |
+							                            (static_cast<std::uint32_t>(messageData[7]) << 24));
+
+							if (!triggers.hasTimeInterval)
 							{
-								parentTC->measurementTimeIntervalCommands.push_back(commandData);
+								triggers.hasTimeInterval = true;
+								triggers.lastTimeIntervalTimestamp_ms = SystemTiming::get_timestamp_ms();
 								LOG_DEBUG("[TC]: TC Requests element: " +
-								          isobus::to_string(static_cast<int>(commandData.elementNumber)) +
+								          isobus::to_string(static_cast<int>(elementNumber)) +
 								          " DDI: " +
-								          isobus::to_string(static_cast<int>(commandData.ddi)) +
+								          isobus::to_string(static_cast<int>(ddi)) +
 								          " every: " +
-								          isobus::to_string(static_cast<int>(commandData.processDataValue)) +
+								          isobus::to_string(static_cast<int>(triggers.timeInterval_ms)) +
 								          " milliseconds.");
 							}
 							else
 							{
-								// Use the existing one and update the value
-								previousCommand->processDataValue = commandData.processDataValue;
+								// Keep counting from the last time the value was sent, with the new interval
 								LOG_DEBUG("[TC]: TC Altered time interval request for element: " +
-								          isobus::to_string(static_cast<int>(commandData.elementNumber)) +
+								          isobus::to_string(static_cast<int>(elementNumber)) +
 								          " DDI: " +
-								          isobus::to_string(static_cast<int>(commandData.ddi)) +
+								          isobus::to_string(static_cast<int>(ddi)) +
 								          " every: " +
-								          isobus::to_string(static_cast<int>(commandData.processDataValue)) +
+								          isobus::to_string(static_cast<int>(triggers.timeInterval_ms)) +
 								          " milliseconds.");
 							}
+							triggers.nextTimeIntervalTimestamp_ms = triggers.lastTimeIntervalTimestamp_ms + triggers.timeInterval_ms;
+							parentTC->measurementTimeIntervalTimers.add_timer(static_cast<std::uint32_t>(index), triggers.nextTimeIntervalTimestamp_ms);
 						}
 						break;
 
 						case ProcessDataCommands::MeasurementMaximumWithinThreshold:
 						{
-							ProcessDataCallbackInfo commandData = { 0, 0, 0, 0, false, false };
 							LOCK_GUARD(Mutex, clientMutex);
-
-							commandData.elementNumber = (static_cast<std::uint16_t>(messageData[0] >> 4) | (static_cast<std::uint16_t>(messageData[1]) << 4));
-							commandData.ddi = static_cast<std::uint16_t>(messageData[2]) |
+							const std::uint16_t elementNumber = (static_cast<std::uint16_t>(messageData[0] >> 4) | (static_cast<std::uint16_t>(messageData[1]) << 4));
+							const std::uint16_t ddi = static_cast<std::uint16_t>(messageData[2]) |
 							  (static_cast<std::uint16_t>(messageData[3]) << 8);
-							commandData.processDataValue = (static_cast<std::int32_t>(messageData[4]) |
-							                                (static_cast<std::int32_t>(messageData[5]) << 8) |
-							                                (static_cast<std::int32_t>(messageData[6]) << 16) |
-							                                (static_cast<std::int32_t>(messageData[7]) << 24));
+							const std::size_t index = parentTC->get_measurement_triggers_index(elementNumber, ddi);
+							auto &triggers = parentTC->measurementTriggers[index];
+
+							triggers.maximumThreshold = (static_cast<std::int32_t>(messageData[4]) |
+							                             (static_cast<std::int32_t>(messageData[5]) << 8) |
+							                             (static_cast<std::int32_t>(messageData[6]) << 16) |
+							                             (static_cast<std::int32_t>(messageData[7]) << 24));
+							triggers.maximumThresholdPassed = false;
 
-							auto previousCommand = std::find(parentTC->measurementMaximumThresholdCommands.begin(), parentTC->measurementMaximumThresholdCommands.end(), commandData);
-							if (parentTC->measurementMaximumThresholdCommands.end() == previousCommand)
+							if (!triggers.hasMaximumThreshold)
 							{
-								parentTC->measurementMaximumThresholdCommands.push_back(commandData);
+								triggers.hasMaximumThreshold = true;
 								LOG_DEBUG("[TC]: TC Requests element: " +
-								          isobus::to_string(static_cast<int>(commandData.elementNumber)) +
+								          isobus::to_string(static_cast<int>(elementNumber)) +
 								          " DDI: " +
-								          isobus::to_string(static_cast<int>(commandData.ddi)) +
+								          isobus::to_string(static_cast<int>(ddi)) +
 								          " when it is above the raw value: " +
-								          isobus::to_string(static_cast<int>(commandData.processDataValue)));
-							}
-							else
-							{
-								// Just update the existing one with the new value
-								previousCommand->processDataValue = commandData.processDataValue;
-								previousCommand->thresholdPassed = false;
+								          isobus::to_string(static_cast<int>(triggers.maximumThreshold)));
 							}
+							parentTC->queue_threshold_check(index);
 						}
 						break;
 
 						case ProcessDataCommands::MeasurementMinimumWithinThreshold:
 						{
-							ProcessDataCallbackInfo commandData = { 0, 0, 0, 0, false, false };
 							LOCK_GUARD(Mutex, clientMutex);
-
-							commandData.elementNumber = (static_cast<std::uint16_t>(messageData[0] >> 4) | (static_cast<std::uint16_t>(messageData[1]) << 4));
-							commandData.ddi = static_cast<std::uint16_t>(messageData[2]) |
+							const std::uint16_t elementNumber = (static_cast<std::uint16_t>(messageData[0] >> 4) | (static_cast<std::uint16_t>(messageData[1]) << 4));
+							const std::uint16_t ddi = static_cast<std::uint16_t>(messageData[2]) |
 							  (static_cast<std::uint16_t>(messageData[3]) << 8);
-							commandData.processDataValue = (static_cast<std::int32_t>(messageData[4]) |
-							                                (static_cast<std::int32_t>(messageData[5]) << 8) |
-							                                (static_cast<std::int32_t>(messageData[6]) << 16) |
-							                                (static_cast<std::int32_t>(messageData[7]) << 24));
+							const std::size_t index = parentTC->get_measurement_triggers_index(elementNumber, ddi);
+							auto &triggers = parentTC->measurementTriggers[index];
+
+							triggers.minimumThreshold = (static_cast<std::int32_t>(messageData[4]) |
+							                             (static_cast<std::int32_t>(messageData[5]) << 8) |
+							                             (static_cast<std::int32_t>(messageData[6]) << 16) |
+							                             (static_cast<std::int32_t>(messageData[7]) << 24));
+							triggers.minimumThresholdPassed = false;
 
-							auto previousCommand = std::find(parentTC->measurementMinimumThresholdCommands.begin(), parentTC->measurementMinimumThresholdCommands.end(), commandData);
-							if (parentTC->measurementMinimumThresholdCommands.end() == previousCommand)
+							if (!triggers.hasMinimumThreshold)
 							{
-								parentTC->measurementMinimumThresholdCommands.push_back(commandData);
+								triggers.hasMinimumThreshold = true;
 								LOG_DEBUG("[TC]: TC Requests Element " +
-								          isobus::to_string(static_cast<int>(commandData.elementNumber)) +
+								          isobus::to_string(static_cast<int>(elementNumber)) +
 								          " DDI: " +
-								          isobus::to_string(static_cast<int>(commandData.ddi)) +
+								          isobus::to_string(static_cast<int>(ddi)) +
 								          " when it is below the raw value: " +
-								          isobus::to_string(static_cast<int>(commandData.processDataValue)));
-							}
-							else
-							{
-								// Just update the existing one with the new value
-								previousCommand->processDataValue = commandData.processDataValue;
-								previousCommand->thresholdPassed = false;
+								          isobus::to_string(static_cast<int>(triggers.minimumThreshold)));
 							}
+							parentTC->queue_threshold_check(index);
 						}
 						break;
 
 						case ProcessDataCommands::MeasurementChangeThreshold:
 						{
-							ProcessDataCallbackInfo commandData = { 0, 0, 0, 0, false, false };
 							LOCK_GUARD(Mutex, clientMutex);
-
-							commandData.elementNumber = (static_cast<std::uint16_t>(messageData[0] >> 4) | (static_cast<std::uint16_t>(messageData[1]) << 4));
-							commandData.ddi = static_cast<std::uint16_t>(messageData[2]) |
+							const std::uint16_t elementNumber = (static_cast<std::uint16_t>(messageData[0] >> 4) | (static_cast<std::uint16_t>(messageData[1]) << 4));
+							const std::uint16_t ddi = static_cast<std::uint16_t>(messageData[2]) |
 							  (static_cast<std::uint16_t>(messageData[3]) << 8);
-							commandData.processDataValue = (static_cast<std::int32_t>(messageData[4]) |
-							                                (static_cast<std::int32_t>(messageData[5]) << 8) |
-							                                (static_cast<std::int32_t>(messageData[6]) << 16) |
-							                                (static_cast<std::int32_t>(messageData[7]) << 24));
+							const std::size_t index = parentTC->get_measurement_triggers_index(elementNumber, ddi);
+							auto &triggers = parentTC->measurementTriggers[index];
+
+							triggers.changeThreshold = (static_cast<std::int32_t>(messageData[4]) |
+							                            (static_cast<std::int32_t>(messageData[5]) << 8) |
+							                            (static_cast<std::int32_t>(messageData[6]) << 16) |
+							                            (static_cast<std::int32_t>(messageData[7]) << 24));
 
-							auto previousCommand = std::find(parentTC->measurementOnChangeThresholdCommands.begin(), parentTC->measurementOnChangeThresholdCommands.end(), commandData);
-							if (parentTC->measurementOnChangeThresholdCommands.end() == previousCommand)
+							if (!triggers.hasChangeThreshold)
 							{
-								parentTC->measurementOnChangeThresholdCommands.push_back(commandData);
+								triggers.hasChangeThreshold = true;
 								LOG_DEBUG("[TC]: TC Requests element " +
-								          isobus::to_string(static_cast<int>(commandData.elementNumber)) +
+								          isobus::to_string(static_cast<int>(elementNumber)) +
 								          " DDI: " +
-								          isobus::to_string(static_cast<int>(commandData.ddi)) +
+								          isobus::to_string(static_cast<int>(ddi)) +
 								          " on change by at least: " +
-								          isobus::to_string(static_cast<int>(commandData.processDataValue)));
-							}
-							else
-							{
-								// Just update the existing one with the new value
-								previousCommand->processDataValue = commandData.processDataValue;
-								previousCommand->thresholdPassed = false;
+								          isobus::to_string(static_cast<int>(triggers.changeThreshold)));
 							}
+							parentTC->queue_threshold_check(index);
 						}
 						break;
 
@@ -2067,6 +2360,8 @@ namespace isobus
 
 			if (StateMachineState::Disconnected == newState)
 			{
+				// The application may be setting section work states or publishing values at the same time
+				LOCK_GUARD(Mutex, clientMutex);
 				clear_queues();
 			}
 		}
@@ -2153,7 +2448,7 @@ namespace isobus
 
 	void TaskControllerClient::on_value_changed_trigger(std::uint16_t elementNumber, std::uint16_t DDI)
 	{
-		ProcessDataCallbackInfo requestData = { 0, 0, 0, 0, false, false };
+		ProcessDataCallbackInfo requestData = { 0, 0, 0, false };
 		LOCK_GUARD(Mutex, clientMutex);
 
 		requestData.ackRequested = false;
@@ -2163,6 +2458,59 @@ namespace isobus
 		queuedValueRequests.push_back(requestData);
 	}
 
+	void TaskControllerClient::publish_value(std::uint16_t elementNumber, std::uint16_t DDI, std::int32_t value)
+	{
+		LOCK_GUARD(Mutex, clientMutex);
+		const std::size_t index = get_measurement_triggers_index(elementNumber, DDI);
+
+		if (store_published_value(index, value))
+		{
+			queue_threshold_check(index);
+		}
+	}
+
+	void TaskControllerClient::set_section_work_state(std::uint16_t elementNumber, std::uint8_t sectionIndex, SectionWorkState state)
+	{
+		LOCK_GUARD(Mutex, clientMutex);
+		update_section_work_state(get_section_work_states(elementNumber), sectionIndex, state, SystemTiming::get_timestamp_ms());
+	}
+
+	void TaskControllerClient::set_section_work_states(std::uint16_t elementNumber, const std::vector<SectionWorkState> &states)
+	{
+		LOCK_GUARD(Mutex, clientMutex);
+		auto &workStates = get_section_work_states(elementNumber);
+		const std::uint32_t timestamp_ms = SystemTiming::get_timestamp_ms();
+		const std::size_t numberOfSections = std::min(states.size(), NUMBER_OF_CONDENSED_WORK_STATE_DDIS * NUMBER_OF_SECTIONS_PER_CONDENSED_WORK_STATE);
+
+		for (std::size_t i = 0; i < numberOfSections; i++)
+		{
+			update_section_work_state(workStates, static_cast<std::uint8_t>(i), states[i], timestamp_ms);
+		}
+	}
+
+	void TaskControllerClient::set_section_work_state_coalescing_window(std::uint32_t window_ms)
+	{
+		LOCK_GUARD(Mutex, clientMutex);
+		sectionWorkStateCoalescingWindow_ms = window_ms;
+	}
+
+	std::uint32_t TaskControllerClient::get_section_work_state_coalescing_window() const
+	{
+		return sectionWorkStateCoalescingWindow_ms;
+	}
+
+	void TaskControllerClient::get_section_work_state_metrics(SectionWorkStateMetrics &metrics)
+	{
+		LOCK_GUARD(Mutex, clientMutex);
+		metrics = sectionWorkStateMetrics;
+	}
+
+	void TaskControllerClient::reset_section_work_state_metrics()
+	{
+		LOCK_GUARD(Mutex, clientMutex);
+		sectionWorkStateMetrics = SectionWorkStateMetrics();
+	}
+
 	bool TaskControllerClient::request_task_controller_identification() const
 	{
 		constexpr std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { static_cast<std::uint8_t>(ProcessDataCommands::TechnicalCapabilities) |
@@ -1567,19 +1567,14 @@ namespace isobus
 
 					if (firstTimeInState)
 					{
-						if (get_any_pool_needs_scaling())
-						{
-							// Scale object pools before upload.
-							if (!scale_object_pools())
-							{
-								set_state(StateMachineState::Failed);
-							}
-						}
+						// Pools that need auto-scaling are scaled one object at a time while they upload
+						objectPoolScalingFailed = false;
 					}
 
 					for (std::uint32_t i = 0; i < objectPools.size(); i++)
 					{
 						if (((nullptr != objectPools[i].objectPoolDataPointer) ||
+						     (nullptr != objectPools[i].objectPoolVectorPointer) ||
 						     (nullptr != objectPools[i].dataCallback)) &&
 						    (objectPools[i].objectPoolSize > 0))
 						{
@@ -1624,8 +1619,18 @@ namespace isobus
 							else if (CurrentObjectPoolUploadState::Failed == currentObjectPoolState)
 							{
 								currentObjectPoolState = CurrentObjectPoolUploadState::Uninitialized;
-								LOG_ERROR("[VT]: An object pool failed to upload. Resetting connection to VT.");
-								set_state(StateMachineState::Disconnected);
+
+								if (objectPoolScalingFailed)
+								{
+									// Retrying won't help, the pool's data is bad
+									LOG_ERROR("[VT]: An object pool could not be auto-scaled.");
+									set_state(StateMachineState::Failed);
+								}
+								else
+								{
+									LOG_ERROR("[VT]: An object pool failed to upload. Resetting connection to VT.");
+									set_state(StateMachineState::Disconnected);
+								}
 							}
 							else
 							{
@@ -3051,11 +3056,10 @@ namespace isobus
 								if ((0 == errorCodes) &&
 								    (0 == objectPoolErrorBitmask))
 								{
-									// Clear scaling buffers
-									for (auto &objectPool : parentVT->objectPools)
-									{
-										objectPool.scaledObjectPool.clear();
-									}
+									// Release the scaling buffer
+									parentVT->scaledObjectBuffer.clear();
+									parentVT->scaledObjectBuffer.shrink_to_fit();
+									parentVT->scaledObjectLength = 0;
 
 									// Check if we need to store this pool
 									if (!parentVT->objectPools[0].versionLabel.empty())
@@ -3296,7 +3300,6 @@ namespace isobus
 		{
 			VirtualTerminalClient *parentVTClient = static_cast<VirtualTerminalClient *>(parentPointer);
 			std::uint32_t poolIndex = std::numeric_limits<std::uint32_t>::max();
-			bool usingExternalCallback = false;
 
 			// Need to figure out which pool we're currently uploading
 			for (std::uint32_t i = 0; i < parentVTClient->objectPools.size(); i++)
@@ -3304,7 +3307,6 @@ namespace isobus
 				if (!parentVTClient->objectPools[i].uploaded)
 				{
 					poolIndex = i;
-					usingExternalCallback = parentVTClient->objectPools[i].useDataCallback;
 					break;
 				}
 			}
@@ -3314,151 +3316,213 @@ namespace isobus
 			    (bytesOffset + numberOfBytesNeeded) <= parentVTClient->objectPools[poolIndex].objectPoolSize + 1)
 			{
 				// We've got more data to transfer
+				std::uint8_t *destination = chunkBuffer;
+				std::uint32_t poolOffset = 0;
+
+				if (0 == bytesOffset)
+				{
+					chunkBuffer[0] = static_cast<std::uint8_t>(Function::ObjectPoolTransferMessage);
+					destination = &chunkBuffer[1];
+					numberOfBytesNeeded--;
+
+					// A new pool is starting, so whatever is in the scaling buffer belongs to another pool
+					parentVTClient->scaledObjectLength = 0;
+				}
+				else
+				{
+					// Subtract off 1 to account for the mux in the first byte of the message
+					poolOffset = bytesOffset - 1;
+				}
+
 				if ((0 != parentVTClient->objectPools[poolIndex].autoScaleDataMaskOriginalDimension) && (0 != parentVTClient->objectPools[poolIndex].autoScaleSoftKeyDesignatorOriginalHeight))
 				{
-					// Object pool has been pre-scaled. Use the scaling buffer instead
-					retVal = true;
-					if (0 == bytesOffset)
-					{
-						chunkBuffer[0] = static_cast<std::uint8_t>(Function::ObjectPoolTransferMessage);
-						memcpy(&chunkBuffer[1], &parentVTClient->objectPools[poolIndex].scaledObjectPool[bytesOffset], numberOfBytesNeeded - 1);
-					}
-					else
-					{
-						// Subtract off 1 to account for the mux in the first byte of the message
-						memcpy(chunkBuffer, &parentVTClient->objectPools[poolIndex].scaledObjectPool[bytesOffset - 1], numberOfBytesNeeded);
-					}
+					retVal = parentVTClient->read_scaled_object_pool_data(poolIndex, callbackIndex, poolOffset, numberOfBytesNeeded, destination);
 				}
 				else
 				{
-					if (usingExternalCallback)
-					{
-						// We're using the user's supplied callback to get a chunk of info
-						if (0 == bytesOffset)
-						{
-							chunkBuffer[0] = static_cast<std::uint8_t>(Function::ObjectPoolTransferMessage);
-							retVal = parentVTClient->objectPools[poolIndex].dataCallback(callbackIndex, bytesOffset, numberOfBytesNeeded - 1, &chunkBuffer[1], parentVTClient);
-						}
-						else
-						{
-							// Subtract off 1 to account for the mux in the first byte of the message
-							retVal = parentVTClient->objectPools[poolIndex].dataCallback(callbackIndex, bytesOffset - 1, numberOfBytesNeeded, chunkBuffer, parentVTClient);
-						}
-					}
-					else
-					{
-						// We already have the whole pool in RAM
-						retVal = true;
-						if (0 == bytesOffset)
-						{
-							chunkBuffer[0] = static_cast<std::uint8_t>(Function::ObjectPoolTransferMessage);
-							memcpy(&chunkBuffer[1], &parentVTClient->objectPools[poolIndex].objectPoolDataPointer[bytesOffset], numberOfBytesNeeded - 1);
-						}
-						else
-						{
-							// Subtract off 1 to account for the mux in the first byte of the message
-							memcpy(chunkBuffer, &parentVTClient->objectPools[poolIndex].objectPoolDataPointer[bytesOffset - 1], numberOfBytesNeeded);
-						}
-					}
+					retVal = parentVTClient->read_object_pool_data(poolIndex, callbackIndex, poolOffset, numberOfBytesNeeded, destination);
 				}
 			}
 		}
 		return retVal;
 	}
 
-	bool VirtualTerminalClient::get_any_pool_needs_scaling() const
+	bool VirtualTerminalClient::read_object_pool_data(std::uint32_t poolIndex, std::uint32_t callbackIndex, std::uint32_t poolOffset, std::uint32_t numberOfBytes, std::uint8_t *destination)
 	{
 		bool retVal = false;
+		const ObjectPoolDataStruct &objectPool = objectPools[poolIndex];
 
-		for (auto &objectPool : objectPools)
+		if (0 == numberOfBytes)
 		{
-			if ((0 != objectPool.autoScaleDataMaskOriginalDimension) &&
-			    (0 != objectPool.autoScaleSoftKeyDesignatorOriginalHeight))
-			{
-				retVal = true;
-				break;
-			}
+			retVal = true;
+		}
+		else if (objectPool.useDataCallback)
+		{
+			// We're using the user's supplied callback to get a chunk of info
+			retVal = objectPool.dataCallback(callbackIndex, poolOffset, numberOfBytes, destination, this);
+		}
+		else if (nullptr != objectPool.objectPoolDataPointer)
+		{
+			// We already have the whole pool in RAM
+			memcpy(destination, &objectPool.objectPoolDataPointer[poolOffset], numberOfBytes);
+			retVal = true;
+		}
+		else if (nullptr != objectPool.objectPoolVectorPointer)
+		{
+			memcpy(destination, &objectPool.objectPoolVectorPointer->at(poolOffset), numberOfBytes);
+			retVal = true;
 		}
 		return retVal;
 	}
 
-	bool VirtualTerminalClient::scale_object_pools()
+	bool VirtualTerminalClient::read_scaled_object_pool_data(std::uint32_t poolIndex, std::uint32_t callbackIndex, std::uint32_t poolOffset, std::uint32_t numberOfBytes, std::uint8_t *destination)
 	{
-		bool retVal = true;
+		bool retVal = ((poolOffset + numberOfBytes) <= objectPools[poolIndex].objectPoolSize);
 
-		for (auto &objectPool : objectPools)
+		while (retVal && (numberOfBytes > 0))
 		{
-			// Step 1: Make a read/write copy of the pool
-			if (nullptr != objectPool.objectPoolDataPointer)
+			if ((0 == scaledObjectLength) || (poolOffset < scaledObjectOffset))
 			{
-				objectPool.scaledObjectPool.resize(objectPool.objectPoolSize);
-				memcpy(&objectPool.scaledObjectPool[0], objectPool.objectPoolDataPointer, objectPool.objectPoolSize);
+				// Either nothing is loaded yet, or the transport protocol went back to resend data from an earlier object.
+				// Objects can only be found by walking the pool from the start, so start over.
+				retVal = load_scaled_object(poolIndex, callbackIndex, 0);
 			}
-			else if (nullptr != objectPool.objectPoolVectorPointer)
+			else if (poolOffset >= (scaledObjectOffset + scaledObjectLength))
 			{
-				objectPool.scaledObjectPool.resize(objectPool.objectPoolVectorPointer->size());
-				std::copy(objectPool.objectPoolVectorPointer->begin(), objectPool.objectPoolVectorPointer->end(), objectPool.scaledObjectPool.begin());
+				retVal = load_scaled_object(poolIndex, callbackIndex, scaledObjectOffset + scaledObjectLength);
 			}
-			else if (objectPool.useDataCallback)
+			else
 			{
-				objectPool.scaledObjectPool.resize(objectPool.objectPoolSize);
+				const std::uint32_t offsetInObject = poolOffset - scaledObjectOffset;
+				std::uint32_t bytesToCopy;
 
-				for (std::uint32_t i = 0; i < objectPool.objectPoolSize; i++)
+				if (offsetInObject < scaledObjectBuffer.size())
 				{
-					retVal &= objectPool.dataCallback(i, i, 1, &objectPool.scaledObjectPool[i], this);
+					bytesToCopy = std::min(numberOfBytes, static_cast<std::uint32_t>(scaledObjectBuffer.size()) - offsetInObject);
+					memcpy(destination, &scaledObjectBuffer[offsetInObject], bytesToCopy);
 				}
-
-				if (!retVal)
+				else
 				{
-					break;
+					// Scaling doesn't change the rest of this object, so it comes straight from the pool
+					bytesToCopy = std::min(numberOfBytes, scaledObjectLength - offsetInObject);
+					retVal = read_object_pool_data(poolIndex, callbackIndex, poolOffset, bytesToCopy, destination);
 				}
+				poolOffset += bytesToCopy;
+				destination += bytesToCopy;
+				numberOfBytes -= bytesToCopy;
 			}
+		}
+		return retVal;
+	}
+
+	bool VirtualTerminalClient::load_scaled_object(std::uint32_t poolIndex, std::uint32_t callbackIndex, std::uint32_t objectOffset)
+	{
+		constexpr std::uint32_t OBJECT_HEADER_LENGTH = 3; // Object ID and type
+		const ObjectPoolDataStruct &objectPool = objectPools[poolIndex];
+		const std::uint32_t bytesRemaining = objectPool.objectPoolSize - objectOffset;
+		std::uint32_t objectLength = 0;
+		bool readSuccessful = true;
+		bool objectValid = false;
+
+		scaledObjectOffset = objectOffset;
+		scaledObjectLength = 0;
+		scaledObjectBuffer.resize(OBJECT_HEADER_LENGTH);
+
+		if (bytesRemaining >= OBJECT_HEADER_LENGTH)
+		{
+			readSuccessful = read_object_pool_data(poolIndex, callbackIndex, objectOffset, OBJECT_HEADER_LENGTH, scaledObjectBuffer.data());
+		}
 
-			// Step 2, Parse the pool and resize each object as we iterate through it
-			auto poolIterator = objectPool.scaledObjectPool.begin();
+		const auto type = static_cast<VirtualTerminalObjectType>(scaledObjectBuffer[2]);
+		std::uint32_t lengthFieldsEnd = get_minimum_object_length(type);
 
-			while ((poolIterator != objectPool.scaledObjectPool.end()) &&
-			       retVal)
+		if (readSuccessful &&
+		    (bytesRemaining >= OBJECT_HEADER_LENGTH) &&
+		    (lengthFieldsEnd >= OBJECT_HEADER_LENGTH) &&
+		    (lengthFieldsEnd <= bytesRemaining))
+		{
+			scaledObjectBuffer.resize(lengthFieldsEnd);
+			readSuccessful = read_object_pool_data(poolIndex, callbackIndex, objectOffset + OBJECT_HEADER_LENGTH, lengthFieldsEnd - OBJECT_HEADER_LENGTH, &scaledObjectBuffer[OBJECT_HEADER_LENGTH]);
+
+			// Some objects have variable length data before the last fields needed to find their length
+			switch (type)
 			{
-				if (VirtualTerminalObjectType::Key == static_cast<VirtualTerminalObjectType>(poolIterator[2]))
+				case VirtualTerminalObjectType::InputString:
 				{
-					retVal &= resize_object(&poolIterator[0],
-					                        static_cast<float>(get_softkey_x_axis_pixels()) / static_cast<float>(objectPool.autoScaleSoftKeyDesignatorOriginalHeight),
-					                        static_cast<VirtualTerminalObjectType>(poolIterator[2]));
+					lengthFieldsEnd += scaledObjectBuffer[16];
 				}
-				else
+				break;
+
+				case VirtualTerminalObjectType::OutputString:
 				{
-					retVal &= resize_object(&poolIterator[0],
-					                        static_cast<float>(get_number_x_pixels()) / static_cast<float>(objectPool.autoScaleDataMaskOriginalDimension),
-					                        static_cast<VirtualTerminalObjectType>(poolIterator[2]));
+					lengthFieldsEnd += static_cast<std::uint16_t>(scaledObjectBuffer[14]) | (static_cast<std::uint16_t>(scaledObjectBuffer[15]) << 8);
 				}
+				break;
 
-				std::uint32_t objectSize = get_number_bytes_in_object(&poolIterator[0]);
-				if (retVal)
+				case VirtualTerminalObjectType::InputAttributes:
 				{
-					if (get_is_object_scalable(static_cast<VirtualTerminalObjectType>(*(poolIterator + 2))))
-					{
-						LOG_DEBUG("[VT]: Resized an object: " +
-						          isobus::to_string(static_cast<int>((*poolIterator)) | (static_cast<int>((*poolIterator + 1))) << 8) +
-						          " with type " +
-						          isobus::to_string(static_cast<int>((*(poolIterator + 2)))) +
-						          " with size " +
-						          isobus::to_string(static_cast<int>(objectSize)));
-					}
+					lengthFieldsEnd += scaledObjectBuffer[4];
 				}
-				else
+				break;
+
+				default:
+					break;
+			}
+
+			if (readSuccessful && (lengthFieldsEnd <= bytesRemaining))
+			{
+				// The length of extended input attributes and auxiliary input type 2 objects is found from the byte just past
+				// their minimum length, which belongs to the next object if they have nothing after it, so buffer one byte
+				// more than the length fields, or a zero if the pool ends here.
+				const std::uint32_t bytesBuffered = static_cast<std::uint32_t>(scaledObjectBuffer.size());
+				const std::uint32_t bytesToBuffer = (lengthFieldsEnd < bytesRemaining) ? (lengthFieldsEnd + 1) : lengthFieldsEnd;
+				scaledObjectBuffer.resize(lengthFieldsEnd + 1, 0);
+				readSuccessful = read_object_pool_data(poolIndex, callbackIndex, objectOffset + bytesBuffered, bytesToBuffer - bytesBuffered, &scaledObjectBuffer[bytesBuffered]);
+				objectLength = get_number_bytes_in_object(scaledObjectBuffer.data());
+
+				if (readSuccessful && (objectLength >= lengthFieldsEnd) && (objectLength <= bytesRemaining))
 				{
-					LOG_ERROR("[VT]: Failed to resize an object: " +
-					          isobus::to_string(static_cast<int>((*poolIterator)) | (static_cast<int>((*poolIterator + 1))) << 8) +
-					          " with type " +
-					          isobus::to_string(static_cast<int>((*poolIterator + 2))) +
-					          " with size " +
-					          isobus::to_string(static_cast<int>(objectSize)));
+					// Scalable objects are buffered whole, except picture graphics where only the header gets scaled
+					if (get_is_object_scalable(type) && (VirtualTerminalObjectType::PictureGraphic != type))
+					{
+						scaledObjectBuffer.resize(objectLength);
+						readSuccessful = read_object_pool_data(poolIndex, callbackIndex, objectOffset + lengthFieldsEnd, objectLength - lengthFieldsEnd, &scaledObjectBuffer[lengthFieldsEnd]);
+					}
+					else if (scaledObjectBuffer.size() > objectLength)
+					{
+						// Don't hand out the byte that was only buffered to find the length
+						scaledObjectBuffer.resize(objectLength);
+					}
+
+					if (readSuccessful)
+					{
+						float scaleFactor;
+
+						if (VirtualTerminalObjectType::Key == type)
+						{
+							scaleFactor = static_cast<float>(get_softkey_x_axis_pixels()) / static_cast<float>(objectPool.autoScaleSoftKeyDesignatorOriginalHeight);
+						}
+						else
+						{
+							scaleFactor = static_cast<float>(get_number_x_pixels()) / static_cast<float>(objectPool.autoScaleDataMaskOriginalDimension);
+						}
+						objectValid = resize_object(scaledObjectBuffer.data(), scaleFactor, type);
+					}
 				}
-				poolIterator += objectSize;
 			}
 		}
-		return retVal;
+
+		if (objectValid)
+		{
+			scaledObjectLength = objectLength;
+		}
+		else if (readSuccessful)
+		{
+			// The pool's data was read fine, so it's the pool itself that's bad
+			objectPoolScalingFailed = true;
+			LOG_ERROR("[VT]: Failed to auto-scale the object at offset %u with type %u", objectOffset, static_cast<unsigned int>(type));
+		}
+		return objectValid;
 	}
 
 	bool VirtualTerminalClient::get_is_object_scalable(VirtualTerminalObjectType type)
@@ -3518,7 +3582,7 @@ namespace isobus
 
 		while ((!get_font_size_supported(retVal)) && (FontSize::Size6x8 != retVal))
 		{
-			retVal = static_cast<FontSize>(static_cast<std::uint8_t>(originalFont) - 1);
+			retVal = static_cast<FontSize>(static_cast<std::uint8_t>(retVal) - 1);
 		}
 		return retVal;
 	}
@@ -4681,6 +4745,29 @@ namespace isobus
 		}
 	}
 
+	std::uint32_t VirtualTerminalClient::get_time_until_next_deadline_ms() const
+	{
+		std::uint32_t retVal = std::numeric_limits<std::uint32_t>::max();
+		const auto time_until_expired = [](std::uint32_t timestamp_ms, std::uint32_t timeout_ms) {
+			const std::uint32_t elapsed_ms = SystemTiming::get_time_elapsed_ms(timestamp_ms);
+			return (elapsed_ms < timeout_ms) ? (timeout_ms - elapsed_ms) : 0;
+		};
+
+		if (sendWorkingSetMaintenance)
+		{
+			retVal = std::min(retVal, time_until_expired(lastWorkingSetMaintenanceTimestamp_ms, WORKING_SET_MAINTENANCE_TIMEOUT_MS));
+		}
+		if ((sendAuxiliaryMaintenance) && (!ourAuxiliaryInputs.empty()))
+		{
+			retVal = std::min(retVal, time_until_expired(lastAuxiliaryMaintenanceTimestamp_ms, AUXILIARY_MAINTENANCE_TIMEOUT_MS));
+		}
+		if (StateMachineState::Connected == state)
+		{
+			retVal = std::min(retVal, time_until_expired(lastVTStatusTimestamp_ms, VT_STATUS_TIMEOUT_MS));
+		}
+		return retVal;
+	}
+
 	void VirtualTerminalClient::worker_thread_function()
 	{
 #if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
@@ -4691,7 +4778,11 @@ namespace isobus
 				break;
 			}
 			update();
-			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+			// Sleep for the regular interval, or less if one of our timers expires before then.
+			// A timer that has already expired is retried a millisecond later so that a send that keeps failing doesn't spin.
+			constexpr std::uint32_t WORKER_THREAD_INTERVAL_MS = 50;
+			std::this_thread::sleep_for(std::chrono::milliseconds(std::max<std::uint32_t>(1, std::min(WORKER_THREAD_INTERVAL_MS, get_time_until_next_deadline_ms()))));
 		}
 #endif
 	}
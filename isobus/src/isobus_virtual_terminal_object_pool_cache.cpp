@@ -0,0 +1,466 @@
+//================================================================================================
+/// @file isobus_virtual_terminal_object_pool_cache.cpp
+///
+/// @brief Implements a cache of parsed VT object pools, keyed by the content of their IOP data.
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/isobus_virtual_terminal_object_pool_cache.hpp"
+
+#include "isobus/isobus/isobus_virtual_terminal_objects.hpp"
+
+#include <cstring>
+
+namespace isobus
+{
+	std::uint64_t VTObjectPoolCache::get_content_hash(const std::uint8_t *data, std::size_t length, std::uint64_t hash)
+	{
+		for (std::size_t i = 0; i < length; i++)
+		{
+			hash ^= data[i];
+			hash *= 0x100000001B3;
+		}
+		return hash;
+	}
+
+	bool VTObjectPoolCache::get_objects(const std::vector<std::uint8_t> &iopData, std::vector<std::shared_ptr<VTObject>> &objects)
+	{
+		const std::uint64_t hash = get_content_hash(iopData.data(), iopData.size());
+		bool retVal = false;
+		std::vector<std::shared_ptr<VTObject>> cachedObjects;
+
+		{
+			const std::lock_guard<std::mutex> lock(cacheMutex);
+			auto entry = find_entry(iopData, hash);
+
+			if (entries.end() != entry)
+			{
+				entry->second.lastUsed = ++useCounter;
+				cachedObjects = entry->second.objects;
+				retVal = true;
+			}
+		}
+
+		// Cached objects are never modified, so they can be copied without holding the lock
+		objects.clear();
+		objects.reserve(cachedObjects.size());
+		for (const auto &object : cachedObjects)
+		{
+			objects.push_back(copy_object(*object));
+		}
+		return retVal;
+	}
+
+	bool VTObjectPoolCache::add_objects(const std::vector<std::uint8_t> &iopData, const std::vector<std::shared_ptr<VTObject>> &objects)
+	{
+		bool retVal = false;
+
+		// Small objects cost about as much to copy as to parse, so pools made mostly of them aren't kept
+		if ((!objects.empty()) &&
+		    (iopData.size() <= get_maximum_cached_bytes()) &&
+		    ((iopData.size() / objects.size()) >= get_minimum_bytes_per_cached_object()))
+		{
+			const std::uint64_t hash = get_content_hash(iopData.data(), iopData.size());
+
+			{
+				const std::lock_guard<std::mutex> lock(cacheMutex);
+				retVal = (entries.end() == find_entry(iopData, hash));
+			}
+
+			if (retVal)
+			{
+				Entry newEntry;
+
+				newEntry.objects.reserve(objects.size());
+				for (std::size_t i = 0; retVal && (i < objects.size()); i++)
+				{
+					newEntry.objects.push_back(copy_object(*objects[i]));
+					retVal = (nullptr != newEntry.objects.back());
+				}
+
+				if (retVal)
+				{
+					newEntry.iopData = iopData;
+
+					const std::lock_guard<std::mutex> lock(cacheMutex);
+					if (entries.end() == find_entry(iopData, hash))
+					{
+						insert_entry(hash, std::move(newEntry));
+					}
+				}
+			}
+		}
+		return retVal;
+	}
+
+	bool VTObjectPoolCache::add_joined_objects(const std::vector<std::vector<std::uint8_t>> &iopFiles)
+	{
+		const std::lock_guard<std::mutex> lock(cacheMutex);
+		bool retVal = !iopFiles.empty();
+		std::uint64_t joinedHash = get_content_hash(nullptr, 0);
+		Entry joinedEntry;
+
+		for (std::size_t i = 0; retVal && (i < iopFiles.size()); i++)
+		{
+			auto entry = find_entry(iopFiles[i], get_content_hash(iopFiles[i].data(), iopFiles[i].size()));
+
+			if (entries.end() != entry)
+			{
+				// Entries share their objects, since nothing ever modifies a cached object
+				entry->second.lastUsed = ++useCounter;
+				joinedEntry.iopData.insert(joinedEntry.iopData.end(), iopFiles[i].begin(), iopFiles[i].end());
+				joinedEntry.objects.insert(joinedEntry.objects.end(), entry->second.objects.begin(), entry->second.objects.end());
+				joinedHash = get_content_hash(iopFiles[i].data(), iopFiles[i].size(), joinedHash);
+			}
+			else
+			{
+				retVal = false;
+			}
+		}
+
+		if (retVal &&
+		    (iopFiles.size() > 1) &&
+		    (joinedEntry.iopData.size() <= maximumCachedBytes) &&
+		    (entries.end() == find_entry(joinedEntry.iopData, joinedHash)))
+		{
+			insert_entry(joinedHash, std::move(joinedEntry));
+		}
+		return retVal;
+	}
+
+	void VTObjectPoolCache::set_maximum_cached_bytes(std::size_t value)
+	{
+		const std::lock_guard<std::mutex> lock(cacheMutex);
+		maximumCachedBytes = value;
+		remove_least_recently_used_entries();
+	}
+
+	std::size_t VTObjectPoolCache::get_maximum_cached_bytes() const
+	{
+		const std::lock_guard<std::mutex> lock(cacheMutex);
+		return maximumCachedBytes;
+	}
+
+	void VTObjectPoolCache::set_minimum_bytes_per_cached_object(std::size_t value)
+	{
+		const std::lock_guard<std::mutex> lock(cacheMutex);
+		minimumBytesPerCachedObject = value;
+	}
+
+	std::size_t VTObjectPoolCache::get_minimum_bytes_per_cached_object() const
+	{
+		const std::lock_guard<std::mutex> lock(cacheMutex);
+		return minimumBytesPerCachedObject;
+	}
+
+	std::size_t VTObjectPoolCache::size() const
+	{
+		const std::lock_guard<std::mutex> lock(cacheMutex);
+		return entries.size();
+	}
+
+	void VTObjectPoolCache::clear()
+	{
+		const std::lock_guard<std::mutex> lock(cacheMutex);
+		entries.clear();
+		cachedBytes = 0;
+	}
+
+	std::shared_ptr<VTObject> VTObjectPoolCache::copy_object(const VTObject &object)
+	{
+		std::shared_ptr<VTObject> retVal;
+
+		switch (object.get_object_type())
+		{
+			case VirtualTerminalObjectType::WorkingSet:
+			{
+				retVal = std::make_shared<WorkingSet>(static_cast<const WorkingSet &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::DataMask:
+			{
+				retVal = std::make_shared<DataMask>(static_cast<const DataMask &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::AlarmMask:
+			{
+				retVal = std::make_shared<AlarmMask>(static_cast<const AlarmMask &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::Container:
+			{
+				retVal = std::make_shared<Container>(static_cast<const Container &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::WindowMask:
+			{
+				retVal = std::make_shared<WindowMask>(static_cast<const WindowMask &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::SoftKeyMask:
+			{
+				retVal = std::make_shared<SoftKeyMask>(static_cast<const SoftKeyMask &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::Key:
+			{
+				retVal = std::make_shared<Key>(static_cast<const Key &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::Button:
+			{
+				retVal = std::make_shared<Button>(static_cast<const Button &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::KeyGroup:
+			{
+				retVal = std::make_shared<KeyGroup>(static_cast<const KeyGroup &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::InputBoolean:
+			{
+				retVal = std::make_shared<InputBoolean>(static_cast<const InputBoolean &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::InputString:
+			{
+				retVal = std::make_shared<InputString>(static_cast<const InputString &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::InputNumber:
+			{
+				retVal = std::make_shared<InputNumber>(static_cast<const InputNumber &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::InputList:
+			{
+				retVal = std::make_shared<InputList>(static_cast<const InputList &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputString:
+			{
+				retVal = std::make_shared<OutputString>(static_cast<const OutputString &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputNumber:
+			{
+				retVal = std::make_shared<OutputNumber>(static_cast<const OutputNumber &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputList:
+			{
+				retVal = std::make_shared<OutputList>(static_cast<const OutputList &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputLine:
+			{
+				retVal = std::make_shared<OutputLine>(static_cast<const OutputLine &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputRectangle:
+			{
+				retVal = std::make_shared<OutputRectangle>(static_cast<const OutputRectangle &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputEllipse:
+			{
+				retVal = std::make_shared<OutputEllipse>(static_cast<const OutputEllipse &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputPolygon:
+			{
+				retVal = std::make_shared<OutputPolygon>(static_cast<const OutputPolygon &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputMeter:
+			{
+				retVal = std::make_shared<OutputMeter>(static_cast<const OutputMeter &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputLinearBarGraph:
+			{
+				retVal = std::make_shared<OutputLinearBarGraph>(static_cast<const OutputLinearBarGraph &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::OutputArchedBarGraph:
+			{
+				retVal = std::make_shared<OutputArchedBarGraph>(static_cast<const OutputArchedBarGraph &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::PictureGraphic:
+			{
+				retVal = std::make_shared<PictureGraphic>(static_cast<const PictureGraphic &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::NumberVariable:
+			{
+				retVal = std::make_shared<NumberVariable>(static_cast<const NumberVariable &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::StringVariable:
+			{
+				retVal = std::make_shared<StringVariable>(static_cast<const StringVariable &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::FontAttributes:
+			{
+				retVal = std::make_shared<FontAttributes>(static_cast<const FontAttributes &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::LineAttributes:
+			{
+				retVal = std::make_shared<LineAttributes>(static_cast<const LineAttributes &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::FillAttributes:
+			{
+				retVal = std::make_shared<FillAttributes>(static_cast<const FillAttributes &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::InputAttributes:
+			{
+				retVal = std::make_shared<InputAttributes>(static_cast<const InputAttributes &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::ExtendedInputAttributes:
+			{
+				retVal = std::make_shared<ExtendedInputAttributes>(static_cast<const ExtendedInputAttributes &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::ColourMap:
+			{
+				retVal = std::make_shared<ColourMap>(static_cast<const ColourMap &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::ObjectPointer:
+			{
+				retVal = std::make_shared<ObjectPointer>(static_cast<const ObjectPointer &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::ExternalObjectPointer:
+			{
+				retVal = std::make_shared<ExternalObjectPointer>(static_cast<const ExternalObjectPointer &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::Macro:
+			{
+				retVal = std::make_shared<Macro>(static_cast<const Macro &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::AuxiliaryFunctionType1:
+			{
+				retVal = std::make_shared<AuxiliaryFunctionType1>(static_cast<const AuxiliaryFunctionType1 &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::AuxiliaryInputType1:
+			{
+				retVal = std::make_shared<AuxiliaryInputType1>(static_cast<const AuxiliaryInputType1 &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::AuxiliaryFunctionType2:
+			{
+				retVal = std::make_shared<AuxiliaryFunctionType2>(static_cast<const AuxiliaryFunctionType2 &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::AuxiliaryInputType2:
+			{
+				retVal = std::make_shared<AuxiliaryInputType2>(static_cast<const AuxiliaryInputType2 &>(object));
+			}
+			break;
+
+			case VirtualTerminalObjectType::AuxiliaryControlDesignatorType2:
+			{
+				retVal = std::make_shared<AuxiliaryControlDesignatorType2>(static_cast<const AuxiliaryControlDesignatorType2 &>(object));
+			}
+			break;
+
+			default:
+			{
+				// Not an object type the parser creates, so there's nothing to copy it as
+			}
+			break;
+		}
+		return retVal;
+	}
+
+	std::multimap<std::uint64_t, VTObjectPoolCache::Entry>::iterator VTObjectPoolCache::find_entry(const std::vector<std::uint8_t> &iopData, std::uint64_t hash)
+	{
+		auto retVal = entries.end();
+		auto matchingEntries = entries.equal_range(hash);
+
+		for (auto entry = matchingEntries.first; entry != matchingEntries.second; entry++)
+		{
+			if ((entry->second.iopData.size() == iopData.size()) &&
+			    (0 == std::memcmp(entry->second.iopData.data(), iopData.data(), iopData.size())))
+			{
+				retVal = entry;
+				break;
+			}
+		}
+		return retVal;
+	}
+
+	void VTObjectPoolCache::insert_entry(std::uint64_t hash, Entry &&entry)
+	{
+		entry.lastUsed = ++useCounter;
+		cachedBytes += entry.iopData.size();
+		entries.emplace(hash, std::move(entry));
+		remove_least_recently_used_entries();
+	}
+
+	void VTObjectPoolCache::remove_least_recently_used_entries()
+	{
+		while (cachedBytes > maximumCachedBytes)
+		{
+			auto leastRecentlyUsed = entries.begin();
+
+			for (auto entry = entries.begin(); entry != entries.end(); entry++)
+			{
+				if (entry->second.lastUsed < leastRecentlyUsed->second.lastUsed)
+				{
+					leastRecentlyUsed = entry;
+				}
+			}
+			cachedBytes -= leastRecentlyUsed->second.iopData.size();
+			entries.erase(leastRecentlyUsed);
+		}
+	}
+} // namespace isobus
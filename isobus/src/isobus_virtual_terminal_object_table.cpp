@@ -0,0 +1,84 @@
+//================================================================================================
+/// @file isobus_virtual_terminal_object_table.cpp
+///
+/// @brief Implements a table that stores a VT object pool indexed directly by object ID.
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/isobus/isobus_virtual_terminal_object_table.hpp"
+
+#include "isobus/isobus/isobus_virtual_terminal_objects.hpp"
+
+namespace isobus
+{
+	VTObjectTable::VTObjectTable(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objects)
+	{
+		for (const auto &object : objects)
+		{
+			add_or_replace_object(object.second);
+		}
+	}
+
+	bool VTObjectTable::add_or_replace_object(std::shared_ptr<VTObject> objectToAdd)
+	{
+		bool retVal = false;
+
+		if (nullptr != objectToAdd)
+		{
+			const std::uint16_t objectID = objectToAdd->get_id();
+			auto &page = pages[objectID / PAGE_SIZE];
+
+			if (nullptr == page)
+			{
+				page.reset(new Page());
+			}
+
+			auto &entry = (*page)[objectID % PAGE_SIZE];
+			if (nullptr == entry)
+			{
+				numberOfObjects++;
+			}
+			entry = objectToAdd;
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	bool VTObjectTable::remove_object(std::uint16_t objectID)
+	{
+		bool retVal = false;
+		auto &page = pages[objectID / PAGE_SIZE];
+
+		if ((nullptr != page) && (nullptr != (*page)[objectID % PAGE_SIZE]))
+		{
+			(*page)[objectID % PAGE_SIZE] = nullptr;
+			numberOfObjects--;
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	void VTObjectTable::clear()
+	{
+		for (auto &page : pages)
+		{
+			page.reset();
+		}
+		numberOfObjects = 0;
+	}
+
+	std::size_t VTObjectTable::size() const
+	{
+		return numberOfObjects;
+	}
+
+	std::map<std::uint16_t, std::shared_ptr<VTObject>> VTObjectTable::to_map() const
+	{
+		std::map<std::uint16_t, std::shared_ptr<VTObject>> retVal;
+
+		for_each_object([&retVal](const std::shared_ptr<VTObject> &object) {
+			retVal.emplace_hint(retVal.end(), object->get_id(), object);
+		});
+		return retVal;
+	}
+} // namespace isobus
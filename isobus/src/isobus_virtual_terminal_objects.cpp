@@ -9,6 +9,8 @@
 #include "isobus/isobus/isobus_virtual_terminal_objects.hpp"
 #include "isobus/isobus/isobus_virtual_terminal_server_managed_working_set.hpp"
 
+#include <cstring>
+
 namespace isobus
 {
 	VTColourTable::VTColourTable()
@@ -237,17 +239,13 @@ namespace isobus
 		}
 	}
 
-	std::shared_ptr<VTObject> VTObject::get_object_by_id(std::uint16_t objectID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool)
+	std::shared_ptr<VTObject> VTObject::get_object_by_id(std::uint16_t objectID, const VTObjectTable &objectPool)
 	{
 		std::shared_ptr<VTObject> retVal = nullptr;
 
-		if ((NULL_OBJECT_ID != objectID) && (objectPool.find(objectID) != objectPool.end()))
+		if (NULL_OBJECT_ID != objectID)
 		{
-			auto object = objectPool.at(objectID);
-			if (nullptr != object)
-			{
-				retVal = object;
-			}
+			retVal = objectPool.get_object_by_id(objectID);
 		}
 		return retVal;
 	}
@@ -271,7 +269,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool WorkingSet::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool WorkingSet::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -313,7 +311,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool WorkingSet::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool WorkingSet::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -432,7 +430,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool DataMask::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool DataMask::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 		std::uint8_t numberOfSoftKeyMasks = 0;
@@ -499,7 +497,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool DataMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool DataMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -574,7 +572,7 @@ namespace isobus
 		return retVal;
 	}
 
-	bool DataMask::change_soft_key_mask(std::uint16_t newMaskID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool)
+	bool DataMask::change_soft_key_mask(std::uint16_t newMaskID, const VTObjectTable &objectPool)
 	{
 		bool retVal = false;
 
@@ -583,9 +581,8 @@ namespace isobus
 			set_soft_key_mask(newMaskID);
 			retVal = true;
 		}
-		else if ((objectPool.end() != objectPool.find(newMaskID)) &&
-		         (nullptr != objectPool.at(newMaskID)) &&
-		         (VirtualTerminalObjectType::SoftKeyMask == objectPool.at(newMaskID)->get_object_type()))
+		else if ((nullptr != objectPool.get_object_by_id(newMaskID)) &&
+		         (VirtualTerminalObjectType::SoftKeyMask == objectPool.get_object_by_id(newMaskID)->get_object_type()))
 		{
 			set_soft_key_mask(newMaskID);
 			retVal = true;
@@ -614,7 +611,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool AlarmMask::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AlarmMask::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -668,7 +665,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool AlarmMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool AlarmMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -805,7 +802,7 @@ namespace isobus
 		signalPriority = value;
 	}
 
-	bool AlarmMask::change_soft_key_mask(std::uint16_t newMaskID, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool)
+	bool AlarmMask::change_soft_key_mask(std::uint16_t newMaskID, const VTObjectTable &objectPool)
 	{
 		bool retVal = false;
 
@@ -814,8 +811,8 @@ namespace isobus
 			set_soft_key_mask(newMaskID);
 			retVal = true;
 		}
-		else if ((nullptr != objectPool.at(newMaskID)) &&
-		         (VirtualTerminalObjectType::SoftKeyMask == objectPool.at(newMaskID)->get_object_type()))
+		else if ((nullptr != objectPool.get_object_by_id(newMaskID)) &&
+		         (VirtualTerminalObjectType::SoftKeyMask == objectPool.get_object_by_id(newMaskID)->get_object_type()))
 		{
 			set_soft_key_mask(newMaskID);
 			retVal = true;
@@ -843,7 +840,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool Container::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool Container::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -897,7 +894,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool Container::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool Container::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		// All attributes are read only
 		returnedError = AttributeError::InvalidAttributeID;
@@ -970,7 +967,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool SoftKeyMask::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool SoftKeyMask::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -1002,7 +999,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool SoftKeyMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool SoftKeyMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -1073,7 +1070,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool Key::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool Key::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -1119,7 +1116,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool Key::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool Key::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -1214,7 +1211,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool KeyGroup::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool KeyGroup::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -1279,7 +1276,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool KeyGroup::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool KeyGroup::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -1298,10 +1295,10 @@ namespace isobus
 				{
 					returnedError = AttributeError::InvalidValue;
 
-					if (objectPool.find(objectID) != objectPool.end())
+					if (objectPool.get_object_id_exists(objectID))
 					{
 						auto newName = static_cast<std::uint16_t>(rawAttributeData);
-						auto newNameObject = objectPool.at(newName);
+						auto newNameObject = objectPool.get_object_by_id(newName);
 
 						if (validate_name(newName, objectPool))
 						{
@@ -1411,9 +1408,9 @@ namespace isobus
 		}
 	}
 
-	bool KeyGroup::validate_name(std::uint16_t nameIDToValidate, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool KeyGroup::validate_name(std::uint16_t nameIDToValidate, const VTObjectTable &objectPool) const
 	{
-		auto newNameObject = objectPool.at(nameIDToValidate);
+		auto newNameObject = objectPool.get_object_by_id(nameIDToValidate);
 		bool retVal = false;
 
 		if ((NULL_OBJECT_ID != nameIDToValidate) &&
@@ -1425,7 +1422,7 @@ namespace isobus
 			{
 				if (newNameObject->get_number_children() > 0)
 				{
-					auto label = objectPool.at(std::static_pointer_cast<ObjectPointer>(newNameObject)->get_child_id(0));
+					auto label = objectPool.get_object_by_id(std::static_pointer_cast<ObjectPointer>(newNameObject)->get_child_id(0));
 
 					if ((nullptr != label) &&
 					    (VirtualTerminalObjectType::OutputString == label->get_object_type()))
@@ -1452,7 +1449,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool Button::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool Button::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -1497,7 +1494,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool Button::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool Button::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -1680,7 +1677,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool InputBoolean::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool InputBoolean::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -1734,7 +1731,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool InputBoolean::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool InputBoolean::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -1765,10 +1762,10 @@ namespace isobus
 						set_foreground_colour_object_id(static_cast<std::uint16_t>(rawAttributeData));
 						retVal = true;
 					}
-					else if (objectPool.find(static_cast<std::uint16_t>(rawAttributeData)) != objectPool.end())
+					else if (objectPool.get_object_id_exists(static_cast<std::uint16_t>(rawAttributeData)))
 					{
-						if (nullptr != objectPool.at(static_cast<std::uint16_t>(rawAttributeData)) &&
-						    (VirtualTerminalObjectType::FontAttributes == objectPool.at(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))
+						if (nullptr != objectPool.get_object_by_id(static_cast<std::uint16_t>(rawAttributeData)) &&
+						    (VirtualTerminalObjectType::FontAttributes == objectPool.get_object_by_id(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))
 						{
 							set_foreground_colour_object_id(static_cast<std::uint16_t>(rawAttributeData));
 							retVal = true;
@@ -1790,10 +1787,10 @@ namespace isobus
 						set_variable_reference(static_cast<std::uint16_t>(rawAttributeData));
 						retVal = true;
 					}
-					else if (objectPool.find(static_cast<std::uint16_t>(rawAttributeData)) != objectPool.end())
+					else if (objectPool.get_object_id_exists(static_cast<std::uint16_t>(rawAttributeData)))
 					{
-						if (nullptr != objectPool.at(static_cast<std::uint16_t>(rawAttributeData)) &&
-						    (VirtualTerminalObjectType::NumberVariable == objectPool.at(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))
+						if (nullptr != objectPool.get_object_by_id(static_cast<std::uint16_t>(rawAttributeData)) &&
+						    (VirtualTerminalObjectType::NumberVariable == objectPool.get_object_by_id(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))
 						{
 							set_variable_reference(static_cast<std::uint16_t>(rawAttributeData));
 							retVal = true;
@@ -1968,7 +1965,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool InputString::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool InputString::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -2037,7 +2034,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool InputString::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool InputString::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -2300,7 +2297,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool InputNumber::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool InputNumber::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -2354,7 +2351,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool InputNumber::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool InputNumber::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -2727,7 +2724,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool InputList::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool InputList::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -2772,7 +2769,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool InputList::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool InputList::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -2922,7 +2919,7 @@ namespace isobus
 		}
 	}
 
-	bool InputList::change_list_item(std::uint8_t index, std::uint16_t newListItem, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool)
+	bool InputList::change_list_item(std::uint8_t index, std::uint16_t newListItem, const VTObjectTable &objectPool)
 	{
 		bool retVal = false;
 
@@ -2983,7 +2980,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputString::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputString::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -3037,7 +3034,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputString::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputString::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -3230,7 +3227,7 @@ namespace isobus
 	{
 		if (isobus::NULL_OBJECT_ID != get_variable_reference())
 		{
-			auto child = get_object_by_id(get_variable_reference(), parentWorkingSet->get_object_tree());
+			auto child = get_object_by_id(get_variable_reference(), parentWorkingSet->get_object_table());
 
 			if ((nullptr != child) && (isobus::VirtualTerminalObjectType::StringVariable == child->get_object_type()))
 			{
@@ -3255,7 +3252,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputNumber::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputNumber::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -3309,7 +3306,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputNumber::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputNumber::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -3591,7 +3588,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputList::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputList::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -3662,7 +3659,7 @@ namespace isobus
 		        (NULL_OBJECT_ID != objectID));
 	}
 
-	bool OutputList::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputList::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -3796,7 +3793,7 @@ namespace isobus
 		value = aValue;
 	}
 
-	bool OutputList::change_list_item(std::uint8_t index, std::uint16_t newListItem, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool)
+	bool OutputList::change_list_item(std::uint8_t index, std::uint16_t newListItem, const VTObjectTable &objectPool)
 	{
 		bool retVal = false;
 
@@ -3816,7 +3813,7 @@ namespace isobus
 		return VirtualTerminalObjectType::OutputLine;
 	}
 
-	bool OutputLine::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputLine::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -3852,7 +3849,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputLine::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputLine::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -4008,7 +4005,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputRectangle::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputRectangle::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -4062,7 +4059,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputRectangle::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputRectangle::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -4241,7 +4238,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputEllipse::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputEllipse::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -4295,7 +4292,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputEllipse::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputEllipse::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -4529,7 +4526,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputPolygon::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputPolygon::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -4583,7 +4580,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputPolygon::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputPolygon::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -4803,7 +4800,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputMeter::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputMeter::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -4839,7 +4836,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputMeter::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputMeter::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -5187,7 +5184,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputLinearBarGraph::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputLinearBarGraph::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -5241,7 +5238,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputLinearBarGraph::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputLinearBarGraph::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -5579,7 +5576,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool OutputArchedBarGraph::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool OutputArchedBarGraph::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -5633,7 +5630,7 @@ namespace isobus
 		return (!anyWrongChildType);
 	}
 
-	bool OutputArchedBarGraph::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool OutputArchedBarGraph::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -6005,12 +6002,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool PictureGraphic::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool PictureGraphic::get_is_valid(const VTObjectTable &) const
 	{
 		return true;
 	}
 
-	bool PictureGraphic::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool PictureGraphic::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -6122,18 +6119,15 @@ namespace isobus
 
 	std::vector<std::uint8_t> &PictureGraphic::get_raw_data()
 	{
+		// The data can be changed through the returned reference
+		rgbaDataValid = false;
 		return rawData;
 	}
 
 	void PictureGraphic::set_raw_data(const std::uint8_t *data, std::uint32_t size)
 	{
-		rawData.clear();
-		rawData.resize(size);
-
-		for (std::uint32_t i = 0; i < size; i++)
-		{
-			rawData[i] = data[i];
-		}
+		rawData.assign(data, data + size);
+		rgbaDataValid = false;
 	}
 
 	void PictureGraphic::add_raw_data(std::uint8_t dataByte)
@@ -6141,7 +6135,149 @@ namespace isobus
 		if (rawData.size() < (get_actual_width() * get_actual_height()))
 		{
 			rawData.push_back(dataByte);
+			rgbaDataValid = false;
+		}
+	}
+
+	bool PictureGraphic::decode_raw_data(const std::uint8_t *data, std::uint32_t size)
+	{
+		const bool runLengthEncoded = get_option(Options::RunLengthEncoded);
+		bool retVal = false;
+
+		if ((!runLengthEncoded) || (0 == (size % 2)))
+		{
+			const std::uint32_t numberOfPixels = static_cast<std::uint32_t>(actualWidth) * actualHeight;
+			std::uint32_t pixelsPerByte = 1;
+			std::uint32_t numberOfPixelsDecoded = 0;
+
+			switch (get_format())
+			{
+				case Format::Monochrome:
+				{
+					pixelsPerByte = 8;
+				}
+				break;
+
+				case Format::FourBitColour:
+				{
+					pixelsPerByte = 2;
+				}
+				break;
+
+				default:
+					break;
+			}
+
+			rawData.resize(numberOfPixels);
+			rgbaDataValid = false;
+
+			if ((1 == pixelsPerByte) && (!runLengthEncoded))
+			{
+				// The data is already one colour index per pixel
+				numberOfPixelsDecoded = std::min(size, numberOfPixels);
+
+				if (0 != numberOfPixelsDecoded)
+				{
+					memcpy(rawData.data(), data, numberOfPixelsDecoded);
+				}
+			}
+			else
+			{
+				const std::uint32_t bitsPerPixel = 8 / pixelsPerByte;
+				const std::uint32_t bytesPerRun = runLengthEncoded ? 2 : 1;
+				std::uint32_t pixelsLeftInLine = actualWidth;
+				std::array<std::uint8_t, 8> bytePixels;
+
+				for (std::uint32_t i = 0; (i < size) && (numberOfPixelsDecoded < numberOfPixels); i += bytesPerRun)
+				{
+					// Run length encoded data is pairs of a repeat count followed by the byte to repeat
+					std::uint32_t repeatCount = runLengthEncoded ? data[i] : 1;
+					const std::uint8_t packedByte = runLengthEncoded ? data[i + 1] : data[i];
+
+					if (1 == pixelsPerByte)
+					{
+						const std::uint32_t pixelsToDecode = std::min(repeatCount, numberOfPixels - numberOfPixelsDecoded);
+						memset(&rawData[numberOfPixelsDecoded], packedByte, pixelsToDecode);
+						numberOfPixelsDecoded += pixelsToDecode;
+					}
+					else
+					{
+						// Pixels are packed starting from the most significant bits
+						for (std::uint32_t j = 0; j < pixelsPerByte; j++)
+						{
+							bytePixels[j] = static_cast<std::uint8_t>((packedByte >> (8 - (bitsPerPixel * (j + 1)))) & ((1 << bitsPerPixel) - 1));
+						}
+
+						for (; (repeatCount > 0) && (numberOfPixelsDecoded < numberOfPixels); repeatCount--)
+						{
+							const std::uint32_t pixelsToDecode = std::min(std::min(pixelsPerByte, pixelsLeftInLine), numberOfPixels - numberOfPixelsDecoded);
+							memcpy(&rawData[numberOfPixelsDecoded], bytePixels.data(), pixelsToDecode);
+							numberOfPixelsDecoded += pixelsToDecode;
+							pixelsLeftInLine -= pixelsToDecode;
+
+							if (0 == pixelsLeftInLine)
+							{
+								// Unused bits at the end of a line are ignored
+								pixelsLeftInLine = actualWidth;
+							}
+						}
+					}
+				}
+			}
+			rawData.resize(numberOfPixelsDecoded);
+			retVal = true;
+		}
+		return retVal;
+	}
+
+	const std::vector<std::uint8_t> &PictureGraphic::get_rgba_data(const VTColourTable &colourTable, const ColourMap *colourMap)
+	{
+		constexpr std::size_t PALETTE_SIZE = 256;
+		const bool transparent = get_option(Options::Transparent);
+		std::array<std::uint32_t, PALETTE_SIZE> palette;
+
+		auto to_channel = [](float value) {
+			return static_cast<std::uint8_t>((std::min(std::max(value, 0.0f), 1.0f) * 255.0f) + 0.5f);
+		};
+
+		// Resolving every colour index once is cheap compared to converting the pixels,
+		// and tells if the pixels have to be converted again
+		for (std::size_t i = 0; i < PALETTE_SIZE; i++)
+		{
+			std::uint8_t colourIndex = static_cast<std::uint8_t>(i);
+
+			if ((nullptr != colourMap) && (i < colourMap->get_number_of_colour_indexes()))
+			{
+				colourIndex = colourMap->get_colour_map_index(colourIndex);
+			}
+
+			const VTColourVector colour = colourTable.get_colour(colourIndex);
+			const std::uint8_t channels[4] = { to_channel(colour.r),
+				                                 to_channel(colour.g),
+				                                 to_channel(colour.b),
+				                                 static_cast<std::uint8_t>((transparent && (transparencyColour == i)) ? 0x00 : 0xFF) };
+			memcpy(&palette[i], channels, sizeof(channels));
+		}
+
+		if ((!rgbaDataValid) ||
+		    (PALETTE_SIZE != rgbaPalette.size()) ||
+		    (!std::equal(palette.begin(), palette.end(), rgbaPalette.begin())))
+		{
+			rgbaPalette.assign(palette.begin(), palette.end());
+			rgbaData.resize(rawData.size() * sizeof(std::uint32_t));
+
+			// Local pointers, since the compiler has to assume byte stores can change the vectors themselves
+			const std::uint8_t *colourIndexes = rawData.data();
+			const std::size_t numberOfPixels = rawData.size();
+			std::uint8_t *pixels = rgbaData.data();
+
+			for (std::size_t i = 0; i < numberOfPixels; i++)
+			{
+				memcpy(&pixels[i * sizeof(std::uint32_t)], &palette[colourIndexes[i]], sizeof(std::uint32_t));
+			}
+			rgbaDataValid = true;
 		}
+		return rgbaData;
 	}
 
 	std::uint32_t PictureGraphic::get_number_of_bytes_in_raw_data() const
@@ -6227,12 +6363,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool NumberVariable::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool NumberVariable::get_is_valid(const VTObjectTable &) const
 	{
 		return true;
 	}
 
-	bool NumberVariable::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool NumberVariable::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -6290,12 +6426,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool StringVariable::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool StringVariable::get_is_valid(const VTObjectTable &) const
 	{
 		return true;
 	}
 
-	bool StringVariable::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool StringVariable::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -6346,12 +6482,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool FontAttributes::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool FontAttributes::get_is_valid(const VTObjectTable &) const
 	{
 		return true;
 	}
 
-	bool FontAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool FontAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -6675,12 +6811,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool LineAttributes::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool LineAttributes::get_is_valid(const VTObjectTable &) const
 	{
 		return true;
 	}
 
-	bool LineAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool LineAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -6789,14 +6925,14 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool FillAttributes::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool FillAttributes::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		return ((NULL_OBJECT_ID == get_fill_pattern()) ||
 		        ((nullptr != get_object_by_id(get_fill_pattern(), objectPool)) &&
 		         (VirtualTerminalObjectType::PictureGraphic == get_object_by_id(get_fill_pattern(), objectPool)->get_object_type())));
 	}
 
-	bool FillAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool FillAttributes::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -6937,12 +7073,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool InputAttributes::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool InputAttributes::get_is_valid(const VTObjectTable &) const
 	{
 		return true;
 	}
 
-	bool InputAttributes::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool InputAttributes::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -7010,12 +7146,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool ExtendedInputAttributes::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool ExtendedInputAttributes::get_is_valid(const VTObjectTable &) const
 	{
 		return true;
 	}
 
-	bool ExtendedInputAttributes::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool ExtendedInputAttributes::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -7083,12 +7219,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool ObjectPointer::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool ObjectPointer::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		return ((NULL_OBJECT_ID == value) || (nullptr != get_object_by_id(value, objectPool)));
 	}
 
-	bool ObjectPointer::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool ObjectPointer::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -7152,16 +7288,16 @@ namespace isobus
 		return 9;
 	}
 
-	bool ExternalObjectPointer::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool ExternalObjectPointer::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool isDefaultObjectValid = (NULL_OBJECT_ID == get_default_object_id()) ||
-		  (nullptr != objectPool.at(get_default_object_id()));
+		  (nullptr != objectPool.get_object_by_id(get_default_object_id()));
 		bool isExternalNAMEIDValid = (NULL_OBJECT_ID == get_external_reference_name_id()) ||
-		  (nullptr != objectPool.at(get_external_reference_name_id()));
+		  (nullptr != objectPool.get_object_by_id(get_external_reference_name_id()));
 		return (isDefaultObjectValid && isExternalNAMEIDValid);
 	}
 
-	bool ExternalObjectPointer::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool ExternalObjectPointer::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -7336,12 +7472,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool Macro::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool Macro::get_is_valid(const VTObjectTable &) const
 	{
 		return get_are_command_packets_valid();
 	}
 
-	bool Macro::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool Macro::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -7447,12 +7583,12 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool ColourMap::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &) const
+	bool ColourMap::get_is_valid(const VTObjectTable &) const
 	{
 		return true;
 	}
 
-	bool ColourMap::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool ColourMap::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false;
@@ -7542,7 +7678,7 @@ namespace isobus
 		return MIN_OBJECT_LENGTH;
 	}
 
-	bool WindowMask::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool WindowMask::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -7899,7 +8035,7 @@ namespace isobus
 		return !anyWrongChildType;
 	}
 
-	bool WindowMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool WindowMask::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -8063,7 +8199,7 @@ namespace isobus
 		return 6;
 	}
 
-	bool AuxiliaryFunctionType1::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AuxiliaryFunctionType1::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		// Despite modern VTs not using this object, we still have to validate it.
 		bool anyWrongChildType = false;
@@ -8104,7 +8240,7 @@ namespace isobus
 		return !anyWrongChildType;
 	}
 
-	bool AuxiliaryFunctionType1::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool AuxiliaryFunctionType1::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false; // All attributes are read only
@@ -8142,7 +8278,7 @@ namespace isobus
 		return 6;
 	}
 
-	bool AuxiliaryFunctionType2::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AuxiliaryFunctionType2::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -8188,7 +8324,7 @@ namespace isobus
 		return !anyWrongChildType;
 	}
 
-	bool AuxiliaryFunctionType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool AuxiliaryFunctionType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -8278,7 +8414,7 @@ namespace isobus
 		return 7;
 	}
 
-	bool AuxiliaryInputType1::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AuxiliaryInputType1::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -8318,7 +8454,7 @@ namespace isobus
 		return !anyWrongChildType;
 	}
 
-	bool AuxiliaryInputType1::set_attribute(std::uint8_t, std::uint32_t, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool AuxiliaryInputType1::set_attribute(std::uint8_t, std::uint32_t, const VTObjectTable &, AttributeError &returnedError)
 	{
 		returnedError = AttributeError::InvalidAttributeID;
 		return false; // All attributes are read only
@@ -8373,7 +8509,7 @@ namespace isobus
 		return 6;
 	}
 
-	bool AuxiliaryInputType2::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AuxiliaryInputType2::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool anyWrongChildType = false;
 
@@ -8419,7 +8555,7 @@ namespace isobus
 		return !anyWrongChildType;
 	}
 
-	bool AuxiliaryInputType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &, AttributeError &returnedError)
+	bool AuxiliaryInputType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &, AttributeError &returnedError)
 	{
 		bool retVal = false;
 
@@ -8522,7 +8658,7 @@ namespace isobus
 		return 6;
 	}
 
-	bool AuxiliaryControlDesignatorType2::get_is_valid(const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool) const
+	bool AuxiliaryControlDesignatorType2::get_is_valid(const VTObjectTable &objectPool) const
 	{
 		bool retVal = (((NULL_OBJECT_ID == auxiliaryObjectID) || ((nullptr != get_object_by_id(auxiliaryObjectID, objectPool)))) && (pointerType <= 3));
 
@@ -8544,7 +8680,7 @@ namespace isobus
 		return retVal;
 	}
 
-	bool AuxiliaryControlDesignatorType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const std::map<std::uint16_t, std::shared_ptr<VTObject>> &objectPool, AttributeError &returnedError)
+	bool AuxiliaryControlDesignatorType2::set_attribute(std::uint8_t attributeID, std::uint32_t rawAttributeData, const VTObjectTable &objectPool, AttributeError &returnedError)
 	{
 		bool retVal = false;
 		returnedError = AttributeError::InvalidAttributeID;
@@ -8553,8 +8689,8 @@ namespace isobus
 		{
 			if ((NULL_OBJECT_ID == rawAttributeData) ||
 			    ((nullptr != get_object_by_id(static_cast<std::uint16_t>(rawAttributeData), objectPool)) &&
-			     ((VirtualTerminalObjectType::AuxiliaryFunctionType2 == objectPool.at(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()) ||
-			      (VirtualTerminalObjectType::AuxiliaryInputType2 == objectPool.at(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))))
+			     ((VirtualTerminalObjectType::AuxiliaryFunctionType2 == objectPool.get_object_by_id(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()) ||
+			      (VirtualTerminalObjectType::AuxiliaryInputType2 == objectPool.get_object_by_id(static_cast<std::uint16_t>(rawAttributeData))->get_object_type()))))
 			{
 				set_auxiliary_object_id(static_cast<std::uint16_t>(rawAttributeData));
 				retVal = true;
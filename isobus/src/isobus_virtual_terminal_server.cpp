@@ -21,6 +21,7 @@ namespace isobus
 {
 	VirtualTerminalServer::VirtualTerminalServer(std::shared_ptr<InternalControlFunction> controlFunctionToUse) :
 	  languageCommandInterface(controlFunctionToUse, true),
+	  objectPoolCache(std::make_shared<VTObjectPoolCache>()),
 	  serverInternalControlFunction(controlFunctionToUse)
 	{
 	}
@@ -118,6 +119,11 @@ namespace isobus
 		return languageCommandInterface;
 	}
 
+	VTObjectPoolCache &VirtualTerminalServer::get_object_pool_cache()
+	{
+		return *objectPoolCache;
+	}
+
 	bool VirtualTerminalServer::check_if_source_is_managed(const CANMessage &message)
 	{
 		// Check if we're managing this CF
@@ -142,6 +148,7 @@ namespace isobus
 			{
 				// This CF is probably trying to initiate communication with us.
 				managedWorkingSetList.emplace_back(std::make_shared<VirtualTerminalServerManagedWorkingSet>(message.get_source_control_function()));
+				managedWorkingSetList.back()->set_object_pool_cache(objectPoolCache);
 				auto &data = message.get_data();
 
 				LOG_INFO("[VT Server]: Client %u initiated working set maintenance messages with version %u", managedWorkingSetList.back()->get_control_function()->get_address(), data[2]);
@@ -515,6 +522,11 @@ namespace isobus
 											}
 										}
 
+										if (allPoolsSaved)
+										{
+											cf->add_stored_version_to_object_pool_cache();
+										}
+
 										std::array<std::uint8_t, CAN_DATA_LENGTH> buffer = { 0 };
 										buffer[0] = static_cast<std::uint8_t>(Function::StoreVersionCommand);
 										buffer[1] = 0xFF; // Reserved
@@ -1136,7 +1148,7 @@ namespace isobus
 
 									if ((NULL_OBJECT_ID != objectID) && (nullptr != targetObject))
 									{
-										if (targetObject->set_attribute(attributeID, attributeData, cf->get_object_tree(), errorCode)) // 0 Is always the read-only "type" attribute
+										if (targetObject->set_attribute(attributeID, attributeData, cf->get_object_table(), errorCode)) // 0 Is always the read-only "type" attribute
 										{
 											parentServer->send_change_attribute_response(objectID, 0, data.at(3), message.get_source_control_function());
 											LOG_DEBUG("[VT Server]: Client %u changed object %u attribute %u to %u", cf->get_control_function()->get_address(), objectID, attributeID, attributeData);
@@ -1251,7 +1263,7 @@ namespace isobus
 											{
 												case VirtualTerminalObjectType::InputList:
 												{
-													if (std::static_pointer_cast<InputList>(targetObject)->change_list_item(listIndex, newObjectID, cf->get_object_tree()))
+													if (std::static_pointer_cast<InputList>(targetObject)->change_list_item(listIndex, newObjectID, cf->get_object_table()))
 													{
 														parentServer->send_change_list_item_response(objectID, newObjectID, 0, listIndex, message.get_source_control_function());
 														LOG_DEBUG("[VT Server]: Client %u change list item command: Object ID: %u, New Object ID: %u, Index: %u", cf->get_control_function()->get_address(), objectID, newObjectID, listIndex);
@@ -1276,7 +1288,7 @@ namespace isobus
 
 												case VirtualTerminalObjectType::OutputList:
 												{
-													if (std::static_pointer_cast<OutputList>(targetObject)->change_list_item(listIndex, newObjectID, cf->get_object_tree()))
+													if (std::static_pointer_cast<OutputList>(targetObject)->change_list_item(listIndex, newObjectID, cf->get_object_table()))
 													{
 														parentServer->send_change_list_item_response(objectID, newObjectID, 0, listIndex, message.get_source_control_function());
 														LOG_DEBUG("[VT Server]: Client %u change list item command: Object ID: %u, New Object ID: %u, Index: %u", cf->get_control_function()->get_address(), objectID, newObjectID, listIndex);
@@ -1364,7 +1376,7 @@ namespace isobus
 											{
 												case VirtualTerminalObjectType::AlarmMask:
 												{
-													if (std::static_pointer_cast<AlarmMask>(targetMask)->change_soft_key_mask(newSoftKeyMaskId, cf->get_object_tree()))
+													if (std::static_pointer_cast<AlarmMask>(targetMask)->change_soft_key_mask(newSoftKeyMaskId, cf->get_object_table()))
 													{
 														LOG_DEBUG("[VT Server]: Client %u change soft key mask command: alarm mask object %u to %u", cf->get_control_function()->get_address(), dataOrAlarmMaskId, newSoftKeyMaskId);
 														parentServer->send_change_soft_key_mask_response(dataOrAlarmMaskId, newSoftKeyMaskId, 0, message.get_source_control_function());
@@ -1381,7 +1393,7 @@ namespace isobus
 
 												case VirtualTerminalObjectType::DataMask:
 												{
-													if (std::static_pointer_cast<DataMask>(targetMask)->change_soft_key_mask(newSoftKeyMaskId, cf->get_object_tree()))
+													if (std::static_pointer_cast<DataMask>(targetMask)->change_soft_key_mask(newSoftKeyMaskId, cf->get_object_table()))
 													{
 														LOG_DEBUG("[VT Server]: Client %u change soft key mask command: data mask object %u to %u", cf->get_control_function()->get_address(), dataOrAlarmMaskId, newSoftKeyMaskId);
 														parentServer->send_change_soft_key_mask_response(dataOrAlarmMaskId, newSoftKeyMaskId, 0, message.get_source_control_function());
@@ -182,14 +182,35 @@ namespace isobus
 			set_object_pool_processing_state(ObjectPoolProcessingThreadState::Running);
 			LOG_INFO("[WS]: Beginning parsing of object pool. This pool has " +
 			         isobus::to_string(static_cast<int>(iopFilesRawData.size())) +
-			         " IOP components.");
-			for (std::size_t i = 0; i < iopFilesRawData.size(); i++)
+			         " IOP components, " +
+			         isobus::to_string(static_cast<int>(iopFilesRawData.size() - numberOfProcessedIopFiles)) +
+			         " of which are new.");
+
+			// Components that were already processed are left alone, so that a partial pool transfer
+			// only replaces the objects it contains and not the ones the earlier transfers created.
+			for (std::size_t i = numberOfProcessedIopFiles; i < iopFilesRawData.size(); i++)
 			{
-				if (!parse_iop_into_objects(iopFilesRawData[i].data(), static_cast<std::uint32_t>(iopFilesRawData[i].size())))
+				std::vector<std::shared_ptr<VTObject>> objects;
+
+				if ((nullptr != objectPoolCache) &&
+				    objectPoolCache->get_objects(iopFilesRawData[i], objects) &&
+				    (objects.size() == add_parsed_objects(objects, objects.size())))
+				{
+					LOG_DEBUG("[WS]: IOP component " + isobus::to_string(static_cast<int>(i)) + " was found in the object pool cache.");
+				}
+				else if (parse_iop_into_objects(iopFilesRawData[i].data(), static_cast<std::uint32_t>(iopFilesRawData[i].size()), objects))
+				{
+					if (nullptr != objectPoolCache)
+					{
+						objectPoolCache->add_objects(iopFilesRawData[i], objects);
+					}
+				}
+				else
 				{
 					lSuccess = false;
 					break;
 				}
+				numberOfProcessedIopFiles = i + 1;
 			}
 
 			if (lSuccess)
@@ -210,6 +231,22 @@ namespace isobus
 		}
 	}
 
+	void VirtualTerminalServerManagedWorkingSet::set_object_pool_cache(std::shared_ptr<VTObjectPoolCache> cache)
+	{
+		objectPoolCache = cache;
+	}
+
+	bool VirtualTerminalServerManagedWorkingSet::add_stored_version_to_object_pool_cache()
+	{
+		bool retVal = false;
+
+		if (nullptr != objectPoolCache)
+		{
+			retVal = objectPoolCache->add_joined_objects(iopFilesRawData);
+		}
+		return retVal;
+	}
+
 	bool VirtualTerminalServerManagedWorkingSet::is_object_pool_transfer_in_progress() const
 	{
 		return iop_load_percentage() != 0.0f;
@@ -13,6 +13,9 @@
 #include "isobus/utility/to_string.hpp"
 
 #include <cstring>
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+#include <thread>
+#endif
 
 namespace isobus
 {
@@ -43,19 +46,28 @@ namespace isobus
 		return workingSetColourTable.get_colour(colourIndex);
 	}
 
+	const VTObjectTable &VirtualTerminalWorkingSetBase::get_object_table() const
+	{
+		return vtObjectTable;
+	}
+
 	const std::map<std::uint16_t, std::shared_ptr<VTObject>> &VirtualTerminalWorkingSetBase::get_object_tree() const
 	{
-		return vtObjectTree;
+		if (!objectTreeMapValid)
+		{
+			objectTreeMap = vtObjectTable.to_map();
+			objectTreeMapValid = true;
+		}
+		return objectTreeMap;
 	}
 
 	bool VirtualTerminalWorkingSetBase::add_or_replace_object(std::shared_ptr<VTObject> objectToAdd)
 	{
-		bool retVal = false;
+		bool retVal = vtObjectTable.add_or_replace_object(objectToAdd);
 
-		if (nullptr != objectToAdd)
+		if (retVal)
 		{
-			vtObjectTree[objectToAdd->get_id()] = objectToAdd;
-			retVal = true;
+			objectTreeMapValid = false;
 		}
 		return retVal;
 	}
@@ -64,6 +76,41 @@ namespace isobus
 	{
 		bool retVal = false;
 
+		if (iopLength > 3)
+		{
+			auto decodedID = static_cast<uint16_t>(static_cast<std::uint16_t>(iopData[0]) | (static_cast<std::uint16_t>(iopData[1]) << 8));
+			const bool isWorkingSet = (VirtualTerminalObjectType::WorkingSet == static_cast<VirtualTerminalObjectType>(iopData[2]));
+
+			if (isWorkingSet &&
+			    (NULL_OBJECT_ID != workingSetID) &&
+			    ((nullptr == get_object_by_id(workingSetID)) ||
+			     (get_object_by_id(workingSetID)->get_id() != decodedID)))
+			{
+				LOG_ERROR("[WS]: Multiple working set objects are not allowed in the object pool. Faulting object " + isobus::to_string(static_cast<int>(decodedID)));
+			}
+			else
+			{
+				std::shared_ptr<VTObject> parsedObject;
+
+				if (isWorkingSet)
+				{
+					workingSetID = decodedID;
+				}
+				retVal = (parse_object(iopData, iopLength, parsedObject) && add_or_replace_object(parsedObject));
+			}
+
+			if (!retVal)
+			{
+				set_object_pool_faulting_object_id(decodedID);
+			}
+		}
+		return retVal;
+	}
+
+	bool VirtualTerminalWorkingSetBase::parse_object(std::uint8_t *&iopData, std::uint32_t &iopLength, std::shared_ptr<VTObject> &parsedObject) const
+	{
+		bool retVal = false;
+
 		if (iopLength > 3)
 		{
 			// We at least have object ID and type
@@ -74,124 +121,114 @@ namespace isobus
 			{
 				case VirtualTerminalObjectType::WorkingSet:
 				{
-					if ((NULL_OBJECT_ID == workingSetID) ||
-					    ((nullptr != get_object_by_id(workingSetID)) &&
-					     (get_object_by_id(workingSetID)->get_id() == decodedID)))
-					{
-						workingSetID = decodedID;
-						auto tempObject = std::make_shared<WorkingSet>();
+					auto tempObject = std::make_shared<WorkingSet>();
 
-						if (iopLength >= tempObject->get_minumum_object_length())
-						{
-							tempObject->set_id(decodedID);
-							tempObject->set_background_color(iopData[3]);
-							tempObject->set_selectable(iopData[4]);
-							tempObject->set_active_mask(static_cast<std::uint16_t>(iopData[5]) | (static_cast<std::uint16_t>(iopData[6]) << 8));
+					if (iopLength >= tempObject->get_minumum_object_length())
+					{
+						tempObject->set_id(decodedID);
+						tempObject->set_background_color(iopData[3]);
+						tempObject->set_selectable(iopData[4]);
+						tempObject->set_active_mask(static_cast<std::uint16_t>(iopData[5]) | (static_cast<std::uint16_t>(iopData[6]) << 8));
 
-							// Now add child objects
-							const std::uint8_t childrenToFollow = iopData[7];
-							const std::uint16_t sizeOfChildren = (childrenToFollow * 6); // ID, X, Y 2 bytes each
-							const std::uint8_t numberOfMacrosToFollow = iopData[8];
-							const std::uint16_t sizeOfMacros = (numberOfMacrosToFollow * 2);
-							const std::uint8_t numberOfLanguagesToFollow = iopData[9];
-							iopLength -= 10; // Subtract the bytes we've processed so far.
-							iopData += 10; // Move the pointer
+						// Now add child objects
+						const std::uint8_t childrenToFollow = iopData[7];
+						const std::uint16_t sizeOfChildren = (childrenToFollow * 6); // ID, X, Y 2 bytes each
+						const std::uint8_t numberOfMacrosToFollow = iopData[8];
+						const std::uint16_t sizeOfMacros = (numberOfMacrosToFollow * 2);
+						const std::uint8_t numberOfLanguagesToFollow = iopData[9];
+						iopLength -= 10; // Subtract the bytes we've processed so far.
+						iopData += 10; // Move the pointer
 
-							if (iopLength >= sizeOfChildren)
+						if (iopLength >= sizeOfChildren)
+						{
+							for (std::uint_fast8_t i = 0; i < childrenToFollow; i++)
 							{
-								for (std::uint_fast8_t i = 0; i < childrenToFollow; i++)
-								{
-									std::uint16_t childID = (static_cast<std::uint16_t>(iopData[0]) | (static_cast<std::uint16_t>(iopData[1]) << 8));
-									auto childX = static_cast<std::int16_t>(static_cast<std::int16_t>(iopData[2]) | (static_cast<std::int16_t>(iopData[3]) << 8));
-									auto childY = static_cast<std::int16_t>(static_cast<std::int16_t>(iopData[4]) | (static_cast<std::int16_t>(iopData[5]) << 8));
-									tempObject->add_child(childID, childX, childY);
-									iopLength -= 6;
-									iopData += 6;
-								}
+								std::uint16_t childID = (static_cast<std::uint16_t>(iopData[0]) | (static_cast<std::uint16_t>(iopData[1]) << 8));
+								auto childX = static_cast<std::int16_t>(static_cast<std::int16_t>(iopData[2]) | (static_cast<std::int16_t>(iopData[3]) << 8));
+								auto childY = static_cast<std::int16_t>(static_cast<std::int16_t>(iopData[4]) | (static_cast<std::int16_t>(iopData[5]) << 8));
+								tempObject->add_child(childID, childX, childY);
+								iopLength -= 6;
+								iopData += 6;
+							}
 
-								// Next, parse macro list
-								if (iopLength >= sizeOfMacros)
+							// Next, parse macro list
+							if (iopLength >= sizeOfMacros)
+							{
+								for (std::uint_fast8_t i = 0; i < numberOfMacrosToFollow; i++)
 								{
-									for (std::uint_fast8_t i = 0; i < numberOfMacrosToFollow; i++)
+									// If the first byte is 255, then more bytes are used! 4.6.22.3
+									if (iopData[0] == static_cast<std::uint8_t>(EventID::UseExtendedMacroReference))
 									{
-										// If the first byte is 255, then more bytes are used! 4.6.22.3
-										if (iopData[0] == static_cast<std::uint8_t>(EventID::UseExtendedMacroReference))
-										{
-											std::uint16_t macroID = (static_cast<std::uint16_t>(iopData[1]) | (static_cast<std::uint16_t>(iopData[3]) << 8));
+										std::uint16_t macroID = (static_cast<std::uint16_t>(iopData[1]) | (static_cast<std::uint16_t>(iopData[3]) << 8));
 
-											if (EventID::Reserved != get_event_from_byte(iopData[2]))
-											{
-												tempObject->add_macro({ get_event_from_byte(iopData[2]), macroID });
-												retVal = true;
-											}
-											else
-											{
-												LOG_ERROR("[WS]: Macro with ID %u which is listed as part of object %u has an invalid or unsupported event ID.", macroID, decodedID);
-												retVal = false;
-												break;
-											}
+										if (EventID::Reserved != get_event_from_byte(iopData[2]))
+										{
+											tempObject->add_macro({ get_event_from_byte(iopData[2]), macroID });
+											retVal = true;
 										}
 										else
 										{
-											if (EventID::Reserved != get_event_from_byte(iopData[0]))
-											{
-												tempObject->add_macro({ get_event_from_byte(iopData[0]), iopData[1] });
-												retVal = true;
-											}
-											else
-											{
-												LOG_ERROR("[WS]: Macro with ID %u which is listed as part of object %u has an invalid or unsupported event ID.", iopData[1], decodedID);
-												retVal = false;
-												break;
-											}
+											LOG_ERROR("[WS]: Macro with ID %u which is listed as part of object %u has an invalid or unsupported event ID.", macroID, decodedID);
+											retVal = false;
+											break;
 										}
-
-										iopLength -= 2;
-										iopData += 2;
 									}
-
-									// Next, parse language list
-									if (iopLength >= static_cast<uint16_t>(numberOfLanguagesToFollow * 2))
+									else
 									{
-										for (std::uint_fast8_t i = 0; i < numberOfLanguagesToFollow; i++)
+										if (EventID::Reserved != get_event_from_byte(iopData[0]))
 										{
-											std::string langCode;
-											langCode.push_back(static_cast<char>(iopData[0]));
-											langCode.push_back(static_cast<char>(iopData[1]));
-											iopLength -= 2;
-											iopData += 2;
-											LOG_DEBUG("[WS]: IOP Language parsed: " + langCode);
+											tempObject->add_macro({ get_event_from_byte(iopData[0]), iopData[1] });
+											retVal = true;
+										}
+										else
+										{
+											LOG_ERROR("[WS]: Macro with ID %u which is listed as part of object %u has an invalid or unsupported event ID.", iopData[1], decodedID);
+											retVal = false;
+											break;
 										}
 									}
-									else
+
+									iopLength -= 2;
+									iopData += 2;
+								}
+
+								// Next, parse language list
+								if (iopLength >= static_cast<uint16_t>(numberOfLanguagesToFollow * 2))
+								{
+									for (std::uint_fast8_t i = 0; i < numberOfLanguagesToFollow; i++)
 									{
-										LOG_ERROR("[WS]: Not enough IOP data to parse working set language codes for object " + isobus::to_string(static_cast<int>(decodedID)));
+										std::string langCode;
+										langCode.push_back(static_cast<char>(iopData[0]));
+										langCode.push_back(static_cast<char>(iopData[1]));
+										iopLength -= 2;
+										iopData += 2;
+										LOG_DEBUG("[WS]: IOP Language parsed: " + langCode);
 									}
-									retVal = true;
 								}
 								else
 								{
-									LOG_ERROR("[WS]: Not enough IOP data to parse working set macros for object " + isobus::to_string(static_cast<int>(decodedID)));
+									LOG_ERROR("[WS]: Not enough IOP data to parse working set language codes for object " + isobus::to_string(static_cast<int>(decodedID)));
 								}
+								retVal = true;
 							}
 							else
 							{
-								LOG_ERROR("[WS]: Not enough IOP data to parse working set children for object " + isobus::to_string(static_cast<int>(decodedID)));
+								LOG_ERROR("[WS]: Not enough IOP data to parse working set macros for object " + isobus::to_string(static_cast<int>(decodedID)));
 							}
 						}
 						else
 						{
-							LOG_ERROR("[WS]: Not enough IOP data to parse working set object " + isobus::to_string(static_cast<int>(decodedID)));
-						}
-
-						if (retVal)
-						{
-							retVal = add_or_replace_object(tempObject);
+							LOG_ERROR("[WS]: Not enough IOP data to parse working set children for object " + isobus::to_string(static_cast<int>(decodedID)));
 						}
 					}
 					else
 					{
-						LOG_ERROR("[WS]: Multiple working set objects are not allowed in the object pool. Faulting object " + isobus::to_string(static_cast<int>(decodedID)));
+						LOG_ERROR("[WS]: Not enough IOP data to parse working set object " + isobus::to_string(static_cast<int>(decodedID)));
+					}
+
+					if (retVal)
+					{
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -288,7 +325,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -408,7 +445,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -515,7 +552,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -711,7 +748,7 @@ namespace isobus
 
 							if (retVal)
 							{
-								retVal = add_or_replace_object(tempObject);
+								parsedObject = tempObject;
 							}
 						}
 					}
@@ -814,7 +851,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -913,7 +950,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -974,7 +1011,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1040,7 +1077,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1084,7 +1121,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1150,7 +1187,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1227,7 +1264,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1288,7 +1325,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1352,7 +1389,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1421,7 +1458,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1477,7 +1514,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1528,7 +1565,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1571,7 +1608,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1624,7 +1661,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1692,7 +1729,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1738,7 +1775,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1783,7 +1820,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1830,7 +1867,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -1873,155 +1910,18 @@ namespace isobus
 							iopData += 17;
 							iopLength -= 17;
 
-							if (tempObject->get_option(PictureGraphic::Options::RunLengthEncoded))
+							if (iopLength < tempObject->get_number_of_bytes_in_raw_data())
 							{
-								if (0 != (tempObject->get_number_of_bytes_in_raw_data() % 2))
-								{
-									LOG_ERROR("[WS]: Picture graphic has RLE but an odd number of data bytes. Object: " + isobus::to_string(static_cast<int>(decodedID)));
-								}
-								else
-								{
-									// Decode the RLE
-									std::size_t lineAmountLeft = tempObject->get_actual_width();
-									for (std::uint_fast32_t i = 0; i < (tempObject->get_number_of_bytes_in_raw_data() / 2); i++)
-									{
-										for (std::size_t j = 0; j < iopData[0]; j++)
-										{
-											switch (tempObject->get_format())
-											{
-												case PictureGraphic::Format::EightBitColour:
-												{
-													tempObject->add_raw_data(iopData[1]);
-												}
-												break;
-
-												case PictureGraphic::Format::FourBitColour:
-												{
-													tempObject->add_raw_data(iopData[1] >> 4);
-													lineAmountLeft--;
-
-													if (lineAmountLeft > 0)
-													{
-														//Unused bits at the end of a line are ignored.
-														tempObject->add_raw_data(iopData[1] & 0x0F);
-														lineAmountLeft--;
-
-														if (0 == lineAmountLeft)
-														{
-															lineAmountLeft = tempObject->get_actual_width();
-														}
-													}
-													else
-													{
-														lineAmountLeft = tempObject->get_actual_width();
-													}
-												}
-												break;
-
-												case PictureGraphic::Format::Monochrome:
-												{
-													for (std::uint_fast8_t k = 0; k < 8U; k++)
-													{
-														tempObject->add_raw_data(static_cast<std::uint8_t>(0 != ((iopData[1]) & (1 << (7 - k)))));
-														lineAmountLeft--;
-
-														if (0 == lineAmountLeft)
-														{
-															break;
-														}
-													}
-
-													if (0 == lineAmountLeft)
-													{
-														lineAmountLeft = tempObject->get_actual_width();
-													}
-												}
-												break;
-
-												default:
-													break;
-											}
-										}
-										iopData += 2;
-										iopLength -= 2;
-									}
-								}
+								LOG_ERROR("[WS]: Not enough IOP data to deserialize picture graphic's pixel data. Object: " + isobus::to_string(static_cast<int>(decodedID)));
+							}
+							else if (tempObject->decode_raw_data(iopData, tempObject->get_number_of_bytes_in_raw_data()))
+							{
+								iopData += tempObject->get_number_of_bytes_in_raw_data();
+								iopLength -= tempObject->get_number_of_bytes_in_raw_data();
 							}
 							else
 							{
-								if (iopLength >= tempObject->get_number_of_bytes_in_raw_data())
-								{
-									switch (tempObject->get_format())
-									{
-										case PictureGraphic::Format::EightBitColour:
-										{
-											tempObject->set_raw_data(iopData, tempObject->get_number_of_bytes_in_raw_data());
-											iopData += tempObject->get_number_of_bytes_in_raw_data();
-											iopLength -= tempObject->get_number_of_bytes_in_raw_data();
-										}
-										break;
-
-										case PictureGraphic::Format::FourBitColour:
-										{
-											std::size_t lineAmountLeft = tempObject->get_actual_width();
-
-											for (std::uint_fast32_t i = 0; i < tempObject->get_number_of_bytes_in_raw_data(); i++)
-											{
-												tempObject->add_raw_data(iopData[0] >> 4);
-												lineAmountLeft--;
-
-												if (lineAmountLeft > 0)
-												{
-													tempObject->add_raw_data(iopData[0] & 0x0F);
-													lineAmountLeft--;
-
-													if (0 == lineAmountLeft)
-													{
-														lineAmountLeft = tempObject->get_actual_width();
-													}
-												}
-												else
-												{
-													lineAmountLeft = tempObject->get_actual_width();
-												}
-												iopData++;
-												iopLength--;
-											}
-										}
-										break;
-
-										case PictureGraphic::Format::Monochrome:
-										{
-											std::size_t lineAmountLeft = tempObject->get_actual_width();
-
-											for (std::uint_fast32_t i = 0; i < tempObject->get_number_of_bytes_in_raw_data(); i++)
-											{
-												for (std::uint_fast8_t j = 0; j < 8U; j++)
-												{
-													tempObject->add_raw_data(static_cast<std::uint8_t>(0 != ((iopData[0]) & (1 << (7 - j)))));
-													lineAmountLeft--;
-
-													if (0 == lineAmountLeft)
-													{
-														break;
-													}
-												}
-
-												if (0 == lineAmountLeft)
-												{
-													lineAmountLeft = tempObject->get_actual_width();
-												}
-												iopData++;
-												iopLength--;
-											}
-										}
-										break;
-									}
-								}
-								else
-								{
-									LOG_ERROR("[WS]: Not enough IOP data to deserialize picture graphic's pixel data. Object: " + isobus::to_string(static_cast<int>(decodedID)));
-								}
+								LOG_ERROR("[WS]: Picture graphic has RLE but an odd number of data bytes. Object: " + isobus::to_string(static_cast<int>(decodedID)));
 							}
 
 							if (iopLength >= sizeOfMacros)
@@ -2054,7 +1954,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2081,7 +1981,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2124,7 +2024,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2172,7 +2072,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2209,7 +2109,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2254,7 +2154,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2321,7 +2221,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2355,7 +2255,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2375,7 +2275,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2405,7 +2305,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2529,7 +2429,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2585,7 +2485,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2650,7 +2550,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2711,7 +2611,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2775,7 +2675,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2808,7 +2708,7 @@ namespace isobus
 
 					if (retVal)
 					{
-						retVal = add_or_replace_object(tempObject);
+						parsedObject = tempObject;
 					}
 				}
 				break;
@@ -2819,18 +2719,13 @@ namespace isobus
 				}
 				break;
 			}
-
-			if (!retVal)
-			{
-				set_object_pool_faulting_object_id(decodedID);
-			}
 		}
 		return retVal;
 	}
 
 	std::shared_ptr<VTObject> VirtualTerminalWorkingSetBase::get_object_by_id(std::uint16_t objectID)
 	{
-		return vtObjectTree[objectID];
+		return vtObjectTable.get_object_by_id(objectID);
 	}
 
 	std::shared_ptr<VTObject> VirtualTerminalWorkingSetBase::get_working_set_object()
@@ -2840,17 +2735,7 @@ namespace isobus
 
 	bool VirtualTerminalWorkingSetBase::get_object_id_exists(std::uint16_t objectID)
 	{
-		bool retVal;
-
-		if (vtObjectTree.find(objectID) == vtObjectTree.end())
-		{
-			retVal = false;
-		}
-		else
-		{
-			retVal = (nullptr != vtObjectTree[objectID]);
-		}
-		return retVal;
+		return vtObjectTable.get_object_id_exists(objectID);
 	}
 
 	EventID VirtualTerminalWorkingSetBase::get_event_from_byte(std::uint8_t eventByte)
@@ -2899,6 +2784,12 @@ namespace isobus
 	}
 
 	bool VirtualTerminalWorkingSetBase::parse_iop_into_objects(std::uint8_t *iopData, std::uint32_t iopLength)
+	{
+		std::vector<std::shared_ptr<VTObject>> parsedObjects;
+		return parse_iop_into_objects(iopData, iopLength, parsedObjects);
+	}
+
+	bool VirtualTerminalWorkingSetBase::parse_iop_into_objects(std::uint8_t *iopData, std::uint32_t iopLength, std::vector<std::shared_ptr<VTObject>> &parsedObjects)
 	{
 		uint32_t remainingLength = iopLength;
 		std::uint8_t *currentIopPointer = iopData;
@@ -2906,9 +2797,66 @@ namespace isobus
 
 		if (iopLength > 0)
 		{
+			// First find where each object is, then construct them independently of each other, and
+			// finally add them to the object table in pool order. Anything the scan or construction
+			// couldn't handle is left to the object-by-object parser below, which does the error reporting.
+			std::vector<IopObjectLocation> objectLocations;
+			scan_iop_objects(iopData, iopLength, objectLocations);
+
+			parsedObjects.clear();
+			if (!objectLocations.empty())
+			{
+				parsedObjects.resize(objectLocations.size());
+				std::atomic<std::size_t> nextObjectIndex(0);
+				std::atomic<std::size_t> firstFailedObjectIndex(objectLocations.size());
+
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+				std::size_t numberOfThreads = std::thread::hardware_concurrency();
+
+				if (numberOfThreads > (objectLocations.size() / MINIMUM_OBJECTS_PER_PARSING_THREAD))
+				{
+					numberOfThreads = objectLocations.size() / MINIMUM_OBJECTS_PER_PARSING_THREAD;
+				}
+
+				std::vector<std::thread> parsingThreads;
+				for (std::size_t i = 1; i < numberOfThreads; i++)
+				{
+					parsingThreads.emplace_back([&]() {
+						parse_scanned_objects(iopData, iopLength, objectLocations, parsedObjects, nextObjectIndex, firstFailedObjectIndex);
+					});
+				}
+#endif
+				parse_scanned_objects(iopData, iopLength, objectLocations, parsedObjects, nextObjectIndex, firstFailedObjectIndex);
+#if !defined CAN_STACK_DISABLE_THREADS && !defined ARDUINO
+				for (auto &thread : parsingThreads)
+				{
+					thread.join();
+				}
+#endif
+
+				const std::size_t numberOfAddedObjects = add_parsed_objects(parsedObjects, firstFailedObjectIndex);
+				parsedObjects.resize(numberOfAddedObjects);
+
+				if (numberOfAddedObjects < objectLocations.size())
+				{
+					currentIopPointer = iopData + objectLocations[numberOfAddedObjects].offset;
+				}
+				else
+				{
+					currentIopPointer = iopData + objectLocations.back().offset + objectLocations.back().length;
+				}
+				remainingLength = iopLength - static_cast<std::uint32_t>(currentIopPointer - iopData);
+			}
+
 			while (remainingLength > 0)
 			{
-				if (!parse_next_object(currentIopPointer, remainingLength))
+				const std::uint16_t objectID = (remainingLength > 1) ? static_cast<std::uint16_t>(static_cast<std::uint16_t>(currentIopPointer[0]) | (static_cast<std::uint16_t>(currentIopPointer[1]) << 8)) : NULL_OBJECT_ID;
+
+				if (parse_next_object(currentIopPointer, remainingLength))
+				{
+					parsedObjects.push_back(get_object_by_id(objectID));
+				}
+				else
 				{
 					LOG_ERROR("[WS]: Parsing object pool failed.");
 					retVal = false;
@@ -2923,6 +2871,367 @@ namespace isobus
 		return retVal;
 	}
 
+	std::uint32_t VirtualTerminalWorkingSetBase::get_serialized_object_length(const std::uint8_t *iopData, std::uint32_t iopLength)
+	{
+		std::uint32_t retVal = 0;
+
+		if (iopLength > 3)
+		{
+			switch (static_cast<VirtualTerminalObjectType>(iopData[2]))
+			{
+				case VirtualTerminalObjectType::WorkingSet:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 10, { { 7, 6 }, { 8, 2 }, { 9, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::DataMask:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 8, { { 6, 6 }, { 7, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::AlarmMask:
+				case VirtualTerminalObjectType::Container:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 10, { { 8, 6 }, { 9, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::WindowMask:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 17, { { 14, 2 }, { 15, 6 }, { 16, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::SoftKeyMask:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 6, { { 4, 2 }, { 5, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::Key:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 7, { { 5, 6 }, { 6, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::Button:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 13, { { 11, 6 }, { 12, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::KeyGroup:
+				{
+					// Children, then a macro count
+					const std::uint32_t macroCountOffset = get_counted_object_length(iopData, iopLength, 9, { { 8, 2 } });
+
+					if ((0 != macroCountOffset) && (iopLength > macroCountOffset))
+					{
+						retVal = macroCountOffset + 1 + (2 * static_cast<std::uint32_t>(iopData[macroCountOffset]));
+					}
+				}
+				break;
+
+				case VirtualTerminalObjectType::InputBoolean:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 13, { { 12, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::InputString:
+				{
+					// A string, an enabled byte, then a macro count
+					if (iopLength > 16)
+					{
+						const std::uint32_t macroCountOffset = 18 + static_cast<std::uint32_t>(iopData[16]);
+
+						if (iopLength > macroCountOffset)
+						{
+							retVal = macroCountOffset + 1 + (2 * static_cast<std::uint32_t>(iopData[macroCountOffset]));
+						}
+					}
+				}
+				break;
+
+				case VirtualTerminalObjectType::InputNumber:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 38, { { 37, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::InputList:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 13, { { 10, 2 }, { 12, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputString:
+				{
+					// A string with a 16 bit length, then a macro count
+					if (iopLength > 15)
+					{
+						const std::uint32_t macroCountOffset = 16 + (static_cast<std::uint32_t>(iopData[14]) | (static_cast<std::uint32_t>(iopData[15]) << 8));
+
+						if (iopLength > macroCountOffset)
+						{
+							retVal = macroCountOffset + 1 + (2 * static_cast<std::uint32_t>(iopData[macroCountOffset]));
+						}
+					}
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputNumber:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 29, { { 28, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputList:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 12, { { 10, 2 }, { 11, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputLine:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 11, { { 10, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputRectangle:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 13, { { 12, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputEllipse:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 15, { { 14, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputPolygon:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 14, { { 12, 4 }, { 13, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputMeter:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 21, { { 20, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputLinearBarGraph:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 24, { { 23, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::OutputArchedBarGraph:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 27, { { 26, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::PictureGraphic:
+				{
+					// Raw data with a 32 bit length, then the macros
+					retVal = get_counted_object_length(iopData, iopLength, 17, { { 16, 2 } });
+
+					if (0 != retVal)
+					{
+						const std::uint64_t totalLength = static_cast<std::uint64_t>(retVal) +
+						  (static_cast<std::uint32_t>(iopData[12]) |
+						   (static_cast<std::uint32_t>(iopData[13]) << 8) |
+						   (static_cast<std::uint32_t>(iopData[14]) << 16) |
+						   (static_cast<std::uint32_t>(iopData[15]) << 24));
+						retVal = (totalLength <= iopLength) ? static_cast<std::uint32_t>(totalLength) : 0;
+					}
+				}
+				break;
+
+				case VirtualTerminalObjectType::NumberVariable:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 7, {});
+				}
+				break;
+
+				case VirtualTerminalObjectType::StringVariable:
+				case VirtualTerminalObjectType::Macro:
+				{
+					// A 16 bit number of bytes to follow
+					if (iopLength > 4)
+					{
+						retVal = 5 + (static_cast<std::uint32_t>(iopData[3]) | (static_cast<std::uint32_t>(iopData[4]) << 8));
+					}
+				}
+				break;
+
+				case VirtualTerminalObjectType::FontAttributes:
+				case VirtualTerminalObjectType::LineAttributes:
+				case VirtualTerminalObjectType::FillAttributes:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 8, { { 7, 2 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::InputAttributes:
+				{
+					// A validation string, then a macro count
+					if (iopLength > 4)
+					{
+						const std::uint32_t macroCountOffset = 5 + static_cast<std::uint32_t>(iopData[4]);
+
+						if (iopLength > macroCountOffset)
+						{
+							retVal = macroCountOffset + 1 + (2 * static_cast<std::uint32_t>(iopData[macroCountOffset]));
+						}
+					}
+				}
+				break;
+
+				case VirtualTerminalObjectType::ObjectPointer:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 5, {});
+				}
+				break;
+
+				case VirtualTerminalObjectType::AuxiliaryFunctionType1:
+				case VirtualTerminalObjectType::AuxiliaryFunctionType2:
+				case VirtualTerminalObjectType::AuxiliaryInputType2:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 6, { { 5, 6 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::AuxiliaryInputType1:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 7, { { 6, 6 } });
+				}
+				break;
+
+				case VirtualTerminalObjectType::AuxiliaryControlDesignatorType2:
+				{
+					retVal = get_counted_object_length(iopData, iopLength, 6, {});
+				}
+				break;
+
+				default:
+				{
+					// Unsupported objects are left to the object-by-object parser so it can report them
+				}
+				break;
+			}
+		}
+
+		if (retVal > iopLength)
+		{
+			retVal = 0;
+		}
+		return retVal;
+	}
+
+	std::uint32_t VirtualTerminalWorkingSetBase::get_counted_object_length(const std::uint8_t *iopData,
+	                                                                        std::uint32_t iopLength,
+	                                                                        std::uint32_t fixedLength,
+	                                                                        std::initializer_list<std::pair<std::uint8_t, std::uint8_t>> countedFields)
+	{
+		std::uint32_t retVal = 0;
+
+		if (iopLength >= fixedLength)
+		{
+			retVal = fixedLength;
+
+			for (const auto &countedField : countedFields)
+			{
+				retVal += static_cast<std::uint32_t>(iopData[countedField.first]) * countedField.second;
+			}
+		}
+		return retVal;
+	}
+
+	void VirtualTerminalWorkingSetBase::scan_iop_objects(const std::uint8_t *iopData, std::uint32_t iopLength, std::vector<IopObjectLocation> &objectLocations)
+	{
+		std::uint32_t offset = 0;
+
+		while (offset < iopLength)
+		{
+			const std::uint32_t objectLength = get_serialized_object_length(iopData + offset, iopLength - offset);
+
+			if (0 == objectLength)
+			{
+				break;
+			}
+			objectLocations.push_back({ offset, objectLength });
+			offset += objectLength;
+		}
+	}
+
+	void VirtualTerminalWorkingSetBase::parse_scanned_objects(std::uint8_t *iopData,
+	                                                          std::uint32_t iopLength,
+	                                                          const std::vector<IopObjectLocation> &objectLocations,
+	                                                          std::vector<std::shared_ptr<VTObject>> &parsedObjects,
+	                                                          std::atomic<std::size_t> &nextObjectIndex,
+	                                                          std::atomic<std::size_t> &firstFailedObjectIndex) const
+	{
+		std::size_t blockStart = nextObjectIndex.fetch_add(PARSE_BLOCK_SIZE);
+
+		while (blockStart < firstFailedObjectIndex)
+		{
+			const std::size_t blockEnd = ((blockStart + PARSE_BLOCK_SIZE) < objectLocations.size()) ? (blockStart + PARSE_BLOCK_SIZE) : objectLocations.size();
+
+			for (std::size_t i = blockStart; i < blockEnd; i++)
+			{
+				std::uint8_t *objectData = iopData + objectLocations[i].offset;
+				std::uint32_t remainingLength = iopLength - objectLocations[i].offset;
+
+				// The object must also use exactly the bytes the scan found for it, otherwise the scan was wrong about where the next objects are
+				if ((!parse_object(objectData, remainingLength, parsedObjects[i])) ||
+				    (objectData != (iopData + objectLocations[i].offset + objectLocations[i].length)))
+				{
+					std::size_t lowestFailedIndex = firstFailedObjectIndex;
+
+					while ((i < lowestFailedIndex) && (!firstFailedObjectIndex.compare_exchange_weak(lowestFailedIndex, i)))
+					{
+						// Another thread reported a failure at the same time, retry against its index
+					}
+					break;
+				}
+			}
+			blockStart = nextObjectIndex.fetch_add(PARSE_BLOCK_SIZE);
+		}
+	}
+
+	std::size_t VirtualTerminalWorkingSetBase::add_parsed_objects(const std::vector<std::shared_ptr<VTObject>> &parsedObjects, std::size_t numberOfObjects)
+	{
+		std::size_t retVal = numberOfObjects;
+
+		for (std::size_t i = 0; i < numberOfObjects; i++)
+		{
+			const std::uint16_t objectID = parsedObjects[i]->get_id();
+
+			if (VirtualTerminalObjectType::WorkingSet == parsedObjects[i]->get_object_type())
+			{
+				if ((NULL_OBJECT_ID == workingSetID) ||
+				    ((workingSetID == objectID) && get_object_id_exists(workingSetID)))
+				{
+					workingSetID = objectID;
+				}
+				else
+				{
+					// Leave the rest to the object-by-object parser, which will report the fault
+					retVal = i;
+					break;
+				}
+			}
+			add_or_replace_object(parsedObjects[i]);
+		}
+		return retVal;
+	}
+
 	void VirtualTerminalWorkingSetBase::set_object_pool_faulting_object_id(std::uint16_t value)
 	{
 		const std::lock_guard<std::mutex> lock(managedWorkingSetMutex);
@@ -20,6 +20,7 @@
 #include "isobus/utility/system_timing.hpp"
 
 #include <algorithm>
+#include <limits>
 
 namespace isobus
 {
@@ -102,8 +103,12 @@ namespace isobus
 		return numberOfFrames;
 	}
 
-	FastPacketProtocol::FastPacketProtocol(const CANMessageFrameCallback &sendCANFrameCallback) :
-	  sendCANFrameCallback(sendCANFrameCallback)
+	FastPacketProtocol::FastPacketProtocol(const CANMessageFrameCallback &sendCANFrameCallback,
+	                                       TransportProtocolMemoryBudget *memoryBudget,
+	                                       TransportProtocolTransmitScheduler *transmitScheduler) :
+	  sendCANFrameCallback(sendCANFrameCallback),
+	  memoryBudget(memoryBudget),
+	  transmitScheduler(transmitScheduler)
 	{
 	}
 
@@ -183,7 +188,13 @@ namespace isobus
 		                                                           parentPointer);
 
 		LOCK_GUARD(Mutex, sessionMutex);
-		activeSessions.push_back(session);
+		activeSessions.add(session);
+		if (nullptr != transmitScheduler)
+		{
+			transmitScheduler->add(session, priority, [this](const std::shared_ptr<TransportProtocolSessionBase> &scheduledSession, std::uint32_t maximumFrames) {
+				return transmit_scheduled_frames(std::static_pointer_cast<FastPacketProtocolSession>(scheduledSession), maximumFrames);
+			});
+		}
 		return true;
 	}
 
@@ -208,32 +219,27 @@ namespace isobus
 		}
 	}
 
-	void FastPacketProtocol::add_session_history(const std::shared_ptr<FastPacketProtocolSession> &session)
+	std::uint32_t FastPacketProtocol::get_time_until_next_deadline_ms() const
 	{
-		if (nullptr != session)
-		{
-			bool formerSessionMatched = false;
+		LOCK_GUARD(Mutex, sessionMutex);
+		std::uint32_t retVal = std::numeric_limits<std::uint32_t>::max();
 
-			for (auto &formerSessions : sessionHistory)
+		// Transmitting sessions only time out while they can't send, which the regular updates retry anyway
+		for (const auto &session : activeSessions.get_sessions())
+		{
+			if (FastPacketProtocolSession::Direction::Receive == session->get_direction())
 			{
-				if ((formerSessions.isoName == session->get_source()->get_NAME()) &&
-				    (formerSessions.parameterGroupNumber == session->get_parameter_group_number()))
-				{
-					formerSessions.sequenceNumber = session->sequenceNumber;
-					formerSessionMatched = true;
-					break;
-				}
+				retVal = std::min(retVal, session->get_time_until_elapsed(FP_TIMEOUT_MS + 1));
 			}
+		}
+		return retVal;
+	}
 
-			if (!formerSessionMatched)
-			{
-				FastPacketHistory history{
-					session->get_source()->get_NAME(),
-					session->get_parameter_group_number(),
-					session->sequenceNumber
-				};
-				sessionHistory.push_back(history);
-			}
+	void FastPacketProtocol::add_session_history(const std::shared_ptr<FastPacketProtocolSession> &session)
+	{
+		if (nullptr != session)
+		{
+			sessionHistory[std::make_pair(session->get_source()->get_NAME().get_full_name(), session->get_parameter_group_number())] = session->sequenceNumber;
 		}
 	}
 
@@ -244,24 +250,27 @@ namespace isobus
 			session->complete(successful);
 			add_session_history(session);
 
-			auto sessionLocation = std::find(activeSessions.begin(), activeSessions.end(), session);
-			if (activeSessions.end() != sessionLocation)
+			if (nullptr != memoryBudget)
 			{
-				activeSessions.erase(sessionLocation);
+				memoryBudget->release(*session);
 			}
+
+			if (nullptr != transmitScheduler)
+			{
+				transmitScheduler->remove(*session);
+			}
+
+			activeSessions.remove(session);
 		}
 	}
 
 	std::uint8_t FastPacketProtocol::get_new_sequence_number(NAME name, std::uint32_t parameterGroupNumber) const
 	{
 		std::uint8_t sequenceNumber = 0;
-		for (const auto &formerSessions : sessionHistory)
+		auto formerSession = sessionHistory.find(std::make_pair(name.get_full_name(), parameterGroupNumber));
+		if (sessionHistory.end() != formerSession)
 		{
-			if ((formerSessions.isoName == name) && (formerSessions.parameterGroupNumber == parameterGroupNumber))
-			{
-				sequenceNumber = formerSessions.sequenceNumber + 1;
-				break;
-			}
+			sequenceNumber = formerSession->second + 1;
 		}
 		return sequenceNumber;
 	}
@@ -331,7 +340,7 @@ namespace isobus
 				{
 					if (session->numberOfBytesTransferred < session->get_message_length())
 					{
-						data.set_byte(session->numberOfBytesTransferred, message.get_uint8_at(1 + i));
+						data.push_back(message.get_uint8_at(1 + i));
 						session->add_number_of_bytes_transferred(1);
 					}
 					else
@@ -392,7 +401,7 @@ namespace isobus
 
 				// Create a new session
 				session = std::make_shared<FastPacketProtocolSession>(FastPacketProtocolSession::Direction::Receive,
-				                                                      std::unique_ptr<CANMessageData>(new CANMessageDataVector(messageLength)),
+				                                                      std::unique_ptr<CANMessageData>(new CANMessageDataVector(0)), // Grown once admitted
 				                                                      message.get_identifier().get_parameter_group_number(),
 				                                                      messageLength,
 				                                                      (message.get_uint8_at(0) & SEQUENCE_NUMBER_BIT_MASK),
@@ -402,17 +411,25 @@ namespace isobus
 				                                                      nullptr, // No callback
 				                                                      nullptr);
 
+				if (!session->grow_receive_buffer(memoryBudget, messageLength))
+				{
+					LOG_WARNING("[FP]: Ignoring new FP session with PGN %u, not enough receive memory available for %u bytes.",
+					            message.get_identifier().get_parameter_group_number(),
+					            messageLength);
+					return;
+				}
+
 				// Save the 6 bytes of payload in this first message
 				// Convert data type to a vector to allow for manipulation
 				auto &data = static_cast<CANMessageDataVector &>(session->get_data());
 				for (std::uint8_t i = 0; i < (PROTOCOL_BYTES_PER_FRAME - 1); i++)
 				{
-					data.set_byte(session->numberOfBytesTransferred, message.get_uint8_at(2 + i));
+					data.push_back(message.get_uint8_at(2 + i));
 					session->add_number_of_bytes_transferred(1);
 				}
 
 				LOCK_GUARD(Mutex, sessionMutex);
-				activeSessions.push_back(session);
+				activeSessions.add(session);
 			}
 		}
 	}
@@ -433,70 +450,82 @@ namespace isobus
 				close_session(session, false);
 			}
 		}
+		else if ((nullptr != transmitScheduler) && transmitScheduler->is_enabled())
+		{
+			// The transmit scheduler sends the frames, shared with the other sessions of the CAN port
+		}
 		else
 		{
-			std::array<std::uint8_t, CAN_DATA_LENGTH> buffer;
 			// We are transmitting a message, let's try and send remaining packets
-			for (std::uint8_t i = 0; i < session->get_number_of_remaining_packets(); i++)
-			{
-				buffer[0] = session->get_last_packet_number();
-				buffer[0] |= (session->sequenceNumber << SEQUENCE_NUMBER_BIT_OFFSET);
+			send_frames(session, session->get_number_of_remaining_packets());
+		}
+	}
 
-				std::uint8_t startIndex = 1;
-				std::uint8_t bytesThisFrame = PROTOCOL_BYTES_PER_FRAME;
-				if (0 == session->get_total_bytes_transferred())
-				{
-					// This is the first frame, so we need to send the message length
-					buffer[1] = session->get_message_length();
-					startIndex++;
-					bytesThisFrame--;
-				}
+	std::uint8_t FastPacketProtocol::send_frames(const std::shared_ptr<FastPacketProtocolSession> &session, std::uint8_t maximumFrames)
+	{
+		std::array<std::uint8_t, CAN_DATA_LENGTH> buffer;
+		std::uint8_t framesSent = 0;
 
-				for (std::uint8_t j = 0; j < bytesThisFrame; j++)
-				{
-					std::uint8_t index = static_cast<std::uint8_t>(session->get_total_bytes_transferred()) + j;
-					if (index < session->get_message_length())
-					{
-						buffer[startIndex + j] = session->get_data().get_byte(index);
-					}
-					else
-					{
-						buffer[startIndex + j] = 0xFF;
-					}
-				}
+		while ((framesSent < maximumFrames) && (session->get_number_of_remaining_packets() > 0))
+		{
+			buffer[0] = session->get_last_packet_number();
+			buffer[0] |= (session->sequenceNumber << SEQUENCE_NUMBER_BIT_OFFSET);
 
-				if (sendCANFrameCallback(session->get_parameter_group_number(),
-				                         CANDataSpan(buffer.data(), buffer.size()),
-				                         std::static_pointer_cast<InternalControlFunction>(session->get_source()),
-				                         session->get_destination(),
-				                         session->priority))
-				{
-					session->add_number_of_bytes_transferred(bytesThisFrame);
-				}
-				else
-				{
-					if (session->get_time_since_last_update() > FP_TIMEOUT_MS)
-					{
-						LOG_ERROR("[FP]: Tx session timed out.");
-						close_session(session, false);
-					}
-					break;
-				}
+			std::uint8_t startIndex = 1;
+			std::uint8_t bytesThisFrame = PROTOCOL_BYTES_PER_FRAME;
+			if (0 == session->get_total_bytes_transferred())
+			{
+				// This is the first frame, so we need to send the message length
+				buffer[1] = session->get_message_length();
+				startIndex++;
+				bytesThisFrame--;
 			}
 
-			if (session->get_number_of_remaining_packets() == 0)
+			const std::uint8_t dataOffset = static_cast<std::uint8_t>(session->get_total_bytes_transferred());
+			std::size_t bytesCopied = 0;
+			if (dataOffset < session->get_message_length())
 			{
-				close_session(session, true);
+				bytesCopied = session->get_data().copy_range(dataOffset, &buffer[startIndex], std::min<std::size_t>(bytesThisFrame, session->get_message_length() - dataOffset));
 			}
+			std::fill(buffer.begin() + startIndex + bytesCopied, buffer.end(), 0xFF);
+
+			if (sendCANFrameCallback(session->get_parameter_group_number(),
+			                         CANDataSpan(buffer.data(), buffer.size()),
+			                         std::static_pointer_cast<InternalControlFunction>(session->get_source()),
+			                         session->get_destination(),
+			                         session->priority))
+			{
+				session->add_number_of_bytes_transferred(bytesThisFrame);
+				framesSent++;
+			}
+			else
+			{
+				if (session->get_time_since_last_update() > FP_TIMEOUT_MS)
+				{
+					LOG_ERROR("[FP]: Tx session timed out.");
+					close_session(session, false);
+				}
+				break;
+			}
+		}
+
+		if (session->get_number_of_remaining_packets() == 0)
+		{
+			close_session(session, true);
 		}
+		return framesSent;
+	}
+
+	std::uint32_t FastPacketProtocol::transmit_scheduled_frames(const std::shared_ptr<FastPacketProtocolSession> &session, std::uint32_t maximumFrames)
+	{
+		LOCK_GUARD(Mutex, sessionMutex);
+		return send_frames(session, static_cast<std::uint8_t>(std::min<std::uint32_t>(maximumFrames, session->get_number_of_remaining_packets())));
 	}
 
 	bool FastPacketProtocol::has_session(std::uint32_t parameterGroupNumber, std::shared_ptr<ControlFunction> source, std::shared_ptr<ControlFunction> destination)
 	{
 		LOCK_GUARD(Mutex, sessionMutex);
-		return std::any_of(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<FastPacketProtocolSession> &session) {
-			return session->matches(source, destination) && (session->get_parameter_group_number() == parameterGroupNumber);
-		});
+		return (nullptr != activeSessions.find(source, destination, parameterGroupNumber));
 	}
 
 	std::shared_ptr<FastPacketProtocol::FastPacketProtocolSession> FastPacketProtocol::get_session(std::uint32_t parameterGroupNumber,
@@ -504,10 +533,7 @@ namespace isobus
 	                                                                                               std::shared_ptr<ControlFunction> destination)
 	{
 		LOCK_GUARD(Mutex, sessionMutex);
-		auto result = std::find_if(activeSessions.begin(), activeSessions.end(), [&](const std::shared_ptr<FastPacketProtocolSession> &session) {
-			return session->matches(source, destination) && (session->get_parameter_group_number() == parameterGroupNumber);
-		});
-		return (activeSessions.end() != result) ? (*result) : nullptr;
+		return activeSessions.find(source, destination, parameterGroupNumber);
 	}
 
 } // namespace isobus
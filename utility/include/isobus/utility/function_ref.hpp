@@ -0,0 +1,87 @@
+//================================================================================================
+/// @file function_ref.hpp
+///
+/// @brief A non-owning, non-allocating reference to a callable object.
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#ifndef FUNCTION_REF_HPP
+#define FUNCTION_REF_HPP
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace isobus
+{
+	template<typename Signature>
+	class FunctionRef;
+
+	//================================================================================================
+	/// @class FunctionRef
+	///
+	/// @brief A reference to a callable object or a free function that can be called like a `std::function`.
+	/// @details Unlike `std::function`, this never copies the callable and never allocates memory.
+	/// It only holds a pointer to the callable, so the referenced callable must stay alive for as
+	/// long as the reference is used.
+	//================================================================================================
+	template<typename R, typename... Args>
+	class FunctionRef<R(Args...)>
+	{
+	public:
+		/// @brief Constructs a reference to a callable object
+		/// @param[in] callable The callable object to reference, which must outlive this reference
+		template<typename F,
+		         typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, FunctionRef>::value>::type>
+		FunctionRef(F &&callable) noexcept :
+		  object(const_cast<void *>(static_cast<const void *>(std::addressof(callable)))),
+		  function(&call_object<typename std::remove_reference<F>::type>)
+		{
+		}
+
+		/// @brief Constructs a reference to a free function
+		/// @param[in] freeFunction The function to reference
+		FunctionRef(R (*freeFunction)(Args...)) noexcept :
+		  freeFunction(freeFunction),
+		  function(&call_free_function)
+		{
+		}
+
+		/// @brief Calls the referenced callable
+		/// @param[in] args The arguments to pass to the callable
+		/// @returns The value returned by the callable
+		R operator()(Args... args) const
+		{
+			return function(*this, std::forward<Args>(args)...);
+		}
+
+	private:
+		/// @brief Calls a referenced callable object of a specific type
+		/// @param[in] reference The reference that holds the object
+		/// @param[in] args The arguments to pass to the callable
+		/// @returns The value returned by the callable
+		template<typename F>
+		static R call_object(const FunctionRef &reference, Args... args)
+		{
+			return (*static_cast<F *>(reference.object))(std::forward<Args>(args)...);
+		}
+
+		/// @brief Calls a referenced free function
+		/// @param[in] reference The reference that holds the function
+		/// @param[in] args The arguments to pass to the function
+		/// @returns The value returned by the function
+		static R call_free_function(const FunctionRef &reference, Args... args)
+		{
+			return reference.freeFunction(std::forward<Args>(args)...);
+		}
+
+		union
+		{
+			void *object; ///< The referenced callable object
+			R (*freeFunction)(Args...); ///< The referenced free function
+		};
+		R (*function)(const FunctionRef &, Args...); ///< Calls the referenced callable with the right type
+	};
+} // namespace isobus
+
+#endif // FUNCTION_REF_HPP
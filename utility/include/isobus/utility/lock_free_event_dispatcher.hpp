@@ -0,0 +1,296 @@
+//================================================================================================
+/// @file lock_free_event_dispatcher.hpp
+///
+/// @brief An event dispatcher for events that are invoked at a high rate, which notifies its
+/// listeners without taking any locks.
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#ifndef LOCK_FREE_EVENT_DISPATCHER_HPP
+#define LOCK_FREE_EVENT_DISPATCHER_HPP
+
+#include "isobus/utility/event_dispatcher.hpp"
+#include "isobus/utility/function_ref.hpp"
+#include "isobus/utility/thread_synchronization.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace isobus
+{
+	//================================================================================================
+	/// @class LockFreeEventDispatcher
+	///
+	/// @brief A dispatcher that notifies listeners when an event is invoked, without locking.
+	/// @details This has the same interface as `EventDispatcher`, but is meant for events that
+	/// are invoked for every CAN frame, possibly from several threads at once.
+	/// The listeners are kept in a contiguous list that is never modified once published.
+	/// Adding or removing a listener publishes a modified copy of the list, so invoking an event
+	/// only counts itself as an active reader and walks the current list. Replaced lists are
+	/// freed by the last invocation to finish, or by the next modification of the listeners.
+	/// Listeners may be added and removed from within a listener, in which case the change
+	/// takes effect from the next invocation on.
+	//================================================================================================
+	template<typename... E>
+	class LockFreeEventDispatcher
+	{
+	public:
+		using Callback = std::function<void(const E &...)>;
+		using CallbackRef = FunctionRef<void(const E &...)>;
+
+		/// @brief Default constructor for the dispatcher
+		LockFreeEventDispatcher() = default;
+
+		/// @brief Deleted copy constructor, as the listener lists are owned by the dispatcher
+		LockFreeEventDispatcher(const LockFreeEventDispatcher &) = delete;
+
+		/// @brief Deleted copy assignment, as the listener lists are owned by the dispatcher
+		LockFreeEventDispatcher &operator=(const LockFreeEventDispatcher &) = delete;
+
+		/// @brief Destructor for the dispatcher, which frees all listener lists
+		~LockFreeEventDispatcher()
+		{
+			delete currentListeners.load();
+			for (const auto list : retiredListeners)
+			{
+				delete list;
+			}
+		}
+
+		/// @brief Register a callback to be invoked when the event is invoked.
+		/// @param callback The callback to register.
+		/// @return A unique identifier for the callback, which can be used to remove the listener.
+		EventCallbackHandle add_listener(const Callback &callback)
+		{
+			std::shared_ptr<Callback> ownedCallback = std::make_shared<Callback>(callback);
+			CallbackRef callbackReference(*ownedCallback);
+			return add_listener(callbackReference, std::move(ownedCallback));
+		}
+
+		/// @brief Register a callback to be invoked when the event is invoked.
+		/// @param callback The callback to register.
+		/// @param context The context object to pass through to the callback.
+		/// @return A unique identifier for the callback, which can be used to remove the listener.
+		template<typename C>
+		EventCallbackHandle add_listener(const std::function<void(const E &..., std::shared_ptr<C>)> &callback, std::weak_ptr<C> context)
+		{
+			Callback callbackWrapper = [callback, context](const E &...args) {
+				if (auto contextPtr = context.lock())
+				{
+					callback(args..., contextPtr);
+				}
+			};
+			return add_listener(callbackWrapper);
+		}
+
+		/// @brief Register an unsafe callback to be invoked when the event is invoked.
+		/// @param callback The callback to register.
+		/// @param context The context object to pass through to the callback.
+		/// @return A unique identifier for the callback, which can be used to remove the listener.
+		template<typename C>
+		EventCallbackHandle add_unsafe_listener(const std::function<void(const E &..., C *)> &callback, C *context)
+		{
+			Callback callbackWrapper = [callback, context](const E &...args) {
+				callback(args..., context);
+			};
+			return add_listener(callbackWrapper);
+		}
+
+		/// @brief Register a reference to a callable to be invoked when the event is invoked.
+		/// @details The callable is not copied, so registering it does not allocate memory for it,
+		/// and invoking it skips the indirection of a `std::function`. The callable must stay
+		/// alive until the listener is removed.
+		/// @param callback The reference to the callable to register.
+		/// @return A unique identifier for the callback, which can be used to remove the listener.
+		EventCallbackHandle add_listener_reference(CallbackRef callback)
+		{
+			return add_listener(callback, nullptr);
+		}
+
+		/// @brief Remove a callback from the list of listeners.
+		/// @param id The unique identifier of the callback to remove.
+		void remove_listener(EventCallbackHandle id) noexcept
+		{
+			LOCK_GUARD(Mutex, writerMutex);
+			const ListenerList *oldListeners = currentListeners.load();
+			if (nullptr != oldListeners)
+			{
+				ListenerList *newListeners = new ListenerList();
+				newListeners->reserve(oldListeners->size());
+				for (const auto &listener : *oldListeners)
+				{
+					if (listener.handle != id)
+					{
+						newListeners->push_back(listener);
+					}
+				}
+
+				if (newListeners->size() == oldListeners->size())
+				{
+					delete newListeners;
+				}
+				else if (newListeners->empty())
+				{
+					delete newListeners;
+					publish(nullptr);
+				}
+				else
+				{
+					publish(newListeners);
+				}
+			}
+			reclaim_retired_listeners();
+		}
+
+		/// @brief Remove all listeners from the event.
+		void clear_listeners() noexcept
+		{
+			LOCK_GUARD(Mutex, writerMutex);
+			publish(nullptr);
+			reclaim_retired_listeners();
+		}
+
+		/// @brief Get the number of listeners registered to this event.
+		/// @return The number of listeners
+		std::size_t get_listener_count()
+		{
+			ReaderGuard guard(*this);
+			return (nullptr != guard.listeners) ? guard.listeners->size() : 0;
+		}
+
+		/// @brief Call and event with context that is forwarded to all listeners.
+		/// @param args The event context to notify listeners with.
+		void invoke(E &&...args)
+		{
+			call(args...);
+		}
+
+		/// @brief Call an event with existing context to notify all listeners.
+		/// @param args The event context to notify listeners with.
+		void call(const E &...args)
+		{
+			ReaderGuard guard(*this);
+			if (nullptr != guard.listeners)
+			{
+				for (const auto &listener : *guard.listeners)
+				{
+					listener.callback(args...);
+				}
+			}
+		}
+
+	private:
+		/// @brief A registered listener
+		struct Listener
+		{
+			EventCallbackHandle handle; ///< The unique identifier of the listener
+			CallbackRef callback; ///< The callable to invoke
+			std::shared_ptr<Callback> ownedCallback; ///< Keeps the callback alive if the dispatcher owns it, otherwise empty
+		};
+
+		using ListenerList = std::vector<Listener>;
+
+		/// @brief Counts an invocation as an active reader of the listener list for its lifetime
+		struct ReaderGuard
+		{
+			/// @brief Constructor that registers the reader and loads the current list
+			/// @param[in] owner The dispatcher to read the listeners of
+			explicit ReaderGuard(LockFreeEventDispatcher &owner) :
+			  dispatcher(owner)
+			{
+				// The reader must be counted before the list is loaded, so that a writer
+				// that sees no active readers knows nobody can still hold a replaced list
+				dispatcher.activeReaders.fetch_add(1);
+				listeners = dispatcher.currentListeners.load();
+			}
+
+			/// @brief Destructor that unregisters the reader, and frees the lists that were
+			/// replaced while it was reading if it was the last reader
+			~ReaderGuard()
+			{
+				if ((1 == dispatcher.activeReaders.fetch_sub(1)) && dispatcher.hasRetiredListeners.load())
+				{
+					dispatcher.try_reclaim_retired_listeners();
+				}
+			}
+
+			LockFreeEventDispatcher &dispatcher; ///< The dispatcher being read
+			const ListenerList *listeners; ///< The listener list that was current when the reader started
+		};
+
+		/// @brief Adds a listener to a copy of the listener list and publishes it
+		/// @param[in] callback The callable to invoke
+		/// @param[in] ownedCallback The owned callback that `callback` refers to, if any
+		/// @return A unique identifier for the callback, which can be used to remove the listener.
+		EventCallbackHandle add_listener(CallbackRef callback, std::shared_ptr<Callback> ownedCallback)
+		{
+			LOCK_GUARD(Mutex, writerMutex);
+			const EventCallbackHandle id = nextId;
+			nextId += 1;
+
+			const ListenerList *oldListeners = currentListeners.load();
+			ListenerList *newListeners = (nullptr != oldListeners) ? new ListenerList(*oldListeners) : new ListenerList();
+			newListeners->push_back({ id, callback, std::move(ownedCallback) });
+			publish(newListeners);
+			reclaim_retired_listeners();
+			return id;
+		}
+
+		/// @brief Replaces the current listener list, and retires the replaced list
+		/// @note The writer mutex must be held by the caller
+		/// @param[in] newListeners The new list of listeners, or `nullptr` if there are none
+		void publish(ListenerList *newListeners)
+		{
+			ListenerList *oldListeners = currentListeners.exchange(newListeners);
+			if (nullptr != oldListeners)
+			{
+				retiredListeners.push_back(oldListeners);
+				// Set before the readers are checked, so that a reader that leaves after the
+				// check sees it and frees the list
+				hasRetiredListeners.store(true);
+			}
+		}
+
+		/// @brief Frees the retired lists if no reader can hold them
+		/// @note The writer mutex must be held by the caller
+		void reclaim_retired_listeners()
+		{
+			// Readers that start now will load the current list, so if there are no
+			// readers right now, none of the retired lists can be in use anymore
+			if ((!retiredListeners.empty()) && (0 == activeReaders.load()))
+			{
+				for (const auto list : retiredListeners)
+				{
+					delete list;
+				}
+				retiredListeners.clear();
+				hasRetiredListeners.store(false);
+			}
+		}
+
+		/// @brief Frees the retired lists from a reader, unless a writer is busy, in which case the writer frees them
+		void try_reclaim_retired_listeners()
+		{
+#if defined CAN_STACK_DISABLE_THREADS || defined ARDUINO
+			reclaim_retired_listeners();
+#else
+			std::unique_lock<Mutex> lock(writerMutex, std::try_to_lock);
+			if (lock.owns_lock())
+			{
+				reclaim_retired_listeners();
+			}
+#endif
+		}
+
+		std::atomic<ListenerList *> currentListeners = { nullptr }; ///< The current list of listeners, or `nullptr` if there are none
+		std::atomic<std::size_t> activeReaders = { 0 }; ///< The number of invocations currently reading a listener list
+		std::vector<ListenerList *> retiredListeners; ///< Replaced lists that may still be read by an invocation
+		std::atomic_bool hasRetiredListeners = { false }; ///< Whether `retiredListeners` is not empty, so readers can check it without the writer mutex
+		Mutex writerMutex; ///< Serializes modifications of the listener list
+		EventCallbackHandle nextId = 0; ///< Counter for generating unique IDs
+	};
+} // namespace isobus
+
+#endif // LOCK_FREE_EVENT_DISPATCHER_HPP
@@ -9,8 +9,23 @@
 #ifndef THREAD_SYNCHRONIZATION_HPP
 #define THREAD_SYNCHRONIZATION_HPP
 
+#include <cstddef>
+
+namespace isobus
+{
+	/// @brief What a bounded queue does with an item that is pushed while the queue is full
+	enum class QueueOverflowPolicy
+	{
+		DropNewest, ///< The pushed item is discarded, the queued items are kept
+		DropOldest ///< The oldest queued item is discarded to make room for the pushed item
+	};
+}
+
 #if defined CAN_STACK_DISABLE_THREADS || defined ARDUINO
-#include <queue>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
 
 namespace isobus
 {
@@ -40,7 +55,7 @@ public:
 	/// @return Simply returns true, since this version of the queue is not limited in size.
 	bool push(const T &item)
 	{
-		queue.push(item);
+		queue.push_back(item);
 		return true;
 	}
 
@@ -58,6 +73,21 @@ public:
 		return true;
 	}
 
+	/// @brief Peek at the next items in the queue, without removing them.
+	/// @param items The buffer to copy the items into.
+	/// @param maximumCount The maximum number of items to copy.
+	/// @return The number of items copied into the buffer.
+	std::size_t peek(T *items, std::size_t maximumCount)
+	{
+		std::size_t count = 0;
+		for (auto it = queue.begin(); (it != queue.end()) && (count < maximumCount); ++it)
+		{
+			items[count] = *it;
+			count++;
+		}
+		return count;
+	}
+
 	/// @brief Pop an item from the queue.
 	/// @return True if the item was popped from the queue, false if the queue is empty.
 	bool pop()
@@ -67,10 +97,20 @@ public:
 			return false;
 		}
 
-		queue.pop();
+		queue.pop_front();
 		return true;
 	}
 
+	/// @brief Pop several items from the queue.
+	/// @param count The number of items to pop.
+	/// @return The number of items that were popped, which is less than `count` if the queue ran empty.
+	std::size_t pop(std::size_t count)
+	{
+		const std::size_t numberToPop = (count < queue.size()) ? count : queue.size();
+		queue.erase(queue.begin(), queue.begin() + numberToPop);
+		return numberToPop;
+	}
+
 	/// @brief Check if the queue is full.
 	/// @return Always returns false, since this version of the queue is not limited in size.
 	bool is_full() const
@@ -78,21 +118,160 @@ public:
 		return false;
 	}
 
+	/// @brief Get the number of items that can still be pushed to the queue.
+	/// @return Always returns the maximum size, since this version of the queue is not limited in size.
+	std::size_t space_available() const
+	{
+		return std::numeric_limits<std::size_t>::max();
+	}
+
+	/// @brief Get the number of items in the queue.
+	/// @return The number of items in the queue.
+	std::size_t size() const
+	{
+		return queue.size();
+	}
+
 	/// @brief Clear the queue.
 	void clear()
 	{
-		queue = {};
+		queue.clear();
 	}
 
 private:
-	std::queue<T> queue; ///< The queue
+	std::deque<T> queue; ///< The queue
 };
 
+
+namespace isobus
+{
+	/// @brief A bounded queue which, when threads are enabled, can be pushed to from multiple threads
+	/// without locking. Since threads are disabled this is a simple ring buffer.
+	/// @tparam T The item type for the queue.
+	template<typename T>
+	class LockFreeMPSCQueue
+	{
+	public:
+		/// @brief Constructor for the queue.
+		/// @param size The maximum number of items in the queue.
+		/// @param initialValue The value to initialize the (reusable) item slots with.
+		explicit LockFreeMPSCQueue(std::size_t size, const T &initialValue = T()) :
+		  buffer(size > 0 ? size : 1, initialValue)
+		{
+		}
+
+		/// @brief Push an item to the queue by filling a queue slot in place.
+		/// @param fill A callable that is passed a reference to the slot to write the item into.
+		/// @return True if the item was pushed, false if it was dropped because the queue is full.
+		template<typename F>
+		bool push_with(F fill)
+		{
+			if (count == buffer.size())
+			{
+				overflowCount++;
+				if ((QueueOverflowPolicy::DropOldest != overflowPolicy) || !discard())
+				{
+					return false;
+				}
+			}
+			fill(buffer[(head + count) % buffer.size()]);
+			count++;
+			return true;
+		}
+
+		/// @brief Push a copy of an item to the queue.
+		/// @param item The item to push to the queue.
+		/// @return True if the item was pushed, false if it was dropped because the queue is full.
+		bool push(const T &item)
+		{
+			return push_with([&item](T &slot) { slot = item; });
+		}
+
+		/// @brief Pop the next item from the queue by swapping it with `item`, so the queue can reuse `item`'s resources.
+		/// @param item The item to swap the front of the queue into.
+		/// @return True if an item was popped, false if the queue is empty.
+		bool pop(T &item)
+		{
+			if (0 == count)
+			{
+				return false;
+			}
+			using std::swap;
+			swap(item, buffer[head]);
+			return discard();
+		}
+
+		/// @brief Remove the next item from the queue without reading it.
+		/// @return True if an item was removed, false if the queue is empty.
+		bool discard()
+		{
+			if (0 == count)
+			{
+				return false;
+			}
+			head = (head + 1) % buffer.size();
+			count--;
+			return true;
+		}
+
+		/// @brief Check if the queue is empty.
+		/// @return True if the queue is empty.
+		bool empty() const
+		{
+			return (0 == count);
+		}
+
+		/// @brief Get the number of items in the queue.
+		/// @return The number of items in the queue.
+		std::size_t size() const
+		{
+			return count;
+		}
+
+		/// @brief Clear the queue.
+		void clear()
+		{
+			head = 0;
+			count = 0;
+		}
+
+		/// @brief Set what happens when an item is pushed while the queue is full.
+		/// @param policy The new overflow policy.
+		void set_overflow_policy(QueueOverflowPolicy policy)
+		{
+			overflowPolicy = policy;
+		}
+
+		/// @brief Get what happens when an item is pushed while the queue is full.
+		/// @return The current overflow policy.
+		QueueOverflowPolicy get_overflow_policy() const
+		{
+			return overflowPolicy;
+		}
+
+		/// @brief Get the number of items that were dropped because the queue was full.
+		/// @return The number of dropped items since construction.
+		std::size_t get_overflow_count() const
+		{
+			return overflowCount;
+		}
+
+	private:
+		std::vector<T> buffer; ///< The item slots of the ring buffer
+		std::size_t head = 0; ///< The index of the item at the front of the queue
+		std::size_t count = 0; ///< The number of items in the queue
+		std::size_t overflowCount = 0; ///< The number of items dropped due to overflow
+		QueueOverflowPolicy overflowPolicy = QueueOverflowPolicy::DropNewest; ///< What to do when the queue is full
+	};
+}
+
 #else
 
 #include <atomic>
 #include <cassert>
+#include <memory>
 #include <mutex>
+#include <utility>
 #include <vector>
 namespace isobus
 {
@@ -157,6 +336,25 @@ public:
 		return true;
 	}
 
+	/// @brief Peek at the next items in the queue, without removing them.
+	/// @param items The buffer to copy the items into.
+	/// @param maximumCount The maximum number of items to copy.
+	/// @return The number of items copied into the buffer.
+	std::size_t peek(T *items, std::size_t maximumCount)
+	{
+		auto currentReadIndex = readIndex.load(std::memory_order_relaxed);
+		const auto currentWriteIndex = writeIndex.load(std::memory_order_acquire);
+		std::size_t count = 0;
+
+		while ((currentReadIndex != currentWriteIndex) && (count < maximumCount))
+		{
+			items[count] = buffer[currentReadIndex];
+			currentReadIndex = nextIndex(currentReadIndex);
+			count++;
+		}
+		return count;
+	}
+
 	/// @brief Pop an item from the queue.
 	/// @return True if the item was popped from the queue, false if the queue is empty.
 	bool pop()
@@ -172,6 +370,20 @@ public:
 		return true;
 	}
 
+	/// @brief Pop several items from the queue.
+	/// @param count The number of items to pop.
+	/// @return The number of items that were popped, which is less than `count` if the queue ran empty.
+	std::size_t pop(std::size_t count)
+	{
+		const auto currentReadIndex = readIndex.load(std::memory_order_relaxed);
+		const auto currentWriteIndex = writeIndex.load(std::memory_order_acquire);
+		const std::size_t used = (currentWriteIndex + capacity - currentReadIndex) % capacity;
+		const std::size_t numberToPop = (count < used) ? count : used;
+
+		readIndex.store((currentReadIndex + numberToPop) % capacity, std::memory_order_release);
+		return numberToPop;
+	}
+
 	/// @brief Check if the queue is full.
 	/// @return True if the queue is full, false if the queue is not full.
 	bool is_full() const
@@ -179,6 +391,25 @@ public:
 		return nextIndex(writeIndex.load(std::memory_order_acquire)) == readIndex.load(std::memory_order_acquire);
 	}
 
+	/// @brief Get the number of items that can still be pushed to the queue.
+	/// @return The number of free slots in the queue.
+	std::size_t space_available() const
+	{
+		const auto currentReadIndex = readIndex.load(std::memory_order_acquire);
+		const auto currentWriteIndex = writeIndex.load(std::memory_order_acquire);
+		const std::size_t used = (currentWriteIndex + capacity - currentReadIndex) % capacity;
+		return capacity - used - 1; // One slot is always kept free to distinguish full from empty
+	}
+
+	/// @brief Get the number of items in the queue.
+	/// @return The number of items in the queue.
+	std::size_t size() const
+	{
+		const auto currentReadIndex = readIndex.load(std::memory_order_acquire);
+		const auto currentWriteIndex = writeIndex.load(std::memory_order_acquire);
+		return (currentWriteIndex + capacity - currentReadIndex) % capacity;
+	}
+
 	/// @brief Clear the queue.
 	void clear()
 	{
@@ -201,6 +432,213 @@ private:
 	}
 };
 
+namespace isobus
+{
+	/// @brief A bounded, lock-free queue that can be pushed to from multiple threads and is popped
+	/// from by a single consumer thread.
+	/// @details This generalizes `LockFreeQueue` to multiple producers. Each slot carries a sequence
+	/// number that tells producers and the consumer whose turn it is, so producers only contend on
+	/// a single atomic index. Items are written into the slots in place and popped by swapping, which
+	/// allows the slots' resources (like buffers) to be recycled. When the queue is full, the pushed
+	/// item or the oldest item is dropped depending on the overflow policy, and counted.
+	/// @note Dropping the oldest item makes the producer briefly act as a consumer, which the
+	/// algorithm supports, so the policy can be used with any number of producers.
+	/// @tparam T The item type for the queue.
+	template<typename T>
+	class LockFreeMPSCQueue
+	{
+	public:
+		/// @brief Constructor for the queue.
+		/// @param size The maximum number of items in the queue.
+		/// @param initialValue The value to initialize the (reusable) item slots with.
+		explicit LockFreeMPSCQueue(std::size_t size, const T &initialValue = T()) :
+		  buffer(size > 0 ? size : 1, initialValue),
+		  sequences(new std::atomic<std::size_t>[size > 0 ? size : 1]),
+		  capacity(size > 0 ? size : 1)
+		{
+			assert(size > 0 && "The size of the queue must be greater than 0.");
+			for (std::size_t i = 0; i < capacity; i++)
+			{
+				sequences[i].store(i, std::memory_order_relaxed);
+			}
+		}
+
+		/// @brief Push an item to the queue by filling a queue slot in place.
+		/// @param fill A callable that is passed a reference to the slot to write the item into.
+		/// @return True if the item was pushed, false if it was dropped because the queue is full.
+		template<typename F>
+		bool push_with(F fill)
+		{
+			std::size_t position;
+			while (!claim_write_position(position))
+			{
+				overflowCount.fetch_add(1, std::memory_order_relaxed);
+				if ((QueueOverflowPolicy::DropOldest != overflowPolicy.load(std::memory_order_relaxed)) || !discard())
+				{
+					return false;
+				}
+			}
+
+			fill(buffer[position % capacity]);
+			sequences[position % capacity].store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		/// @brief Push a copy of an item to the queue.
+		/// @param item The item to push to the queue.
+		/// @return True if the item was pushed, false if it was dropped because the queue is full.
+		bool push(const T &item)
+		{
+			return push_with([&item](T &slot) { slot = item; });
+		}
+
+		/// @brief Pop the next item from the queue by swapping it with `item`, so the queue can reuse `item`'s resources.
+		/// @param item The item to swap the front of the queue into.
+		/// @return True if an item was popped, false if the queue is empty.
+		bool pop(T &item)
+		{
+			std::size_t position;
+			if (!claim_read_position(position))
+			{
+				return false;
+			}
+
+			using std::swap;
+			swap(item, buffer[position % capacity]);
+			sequences[position % capacity].store(position + capacity, std::memory_order_release);
+			return true;
+		}
+
+		/// @brief Remove the next item from the queue without reading it.
+		/// @return True if an item was removed, false if the queue is empty.
+		bool discard()
+		{
+			std::size_t position;
+			if (!claim_read_position(position))
+			{
+				return false;
+			}
+
+			sequences[position % capacity].store(position + capacity, std::memory_order_release);
+			return true;
+		}
+
+		/// @brief Check if the queue is empty.
+		/// @note With concurrent producers this is only a snapshot.
+		/// @return True if the queue is empty.
+		bool empty() const
+		{
+			return readIndex.load(std::memory_order_acquire) == writeIndex.load(std::memory_order_acquire);
+		}
+
+		/// @brief Get the number of items in the queue.
+		/// @note With concurrent producers this is only a snapshot.
+		/// @return The number of items in the queue.
+		std::size_t size() const
+		{
+			const auto currentReadIndex = readIndex.load(std::memory_order_acquire);
+			const auto currentWriteIndex = writeIndex.load(std::memory_order_acquire);
+			return (currentWriteIndex > currentReadIndex) ? (currentWriteIndex - currentReadIndex) : 0;
+		}
+
+		/// @brief Clear the queue.
+		void clear()
+		{
+			while (discard())
+			{
+			}
+		}
+
+		/// @brief Set what happens when an item is pushed while the queue is full.
+		/// @param policy The new overflow policy.
+		void set_overflow_policy(QueueOverflowPolicy policy)
+		{
+			overflowPolicy.store(policy, std::memory_order_relaxed);
+		}
+
+		/// @brief Get what happens when an item is pushed while the queue is full.
+		/// @return The current overflow policy.
+		QueueOverflowPolicy get_overflow_policy() const
+		{
+			return overflowPolicy.load(std::memory_order_relaxed);
+		}
+
+		/// @brief Get the number of items that were dropped because the queue was full.
+		/// @return The number of dropped items since construction.
+		std::size_t get_overflow_count() const
+		{
+			return overflowCount.load(std::memory_order_relaxed);
+		}
+
+	private:
+		/// @brief Claim the next position to write an item to.
+		/// @param position The claimed position.
+		/// @return True if a position was claimed, false if the queue is full.
+		bool claim_write_position(std::size_t &position)
+		{
+			position = writeIndex.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				const auto sequence = sequences[position % capacity].load(std::memory_order_acquire);
+				const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+				if (0 == difference)
+				{
+					if (writeIndex.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						return true;
+					}
+				}
+				else if (difference < 0)
+				{
+					return false; // The slot hasn't been consumed yet, so the queue is full
+				}
+				else
+				{
+					position = writeIndex.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/// @brief Claim the next position to read an item from.
+		/// @param position The claimed position.
+		/// @return True if a position was claimed, false if the queue is empty.
+		bool claim_read_position(std::size_t &position)
+		{
+			position = readIndex.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				const auto sequence = sequences[position % capacity].load(std::memory_order_acquire);
+				const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+				if (0 == difference)
+				{
+					if (readIndex.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						return true;
+					}
+				}
+				else if (difference < 0)
+				{
+					return false; // The slot hasn't been written yet, so the queue is empty
+				}
+				else
+				{
+					position = readIndex.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		std::vector<T> buffer; ///< The item slots of the ring buffer
+		std::unique_ptr<std::atomic<std::size_t>[]> sequences; ///< The sequence number of each slot
+		const std::size_t capacity; ///< The capacity of the ring buffer
+		std::atomic<std::size_t> writeIndex = { 0 }; ///< The next position producers will claim
+		std::atomic<std::size_t> readIndex = { 0 }; ///< The next position the consumer will claim
+		std::atomic<std::size_t> overflowCount = { 0 }; ///< The number of items dropped due to overflow
+		std::atomic<QueueOverflowPolicy> overflowPolicy = { QueueOverflowPolicy::DropNewest }; ///< What to do when the queue is full
+	};
+}
+
 #endif
 
 #endif // THREAD_SYNCHRONIZATION_HPP
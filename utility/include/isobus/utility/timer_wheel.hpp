@@ -0,0 +1,82 @@
+//================================================================================================
+/// @file timer_wheel.hpp
+///
+/// @brief A hierarchical timer wheel for tracking many millisecond timers cheaply.
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace isobus
+{
+	//================================================================================================
+	/// @class TimerWheel
+	///
+	/// @brief Tracks timers against the SystemTiming millisecond clock, and finds the ones that
+	/// expired without looking at the ones that didn't.
+	/// @details Timers are sorted into 4 levels of 64 slots each. The first level has a slot for each of
+	/// the next 64 milliseconds, and each level after it has slots that cover 64 times as long as the
+	/// level below it. As time passes, the slots of the higher levels are moved down a level whenever
+	/// the level below them wraps around. So adding a timer and expiring a timer are constant time,
+	/// no matter how many timers there are. Timers further in the future than the 4 levels cover
+	/// (about 4.6 hours) are kept in the last level until they come within range.
+	/// Timers can't be removed. Instead, the owner should check if an expired timer is still wanted.
+	//================================================================================================
+	class TimerWheel
+	{
+	public:
+		/// @brief A timer in the wheel
+		struct Timer
+		{
+			std::uint32_t id; ///< An identifier for what the timer is for, chosen by the owner of the wheel
+			std::uint32_t expiryTime_ms; ///< The SystemTiming timestamp when the timer expires
+		};
+
+		/// @brief Constructs an empty timer wheel
+		TimerWheel() = default;
+
+		/// @brief Adds a timer to the wheel
+		/// @param[in] id An identifier for what the timer is for, which is returned when the timer expires
+		/// @param[in] expiryTime_ms The SystemTiming timestamp when the timer expires.
+		/// Timers that have already expired are returned by the next call to get_expired_timers.
+		void add_timer(std::uint32_t id, std::uint32_t expiryTime_ms);
+
+		/// @brief Removes every timer that has expired from the wheel, and adds them to a list
+		/// @param[out] expiredTimers The list to add the expired timers to, in the order they expired
+		void get_expired_timers(std::vector<Timer> &expiredTimers);
+
+		/// @brief Returns the number of timers in the wheel
+		/// @returns The number of timers in the wheel
+		std::size_t size() const;
+
+		/// @brief Removes every timer from the wheel
+		void clear();
+
+	private:
+		static constexpr std::uint32_t SLOT_BITS = 6; ///< The number of timestamp bits each level of the wheel covers
+		static constexpr std::uint32_t SLOTS_PER_LEVEL = 1 << SLOT_BITS; ///< The number of slots in each level of the wheel
+		static constexpr std::uint32_t SLOT_MASK = SLOTS_PER_LEVEL - 1; ///< Masks the timestamp bits of one level of the wheel
+		static constexpr std::uint32_t NUMBER_OF_LEVELS = 4; ///< The number of levels in the wheel
+		static constexpr std::uint32_t WHEEL_RANGE_MS = 1 << (SLOT_BITS * NUMBER_OF_LEVELS); ///< How far into the future the wheel can sort timers
+
+		/// @brief Puts a timer into the slot it belongs in, based on how long it is until it expires
+		/// @param[in] timer The timer to add
+		void insert_timer(const Timer &timer);
+
+		/// @brief Moves the timers in the slots of the higher levels that start at the current time down a level
+		void cascade_timers();
+
+		std::array<std::vector<Timer>, SLOTS_PER_LEVEL * NUMBER_OF_LEVELS> slots; ///< The timers in each slot of each level, level by level
+		std::array<std::size_t, NUMBER_OF_LEVELS> numberOfTimersInLevel = { { 0 } }; ///< The number of timers in each level
+		std::size_t numberOfTimers = 0; ///< The total number of timers in the wheel
+		std::uint32_t currentTime_ms = 0; ///< The next millisecond of the first level that hasn't been processed yet
+	};
+} // namespace isobus
+
+#endif // TIMER_WHEEL_HPP
@@ -0,0 +1,137 @@
+//================================================================================================
+/// @file timer_wheel.cpp
+///
+/// @brief Implements a hierarchical timer wheel for tracking many millisecond timers cheaply.
+///
+/// @copyright 2024 The Open-Agriculture Developers
+//================================================================================================
+#include "isobus/utility/timer_wheel.hpp"
+
+#include "isobus/utility/system_timing.hpp"
+
+namespace isobus
+{
+	void TimerWheel::add_timer(std::uint32_t id, std::uint32_t expiryTime_ms)
+	{
+		if (0 == numberOfTimers)
+		{
+			// The wheel doesn't need to keep up with the clock while it's empty, so catch up now
+			currentTime_ms = SystemTiming::get_timestamp_ms();
+		}
+		insert_timer({ id, expiryTime_ms });
+	}
+
+	void TimerWheel::get_expired_timers(std::vector<Timer> &expiredTimers)
+	{
+		const std::uint32_t timestamp_ms = SystemTiming::get_timestamp_ms();
+
+		while ((0 != numberOfTimers) &&
+		       (static_cast<std::int32_t>(timestamp_ms - currentTime_ms) >= 0))
+		{
+			if (0 == (currentTime_ms & SLOT_MASK))
+			{
+				cascade_timers();
+			}
+
+			auto &slot = slots[currentTime_ms & SLOT_MASK];
+			if (!slot.empty())
+			{
+				expiredTimers.insert(expiredTimers.end(), slot.begin(), slot.end());
+				numberOfTimersInLevel[0] -= slot.size();
+				numberOfTimers -= slot.size();
+				slot.clear();
+			}
+
+			if (0 == numberOfTimersInLevel[0])
+			{
+				// Nothing can expire before the next time the higher levels cascade, so skip straight to it
+				currentTime_ms = (currentTime_ms | SLOT_MASK) + 1;
+			}
+			else
+			{
+				currentTime_ms++;
+			}
+		}
+
+		if ((0 == numberOfTimers) ||
+		    (static_cast<std::int32_t>(timestamp_ms - currentTime_ms) < 0))
+		{
+			currentTime_ms = timestamp_ms + 1;
+		}
+	}
+
+	std::size_t TimerWheel::size() const
+	{
+		return numberOfTimers;
+	}
+
+	void TimerWheel::clear()
+	{
+		for (auto &slot : slots)
+		{
+			slot.clear();
+		}
+		numberOfTimersInLevel.fill(0);
+		numberOfTimers = 0;
+	}
+
+	void TimerWheel::insert_timer(const Timer &timer)
+	{
+		std::uint32_t slotTime_ms = timer.expiryTime_ms;
+		std::uint32_t timeUntilExpiry_ms = timer.expiryTime_ms - currentTime_ms;
+		std::uint32_t level = 0;
+
+		if (static_cast<std::int32_t>(timeUntilExpiry_ms) <= 0)
+		{
+			// Already expired, so it goes in the next slot to be processed
+			slotTime_ms = currentTime_ms;
+			timeUntilExpiry_ms = 0;
+		}
+		else if (timeUntilExpiry_ms >= WHEEL_RANGE_MS)
+		{
+			// Park it in the furthest slot of the last level, it gets sorted again when that slot cascades
+			slotTime_ms = currentTime_ms + WHEEL_RANGE_MS - 1;
+			timeUntilExpiry_ms = WHEEL_RANGE_MS - 1;
+		}
+
+		while ((level < (NUMBER_OF_LEVELS - 1)) &&
+		       (timeUntilExpiry_ms >= (1UL << (SLOT_BITS * (level + 1)))))
+		{
+			level++;
+		}
+
+		slots[(level * SLOTS_PER_LEVEL) + ((slotTime_ms >> (SLOT_BITS * level)) & SLOT_MASK)].push_back(timer);
+		numberOfTimersInLevel[level]++;
+		numberOfTimers++;
+	}
+
+	void TimerWheel::cascade_timers()
+	{
+		std::vector<Timer> cascadingTimers;
+
+		for (std::uint32_t level = 1; level < NUMBER_OF_LEVELS; level++)
+		{
+			const std::uint32_t slotIndex = (currentTime_ms >> (SLOT_BITS * level)) & SLOT_MASK;
+			auto &slot = slots[(level * SLOTS_PER_LEVEL) + slotIndex];
+
+			if (!slot.empty())
+			{
+				cascadingTimers.swap(slot);
+				numberOfTimersInLevel[level] -= cascadingTimers.size();
+				numberOfTimers -= cascadingTimers.size();
+
+				for (const auto &timer : cascadingTimers)
+				{
+					insert_timer(timer);
+				}
+				cascadingTimers.clear();
+			}
+
+			if (0 != slotIndex)
+			{
+				// Only the level above a level that just wrapped around needs to cascade
+				break;
+			}
+		}
+	}
+} // namespace isobus